@@ -3,6 +3,7 @@
 #include "Core/ApplicationInfo.h"
 #include "Core/Liara_App.h"
 #include "Graphics/Liara_Model.h"
+#include "Graphics/MeshSimplifier.h"
 #include "Listener/KeybordMovementController.h"
 #include "Systems/ImGuiSystem.h"
 #include "Systems/PointLightSystem.h"
@@ -29,7 +30,7 @@ DemoApp::DemoApp(const Liara::Core::ApplicationInfo& appInfo)
 }
 
 void DemoApp::ProcessInput(const float frameTime) {
-    m_Controller.moveInSpaceXYZ(m_Window.GetWindow(), frameTime, *m_Player);
+    m_Controller.moveInSpaceXYZ(GetKeyboardState(), frameTime, *m_Player);
     m_Camera.SetViewYXZ(m_Player->transform.position, m_Player->transform.rotation);
 }
 
@@ -38,23 +39,32 @@ void DemoApp::InitSystems() {
         m_Device, m_RendererManager.GetRenderer().GetRenderPass(), m_GlobalSetLayout, *m_SettingsManager));
     AddSystem(std::make_unique<Liara::Systems::PointLightSystem>(
         m_Device, m_RendererManager.GetRenderer().GetRenderPass(), m_GlobalSetLayout, *m_SettingsManager));
-    AddSystem(std::make_unique<Liara::Systems::ImGuiSystem>(m_Window,
-                                                            m_Device,
-                                                            m_ApplicationInfo,
-                                                            m_RendererManager.GetRenderer().GetRenderPass(),
-                                                            m_RendererManager.GetRenderer().GetImageCount()));
+    if (!m_Window.IsHeadless()) {
+        AddSystem(std::make_unique<Liara::Systems::ImGuiSystem>(m_Window,
+                                                                m_Device,
+                                                                m_ApplicationInfo,
+                                                                m_RendererManager.GetRenderer().GetRenderPass(),
+                                                                m_RendererManager.GetRenderer().GetImageCount()));
+    }
 }
 
 
 void DemoApp::LoadGameObjects() {
-    const std::shared_ptr model =
-        Liara::Graphics::Liara_Model::CreateFromFile(m_Device, "assets/models/viking_room.obj", 1);
+    auto meshData = Liara::Graphics::LoadMeshFromOBJ("assets/models/viking_room.obj", 1);
+    Liara::Graphics::GenerateMeshLods(meshData,
+                                      {.levelCount = m_SettingsManager->GetUInt("mesh.lod_levels"),
+                                       .reduction = m_SettingsManager->GetFloat("mesh.lod_reduction"),
+                                       .maxError = m_SettingsManager->GetFloat("mesh.lod_max_error")},
+                                      m_JobSystem.get());
+    const std::shared_ptr model = Liara::Graphics::Liara_Model::CreateFromMeshData(m_Device, meshData);
     auto vikingRoom = Liara::Core::Liara_GameObject::CreateGameObject();
     vikingRoom.model = model;
+    // The walls of the room hide what is behind them when occlusion culling is enabled
+    vikingRoom.occluder = Liara::Graphics::CreateOccluderMesh(meshData);
     vikingRoom.transform.position = {0.F, .75F, 0.F};
     vikingRoom.transform.scale = {1.5F, 1.5F, 1.5F};
     vikingRoom.transform.rotation = {glm::radians(90.F), glm::radians(135.F), 0.f};
-    m_GameObjects.emplace(vikingRoom.GetId(), std::move(vikingRoom));
+    std::move(vikingRoom).Spawn(m_Registry);
 
     const std::vector<glm::vec3> lightColors{
         {1.F, .1F, .1F},
@@ -72,11 +82,11 @@ void DemoApp::LoadGameObjects() {
                         (static_cast<float>(i) * glm::two_pi<float>()) / static_cast<float>(lightColors.size()),
                         {0.F, -1.F, 0.F});
         pointLight.transform.position = glm::vec3(rotateLight * glm::vec4(-1.F, -0.3F, -1.F, 1.F));
-        m_GameObjects.emplace(pointLight.GetId(), std::move(pointLight));
+        std::move(pointLight).Spawn(m_Registry);
     }
 
     auto pointLight = Liara::Core::Liara_GameObject::MakePointLight(0.5F);
     pointLight.color = {1.F, 1.F, 1.F};
     pointLight.transform.position = {0.F, -0.25F, 0.F};
-    m_GameObjects.emplace(pointLight.GetId(), std::move(pointLight));
+    std::move(pointLight).Spawn(m_Registry);
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+/**
+ * @file BenchmarkUtils.h
+ * @brief Minimal timing helpers shared by the benchmark executables.
+ *
+ * Benchmarks are plain executables printing their results, they are not registered as tests.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace Liara::Benchmarks
+{
+    /**
+     * @brief Prevents the compiler from optimizing away a computed value.
+     */
+    template <typename T> void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+
+    struct BenchmarkResult
+    {
+        double minMs = 0.0;
+        double medianMs = 0.0;
+        double meanMs = 0.0;
+    };
+
+    /**
+     * @brief Runs func a few times to warm up, then iterations times, and prints the timings.
+     * @return The measured timings, in milliseconds per iteration.
+     */
+    template <typename Func>
+    BenchmarkResult Run(const std::string_view name, const size_t iterations, Func&& func, const size_t warmup = 3) {
+        for (size_t i = 0; i < warmup; ++i) { func(); }
+
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        for (size_t i = 0; i < iterations; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            func();
+            const auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+
+        std::ranges::sort(samples);
+        BenchmarkResult result;
+        result.minMs = samples.front();
+        result.medianMs = samples[samples.size() / 2];
+        for (const double sample : samples) { result.meanMs += sample; }
+        result.meanMs /= static_cast<double>(samples.size());
+
+        std::printf("%-48.*s min %9.3f ms | median %9.3f ms | mean %9.3f ms\n",
+                    static_cast<int>(name.size()),
+                    name.data(),
+                    result.minMs,
+                    result.medianMs,
+                    result.meanMs);
+        return result;
+    }
+}
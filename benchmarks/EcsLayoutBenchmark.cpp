@@ -0,0 +1,100 @@
+/**
+ * Compares the iteration cost of the old game object map (`std::unordered_map<id_t, Liara_GameObject>`)
+ * with the sparse-set storage of `Liara_Registry`, on the two access patterns of the render and light systems.
+ */
+
+#include "Core/Components/ColorComponent.h"
+#include "Core/Components/PointLightComponent.h"
+#include "Core/Components/TransformComponent3d.h"
+#include "Core/ECS/Liara_Registry.h"
+#include "Core/Liara_GameObject.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <utility>
+
+#include "BenchmarkUtils.h"
+#include "glm/ext/vector_float3.hpp"
+#include "glm/ext/vector_float4.hpp"
+
+namespace
+{
+    using namespace Liara;
+    using LegacyMap = std::unordered_map<unsigned int, Core::Liara_GameObject>;
+
+    constexpr size_t LIGHT_RATIO = 16;  // One object out of LIGHT_RATIO is a point light
+
+    Core::Liara_GameObject MakeObject(std::mt19937& rng, const size_t index) {
+        std::uniform_real_distribution position(-100.0f, 100.0f);
+        std::uniform_real_distribution angle(0.0f, 6.28f);
+
+        auto object = index % LIGHT_RATIO == 0 ? Core::Liara_GameObject::MakePointLight()
+                                               : Core::Liara_GameObject::CreateGameObject();
+        object.transform.position = {position(rng), position(rng), position(rng)};
+        object.transform.rotation = {angle(rng), angle(rng), angle(rng)};
+        object.color = {1.0f, 0.5f, 0.25f};
+        return object;
+    }
+
+    void RunScenario(const size_t objectCount, const size_t iterations) {
+        std::printf("\n--- %zu objects ---\n", objectCount);
+
+        std::mt19937 rng(42);
+        LegacyMap legacy;
+        Core::ECS::Liara_Registry registry;
+        for (size_t i = 0; i < objectCount; ++i) {
+            legacy.emplace(static_cast<unsigned int>(i), MakeObject(rng, i));
+            MakeObject(rng, i).Spawn(registry);
+        }
+
+        Benchmarks::Run("Map: model matrices", iterations, [&] {
+            glm::vec4 sum{0.0f};
+            for (const auto& [id, object] : legacy) { sum += object.transform.GetMat4()[3]; }
+            Benchmarks::DoNotOptimize(sum);
+        });
+
+        Benchmarks::Run("Registry: model matrices", iterations, [&] {
+            glm::vec4 sum{0.0f};
+            registry.View<const Core::Component::TransformComponent3d>().Each(
+                [&](Core::ECS::Entity, const Core::Component::TransformComponent3d& transform) {
+                    sum += transform.GetMat4()[3];
+                });
+            Benchmarks::DoNotOptimize(sum);
+        });
+
+        Benchmarks::Run("Map: point light pass", iterations, [&] {
+            glm::vec4 sum{0.0f};
+            for (auto& [id, object] : legacy) {
+                if (!object.pointLight) { continue; }
+                object.transform.position.y += 0.001f;
+                sum += glm::vec4(object.color, object.pointLight->intensity);
+            }
+            Benchmarks::DoNotOptimize(sum);
+        });
+
+        Benchmarks::Run("Registry: point light pass", iterations, [&] {
+            glm::vec4 sum{0.0f};
+            registry
+                .View<const Core::Component::PointLightComponent,
+                      Core::Component::TransformComponent3d,
+                      const Core::Component::ColorComponent>()
+                .Each([&](Core::ECS::Entity,
+                          const Core::Component::PointLightComponent& pointLight,
+                          Core::Component::TransformComponent3d& transform,
+                          const Core::Component::ColorComponent& color) {
+                    transform.position.y += 0.001f;
+                    sum += glm::vec4(color.color, pointLight.intensity);
+                });
+            Benchmarks::DoNotOptimize(sum);
+        });
+    }
+}
+
+int main() {
+    RunScenario(10'000, 200);
+    RunScenario(100'000, 50);
+    RunScenario(1'000'000, 10);
+    return 0;
+}
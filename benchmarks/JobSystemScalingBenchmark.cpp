@@ -0,0 +1,93 @@
+/**
+ * Scaling of the job system from 1 to N threads:
+ * a compute bound ParallelFor over 1M transforms, and 10k tiny jobs to expose the scheduling overhead.
+ */
+
+#include "Core/Components/TransformComponent3d.h"
+#include "Core/Jobs/Liara_JobSystem.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "glm/ext/matrix_float4x4.hpp"
+
+namespace
+{
+    using namespace Liara;
+
+    constexpr size_t TRANSFORMS = 1'000'000;
+    constexpr size_t BATCH_SIZE = 1024;
+    constexpr size_t TINY_JOBS = 10'000;
+    constexpr size_t ITERATIONS = 30;
+
+    void ComputeMatrices(const std::vector<Core::Component::TransformComponent3d>& transforms,
+                         std::vector<glm::mat4>& matrices,
+                         const size_t begin,
+                         const size_t end) {
+        for (size_t i = begin; i < end; ++i) { matrices[i] = transforms[i].GetMat4(); }
+    }
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution value(-10.0f, 10.0f);
+
+    std::vector<Core::Component::TransformComponent3d> transforms(TRANSFORMS);
+    for (auto& transform : transforms) {
+        transform.position = {value(rng), value(rng), value(rng)};
+        transform.rotation = {value(rng), value(rng), value(rng)};
+    }
+    std::vector<glm::mat4> matrices(TRANSFORMS);
+
+    const uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::printf("%zu transforms, up to %u threads\n\n", TRANSFORMS, maxThreads);
+
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threads = 1; threads < maxThreads; threads *= 2) { threadCounts.push_back(threads); }
+    threadCounts.push_back(maxThreads);
+
+    char name[64];
+    double baseline = 0.0;
+    for (const uint32_t threads : threadCounts) {
+        double median = 0.0;
+        if (threads == 1) {
+            // A job system always has at least one worker, the single thread case is the plain loop
+            std::snprintf(name, sizeof(name), "ParallelFor GetMat4, 1 thread (serial)");
+            median = Benchmarks::Run(name, ITERATIONS, [&] {
+                ComputeMatrices(transforms, matrices, 0, TRANSFORMS);
+                Benchmarks::DoNotOptimize(matrices.back());
+            }).medianMs;
+            baseline = median;
+        }
+        else {
+            Core::Jobs::Liara_JobSystem jobSystem(threads - 1);
+
+            std::snprintf(name, sizeof(name), "ParallelFor GetMat4, %u threads", threads);
+            median = Benchmarks::Run(name, ITERATIONS, [&] {
+                jobSystem.ParallelFor(TRANSFORMS, BATCH_SIZE, [&](const size_t begin, const size_t end) {
+                    ComputeMatrices(transforms, matrices, begin, end);
+                });
+                Benchmarks::DoNotOptimize(matrices.back());
+            }).medianMs;
+
+            std::snprintf(name, sizeof(name), "%zu tiny jobs, %u threads", TINY_JOBS, threads);
+            Benchmarks::Run(name, ITERATIONS, [&] {
+                Core::Jobs::JobCounter counter;
+                for (size_t i = 0; i < TINY_JOBS; ++i) {
+                    jobSystem.Schedule([] {}, std::span<const Core::Jobs::JobHandle>{}, &counter);
+                }
+                jobSystem.Wait(counter);
+            });
+        }
+        std::printf("  -> speedup x%.2f\n", baseline / median);
+    }
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * Dynamic BVH at 10k, 100k and 1M objects of constant density:
+ * bulk and incremental build, per-step updates of moving objects, and frustum, radius, ray and nearest queries
+ * against a linear scan of the boxes.
+ */
+
+#include "Core/Liara_Camera.h"
+#include "Core/Math/Bounds.h"
+#include "Core/Math/FrustumCulling.h"
+#include "Core/Spatial/Liara_DynamicBVH.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "glm/ext/vector_float3.hpp"
+#include "glm/geometric.hpp"
+
+namespace
+{
+    using namespace Liara;
+
+    constexpr size_t QUERIES = 1000;
+    constexpr float QUERY_RADIUS = 10.0f;
+    constexpr float MOVING_FRACTION = 0.1f;  ///< Objects moving at each simulated step
+    constexpr float MAX_SPEED = 0.2f;        ///< Displacement per step, in world units
+
+    struct Scene
+    {
+        std::vector<Core::Math::AABB> boxes;
+        float extent = 0.0f;  ///< Objects are spread in [-extent, extent]^3
+    };
+
+    Scene CreateScene(const size_t count, std::mt19937& rng) {
+        Scene scene;
+        // About one object per 64 cubic units, whatever the count
+        scene.extent = 2.0f * std::cbrt(static_cast<float>(count));
+        std::uniform_real_distribution position(-scene.extent, scene.extent);
+        std::uniform_real_distribution halfSize(0.25f, 1.0f);
+
+        scene.boxes.resize(count);
+        for (auto& box : scene.boxes) {
+            const glm::vec3 center{position(rng), position(rng), position(rng)};
+            const glm::vec3 half{halfSize(rng), halfSize(rng), halfSize(rng)};
+            box = {.min = center - half, .max = center + half};
+        }
+        return scene;
+    }
+
+    float DistanceSquared(const Core::Math::AABB& box, const glm::vec3& point) {
+        const glm::vec3 offset = glm::max(glm::max(box.min - point, point - box.max), glm::vec3(0.0f));
+        return glm::dot(offset, offset);
+    }
+
+    void RunSize(const size_t count) {
+        std::mt19937 rng(42);
+        Scene scene = CreateScene(count, rng);
+        const size_t iterations = count >= 1'000'000 ? 5 : 20;
+        std::printf("== %zu objects, extent %.0f ==\n", count, scene.extent);
+
+        char name[96];
+        Core::Spatial::Liara_DynamicBVH tree(0.25f);
+
+        // Build
+        std::snprintf(name, sizeof(name), "Bulk build");
+        Benchmarks::Run(name, iterations, [&] {
+            tree.Build(scene.boxes);
+            Benchmarks::DoNotOptimize(tree.GetHeight());
+        });
+        std::printf("  -> height %d, area ratio %.1f\n", tree.GetHeight(), tree.GetAreaRatio());
+
+        std::snprintf(name, sizeof(name), "Incremental build");
+        Benchmarks::Run(
+            name,
+            std::max<size_t>(iterations / 4, 1),
+            [&] {
+                tree.Clear();
+                for (size_t i = 0; i < count; ++i) { tree.Insert(scene.boxes[i], static_cast<uint32_t>(i)); }
+                Benchmarks::DoNotOptimize(tree.GetHeight());
+            },
+            1);
+        std::printf("  -> height %d, area ratio %.1f\n", tree.GetHeight(), tree.GetAreaRatio());
+
+        // Update: a fraction of the objects drift at each step, most stay within their fat box
+        std::vector<uint32_t> moving(static_cast<size_t>(static_cast<float>(count) * MOVING_FRACTION));
+        std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(count - 1));
+        for (auto& index : moving) { index = pick(rng); }
+        std::vector<glm::vec3> velocities(moving.size());
+        std::uniform_real_distribution speed(-MAX_SPEED, MAX_SPEED);
+        for (auto& velocity : velocities) { velocity = {speed(rng), speed(rng), speed(rng)}; }
+
+        size_t reinserted = 0;
+        size_t steps = 0;
+        // The proxies of a bulk built tree are the indices of the boxes
+        tree.Build(scene.boxes);
+        std::snprintf(name, sizeof(name), "Update %zu moving objects", moving.size());
+        Benchmarks::Run(name, iterations, [&] {
+            for (size_t i = 0; i < moving.size(); ++i) {
+                Core::Math::AABB& box = scene.boxes[moving[i]];
+                box.min = box.min + velocities[i];
+                box.max = box.max + velocities[i];
+                reinserted += tree.Move(moving[i], box, velocities[i]) ? 1 : 0;
+            }
+            ++steps;
+        });
+        std::printf("  -> %.1f%% reinserted per step, height %d, area ratio %.1f\n",
+                    100.0 * static_cast<double>(reinserted) / static_cast<double>(steps * moving.size()),
+                    tree.GetHeight(),
+                    tree.GetAreaRatio());
+
+        // Frustum: a camera at the center of the scene, seeing a small part of it
+        Core::Liara_Camera camera;
+        camera.SetPerspectiveProjection(1.0f, 16.0f / 9.0f, 0.1f, scene.extent * 0.5f);
+        camera.SetViewDirection(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        const auto frustum =
+            Core::Math::Frustum::FromMatrix(camera.GetProjectionMatrix() * camera.GetViewMatrix());
+
+        size_t visible = 0;
+        Benchmarks::Run("Frustum, linear scan", iterations, [&] {
+            visible = 0;
+            for (const auto& box : scene.boxes) { visible += frustum.IsBoxVisible(box) ? 1 : 0; }
+            Benchmarks::DoNotOptimize(visible);
+        });
+        std::printf("  -> %zu visible\n", visible);
+        Benchmarks::Run("Frustum, BVH", iterations, [&] {
+            visible = 0;
+            tree.QueryFrustum(frustum, [&](Core::Spatial::ProxyId) { ++visible; });
+            Benchmarks::DoNotOptimize(visible);
+        });
+        std::printf("  -> %zu candidates\n", visible);
+
+        // Query points and rays inside the scene
+        std::uniform_real_distribution position(-scene.extent, scene.extent);
+        std::vector<glm::vec3> points(QUERIES);
+        std::vector<glm::vec3> directions(QUERIES);
+        for (size_t i = 0; i < QUERIES; ++i) {
+            points[i] = {position(rng), position(rng), position(rng)};
+            directions[i] = glm::normalize(glm::vec3(position(rng), position(rng), position(rng)));
+        }
+
+        std::snprintf(name, sizeof(name), "%zu radius queries, linear scan", QUERIES);
+        size_t found = 0;
+        const auto linearRadius = [&] {
+            found = 0;
+            for (const auto& point : points) {
+                for (const auto& box : scene.boxes) {
+                    found += DistanceSquared(box, point) <= QUERY_RADIUS * QUERY_RADIUS ? 1 : 0;
+                }
+            }
+            Benchmarks::DoNotOptimize(found);
+        };
+        // The linear scans are slow enough at 1M objects to be measured once
+        Benchmarks::Run(name, 1, linearRadius, 0);
+        std::snprintf(name, sizeof(name), "%zu radius queries, BVH", QUERIES);
+        Benchmarks::Run(name, iterations, [&] {
+            found = 0;
+            for (const auto& point : points) {
+                tree.QuerySphere(point, QUERY_RADIUS, [&](Core::Spatial::ProxyId) { ++found; });
+            }
+            Benchmarks::DoNotOptimize(found);
+        });
+        std::printf("  -> %.1f candidates per query\n", static_cast<double>(found) / QUERIES);
+
+        std::snprintf(name, sizeof(name), "%zu raycasts (closest hit), BVH", QUERIES);
+        size_t hits = 0;
+        Benchmarks::Run(name, iterations, [&] {
+            hits = 0;
+            for (size_t i = 0; i < QUERIES; ++i) {
+                const Core::Spatial::Ray ray{.origin = points[i], .direction = directions[i]};
+                const glm::vec3 inverseDirection = 1.0f / ray.direction;
+                float closest = -1.0f;
+                tree.Raycast(ray, [&](const Core::Spatial::ProxyId proxy, const Core::Spatial::Ray& clipped) {
+                    const float distance = Core::Spatial::Detail::IntersectRay(
+                        tree.GetBox(proxy), clipped.origin, inverseDirection, clipped.maxDistance);
+                    if (distance >= 0.0f) { closest = distance; }
+                    return distance;
+                });
+                hits += closest >= 0.0f ? 1 : 0;
+            }
+            Benchmarks::DoNotOptimize(hits);
+        });
+        std::printf("  -> %zu hits\n", hits);
+
+        std::snprintf(name, sizeof(name), "%zu nearest queries, linear scan", QUERIES);
+        size_t checksum = 0;
+        const auto linearNearest = [&] {
+            checksum = 0;
+            for (const auto& point : points) {
+                float best = std::numeric_limits<float>::max();
+                size_t nearest = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    if (const float distance = DistanceSquared(scene.boxes[i], point); distance < best) {
+                        best = distance;
+                        nearest = i;
+                    }
+                }
+                checksum += nearest;
+            }
+            Benchmarks::DoNotOptimize(checksum);
+        };
+        Benchmarks::Run(name, 1, linearNearest, 0);
+        std::snprintf(name, sizeof(name), "%zu nearest queries, BVH", QUERIES);
+        Benchmarks::Run(name, iterations, [&] {
+            for (const auto& point : points) { Benchmarks::DoNotOptimize(tree.FindNearest(point)); }
+        });
+        std::printf("\n");
+    }
+}
+
+int main() {
+    for (const size_t count : {10'000, 100'000, 1'000'000}) { RunSize(count); }
+    return 0;
+}
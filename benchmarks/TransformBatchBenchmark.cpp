@@ -0,0 +1,86 @@
+/**
+ * Model and normal matrix computation for 100k transforms:
+ * per-object GetMat4/GetNormalMatrix against the structure-of-arrays batch, for each SIMD level.
+ */
+
+#include "Core/Components/TransformComponent3d.h"
+#include "Core/Math/TransformBatch.h"
+#include "Plateform/CpuFeatures.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "glm/ext/matrix_float3x3.hpp"
+#include "glm/ext/matrix_float4x4.hpp"
+
+namespace
+{
+    using namespace Liara;
+
+    constexpr size_t OBJECTS = 100'000;
+    constexpr size_t ITERATIONS = 100;
+
+    float MaxError(const std::vector<glm::mat4>& expected, const std::vector<glm::mat4>& actual) {
+        float error = 0.0f;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            for (int column = 0; column < 4; ++column) {
+                for (int row = 0; row < 4; ++row) {
+                    error = std::max(error, std::abs(expected[i][column][row] - actual[i][column][row]));
+                }
+            }
+        }
+        return error;
+    }
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution position(-100.0f, 100.0f);
+    std::uniform_real_distribution angle(-6.28f, 6.28f);
+    std::uniform_real_distribution scale(0.1f, 4.0f);
+
+    std::vector<Core::Component::TransformComponent3d> transforms(OBJECTS);
+    Core::Math::TransformSoA batch;
+    batch.Reserve(OBJECTS);
+    for (auto& transform : transforms) {
+        transform.position = {position(rng), position(rng), position(rng)};
+        transform.rotation = {angle(rng), angle(rng), angle(rng)};
+        transform.scale = {scale(rng), scale(rng), scale(rng)};
+        batch.PushBack(transform);
+    }
+
+    std::vector<glm::mat4> reference(OBJECTS);
+    std::vector<glm::mat4> models(OBJECTS);
+    std::vector<glm::mat3> normals(OBJECTS);
+
+    std::printf("%zu transforms, CPU SIMD level: %s\n\n",
+                OBJECTS,
+                Plateform::SimdLevelToString(Plateform::GetSimdLevel()).data());
+
+    Benchmarks::Run("Per object GetMat4/GetNormalMatrix", ITERATIONS, [&] {
+        for (size_t i = 0; i < OBJECTS; ++i) {
+            reference[i] = transforms[i].GetMat4();
+            normals[i] = transforms[i].GetNormalMatrix();
+        }
+        Benchmarks::DoNotOptimize(normals.back());
+    });
+
+    for (const auto level : {Plateform::SimdLevel::SCALAR, Plateform::SimdLevel::SSE2, Plateform::SimdLevel::AVX2}) {
+        if (level > Plateform::GetSimdLevel()) { continue; }
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "Batch %s", Plateform::SimdLevelToString(level).data());
+        Benchmarks::Run(name, ITERATIONS, [&] {
+            Core::Math::ComputeTransformMatrices(batch, models, normals, level);
+            Benchmarks::DoNotOptimize(models.back());
+        });
+        std::printf("  -> max error against GetMat4: %g\n", MaxError(reference, models));
+    }
+
+    return 0;
+}
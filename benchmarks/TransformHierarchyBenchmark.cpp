@@ -0,0 +1,124 @@
+/**
+ * Per-frame transform cost of a scene with 100k static nodes and 1k moving nodes:
+ * recomputing every matrix from Euler angles (the previous render path) against the cached hierarchy.
+ */
+
+#include "Core/Components/TransformComponent3d.h"
+#include "Core/Components/WorldTransformComponent.h"
+#include "Core/ECS/Liara_Registry.h"
+#include "Core/ECS/Liara_TransformHierarchy.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float4.hpp"
+
+namespace
+{
+    using namespace Liara;
+
+    constexpr size_t STATIC_NODES = 100'000;
+    constexpr size_t MOVING_NODES = 1'000;
+    constexpr size_t CHILDREN_PER_GROUP = 9;  // Static nodes are grouped under static roots
+    constexpr size_t ITERATIONS = 200;
+
+    struct Scene
+    {
+        Core::ECS::Liara_Registry registry;
+        Core::ECS::Liara_TransformHierarchy hierarchy{registry};
+        std::vector<Core::ECS::Entity> movingNodes;
+    };
+
+    Core::ECS::Entity CreateNode(Scene& scene, std::mt19937& rng) {
+        std::uniform_real_distribution position(-100.0f, 100.0f);
+        std::uniform_real_distribution angle(0.0f, 6.28f);
+
+        const auto entity = scene.registry.Create();
+        auto& transform = scene.registry.Emplace<Core::Component::TransformComponent3d>(entity);
+        transform.position = {position(rng), position(rng), position(rng)};
+        transform.rotation = {angle(rng), angle(rng), angle(rng)};
+        return entity;
+    }
+
+    /**
+     * Builds the static groups, then the moving nodes either as leaves of static roots
+     * or as roots of their own subtree (movingRoots), so the subtree follows them.
+     */
+    void BuildScene(Scene& scene, const bool movingRoots) {
+        std::mt19937 rng(42);
+        std::vector<Core::ECS::Entity> staticRoots;
+
+        for (size_t i = 0; i < STATIC_NODES; i += CHILDREN_PER_GROUP + 1) {
+            const auto root = CreateNode(scene, rng);
+            staticRoots.push_back(root);
+            for (size_t child = 0; child < CHILDREN_PER_GROUP; ++child) {
+                scene.hierarchy.SetParent(CreateNode(scene, rng), root);
+            }
+        }
+
+        for (size_t i = 0; i < MOVING_NODES; ++i) {
+            const auto node = CreateNode(scene, rng);
+            if (movingRoots) { scene.hierarchy.SetParent(staticRoots[i], node); }
+            else { scene.hierarchy.SetParent(node, staticRoots[i]); }
+            scene.movingNodes.push_back(node);
+        }
+
+        scene.hierarchy.Update();
+    }
+
+    void MoveNodes(Scene& scene) {
+        for (const auto entity : scene.movingNodes) {
+            scene.registry.Get<Core::Component::TransformComponent3d>(entity).rotation.y += 0.01f;
+            scene.hierarchy.MarkDirty(entity);
+        }
+    }
+}
+
+int main() {
+    std::printf("%zu static nodes, %zu moving nodes\n\n", STATIC_NODES, MOVING_NODES);
+
+    {
+        Scene scene;
+        BuildScene(scene, false);
+
+        Benchmarks::Run("Recompute every matrix (GetMat4/GetNormalMatrix)", ITERATIONS, [&] {
+            MoveNodes(scene);
+            glm::vec4 sum{0.0f};
+            scene.registry.View<const Core::Component::TransformComponent3d>().Each(
+                [&](Core::ECS::Entity, const Core::Component::TransformComponent3d& transform) {
+                    sum += transform.GetMat4()[3];
+                    sum += glm::vec4(transform.GetNormalMatrix()[0], 0.0f);
+                });
+            Benchmarks::DoNotOptimize(sum);
+        });
+
+        Benchmarks::Run("Cached hierarchy, moving leaves", ITERATIONS, [&] {
+            MoveNodes(scene);
+            scene.hierarchy.Update();
+            Benchmarks::DoNotOptimize(scene.hierarchy.GetLastUpdateCount());
+        });
+
+        Benchmarks::Run("Cached hierarchy, nothing moves", ITERATIONS, [&] {
+            scene.hierarchy.Update();
+            Benchmarks::DoNotOptimize(scene.hierarchy.GetLastUpdateCount());
+        });
+    }
+
+    {
+        Scene scene;
+        BuildScene(scene, true);
+
+        Benchmarks::Run("Cached hierarchy, moving subtree roots", ITERATIONS, [&] {
+            MoveNodes(scene);
+            scene.hierarchy.Update();
+            Benchmarks::DoNotOptimize(scene.hierarchy.GetLastUpdateCount());
+        });
+        std::printf("  -> %zu world matrices recomputed per frame\n", scene.hierarchy.GetLastUpdateCount());
+    }
+
+    return 0;
+}
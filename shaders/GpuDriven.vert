@@ -0,0 +1,58 @@
+#version 450
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 color;
+layout(location = 2) in vec3 normal;
+layout(location = 3) in vec2 uv;
+layout(location = 4) in uint specularExponent; // TODO : Use a material property instead of this
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec3 fragPosWorld;
+layout(location = 2) out vec3 fragNormalWorld;
+layout(location = 3) out vec2 fragTexCoords;
+layout(location = 4) out uint fragSpecularExponent; // TODO : Use a material property instead of this
+
+layout(constant_id = 0) const uint MAX_LIGHTS = 10;
+
+struct PointLight
+{
+    vec4 position; // ignore w
+    vec4 color; // w is intensity
+};
+
+layout(set = 0, binding = 0) uniform GlobalUbo
+{
+    mat4 projection;
+    mat4 view;
+    mat4 inverseView;
+    vec4 directionalLightDirection; // xyz is direction, w is intensity
+    vec4 directionalLightColor; // w is ambient intensity
+    PointLight pointLights[MAX_LIGHTS];
+    int numLights;
+} ubo;
+
+struct Object
+{
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 boundingSphere;
+    uint drawSlot;
+    uint visibilityIndex;
+};
+
+// Filled by CullObjects.comp, the instance index includes the firstInstance of the draw slot
+layout(set = 1, binding = 0) readonly buffer Objects { Object objects[]; };
+layout(set = 1, binding = 2) readonly buffer VisibleObjects { uint visibleObjects[]; };
+
+void main()
+{
+    Object object = objects[visibleObjects[gl_InstanceIndex]];
+    vec4 positionWorld = object.modelMatrix * vec4(position, 1.0);
+    gl_Position = ubo.projection * ubo.view * positionWorld;
+
+    fragNormalWorld = normalize(mat3(object.normalMatrix) * normal);
+    fragPosWorld = positionWorld.xyz;
+    fragColor = color;
+    fragTexCoords = uv;
+    fragSpecularExponent = specularExponent;
+}
@@ -29,12 +29,6 @@ layout(set = 0, binding = 0) uniform GlobalUbo
 
 layout(set = 0, binding = 1) uniform sampler2D texSampler; // uniform implique que la valeur ne change pas entre les vertex, mais uniquement entre les objets
 
-layout(push_constant) uniform PushConstant
-{
-    mat4 modelMatrix;
-    mat4 normalMatrix;
-} pushConstant;
-
 void main()
 {
     vec3 ambientLight = ubo.directionalLightColor.xyz * ubo.directionalLightColor.w;
@@ -6,6 +6,9 @@ layout(location = 2) in vec3 normal;
 layout(location = 3) in vec2 uv;
 layout(location = 4) in uint specularExponent; // TODO : Use a material property instead of this
 
+// Per instance, from the instance buffer of the render queue
+layout(location = 5) in uint objectIndex;
+
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec3 fragPosWorld;
 layout(location = 2) out vec3 fragNormalWorld;
@@ -31,18 +34,26 @@ layout(set = 0, binding = 0) uniform GlobalUbo
     int numLights;
 } ubo;
 
-layout(push_constant) uniform PushConstant
+struct ObjectData
 {
     mat4 modelMatrix;
-    mat4 normalMatrix;
-} pushConstant;
+    vec4 normalMatrix[3]; // columns of the mat3, w unused
+    uint materialIndex;
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer ObjectBuffer
+{
+    ObjectData objects[];
+};
 
 void main()
 {
-    vec4 positionWorld = pushConstant.modelMatrix * vec4(position, 1.0);
+    ObjectData object = objects[objectIndex];
+    vec4 positionWorld = object.modelMatrix * vec4(position, 1.0);
     gl_Position = ubo.projection * ubo.view * positionWorld;
 
-    fragNormalWorld = normalize(mat3(pushConstant.normalMatrix) * normal);
+    mat3 normalMatrix = mat3(object.normalMatrix[0].xyz, object.normalMatrix[1].xyz, object.normalMatrix[2].xyz);
+    fragNormalWorld = normalize(normalMatrix * normal);
     fragPosWorld = positionWorld.xyz;
     fragColor = color;
     fragTexCoords = uv;
@@ -5,6 +5,7 @@
 #include <string_view>
 
 #include "ApplicationInfo.h"
+#include "Liara_SettingsManager.h"
 #include "Logging/Logger.h"
 #include "Logging/LogMacros.h"
 
@@ -30,8 +31,10 @@ namespace Liara::Core
 {
     /**
      * @brief Template to run a Liara application with error handling
+     * @param argc, argv Command line, "--setting=value" arguments override the settings (see Liara_SettingsManager)
      */
-    template <typename AppClass> int RunApplication(const ApplicationInfo& appInfo) {
+    template <typename AppClass>
+    int RunApplication(const ApplicationInfo& appInfo, const int argc = 0, const char* const* argv = nullptr) {
         auto& logger = Liara::Logging::Logger::GetInstance();
 
 #ifndef NDEBUG
@@ -68,6 +71,8 @@ namespace Liara::Core
 
         bool result = EXIT_FAILURE;
 
+        Liara_SettingsManager::SetCommandLineArguments(argc, argv);
+
         try {
             AppClass app(appInfo);
             app.Run();
@@ -120,22 +125,22 @@ namespace Liara::Core
  * LIARA_APPLICATION(MyApp, "MyApp", 1, 0, 0, "My awesome application");
  */
 #define LIARA_APPLICATION(AppClass, name, major, minor, patch, ...)                                           \
-    int main(int, char*[]) {                                                                                  \
+    int main(int argc, char* argv[]) {                                                                        \
         constexpr auto app_info = Liara::Core::CreateApplicationInfo(name, major, minor, patch, __VA_ARGS__); \
         static_assert(Liara::Core::IsValidAppInfo(app_info),                                                  \
                       "Invalid application info provided to LIARA_APPLICATION");                              \
-        return Liara::Core::RunApplication<AppClass>(app_info);                                               \
+        return Liara::Core::RunApplication<AppClass>(app_info, argc, argv);                                   \
     }
 
 /**
  * @brief Extended macro with more control over application info
  */
 #define LIARA_APPLICATION_EX(AppClass, app_info_expr)                               \
-    int main(int, char*[]) {                                                        \
+    int main(int argc, char* argv[]) {                                              \
         constexpr auto app_info = app_info_expr;                                    \
         static_assert(Liara::Core::IsValidAppInfo(app_info),                        \
                       "Invalid application info provided to LIARA_APPLICATION_EX"); \
-        return Liara::Core::RunApplication<AppClass>(app_info);                     \
+        return Liara::Core::RunApplication<AppClass>(app_info, argc, argv);         \
     }
 
 /**
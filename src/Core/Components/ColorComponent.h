@@ -0,0 +1,11 @@
+#pragma once
+
+#include "glm/ext/vector_float3.hpp"
+
+namespace Liara::Core::Component
+{
+    struct ColorComponent
+    {
+        glm::vec3 color{1.0F};
+    };
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Core/ECS/Entity.h"
+
+namespace Liara::Core::Component
+{
+    /**
+     * @brief Links of an entity in the transform hierarchy, children form an intrusive doubly linked list.
+     * Managed by `ECS::Liara_TransformHierarchy`, don't edit it directly.
+     */
+    struct HierarchyComponent
+    {
+        ECS::Entity parent = ECS::NULL_ENTITY;
+        ECS::Entity firstChild = ECS::NULL_ENTITY;
+        ECS::Entity previousSibling = ECS::NULL_ENTITY;
+        ECS::Entity nextSibling = ECS::NULL_ENTITY;
+    };
+}
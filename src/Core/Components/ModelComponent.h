@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace Liara::Graphics
+{
+    class Liara_Model;
+}
+
+namespace Liara::Core::Component
+{
+    struct ModelComponent
+    {
+        std::shared_ptr<Graphics::Liara_Model> model;
+        uint32_t lodLevel = 0;  ///< Level of detail to draw, chosen each frame from the projected size of the model
+    };
+}
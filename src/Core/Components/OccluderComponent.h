@@ -0,0 +1,20 @@
+#pragma once
+
+#include <memory>
+
+namespace Liara::Core::Culling
+{
+    struct OccluderMesh;
+}
+
+namespace Liara::Core::Component
+{
+    /**
+     * @brief Marks an entity as hiding what is behind it, for the CPU occlusion culling.
+     * The mesh is rasterized with the world matrix of the entity, it does not need a `ModelComponent`.
+     */
+    struct OccluderComponent
+    {
+        std::shared_ptr<const Culling::OccluderMesh> mesh;
+    };
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#include "glm/ext/matrix_float3x3.hpp"
+#include "glm/ext/matrix_float4x4.hpp"
+
+namespace Liara::Core::Component
+{
+    /**
+     * @brief Cached matrices of an entity with a `TransformComponent3d`.
+     * Computed by `ECS::Liara_TransformHierarchy` only when the entity or one of its ancestors moved.
+     *
+     * world and normal hold the state of the last simulation step, previousWorld and previousNormal the state
+     * of the step before. Renderers use the interpolated matrices, blended between both by the hierarchy.
+     */
+    struct WorldTransformComponent
+    {
+        glm::mat4 local{1.0F};   ///< Matrix of the TransformComponent3d, relative to the parent
+        glm::mat4 world{1.0F};   ///< Local matrix combined with the world matrix of the parent
+        glm::mat3 normal{1.0F};  ///< Inverse transpose of the world matrix upper 3x3
+
+        glm::mat4 previousWorld{1.0F};       ///< World matrix at the previous simulation step
+        glm::mat3 previousNormal{1.0F};      ///< Normal matrix at the previous simulation step
+        glm::mat4 interpolatedWorld{1.0F};   ///< World matrix to render, between previousWorld and world
+        glm::mat3 interpolatedNormal{1.0F};  ///< Normal matrix to render, between previousNormal and normal
+
+        uint32_t movedStep = 0;    ///< Last simulation step in which the matrices changed
+        bool initialized = false;  ///< Whether the matrices were computed at least once
+        bool dirty = true;         ///< Whether the local matrix must be recomputed
+    };
+}
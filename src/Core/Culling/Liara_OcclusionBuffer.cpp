@@ -0,0 +1,343 @@
+#include "Liara_OcclusionBuffer.h"
+
+#include "Core/Logging/LogMacros.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "glm/common.hpp"
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float3.hpp"
+#include "glm/ext/vector_float4.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LIARA_OCCLUSION_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+namespace Liara::Core::Culling
+{
+    namespace
+    {
+        /// Below this many vertices, transforming an occluder on the calling thread is cheaper than scheduling jobs
+        constexpr size_t PARALLEL_VERTEX_THRESHOLD = 4096;
+        constexpr size_t VERTEX_BATCH_SIZE = 1024;
+
+        /// Triangles with a smaller screen area (in pixels) cover no pixel center worth testing
+        constexpr float MIN_TRIANGLE_AREA = 1e-6f;
+
+        uint32_t RoundUpToTile(const uint32_t size) {
+            const uint32_t tile = Liara_OcclusionBuffer::TILE_SIZE;
+            return std::max((size + tile - 1) / tile, 1u) * tile;
+        }
+
+        /**
+         * @brief Edge function E(x, y) = a * x + b * y + c, positive on the inner side of the edge from p to q.
+         */
+        struct Edge
+        {
+            float a, b, c;
+
+            Edge(const float px, const float py, const float qx, const float qy)
+                : a(py - qy)
+                , b(qx - px)
+                , c(-(a * px) - (b * py)) {}
+        };
+    }
+
+    Liara_OcclusionBuffer::Liara_OcclusionBuffer(const uint32_t width, const uint32_t height)
+        : m_Width(RoundUpToTile(width))
+        , m_Height(RoundUpToTile(height))
+        , m_TilesX(m_Width / TILE_SIZE)
+        , m_TilesY(m_Height / TILE_SIZE)
+        , m_Depth(static_cast<size_t>(m_Width) * m_Height, 1.0f)
+        , m_TileMax(static_cast<size_t>(m_TilesX) * m_TilesY, 1.0f)
+        , m_Bins(m_TilesY) {}
+
+    void Liara_OcclusionBuffer::Begin(const glm::mat4& viewProjection) {
+        m_ViewProjection = viewProjection;
+        std::ranges::fill(m_Depth, 1.0f);
+        std::ranges::fill(m_TileMax, 1.0f);
+        m_Triangles.clear();
+        for (auto& bin : m_Bins) { bin.clear(); }
+    }
+
+    void Liara_OcclusionBuffer::AddOccluder(const OccluderMesh& mesh,
+                                            const glm::mat4& model,
+                                            Jobs::Liara_JobSystem* jobSystem) {
+        const glm::mat4 modelViewProjection = m_ViewProjection * model;
+        const size_t vertexCount = mesh.positions.size();
+        m_ClipPositions.resize(vertexCount);
+
+        const auto transform = [&](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                m_ClipPositions[i] = modelViewProjection * glm::vec4(mesh.positions[i], 1.0f);
+            }
+        };
+        if (jobSystem != nullptr && vertexCount >= PARALLEL_VERTEX_THRESHOLD) {
+            jobSystem->ParallelFor(vertexCount, VERTEX_BATCH_SIZE, transform);
+        }
+        else { transform(0, vertexCount); }
+
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const uint32_t a = mesh.indices[i];
+            const uint32_t b = mesh.indices[i + 1];
+            const uint32_t c = mesh.indices[i + 2];
+            if (a >= vertexCount || b >= vertexCount || c >= vertexCount) {
+                LIARA_LOG_VERBOSE(LogCore, "Skipping occluder triangle {} with an out of range index", i / 3);
+                continue;
+            }
+            AddClippedTriangle(m_ClipPositions[a], m_ClipPositions[b], m_ClipPositions[c]);
+        }
+    }
+
+    void Liara_OcclusionBuffer::AddClippedTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+        // The near plane of a [0, 1] depth range is z = 0 in clip space
+        const std::array<glm::vec4, 3> input{a, b, c};
+        const int insideCount = (a.z >= 0.0f ? 1 : 0) + (b.z >= 0.0f ? 1 : 0) + (c.z >= 0.0f ? 1 : 0);
+        if (insideCount == 3) {
+            AddScreenTriangle(a, b, c);
+            return;
+        }
+        if (insideCount == 0) { return; }
+
+        // Sutherland-Hodgman against the near plane, a triangle gives a triangle or a quad
+        std::array<glm::vec4, 4> polygon{};
+        size_t polygonSize = 0;
+        for (size_t i = 0; i < 3; ++i) {
+            const glm::vec4& current = input[i];
+            const glm::vec4& next = input[(i + 1) % 3];
+            if (current.z >= 0.0f) { polygon[polygonSize++] = current; }
+            if ((current.z >= 0.0f) != (next.z >= 0.0f)) {
+                const float t = current.z / (current.z - next.z);
+                polygon[polygonSize++] = current + ((next - current) * t);
+            }
+        }
+
+        for (size_t i = 2; i < polygonSize; ++i) { AddScreenTriangle(polygon[0], polygon[i - 1], polygon[i]); }
+    }
+
+    void Liara_OcclusionBuffer::AddScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+        if (a.w <= 0.0f || b.w <= 0.0f || c.w <= 0.0f) { return; }
+
+        const auto width = static_cast<float>(m_Width);
+        const auto height = static_cast<float>(m_Height);
+
+        ScreenTriangle triangle{};
+        float depth[3];
+        const std::array<const glm::vec4*, 3> vertices{&a, &b, &c};
+        for (size_t i = 0; i < 3; ++i) {
+            const glm::vec4& vertex = *vertices[i];
+            triangle.x[i] = ((vertex.x / vertex.w) * 0.5f + 0.5f) * width;
+            triangle.y[i] = ((vertex.y / vertex.w) * 0.5f + 0.5f) * height;
+            depth[i] = vertex.z / vertex.w;
+        }
+
+        const float dx1 = triangle.x[1] - triangle.x[0];
+        const float dy1 = triangle.y[1] - triangle.y[0];
+        const float dx2 = triangle.x[2] - triangle.x[0];
+        const float dy2 = triangle.y[2] - triangle.y[0];
+        float area = (dx1 * dy2) - (dx2 * dy1);
+        if (std::abs(area) < MIN_TRIANGLE_AREA || !std::isfinite(area)) { return; }
+
+        // Occluders block the view from both sides, back faces are kept and turned to the same winding
+        float dz1 = depth[1] - depth[0];
+        float dz2 = depth[2] - depth[0];
+        if (area < 0.0f) {
+            std::swap(triangle.x[1], triangle.x[2]);
+            std::swap(triangle.y[1], triangle.y[2]);
+            std::swap(dz1, dz2);
+            area = -area;
+        }
+        const float ex1 = triangle.x[1] - triangle.x[0];
+        const float ey1 = triangle.y[1] - triangle.y[0];
+        const float ex2 = triangle.x[2] - triangle.x[0];
+        const float ey2 = triangle.y[2] - triangle.y[0];
+        triangle.depthA = ((dz1 * ey2) - (dz2 * ey1)) / area;
+        triangle.depthB = ((ex1 * dz2) - (ex2 * dz1)) / area;
+        triangle.depthC = depth[0] - (triangle.depthA * triangle.x[0]) - (triangle.depthB * triangle.y[0]);
+
+        const float minX = std::min({triangle.x[0], triangle.x[1], triangle.x[2]});
+        const float maxX = std::max({triangle.x[0], triangle.x[1], triangle.x[2]});
+        const float minY = std::min({triangle.y[0], triangle.y[1], triangle.y[2]});
+        const float maxY = std::max({triangle.y[0], triangle.y[1], triangle.y[2]});
+
+        // Rows and columns whose pixel centers (i + 0.5) may be covered
+        const float firstRow = std::max(std::ceil(minY - 0.5f), 0.0f);
+        const float lastRow = std::min(std::floor(maxY - 0.5f), height - 1.0f);
+        const float firstColumn = std::max(std::ceil(minX - 0.5f), 0.0f);
+        const float lastColumn = std::min(std::floor(maxX - 0.5f), width - 1.0f);
+        if (firstRow > lastRow || firstColumn > lastColumn) { return; }
+
+        triangle.firstRow = static_cast<uint32_t>(firstRow);
+        triangle.lastRow = static_cast<uint32_t>(lastRow);
+
+        const auto index = static_cast<uint32_t>(m_Triangles.size());
+        m_Triangles.push_back(triangle);
+        for (uint32_t band = triangle.firstRow / TILE_SIZE; band <= triangle.lastRow / TILE_SIZE; ++band) {
+            m_Bins[band].push_back(index);
+        }
+    }
+
+    void Liara_OcclusionBuffer::Rasterize(Jobs::Liara_JobSystem* jobSystem) {
+        if (jobSystem == nullptr) {
+            for (uint32_t band = 0; band < m_TilesY; ++band) { RasterizeBand(band); }
+            return;
+        }
+
+        // Bands do not share pixels, each one is written by a single job
+        jobSystem->ParallelFor(m_TilesY, 1, [this](const size_t begin, const size_t end) {
+            for (size_t band = begin; band < end; ++band) { RasterizeBand(static_cast<uint32_t>(band)); }
+        });
+    }
+
+    void Liara_OcclusionBuffer::RasterizeBand(const uint32_t band) {
+        const uint32_t bandFirstRow = band * TILE_SIZE;
+        const uint32_t bandLastRow = bandFirstRow + TILE_SIZE - 1;
+        for (const uint32_t index : m_Bins[band]) {
+            const ScreenTriangle& triangle = m_Triangles[index];
+            const uint32_t firstRow = std::max(triangle.firstRow, bandFirstRow);
+            const uint32_t lastRow = std::min(triangle.lastRow, bandLastRow);
+            if (firstRow <= lastRow) { RasterizeTriangle(triangle, firstRow, lastRow); }
+        }
+        UpdateTileDepth(band);
+    }
+
+    void Liara_OcclusionBuffer::RasterizeTriangle(const ScreenTriangle& triangle,
+                                                  const uint32_t firstRow,
+                                                  const uint32_t lastRow) {
+        const Edge edges[3] = {
+            {triangle.x[0], triangle.y[0], triangle.x[1], triangle.y[1]},
+            {triangle.x[1], triangle.y[1], triangle.x[2], triangle.y[2]},
+            {triangle.x[2], triangle.y[2], triangle.x[0], triangle.y[0]},
+        };
+
+        const float minX = std::min({triangle.x[0], triangle.x[1], triangle.x[2]});
+        const float maxX = std::max({triangle.x[0], triangle.x[1], triangle.x[2]});
+        const auto firstColumn = static_cast<uint32_t>(std::max(std::ceil(minX - 0.5f), 0.0f));
+        const auto lastColumn =
+            static_cast<uint32_t>(std::min(std::floor(maxX - 0.5f), static_cast<float>(m_Width) - 1.0f));
+
+#if defined(LIARA_OCCLUSION_SSE2)
+        // The width is a multiple of 4, groups aligned on 4 pixels never leave the row
+        const uint32_t firstGroup = firstColumn & ~3u;
+        const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 edgeA[3] = {_mm_set1_ps(edges[0].a), _mm_set1_ps(edges[1].a), _mm_set1_ps(edges[2].a)};
+        const __m128 depthA = _mm_set1_ps(triangle.depthA);
+
+        for (uint32_t row = firstRow; row <= lastRow; ++row) {
+            const float centerY = static_cast<float>(row) + 0.5f;
+            const __m128 edgeRow[3] = {_mm_set1_ps((edges[0].b * centerY) + edges[0].c),
+                                       _mm_set1_ps((edges[1].b * centerY) + edges[1].c),
+                                       _mm_set1_ps((edges[2].b * centerY) + edges[2].c)};
+            const __m128 depthRow = _mm_set1_ps((triangle.depthB * centerY) + triangle.depthC);
+            float* const depthLine = m_Depth.data() + (static_cast<size_t>(row) * m_Width);
+
+            for (uint32_t column = firstGroup; column <= lastColumn; column += 4) {
+                const __m128 centerX = _mm_add_ps(_mm_set1_ps(static_cast<float>(column)), laneOffsets);
+                __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[0], centerX), edgeRow[0]), zero);
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[1], centerX), edgeRow[1]), zero));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[2], centerX), edgeRow[2]), zero));
+                if (_mm_movemask_ps(inside) == 0) { continue; }
+
+                const __m128 depth =
+                    _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(depthA, centerX), depthRow), zero), one);
+                const __m128 current = _mm_loadu_ps(depthLine + column);
+                const __m128 nearest = _mm_min_ps(current, depth);
+                _mm_storeu_ps(depthLine + column,
+                              _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+            }
+        }
+#else
+        for (uint32_t row = firstRow; row <= lastRow; ++row) {
+            const float centerY = static_cast<float>(row) + 0.5f;
+            float* const depthLine = m_Depth.data() + (static_cast<size_t>(row) * m_Width);
+            for (uint32_t column = firstColumn; column <= lastColumn; ++column) {
+                const float centerX = static_cast<float>(column) + 0.5f;
+                bool inside = true;
+                for (const Edge& edge : edges) {
+                    inside = inside && (edge.a * centerX) + (edge.b * centerY) + edge.c >= 0.0f;
+                }
+                if (!inside) { continue; }
+
+                const float depth = std::clamp(
+                    (triangle.depthA * centerX) + (triangle.depthB * centerY) + triangle.depthC, 0.0f, 1.0f);
+                depthLine[column] = std::min(depthLine[column], depth);
+            }
+        }
+#endif
+    }
+
+    void Liara_OcclusionBuffer::UpdateTileDepth(const uint32_t band) {
+        for (uint32_t tileX = 0; tileX < m_TilesX; ++tileX) {
+            float farthest = 0.0f;
+            for (uint32_t y = 0; y < TILE_SIZE; ++y) {
+                const float* const pixels =
+                    m_Depth.data() + (static_cast<size_t>((band * TILE_SIZE) + y) * m_Width) + (tileX * TILE_SIZE);
+                farthest = std::max(farthest, *std::max_element(pixels, pixels + TILE_SIZE));
+            }
+            m_TileMax[(static_cast<size_t>(band) * m_TilesX) + tileX] = farthest;
+        }
+    }
+
+    bool Liara_OcclusionBuffer::IsBoxVisible(const Math::AABB& box, const glm::mat4& model) const {
+        const glm::mat4 modelViewProjection = m_ViewProjection * model;
+
+        glm::vec3 screenMin{std::numeric_limits<float>::max()};
+        glm::vec3 screenMax{std::numeric_limits<float>::lowest()};
+        for (uint32_t corner = 0; corner < 8; ++corner) {
+            const glm::vec4 position{(corner & 1u) != 0 ? box.max.x : box.min.x,
+                                     (corner & 2u) != 0 ? box.max.y : box.min.y,
+                                     (corner & 4u) != 0 ? box.max.z : box.min.z,
+                                     1.0f};
+            const glm::vec4 clip = modelViewProjection * position;
+            // A box crossing the near plane covers the whole view, or part of it behind the camera
+            if (clip.z < 0.0f || clip.w <= 0.0f) { return true; }
+
+            const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            screenMin = glm::min(screenMin, ndc);
+            screenMax = glm::max(screenMax, ndc);
+        }
+
+        const auto width = static_cast<float>(m_Width);
+        const auto height = static_cast<float>(m_Height);
+        const float left = (screenMin.x * 0.5f + 0.5f) * width;
+        const float right = (screenMax.x * 0.5f + 0.5f) * width;
+        const float top = (screenMin.y * 0.5f + 0.5f) * height;
+        const float bottom = (screenMax.y * 0.5f + 0.5f) * height;
+        // Out of the view, frustum culling decides
+        if (right < 0.0f || left >= width || bottom < 0.0f || top >= height) { return true; }
+
+        const auto firstColumn = static_cast<uint32_t>(std::max(left, 0.0f));
+        const auto lastColumn = static_cast<uint32_t>(std::min(right, width - 1.0f));
+        const auto firstRow = static_cast<uint32_t>(std::max(top, 0.0f));
+        const auto lastRow = static_cast<uint32_t>(std::min(bottom, height - 1.0f));
+        const float nearestDepth = screenMin.z;
+
+        for (uint32_t tileY = firstRow / TILE_SIZE; tileY <= lastRow / TILE_SIZE; ++tileY) {
+            for (uint32_t tileX = firstColumn / TILE_SIZE; tileX <= lastColumn / TILE_SIZE; ++tileX) {
+                // Every pixel of the tile holds an occluder in front of the box
+                if (m_TileMax[(static_cast<size_t>(tileY) * m_TilesX) + tileX] < nearestDepth) { continue; }
+
+                const uint32_t rowEnd = std::min(lastRow, (tileY * TILE_SIZE) + TILE_SIZE - 1);
+                const uint32_t columnBegin = std::max(firstColumn, tileX * TILE_SIZE);
+                const uint32_t columnEnd = std::min(lastColumn, (tileX * TILE_SIZE) + TILE_SIZE - 1);
+                for (uint32_t row = std::max(firstRow, tileY * TILE_SIZE); row <= rowEnd; ++row) {
+                    const float* const depthLine = m_Depth.data() + (static_cast<size_t>(row) * m_Width);
+                    for (uint32_t column = columnBegin; column <= columnEnd; ++column) {
+                        if (depthLine[column] >= nearestDepth) { return true; }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+}
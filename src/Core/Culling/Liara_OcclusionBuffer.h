@@ -0,0 +1,124 @@
+/**
+ * @file Liara_OcclusionBuffer.h
+ * @brief Defines the `Liara_OcclusionBuffer` class, a low resolution CPU depth buffer to cull hidden objects.
+ *
+ * A few selected occluders (walls, floors, big props) are rasterized each frame into a small depth buffer,
+ * then the boxes of the objects that passed frustum culling are tested against it before their draws are recorded.
+ * The buffer is split into horizontal bands rasterized in parallel on the job system, 4 pixels per SSE2 instruction
+ * on x86, one at a time elsewhere. Each 8x8 tile keeps the farthest depth of its pixels, so most tests only read tiles.
+ *
+ * The test is conservative: an object is only reported hidden when every pixel its box covers holds an occluder
+ * nearer than the nearest point of the box. Objects crossing the near plane are always visible.
+ */
+
+#pragma once
+
+#include "Core/Jobs/Liara_JobSystem.h"
+#include "Core/Math/Bounds.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float3.hpp"
+#include "glm/ext/vector_float4.hpp"
+
+namespace Liara::Core::Culling
+{
+    /**
+     * @struct OccluderMesh
+     * @brief Triangles of an occluder, positions only. Usually a simplified version of the rendered mesh.
+     */
+    struct OccluderMesh
+    {
+        std::vector<glm::vec3> positions;
+        std::vector<uint32_t> indices;  ///< 3 per triangle
+
+        [[nodiscard]] size_t GetTriangleCount() const { return indices.size() / 3; }
+    };
+
+    /**
+     * @class Liara_OcclusionBuffer
+     * @brief Depth buffer in [0, 1], 0 at the near plane, holding the nearest occluder of each pixel.
+     *
+     * Usage per frame: Begin, AddOccluder for each occluder, Rasterize, then any number of IsBoxVisible.
+     * The tests may run on several threads at once, the other methods may not.
+     */
+    class Liara_OcclusionBuffer
+    {
+    public:
+        static constexpr uint32_t TILE_SIZE = 8;  ///< Width and height of a tile, in pixels
+        static constexpr uint32_t DEFAULT_WIDTH = 320;
+        static constexpr uint32_t DEFAULT_HEIGHT = 192;
+
+        /**
+         * @param width Width in pixels, rounded up to a multiple of TILE_SIZE.
+         * @param height Height in pixels, rounded up to a multiple of TILE_SIZE.
+         */
+        explicit Liara_OcclusionBuffer(uint32_t width = DEFAULT_WIDTH, uint32_t height = DEFAULT_HEIGHT);
+
+        /**
+         * @brief Clears the depth to the far plane and removes the occluders of the previous frame.
+         * @param viewProjection Projection * view matrix of the camera, for a [0, 1] depth range.
+         */
+        void Begin(const glm::mat4& viewProjection);
+
+        /**
+         * @brief Transforms the triangles of an occluder to screen space, clipping them against the near plane.
+         * @param jobSystem Optional job system to transform the vertices of large meshes on.
+         */
+        void AddOccluder(const OccluderMesh& mesh, const glm::mat4& model, Jobs::Liara_JobSystem* jobSystem = nullptr);
+
+        /**
+         * @brief Rasterizes the added occluders, one band of tiles per job.
+         * @param jobSystem Optional job system, the bands are rasterized on the calling thread without it.
+         */
+        void Rasterize(Jobs::Liara_JobSystem* jobSystem = nullptr);
+
+        /**
+         * @brief Tests a box against the rasterized occluders.
+         * @param box Box in model space.
+         * @param model Model matrix of the box.
+         * @return false if the box is entirely hidden behind the occluders.
+         */
+        [[nodiscard]] bool IsBoxVisible(const Math::AABB& box, const glm::mat4& model) const;
+
+        [[nodiscard]] uint32_t GetWidth() const { return m_Width; }
+        [[nodiscard]] uint32_t GetHeight() const { return m_Height; }
+        [[nodiscard]] size_t GetTriangleCount() const { return m_Triangles.size(); }  ///< After clipping
+        [[nodiscard]] std::span<const float> GetDepth() const { return m_Depth; }     ///< Row-major, top row first
+
+    private:
+        /**
+         * @brief Screen-space triangle, counter-clockwise on screen, with its depth as a plane z = a * x + b * y + c.
+         */
+        struct ScreenTriangle
+        {
+            float x[3];
+            float y[3];
+            float depthA, depthB, depthC;
+            uint32_t firstRow, lastRow;  ///< Rows whose pixel centers the triangle may cover, inclusive
+        };
+
+        void AddClippedTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+        void AddScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+
+        void RasterizeBand(uint32_t band);
+        void RasterizeTriangle(const ScreenTriangle& triangle, uint32_t firstRow, uint32_t lastRow);
+        void UpdateTileDepth(uint32_t band);
+
+        uint32_t m_Width;
+        uint32_t m_Height;
+        uint32_t m_TilesX;
+        uint32_t m_TilesY;
+
+        glm::mat4 m_ViewProjection{1.0f};
+        std::vector<float> m_Depth;    ///< Nearest occluder depth of each pixel
+        std::vector<float> m_TileMax;  ///< Farthest depth of each tile
+        std::vector<ScreenTriangle> m_Triangles;
+        std::vector<std::vector<uint32_t>> m_Bins;  ///< Triangles overlapping each band (row of tiles)
+        std::vector<glm::vec4> m_ClipPositions;     ///< Scratch of AddOccluder
+    };
+}
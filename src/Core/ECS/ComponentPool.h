@@ -0,0 +1,156 @@
+/**
+ * @file ComponentPool.h
+ * @brief Defines the `ComponentPool` class, a sparse set storing one component type.
+ *
+ * Components are stored contiguously in a dense array, in the same order as the dense array of entities.
+ * A sparse array indexed by entity slot gives the position of the component in the dense array,
+ * so insertion, removal and lookup are O(1) and iteration is linear in memory.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Entity.h"
+
+namespace Liara::Core::ECS
+{
+    namespace Detail
+    {
+        inline uint32_t NextComponentTypeId() {
+            // Systems running in parallel may request their first id concurrently
+            static std::atomic<uint32_t> counter = 0;
+            return counter.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Returns a unique, dense id for the component type T.
+     * Ids are attributed on first use, they are only stable during the lifetime of the process.
+     */
+    template <typename T> uint32_t ComponentTypeId() {
+        static const uint32_t id = Detail::NextComponentTypeId();
+        return id;
+    }
+
+    /**
+     * @class IComponentPool
+     * @brief Type-erased interface of a component pool, used by the registry to manage pools of any type.
+     */
+    class IComponentPool
+    {
+    public:
+        IComponentPool() = default;
+        virtual ~IComponentPool() = default;
+        IComponentPool(const IComponentPool&) = delete;
+        IComponentPool& operator=(const IComponentPool&) = delete;
+        IComponentPool(IComponentPool&&) = delete;
+        IComponentPool& operator=(IComponentPool&&) = delete;
+
+        /**
+         * @brief Whether the entity owns a component in this pool.
+         * The stored handle is compared too, so a stale handle whose slot was reused is rejected.
+         */
+        [[nodiscard]] bool Contains(const Entity entity) const {
+            return entity.index < m_Sparse.size() && m_Sparse[entity.index] != INVALID_INDEX
+                && m_Entities[m_Sparse[entity.index]] == entity;
+        }
+        [[nodiscard]] size_t Size() const { return m_Entities.size(); }
+        [[nodiscard]] bool Empty() const { return m_Entities.empty(); }
+        [[nodiscard]] std::span<const Entity> Entities() const { return m_Entities; }
+        /// Changes with every insertion and removal, tells whether the set of owners changed since an earlier call
+        [[nodiscard]] uint64_t GetVersion() const { return m_Version; }
+
+        virtual void Remove(Entity entity) = 0;
+        virtual void Clear() = 0;
+
+    protected:
+        static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+        std::vector<uint32_t> m_Sparse;  ///< Entity slot -> index in the dense arrays
+        std::vector<Entity> m_Entities;  ///< Dense array of the entities owning a component
+        uint64_t m_Version = 0;
+    };
+
+    /**
+     * @class ComponentPool
+     * @brief Sparse set storing the components of type T.
+     */
+    template <typename T> class ComponentPool final : public IComponentPool
+    {
+    public:
+        template <typename... Args> T& Emplace(const Entity entity, Args&&... args) {
+            assert(!Contains(entity) && "Entity already has this component");
+
+            if (entity.index >= m_Sparse.size()) {
+                m_Sparse.resize(static_cast<size_t>(entity.index) + 1, INVALID_INDEX);
+            }
+
+            m_Sparse[entity.index] = static_cast<uint32_t>(m_Entities.size());
+            m_Entities.push_back(entity);
+            ++m_Version;
+            if constexpr (std::is_aggregate_v<T>) { return m_Components.emplace_back(T{std::forward<Args>(args)...}); }
+            else { return m_Components.emplace_back(std::forward<Args>(args)...); }
+        }
+
+        /**
+         * @brief Removes the component of the entity, by swapping it with the last one of the dense array.
+         * Does nothing if the entity doesn't own the component.
+         */
+        void Remove(const Entity entity) override {
+            if (!Contains(entity)) { return; }
+
+            const uint32_t index = m_Sparse[entity.index];
+            if (const Entity last = m_Entities.back(); last != entity) {
+                m_Entities[index] = last;
+                m_Components[index] = std::move(m_Components.back());
+                m_Sparse[last.index] = index;
+            }
+
+            m_Entities.pop_back();
+            m_Components.pop_back();
+            m_Sparse[entity.index] = INVALID_INDEX;
+            ++m_Version;
+        }
+
+        void Clear() override {
+            m_Sparse.clear();
+            m_Entities.clear();
+            m_Components.clear();
+            ++m_Version;
+        }
+
+        [[nodiscard]] T& Get(const Entity entity) {
+            assert(Contains(entity) && "Entity doesn't have this component");
+            return m_Components[m_Sparse[entity.index]];
+        }
+
+        [[nodiscard]] const T& Get(const Entity entity) const {
+            assert(Contains(entity) && "Entity doesn't have this component");
+            return m_Components[m_Sparse[entity.index]];
+        }
+
+        [[nodiscard]] T* TryGet(const Entity entity) {
+            return Contains(entity) ? &m_Components[m_Sparse[entity.index]] : nullptr;
+        }
+
+        [[nodiscard]] const T* TryGet(const Entity entity) const {
+            return Contains(entity) ? &m_Components[m_Sparse[entity.index]] : nullptr;
+        }
+
+        /// Dense array of the components, in the same order as Entities()
+        [[nodiscard]] std::span<T> Components() { return m_Components; }
+        [[nodiscard]] std::span<const T> Components() const { return m_Components; }
+
+    private:
+        std::vector<T> m_Components;
+    };
+}
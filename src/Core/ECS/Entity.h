@@ -0,0 +1,44 @@
+/**
+ * @file Entity.h
+ * @brief Defines the generational entity handle used by the `Liara_Registry`.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace Liara::Core::ECS
+{
+    /**
+     * @struct Entity
+     * @brief Generational handle of an entity inside a `Liara_Registry`.
+     *
+     * The index is the slot of the entity, reused once the entity is destroyed, and also the index of the entity
+     * in the sparse arrays of the component pools. The generation is incremented each time the slot is released,
+     * so a handle to a destroyed entity never matches the entity that reuses its slot.
+     */
+    struct Entity
+    {
+        static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+        uint32_t index = INVALID_INDEX;  ///< Slot of the entity
+        uint32_t generation = 0;         ///< Generation of the slot when the handle was created
+
+        [[nodiscard]] constexpr bool IsNull() const { return index == INVALID_INDEX; }
+
+        constexpr bool operator==(const Entity&) const = default;
+    };
+
+    /// Value representing the absence of an entity
+    constexpr Entity NULL_ENTITY{};
+}
+
+template <> struct std::hash<Liara::Core::ECS::Entity>
+{
+    size_t operator()(const Liara::Core::ECS::Entity& entity) const noexcept {
+        return std::hash<uint64_t>{}((static_cast<uint64_t>(entity.generation) << 32) | entity.index);
+    }
+};
@@ -0,0 +1,57 @@
+#include "Liara_Registry.h"
+
+#include <cassert>
+#include <cstdint>
+
+namespace Liara::Core::ECS
+{
+    Entity Liara_Registry::Create() {
+        uint32_t index = 0;
+        if (!m_FreeSlots.empty()) {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else {
+            assert(m_Slots.size() < Entity::INVALID_INDEX && "Entity slots exhausted");
+            index = static_cast<uint32_t>(m_Slots.size());
+            m_Slots.emplace_back();
+        }
+
+        Slot& slot = m_Slots[index];
+        slot.alive = true;
+        ++m_AliveCount;
+        return {.index = index, .generation = slot.generation};
+    }
+
+    void Liara_Registry::Destroy(const Entity entity) {
+        if (!IsAlive(entity)) { return; }
+
+        for (const auto& pool : m_Pools) {
+            if (pool) { pool->Remove(entity); }
+        }
+
+        // The generation wraps around after 2^32 reuses of the same slot, which is acceptable for stale handles
+        Slot& slot = m_Slots[entity.index];
+        slot.alive = false;
+        ++slot.generation;
+        m_FreeSlots.push_back(entity.index);
+        --m_AliveCount;
+    }
+
+    void Liara_Registry::Clear() {
+        for (const auto& pool : m_Pools) {
+            if (pool) { pool->Clear(); }
+        }
+
+        // Slots are kept so that handles created before the clear stay invalid
+        m_FreeSlots.clear();
+        for (uint32_t index = static_cast<uint32_t>(m_Slots.size()); index-- > 0;) {
+            if (m_Slots[index].alive) {
+                m_Slots[index].alive = false;
+                ++m_Slots[index].generation;
+            }
+            m_FreeSlots.push_back(index);
+        }
+        m_AliveCount = 0;
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file Liara_Registry.h
+ * @brief Defines the `Liara_Registry` class, which owns the entities and their components.
+ *
+ * Each component type is stored in its own `ComponentPool` (a sparse set), so systems iterate
+ * contiguous arrays of only the components they use.
+ * Entity slots are recycled through a free list, handles stay safe thanks to their generation.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ComponentPool.h"
+#include "Entity.h"
+#include "Liara_View.h"
+
+namespace Liara::Core::ECS
+{
+    /**
+     * @class Liara_Registry
+     * @brief Container of entities and components, replacing the old map of game objects.
+     */
+    class Liara_Registry
+    {
+    public:
+        Liara_Registry() = default;
+        ~Liara_Registry() = default;
+        Liara_Registry(const Liara_Registry&) = delete;
+        Liara_Registry& operator=(const Liara_Registry&) = delete;
+        Liara_Registry(Liara_Registry&&) = default;
+        Liara_Registry& operator=(Liara_Registry&&) = default;
+
+        /**
+         * @brief Creates a new entity without any component, reusing a released slot when possible.
+         */
+        [[nodiscard]] Entity Create();
+
+        /**
+         * @brief Destroys an entity, removes all its components and releases its slot.
+         * Does nothing if the handle is stale.
+         */
+        void Destroy(Entity entity);
+
+        /**
+         * @brief Destroys all the entities and their components.
+         */
+        void Clear();
+
+        [[nodiscard]] bool IsAlive(const Entity entity) const {
+            return entity.index < m_Slots.size() && m_Slots[entity.index].alive
+                && m_Slots[entity.index].generation == entity.generation;
+        }  ///< Whether the handle refers to an entity of the registry, O(1)
+        [[nodiscard]] size_t Size() const { return m_AliveCount; }        ///< Number of alive entities
+        [[nodiscard]] size_t Capacity() const { return m_Slots.size(); }  ///< Number of allocated slots
+
+        /**
+         * @brief Adds a component of type T to the entity, constructed from args.
+         * @return A reference to the new component.
+         */
+        template <typename T, typename... Args> T& Emplace(Entity entity, Args&&... args);
+
+        /**
+         * @brief Removes the component of type T from the entity, if any.
+         */
+        template <typename T> void Remove(Entity entity);
+
+        template <typename T> [[nodiscard]] bool Has(Entity entity) const;
+        template <typename T> [[nodiscard]] T& Get(Entity entity);
+        template <typename T> [[nodiscard]] const T& Get(Entity entity) const;
+        template <typename T> [[nodiscard]] T* TryGet(Entity entity);
+        template <typename T> [[nodiscard]] const T* TryGet(Entity entity) const;
+
+        /**
+         * @brief Returns the pool storing the components of type T, creating it if needed.
+         * Gives direct access to the dense arrays of entities and components.
+         */
+        template <typename T> [[nodiscard]] ComponentPool<T>& Storage();
+
+        /**
+         * @brief Returns a view over the entities owning all the components Ts.
+         */
+        template <typename... Ts> [[nodiscard]] Liara_View<Ts...> View();
+
+    private:
+        template <typename T> [[nodiscard]] const ComponentPool<T>* FindStorage() const;
+
+        struct Slot
+        {
+            uint32_t generation = 0;
+            bool alive = false;
+        };
+
+        std::vector<std::unique_ptr<IComponentPool>> m_Pools;  ///< Pools, indexed by component type id
+        std::vector<Slot> m_Slots;                             ///< Entity slots, indexed by Entity::index
+        std::vector<uint32_t> m_FreeSlots;                     ///< Released slots, reused in LIFO order
+        size_t m_AliveCount = 0;
+    };
+}
+
+#include "Liara_Registry.tpp"
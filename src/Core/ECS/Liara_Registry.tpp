@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Liara_Registry.h"
+
+#include <cassert>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Liara::Core::ECS
+{
+    template <typename T, typename... Args> T& Liara_Registry::Emplace(const Entity entity, Args&&... args) {
+        assert(IsAlive(entity) && "Cannot add a component to a dead entity");
+        return Storage<T>().Emplace(entity, std::forward<Args>(args)...);
+    }
+
+    template <typename T> void Liara_Registry::Remove(const Entity entity) {
+        if (const uint32_t id = ComponentTypeId<T>(); id < m_Pools.size() && m_Pools[id]) {
+            m_Pools[id]->Remove(entity);
+        }
+    }
+
+    template <typename T> bool Liara_Registry::Has(const Entity entity) const {
+        const auto* pool = FindStorage<T>();
+        return pool != nullptr && pool->Contains(entity);
+    }
+
+    template <typename T> T& Liara_Registry::Get(const Entity entity) { return Storage<T>().Get(entity); }
+
+    template <typename T> const T& Liara_Registry::Get(const Entity entity) const {
+        const auto* pool = FindStorage<T>();
+        assert(pool != nullptr && "Entity doesn't have this component");
+        return pool->Get(entity);
+    }
+
+    template <typename T> T* Liara_Registry::TryGet(const Entity entity) { return Storage<T>().TryGet(entity); }
+
+    template <typename T> const T* Liara_Registry::TryGet(const Entity entity) const {
+        const auto* pool = FindStorage<T>();
+        return pool != nullptr ? pool->TryGet(entity) : nullptr;
+    }
+
+    template <typename T> ComponentPool<T>& Liara_Registry::Storage() {
+        static_assert(!std::is_const_v<T>, "Storage type must not be const-qualified");
+
+        const uint32_t id = ComponentTypeId<T>();
+        if (id >= m_Pools.size()) { m_Pools.resize(static_cast<size_t>(id) + 1); }
+        if (!m_Pools[id]) { m_Pools[id] = std::make_unique<ComponentPool<T>>(); }
+        return static_cast<ComponentPool<T>&>(*m_Pools[id]);
+    }
+
+    template <typename... Ts> Liara_View<Ts...> Liara_Registry::View() {
+        return Liara_View<Ts...>(Storage<std::remove_const_t<Ts>>()...);
+    }
+
+    template <typename T> const ComponentPool<T>* Liara_Registry::FindStorage() const {
+        const uint32_t id = ComponentTypeId<T>();
+        if (id >= m_Pools.size() || !m_Pools[id]) { return nullptr; }
+        return static_cast<const ComponentPool<T>*>(m_Pools[id].get());
+    }
+}
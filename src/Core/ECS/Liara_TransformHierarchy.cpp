@@ -0,0 +1,303 @@
+#include "Liara_TransformHierarchy.h"
+
+#include "Core/Components/HierarchyComponent.h"
+#include "Core/Components/TransformComponent3d.h"
+#include "Core/Components/WorldTransformComponent.h"
+#include "Core/Jobs/Liara_JobSystem.h"
+#include "Core/Logging/LogMacros.h"
+#include "Core/Math/TransformBatch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "glm/ext/matrix_float3x3.hpp"
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float3.hpp"
+
+namespace Liara::Core::ECS
+{
+    namespace
+    {
+        // Below a few thousand matrices the SIMD kernel is faster than waking the workers
+        constexpr size_t PARALLEL_BATCH_SIZE = 4096;
+
+        /**
+         * The upper 3x3 of a TRS matrix is R * S, its inverse transpose is R * S^-1:
+         * each column only needs to be divided by the squared scale, no trigonometry nor inversion is needed.
+         */
+        glm::mat3 ComputeLocalNormalMatrix(const glm::mat4& local, const glm::vec3& scale) {
+            const glm::vec3 invScaleSquared = 1.0F / (scale * scale);
+            return glm::mat3{glm::vec3(local[0]) * invScaleSquared.x,
+                             glm::vec3(local[1]) * invScaleSquared.y,
+                             glm::vec3(local[2]) * invScaleSquared.z};
+        }
+    }
+
+    void Liara_TransformHierarchy::SetParent(const Entity child, const Entity parent) {
+        LIARA_CHECK_ARGUMENT(m_Registry.IsAlive(child), LogCore, "Cannot parent a dead entity");
+        LIARA_CHECK_ARGUMENT(
+            parent.IsNull() || m_Registry.IsAlive(parent), LogCore, "Cannot parent an entity to a dead entity");
+        LIARA_CHECK_ARGUMENT(
+            child != parent && !IsAncestorOf(child, parent), LogCore, "Parenting would create a cycle");
+
+        if (GetParent(child) == parent) { return; }
+
+        // Create both nodes first, emplacing may reallocate the pool and invalidate references
+        if (!m_Registry.Has<Component::HierarchyComponent>(child)) {
+            m_Registry.Emplace<Component::HierarchyComponent>(child);
+        }
+        if (!parent.IsNull() && !m_Registry.Has<Component::HierarchyComponent>(parent)) {
+            m_Registry.Emplace<Component::HierarchyComponent>(parent);
+        }
+
+        Detach(child);
+
+        if (!parent.IsNull()) {
+            auto& childNode = m_Registry.Get<Component::HierarchyComponent>(child);
+            auto& parentNode = m_Registry.Get<Component::HierarchyComponent>(parent);
+
+            childNode.parent = parent;
+            childNode.nextSibling = parentNode.firstChild;
+            if (!parentNode.firstChild.IsNull()) {
+                m_Registry.Get<Component::HierarchyComponent>(parentNode.firstChild).previousSibling = child;
+            }
+            parentNode.firstChild = child;
+        }
+
+        MarkDirty(child);
+    }
+
+    Entity Liara_TransformHierarchy::GetParent(const Entity entity) const {
+        const auto* node = m_Registry.TryGet<Component::HierarchyComponent>(entity);
+        return node != nullptr ? node->parent : NULL_ENTITY;
+    }
+
+    void Liara_TransformHierarchy::MarkDirty(const Entity entity) {
+        // Entities without cached matrices yet are picked up by RegisterNewTransforms
+        if (auto* world = m_Registry.TryGet<Component::WorldTransformComponent>(entity);
+            world != nullptr && !world->dirty) {
+            world->dirty = true;
+            m_DirtyEntities.push_back(entity);
+        }
+    }
+
+    void Liara_TransformHierarchy::Destroy(const Entity entity) {
+        if (!m_Registry.IsAlive(entity)) { return; }
+
+        Detach(entity);
+
+        m_Stack.clear();
+        m_Stack.push_back(entity);
+        while (!m_Stack.empty()) {
+            const Entity current = m_Stack.back();
+            m_Stack.pop_back();
+
+            if (const auto* node = m_Registry.TryGet<Component::HierarchyComponent>(current)) {
+                for (Entity child = node->firstChild; !child.IsNull();
+                     child = m_Registry.Get<Component::HierarchyComponent>(child).nextSibling) {
+                    m_Stack.push_back(child);
+                }
+            }
+            m_Registry.Destroy(current);
+        }
+    }
+
+    void Liara_TransformHierarchy::Update(Jobs::Liara_JobSystem* jobSystem) {
+        RegisterNewTransforms();
+        ComputeDirtyLocalMatrices(jobSystem);
+
+        m_LastUpdateCount = 0;
+        for (const Entity entity : m_DirtyEntities) {
+            // Skip entities already recomputed with a dirty ancestor, or that will be with it
+            const auto* world = m_Registry.TryGet<Component::WorldTransformComponent>(entity);
+            if (world == nullptr || !world->dirty || HasDirtyAncestor(entity)) { continue; }
+
+            UpdateSubtree(entity);
+        }
+        m_DirtyEntities.clear();
+    }
+
+    void Liara_TransformHierarchy::BeginStep() {
+        auto& worlds = m_Registry.Storage<Component::WorldTransformComponent>();
+        for (const Entity entity : m_MovedEntities) {
+            if (auto* world = worlds.TryGet(entity)) {
+                world->previousWorld = world->world;
+                world->previousNormal = world->normal;
+                world->interpolatedWorld = world->world;
+                world->interpolatedNormal = world->normal;
+            }
+        }
+        m_MovedEntities.clear();
+        ++m_Step;
+        m_InStep = true;
+    }
+
+    void Liara_TransformHierarchy::Interpolate(const float alpha) {
+        auto& worlds = m_Registry.Storage<Component::WorldTransformComponent>();
+        for (const Entity entity : m_MovedEntities) {
+            auto* world = worlds.TryGet(entity);
+            if (world == nullptr) { continue; }
+
+            // Component-wise blend, close enough to a proper rotation interpolation for the motion of a single step
+            for (int column = 0; column < 4; ++column) {
+                world->interpolatedWorld[column] =
+                    world->previousWorld[column] + (world->world[column] - world->previousWorld[column]) * alpha;
+            }
+            for (int column = 0; column < 3; ++column) {
+                world->interpolatedNormal[column] =
+                    world->previousNormal[column] + (world->normal[column] - world->previousNormal[column]) * alpha;
+            }
+        }
+    }
+
+    void Liara_TransformHierarchy::RegisterNewTransforms() {
+        auto& transforms = m_Registry.Storage<Component::TransformComponent3d>();
+        auto& worlds = m_Registry.Storage<Component::WorldTransformComponent>();
+        // Equal sizes do not tell a transform added from another removed in the same frame
+        if (transforms.GetVersion() == m_TransformsVersion && worlds.GetVersion() == m_WorldsVersion) { return; }
+
+        for (const Entity entity : transforms.Entities()) {
+            if (!worlds.Contains(entity)) {
+                worlds.Emplace(entity);
+                m_DirtyEntities.push_back(entity);
+            }
+        }
+
+        // Drop the cached matrices of entities whose transform was removed
+        if (worlds.Size() != transforms.Size()) {
+            std::vector<Entity> orphans;
+            for (const Entity entity : worlds.Entities()) {
+                if (!transforms.Contains(entity)) { orphans.push_back(entity); }
+            }
+            for (const Entity entity : orphans) { worlds.Remove(entity); }
+        }
+
+        m_TransformsVersion = transforms.GetVersion();
+        m_WorldsVersion = worlds.GetVersion();
+    }
+
+    void Liara_TransformHierarchy::ComputeDirtyLocalMatrices(Jobs::Liara_JobSystem* jobSystem) {
+        auto& transforms = m_Registry.Storage<Component::TransformComponent3d>();
+        auto& worlds = m_Registry.Storage<Component::WorldTransformComponent>();
+
+        m_Batch.Clear();
+        m_BatchEntities.clear();
+        for (const Entity entity : m_DirtyEntities) {
+            const auto* world = worlds.TryGet(entity);
+            const auto* transform = transforms.TryGet(entity);
+            if (world == nullptr || transform == nullptr || !world->dirty) { continue; }
+
+            m_Batch.PushBack(*transform);
+            m_BatchEntities.push_back(entity);
+        }
+        if (m_BatchEntities.empty()) { return; }
+
+        m_BatchMatrices.resize(m_BatchEntities.size());
+        if (jobSystem != nullptr && m_BatchEntities.size() >= PARALLEL_BATCH_SIZE * 2) {
+            jobSystem->ParallelFor(m_BatchEntities.size(), PARALLEL_BATCH_SIZE, [this](size_t begin, size_t end) {
+                Math::ComputeTransformMatrixRange(m_Batch, begin, end - begin, m_BatchMatrices);
+            });
+        }
+        else { Math::ComputeTransformMatrices(m_Batch, m_BatchMatrices); }
+
+        for (size_t i = 0; i < m_BatchEntities.size(); ++i) {
+            worlds.Get(m_BatchEntities[i]).local = m_BatchMatrices[i];
+        }
+    }
+
+    void Liara_TransformHierarchy::UpdateSubtree(const Entity root) {
+        auto& transforms = m_Registry.Storage<Component::TransformComponent3d>();
+        auto& worlds = m_Registry.Storage<Component::WorldTransformComponent>();
+        auto& nodes = m_Registry.Storage<Component::HierarchyComponent>();
+
+        m_Stack.clear();
+        m_Stack.push_back(root);
+        while (!m_Stack.empty()) {
+            const Entity entity = m_Stack.back();
+            m_Stack.pop_back();
+
+            auto* world = worlds.TryGet(entity);
+            const auto* transform = transforms.TryGet(entity);
+            const auto* node = nodes.TryGet(entity);
+
+            if (world != nullptr && transform != nullptr) {
+                // The local matrix of dirty entities was computed by the batch
+                world->dirty = false;
+
+                if (world->movedStep != m_Step) {
+                    world->movedStep = m_Step;
+                    m_MovedEntities.push_back(entity);
+                }
+
+                const glm::mat3 localNormal = ComputeLocalNormalMatrix(world->local, transform->scale);
+                const auto* parentWorld = node != nullptr ? worlds.TryGet(node->parent) : nullptr;
+                if (parentWorld != nullptr) {
+                    world->world = parentWorld->world * world->local;
+                    world->normal = parentWorld->normal * localNormal;
+                }
+                else {
+                    world->world = world->local;
+                    world->normal = localNormal;
+                }
+
+                // A new entity appears where it is, without blending from the identity, and so does one moved
+                // outside of a step, without blending from the state of the last one
+                if (!world->initialized || !m_InStep) {
+                    world->previousWorld = world->world;
+                    world->previousNormal = world->normal;
+                    world->interpolatedWorld = world->world;
+                    world->interpolatedNormal = world->normal;
+                    world->initialized = true;
+                }
+                ++m_LastUpdateCount;
+            }
+
+            if (node != nullptr) {
+                for (Entity child = node->firstChild; !child.IsNull(); child = nodes.Get(child).nextSibling) {
+                    m_Stack.push_back(child);
+                }
+            }
+        }
+    }
+
+    void Liara_TransformHierarchy::Detach(const Entity child) {
+        auto* childNode = m_Registry.TryGet<Component::HierarchyComponent>(child);
+        if (childNode == nullptr || childNode->parent.IsNull()) { return; }
+
+        if (!childNode->previousSibling.IsNull()) {
+            m_Registry.Get<Component::HierarchyComponent>(childNode->previousSibling).nextSibling =
+                childNode->nextSibling;
+        }
+        else if (auto* parentNode = m_Registry.TryGet<Component::HierarchyComponent>(childNode->parent)) {
+            parentNode->firstChild = childNode->nextSibling;
+        }
+
+        if (!childNode->nextSibling.IsNull()) {
+            m_Registry.Get<Component::HierarchyComponent>(childNode->nextSibling).previousSibling =
+                childNode->previousSibling;
+        }
+
+        childNode->parent = NULL_ENTITY;
+        childNode->previousSibling = NULL_ENTITY;
+        childNode->nextSibling = NULL_ENTITY;
+        MarkDirty(child);
+    }
+
+    bool Liara_TransformHierarchy::HasDirtyAncestor(const Entity entity) const {
+        for (Entity ancestor = GetParent(entity); !ancestor.IsNull(); ancestor = GetParent(ancestor)) {
+            if (const auto* world = m_Registry.TryGet<Component::WorldTransformComponent>(ancestor);
+                world != nullptr && world->dirty) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Liara_TransformHierarchy::IsAncestorOf(const Entity ancestor, const Entity entity) const {
+        for (Entity current = GetParent(entity); !current.IsNull(); current = GetParent(current)) {
+            if (current == ancestor) { return true; }
+        }
+        return false;
+    }
+}
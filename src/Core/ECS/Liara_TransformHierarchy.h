@@ -0,0 +1,120 @@
+/**
+ * @file Liara_TransformHierarchy.h
+ * @brief Defines the `Liara_TransformHierarchy` class, which maintains parent/child links and cached matrices.
+ */
+
+#pragma once
+
+#include "Core/Jobs/Liara_JobSystem.h"
+#include "Core/Math/TransformBatch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Entity.h"
+#include "glm/ext/matrix_float4x4.hpp"
+#include "Liara_Registry.h"
+
+namespace Liara::Core::ECS
+{
+    /**
+     * @class Liara_TransformHierarchy
+     * @brief Computes the `WorldTransformComponent` of the entities owning a `TransformComponent3d`.
+     *
+     * Matrices are cached: an entity is only recomputed when it was marked dirty or when one of its ancestors was,
+     * so static entities cost nothing per frame.
+     * Systems modifying a `TransformComponent3d` must call MarkDirty() on the entity.
+     *
+     * With a fixed simulation step, BeginStep() is called before each step, EndStep() after it, and Interpolate()
+     * before rendering to blend the matrices of the entities that moved during the last step. An entity moved
+     * outside of a step has no previous step to blend from, it is rendered where it is.
+     */
+    class Liara_TransformHierarchy
+    {
+    public:
+        explicit Liara_TransformHierarchy(Liara_Registry& registry)
+            : m_Registry(registry) {}
+
+        /**
+         * @brief Attaches the child to the parent, or detaches it if parent is NULL_ENTITY.
+         * The local transform of the child is kept, so its world position changes with the parent.
+         * @throws std::invalid_argument if an entity is not alive or if the link would create a cycle.
+         */
+        void SetParent(Entity child, Entity parent);
+
+        /**
+         * @brief Returns the parent of the entity, or NULL_ENTITY if it is a root.
+         */
+        [[nodiscard]] Entity GetParent(Entity entity) const;
+
+        /**
+         * @brief Flags the local transform of the entity as modified, its subtree is recomputed by the next Update.
+         */
+        void MarkDirty(Entity entity);
+
+        /**
+         * @brief Destroys the entity and all its descendants, and unlinks it from its parent.
+         */
+        void Destroy(Entity entity);
+
+        /**
+         * @brief Recomputes the matrices of the dirty subtrees and tracks the new transforms.
+         * @param jobSystem Optional job system, large batches of dirty local matrices are then split across workers.
+         */
+        void Update(Jobs::Liara_JobSystem* jobSystem = nullptr);
+
+        /**
+         * @brief Starts a new simulation step: the current matrices become the previous ones of the moved entities.
+         */
+        void BeginStep();
+
+        /**
+         * @brief Ends the simulation step, the matrices recomputed until the next BeginStep are not blended.
+         */
+        void EndStep() { m_InStep = false; }
+
+        /**
+         * @brief Computes the interpolated matrices of the entities that moved during the last step.
+         * @param alpha Blend factor between the previous (0) and the current (1) step.
+         */
+        void Interpolate(float alpha);
+
+        /**
+         * @brief Returns the number of entities whose world matrix was recomputed by the last Update.
+         */
+        [[nodiscard]] size_t GetLastUpdateCount() const { return m_LastUpdateCount; }
+
+        /**
+         * @brief Returns the entities whose matrices changed since the last BeginStep.
+         */
+        [[nodiscard]] std::span<const Entity> GetMovedEntities() const { return m_MovedEntities; }
+
+    private:
+        void RegisterNewTransforms();
+        void ComputeDirtyLocalMatrices(Jobs::Liara_JobSystem* jobSystem);
+        void UpdateSubtree(Entity root);
+        void Detach(Entity child);
+
+        [[nodiscard]] bool HasDirtyAncestor(Entity entity) const;
+        [[nodiscard]] bool IsAncestorOf(Entity ancestor, Entity entity) const;
+
+        Liara_Registry& m_Registry;
+
+        std::vector<Entity> m_DirtyEntities;  ///< Entities marked dirty since the last update
+        std::vector<Entity> m_MovedEntities;  ///< Entities whose matrices changed during the current step
+        std::vector<Entity> m_Stack;          ///< Traversal stack, kept to avoid reallocations
+
+        // Batch of dirty local transforms, kept to avoid reallocations
+        Math::TransformSoA m_Batch;
+        std::vector<Entity> m_BatchEntities;
+        std::vector<glm::mat4> m_BatchMatrices;
+
+        size_t m_LastUpdateCount = 0;
+        uint64_t m_TransformsVersion = 0;  ///< Of the transform pool, at the last scan for new transforms
+        uint64_t m_WorldsVersion = 0;      ///< Of the world transform pool, at the last scan
+        uint32_t m_Step = 1;
+        bool m_InStep = false;  ///< Between BeginStep and EndStep
+    };
+}
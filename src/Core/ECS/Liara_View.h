@@ -0,0 +1,78 @@
+/**
+ * @file Liara_View.h
+ * @brief Defines the `Liara_View` class, used to iterate over the entities owning a set of components.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+#include "ComponentPool.h"
+#include "Entity.h"
+
+namespace Liara::Core::ECS
+{
+    /**
+     * @class Liara_View
+     * @brief Non-owning view over the entities owning all the components Ts.
+     *
+     * The iteration is driven by the smallest pool, the other pools are only used for O(1) lookups.
+     * With a single component type, the dense array is iterated directly.
+     * A component type can be const-qualified to express a read-only access.
+     * Adding or removing the iterated components while iterating is not supported.
+     */
+    template <typename... Ts> class Liara_View
+    {
+        static_assert(sizeof...(Ts) > 0, "A view needs at least one component type");
+
+    public:
+        explicit Liara_View(ComponentPool<std::remove_const_t<Ts>>&... pools)
+            : m_Pools(&pools...) {}
+
+        /**
+         * @brief Calls func(entity, Ts&...) for each entity owning all the components.
+         */
+        template <typename Func> void Each(Func&& func) const {
+            if constexpr (sizeof...(Ts) == 1) {
+                auto* pool = std::get<0>(m_Pools);
+                const auto entities = pool->Entities();
+                const auto components = pool->Components();
+                for (size_t i = 0; i < entities.size(); ++i) {
+                    func(entities[i], static_cast<Ts&>(components[i])...);
+                }
+            }
+            else {
+                for (const Entity entity : Lead()->Entities()) {
+                    if (ContainsAll(entity)) {
+                        func(entity, static_cast<Ts&>(std::get<Pool<Ts>*>(m_Pools)->Get(entity))...);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Returns an upper bound of the number of entities in the view (the size of the smallest pool).
+         */
+        [[nodiscard]] size_t SizeHint() const { return Lead()->Size(); }
+
+        [[nodiscard]] bool Contains(const Entity entity) const { return ContainsAll(entity); }
+
+    private:
+        template <typename T> using Pool = ComponentPool<std::remove_const_t<T>>;
+
+        [[nodiscard]] const IComponentPool* Lead() const {
+            const IComponentPool* lead = std::get<0>(m_Pools);
+            ((lead = std::get<Pool<Ts>*>(m_Pools)->Size() < lead->Size() ? std::get<Pool<Ts>*>(m_Pools) : lead), ...);
+            return lead;
+        }
+
+        [[nodiscard]] bool ContainsAll(const Entity entity) const {
+            return (std::get<Pool<Ts>*>(m_Pools)->Contains(entity) && ...);
+        }
+
+        std::tuple<Pool<Ts>*...> m_Pools;
+    };
+}
@@ -1,12 +1,24 @@
 #pragma once
+#include "Core/Culling/Liara_OcclusionBuffer.h"
+#include "Core/ECS/Liara_Registry.h"
+#include "Core/ECS/Liara_TransformHierarchy.h"
+#include "Core/Jobs/Liara_JobSystem.h"
+#include "Core/Memory/Liara_FrameAllocator.h"
+#include "Core/Spatial/Liara_SceneIndex.h"
 #include "Liara_Camera.h"
-#include "Liara_GameObject.h"
 #include "Systems/PointLightSystem.h"
 
 #include <vulkan/vulkan_core.h>
 
+#include <atomic>
+#include <cstdint>
 
 
+namespace Liara::Graphics
+{
+    class Liara_RenderQueue;
+}
+
 namespace Liara::Core
 {
     struct FrameInfo
@@ -16,30 +28,65 @@ namespace Liara::Core
         VkCommandBuffer commandBuffer;
         Liara_Camera& camera;
         VkDescriptorSet globalDescriptorSet;
-        Liara_GameObject::Map& gameObjects;
+        ECS::Liara_Registry& registry;
+        ECS::Liara_TransformHierarchy& transformHierarchy;
+        Jobs::Liara_JobSystem& jobSystem;
+        Memory::Liara_LinearArena& frameArena;  ///< Scratch memory of the frame, reset when its frame index comes back
+        const Spatial::Liara_SceneIndex& sceneIndex;  ///< BVH of the renderable entities, for spatial queries
+        Graphics::Liara_RenderQueue& renderQueue;     ///< Sorted draws, flushed after the Render of each system
+        float interpolationAlpha = 1.0f;  ///< Position of the frame between the last two simulation steps, in [0, 1]
+        const Culling::Liara_OcclusionBuffer* occlusionBuffer = nullptr;  ///< Occluders of the frame, null if disabled
     };
 
+    /**
+     * @brief Counters of the frame being recorded, and their values for the previous frame.
+     * The current counters are atomic, the command buffers of a frame being recorded by several threads.
+     */
     struct FrameStats
     {
-        uint64_t triangleCount = 0;
-        uint64_t vertexCount = 0;
-        uint64_t drawCallCount = 0;
-        double meshDrawTime = 0.0f;
+        std::atomic<uint64_t> triangleCount = 0;
+        std::atomic<uint64_t> vertexCount = 0;
+        std::atomic<uint64_t> drawCallCount = 0;
+        std::atomic<uint64_t> bindCount = 0;  ///< Pipeline, descriptor set and vertex buffer binds of the render queue
+        std::atomic<uint64_t> visibleObjectCount = 0;   ///< Objects that passed culling
+        std::atomic<uint64_t> culledObjectCount = 0;    ///< Objects skipped by frustum culling
+        std::atomic<uint64_t> occludedObjectCount = 0;  ///< Objects in the frustum but hidden behind occluders
+        std::atomic<uint64_t> uploadedObjectCount = 0;  ///< Objects rewritten into an object buffer
+        std::atomic<uint64_t> defragmentedBytes = 0;    ///< Bytes the defragmenter copied
+        std::atomic<double> meshDrawTime = 0.0;
 
         uint64_t previousTriangleCount = 0;
         uint64_t previousVertexCount = 0;
         uint64_t previousDrawCallCount = 0;
+        uint64_t previousBindCount = 0;
+        uint64_t previousVisibleObjectCount = 0;
+        uint64_t previousCulledObjectCount = 0;
+        uint64_t previousOccludedObjectCount = 0;
+        uint64_t previousUploadedObjectCount = 0;
+        uint64_t previousDefragmentedBytes = 0;
         double previousMeshDrawTime = 0.0f;
 
         void Reset() {
             previousTriangleCount = triangleCount;
             previousVertexCount = vertexCount;
             previousDrawCallCount = drawCallCount;
+            previousBindCount = bindCount;
+            previousVisibleObjectCount = visibleObjectCount;
+            previousCulledObjectCount = culledObjectCount;
+            previousOccludedObjectCount = occludedObjectCount;
+            previousUploadedObjectCount = uploadedObjectCount;
+            previousDefragmentedBytes = defragmentedBytes;
             previousMeshDrawTime = meshDrawTime;
 
             triangleCount = 0;
             vertexCount = 0;
             drawCallCount = 0;
+            bindCount = 0;
+            visibleObjectCount = 0;
+            culledObjectCount = 0;
+            occludedObjectCount = 0;
+            uploadedObjectCount = 0;
+            defragmentedBytes = 0;
             meshDrawTime = 0.0f;
         }
     };
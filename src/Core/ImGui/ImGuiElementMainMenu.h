@@ -13,9 +13,9 @@ namespace Liara::Core::ImGuiElements
     class MainMenu final : public ImGuiElement
     {
     public:
-        explicit MainMenu(const ApplicationInfo& appInfo)
+        MainMenu(const ApplicationInfo& appInfo, const Graphics::Liara_Device& device)
             : m_app_info(appInfo)
-            , m_engine_stats_element(new UI::ImGuiEngineStats(m_app_info)) {}
+            , m_engine_stats_element(new UI::ImGuiEngineStats(m_app_info, device)) {}
 
         ~MainMenu() override = default;
 
@@ -40,7 +40,7 @@ namespace Liara::Core::ImGuiElements
 
             if (m_show_log_console) {
                 if (auto* console = Liara::Logging::Logger::GetInstance().GetImGuiConsole()) {
-                    console->Draw(&m_show_log_console);
+                    console->Draw(frameInfo.frameArena, &m_show_log_console);
                 }
             }
         }
@@ -0,0 +1,206 @@
+#include "Liara_JobSystem.h"
+
+#include "Core/Logging/LogMacros.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+LIARA_DEFINE_LOG_CATEGORY(LogJobs, "Jobs", Info, Verbose);
+
+namespace Liara::Core::Jobs
+{
+    namespace Detail
+    {
+        struct Job
+        {
+            Liara_JobSystem::JobFunction function;
+            JobCounter* counter = nullptr;
+
+            std::atomic<uint32_t> pendingDependencies{1};  ///< Unfinished dependencies, plus one while scheduling
+            std::atomic<bool> finished{false};
+
+            std::mutex mutex;                                ///< Guards finished transitions and continuations
+            std::vector<std::shared_ptr<Job>> continuations;  ///< Jobs waiting on this one
+        };
+    }
+
+    namespace
+    {
+        // Identifies the queue of the current thread, per job system since several may coexist
+        thread_local const Liara_JobSystem* t_Owner = nullptr;
+        thread_local size_t t_QueueIndex = 0;
+    }
+
+    bool JobHandle::IsDone() const { return m_Job == nullptr || m_Job->finished.load(std::memory_order_acquire); }
+
+    Liara_JobSystem::Liara_JobSystem(uint32_t workerCount) {
+        if (workerCount == 0) { workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1; }
+
+        m_Queues.reserve(workerCount + 1);
+        for (uint32_t i = 0; i < workerCount + 1; ++i) { m_Queues.push_back(std::make_unique<WorkQueue>()); }
+
+        m_Workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i) {
+            m_Workers.emplace_back([this, i] { WorkerLoop(i + 1); });
+        }
+
+        LIARA_LOG_INFO(LogJobs, "Job system started with {} workers", workerCount);
+    }
+
+    Liara_JobSystem::~Liara_JobSystem() {
+        while (RunPendingJob()) {}
+
+        {
+            const std::scoped_lock lock(m_SleepMutex);
+            m_Stopping.store(true, std::memory_order_release);
+        }
+        m_WakeCondition.notify_all();
+        m_Workers.clear();
+
+        LIARA_LOG_VERBOSE(LogJobs, "Job system stopped");
+    }
+
+    JobHandle Liara_JobSystem::Schedule(JobFunction function,
+                                        const std::span<const JobHandle> dependencies,
+                                        JobCounter* counter) {
+        auto job = std::make_shared<Detail::Job>();
+        job->function = std::move(function);
+        job->counter = counter;
+        if (counter != nullptr) { counter->m_Pending.fetch_add(1, std::memory_order_relaxed); }
+
+        for (const JobHandle& dependency : dependencies) {
+            if (!dependency.IsValid()) { continue; }
+
+            const std::scoped_lock lock(dependency.m_Job->mutex);
+            if (!dependency.m_Job->finished.load(std::memory_order_relaxed)) {
+                job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+                dependency.m_Job->continuations.push_back(job);
+            }
+        }
+
+        // Release the scheduling reference, the job is queued here if every dependency already finished
+        if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) { Enqueue(job); }
+
+        return JobHandle(std::move(job));
+    }
+
+    void Liara_JobSystem::Wait(const JobHandle& handle) {
+        while (!handle.IsDone()) {
+            if (!RunPendingJob()) { std::this_thread::yield(); }
+        }
+    }
+
+    void Liara_JobSystem::Wait(const JobCounter& counter) {
+        while (!counter.IsDone()) {
+            if (!RunPendingJob()) { std::this_thread::yield(); }
+        }
+    }
+
+    void Liara_JobSystem::WorkerLoop(const size_t queueIndex) {
+        t_Owner = this;
+        t_QueueIndex = queueIndex;
+
+        while (true) {
+            if (const auto job = PopOrSteal(queueIndex)) {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock lock(m_SleepMutex);
+            m_WakeCondition.wait(lock, [this] {
+                return m_QueuedJobs.load(std::memory_order_acquire) > 0 || m_Stopping.load(std::memory_order_acquire);
+            });
+            if (m_Stopping.load(std::memory_order_acquire) && m_QueuedJobs.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+    void Liara_JobSystem::Enqueue(std::shared_ptr<Detail::Job> job) {
+        // Counted before the push so that a concurrent pop never makes the counter wrap
+        m_QueuedJobs.fetch_add(1, std::memory_order_release);
+
+        auto& queue = *m_Queues[GetCurrentQueueIndex()];
+        {
+            const std::scoped_lock lock(queue.mutex);
+            queue.jobs.push_back(std::move(job));
+        }
+
+        // Taking the lock orders the notification after a worker checked the predicate, no wakeup is lost
+        { const std::scoped_lock lock(m_SleepMutex); }
+        m_WakeCondition.notify_one();
+    }
+
+    std::shared_ptr<Detail::Job> Liara_JobSystem::PopOrSteal(const size_t queueIndex) {
+        {
+            auto& own = *m_Queues[queueIndex];
+            const std::scoped_lock lock(own.mutex);
+            if (!own.jobs.empty()) {
+                auto job = std::move(own.jobs.back());
+                own.jobs.pop_back();
+                m_QueuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+                return job;
+            }
+        }
+
+        for (size_t offset = 1; offset < m_Queues.size(); ++offset) {
+            auto& victim = *m_Queues[(queueIndex + offset) % m_Queues.size()];
+            const std::scoped_lock lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                auto job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                m_QueuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void Liara_JobSystem::Execute(const std::shared_ptr<Detail::Job>& job) {
+        try {
+            job->function();
+        }
+        catch (const std::exception& e) {
+            LIARA_LOG_ERROR(LogJobs, "Job threw an exception: {}", e.what());
+        }
+        catch (...) {
+            LIARA_LOG_ERROR(LogJobs, "Job threw an unknown exception");
+        }
+        job->function = nullptr;  // Release the captures now, handles may keep the job alive for long
+
+        std::vector<std::shared_ptr<Detail::Job>> continuations;
+        {
+            const std::scoped_lock lock(job->mutex);
+            job->finished.store(true, std::memory_order_release);
+            continuations.swap(job->continuations);
+        }
+        for (auto& continuation : continuations) {
+            if (continuation->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Enqueue(std::move(continuation));
+            }
+        }
+
+        // Last access to the counter, its owner may destroy it as soon as it reaches zero
+        if (job->counter != nullptr) { job->counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel); }
+    }
+
+    bool Liara_JobSystem::RunPendingJob() {
+        if (const auto job = PopOrSteal(GetCurrentQueueIndex())) {
+            Execute(job);
+            return true;
+        }
+        return false;
+    }
+
+    size_t Liara_JobSystem::GetCurrentQueueIndex() const { return t_Owner == this ? t_QueueIndex : 0; }
+}
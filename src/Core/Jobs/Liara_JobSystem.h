@@ -0,0 +1,185 @@
+/**
+ * @file Liara_JobSystem.h
+ * @brief Defines the `Liara_JobSystem` class, a work-stealing thread pool for engine and system tasks.
+ *
+ * Each worker owns a deque: it pushes and pops its own jobs at the back (LIFO, cache friendly),
+ * and idle workers steal from the front of the others (FIFO, oldest and usually biggest jobs first).
+ * Jobs can depend on other jobs, they are only queued once all their dependencies have finished.
+ * Threads waiting on a job or a counter run queued jobs instead of blocking, so waiting from a job is safe.
+ */
+
+#pragma once
+
+#include "Core/Logging/LogMacros.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+LIARA_DECLARE_LOG_CATEGORY_EXTERN(LogJobs, Info, Verbose);
+
+namespace Liara::Core::Jobs
+{
+    namespace Detail
+    {
+        struct Job;
+    }
+
+    /**
+     * @class JobCounter
+     * @brief Counts the unfinished jobs of a group, to wait on all of them at once.
+     * The counter must outlive the jobs it tracks.
+     */
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        [[nodiscard]] bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+        [[nodiscard]] size_t GetPending() const { return m_Pending.load(std::memory_order_acquire); }
+
+    private:
+        friend class Liara_JobSystem;
+        std::atomic<size_t> m_Pending{0};
+    };
+
+    /**
+     * @class JobHandle
+     * @brief Reference to a scheduled job, used to wait on it or to declare it as a dependency.
+     * A default constructed handle refers to no job and is always done.
+     */
+    class JobHandle
+    {
+    public:
+        JobHandle() = default;
+
+        [[nodiscard]] bool IsValid() const { return m_Job != nullptr; }
+        [[nodiscard]] bool IsDone() const;
+
+    private:
+        friend class Liara_JobSystem;
+        explicit JobHandle(std::shared_ptr<Detail::Job> job)
+            : m_Job(std::move(job)) {}
+
+        std::shared_ptr<Detail::Job> m_Job;
+    };
+
+    /**
+     * @class Liara_JobSystem
+     * @brief Thread pool running jobs on a fixed set of workers, with work stealing between them.
+     */
+    class Liara_JobSystem
+    {
+    public:
+        using JobFunction = std::function<void()>;
+
+        /**
+         * @brief Starts the workers.
+         * @param workerCount Number of worker threads, 0 to use one per hardware thread minus the calling thread.
+         */
+        explicit Liara_JobSystem(uint32_t workerCount = 0);
+
+        /**
+         * @brief Finishes the queued jobs, then stops and joins the workers.
+         */
+        ~Liara_JobSystem();
+
+        Liara_JobSystem(const Liara_JobSystem&) = delete;
+        Liara_JobSystem& operator=(const Liara_JobSystem&) = delete;
+        Liara_JobSystem(Liara_JobSystem&&) = delete;
+        Liara_JobSystem& operator=(Liara_JobSystem&&) = delete;
+
+        /**
+         * @brief Schedules a job, it runs once all its dependencies have finished.
+         * @param function The work to run, exceptions are logged and swallowed.
+         * @param dependencies Jobs that must finish before this one starts, invalid handles are ignored.
+         * @param counter Optional counter, incremented now and decremented when the job finishes.
+         * @return A handle on the job, usable as a dependency of other jobs (continuation).
+         */
+        JobHandle Schedule(JobFunction function,
+                           std::span<const JobHandle> dependencies = {},
+                           JobCounter* counter = nullptr);
+
+        JobHandle Schedule(JobFunction function,
+                           const std::initializer_list<JobHandle> dependencies,
+                           JobCounter* counter = nullptr) {
+            return Schedule(std::move(function), std::span(dependencies.begin(), dependencies.size()), counter);
+        }
+
+        /**
+         * @brief Splits [0, count) into batches run in parallel, and waits for all of them.
+         * @param count Number of elements.
+         * @param batchSize Minimum number of elements per job, to amortize the scheduling cost.
+         * @param function Called as function(begin, end) for each batch.
+         * @throws The exception of a batch that threw, once every batch ended. The batch of the calling thread wins,
+         * then the first of the others to throw.
+         */
+        template <typename Func> void ParallelFor(size_t count, size_t batchSize, Func&& function);
+
+        /**
+         * @brief Runs queued jobs until the job has finished.
+         */
+        void Wait(const JobHandle& handle);
+
+        /**
+         * @brief Runs queued jobs until every job tracked by the counter has finished.
+         */
+        void Wait(const JobCounter& counter);
+
+        /**
+         * @brief Number of threads running jobs: the workers plus the thread waiting on them.
+         */
+        [[nodiscard]] uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Workers.size()) + 1; }
+        [[nodiscard]] uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+        /**
+         * @brief Index of the calling thread in [0, GetThreadCount()), to pick per-thread resources.
+         * Worker i gets i + 1, every thread that is not a worker gets 0 and must not use such resources concurrently.
+         */
+        [[nodiscard]] uint32_t GetCurrentThreadIndex() const { return static_cast<uint32_t>(GetCurrentQueueIndex()); }
+
+    private:
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<std::shared_ptr<Detail::Job>> jobs;
+        };
+
+        void WorkerLoop(size_t queueIndex);
+
+        void Enqueue(std::shared_ptr<Detail::Job> job);
+        [[nodiscard]] std::shared_ptr<Detail::Job> PopOrSteal(size_t queueIndex);
+        void Execute(const std::shared_ptr<Detail::Job>& job);
+
+        /**
+         * @brief Runs one queued job, if any.
+         * @return true if a job was run.
+         */
+        bool RunPendingJob();
+
+        [[nodiscard]] size_t GetCurrentQueueIndex() const;
+
+        // Queue 0 is shared by the threads that are not workers, queue i + 1 belongs to worker i
+        std::vector<std::unique_ptr<WorkQueue>> m_Queues;
+        std::vector<std::jthread> m_Workers;
+
+        std::atomic<size_t> m_QueuedJobs{0};  ///< Jobs waiting in a queue, to let idle workers sleep
+        std::atomic<bool> m_Stopping{false};
+        std::mutex m_SleepMutex;
+        std::condition_variable m_WakeCondition;
+    };
+}
+
+#include "Liara_JobSystem.tpp"
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Liara_JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <span>
+
+namespace Liara::Core::Jobs
+{
+    template <typename Func>
+    void Liara_JobSystem::ParallelFor(const size_t count, const size_t batchSize, Func&& function) {
+        if (count == 0) { return; }
+
+        // A few batches per thread leave room for stealing without paying the scheduling cost for tiny batches
+        const size_t maxBatches = static_cast<size_t>(GetThreadCount()) * 4;
+        const size_t size = std::max({batchSize, size_t{1}, (count + maxBatches - 1) / maxBatches});
+        if (size >= count) {
+            function(size_t{0}, count);
+            return;
+        }
+
+        // The first exception of the scheduled batches, rethrown once they all ended whichever thread ran them
+        JobCounter counter;
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        for (size_t begin = size; begin < count; begin += size) {
+            const size_t end = std::min(begin + size, count);
+            Schedule(
+                [&function, &failed, &error, begin, end] {
+                    try {
+                        function(begin, end);
+                    }
+                    catch (...) {
+                        if (!failed.exchange(true, std::memory_order_acq_rel)) { error = std::current_exception(); }
+                    }
+                },
+                std::span<const JobHandle>{},
+                &counter);
+        }
+
+        // The calling thread takes the first batch, the jobs reference this frame so they must end before leaving
+        try {
+            function(size_t{0}, size);
+        }
+        catch (...) {
+            Wait(counter);
+            throw;
+        }
+        Wait(counter);
+        if (error) { std::rethrow_exception(error); }
+    }
+}
@@ -1,6 +1,9 @@
 #include "Liara_App.h"
 
 #include "Core/ApplicationInfo.h"
+#include "Core/Components/OccluderComponent.h"
+#include "Core/Components/WorldTransformComponent.h"
+#include "Core/Liara_FrameTimings.h"
 #include "Core/Liara_SignalHandler.h"
 #include "Graphics/Descriptors/Liara_Descriptor.h"
 #include "Graphics/GraphicsConstants.h"
@@ -8,6 +11,7 @@
 #include "Graphics/Liara_Texture.h"
 #include "Graphics/Ubo/GlobalUbo.h"
 #include "Graphics/VkResultToString.h"
+#include "Systems/GpuDrivenRenderSystem.h"
 #include "Systems/ImGuiSystem.h"
 #include "Systems/Liara_System.h"
 #include "Systems/PointLightSystem.h"
@@ -15,9 +19,17 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
 #include <memory>
+#include <nlohmann/json.hpp>
 #include <SDL2/SDL_events.h>
+#include <SDL2/SDL_keyboard.h>
+#include <span>
 #include <stdexcept>
+#include <string>
 
 #include "FrameInfo.h"
 #include "glm/trigonometric.hpp"
@@ -39,8 +51,15 @@ namespace Liara::Core
         , m_SettingsManager(std::make_unique<Liara_SettingsManager>(appInfo))
         , m_Window(*m_SettingsManager)
         , m_Device(m_Window, *m_SettingsManager)
-        , m_RendererManager(m_Window, m_Device, *m_SettingsManager) {
+        , m_RendererManager(m_Window,
+                            m_Device,
+                            *m_SettingsManager,
+                            m_Window.IsHeadless() ? Graphics::Renderers::RendererType::HEADLESS
+                                                  : Graphics::Renderers::RendererType::FORWARD) {
         m_SettingsManager->LoadFromFile("settings.cfg");
+        m_JobSystem = std::make_unique<Jobs::Liara_JobSystem>(m_SettingsManager->GetUInt("jobs.worker_count"));
+        m_FrameAllocator = std::make_unique<Memory::Liara_FrameAllocator>(
+            Graphics::Constants::MAX_FRAMES_IN_FLIGHT, m_SettingsManager->GetUInt("memory.frame_arena_size"));
 
         // Todo: Check if this is the right place to put this
         m_DescriptorAllocator =
@@ -51,6 +70,8 @@ namespace Liara::Core
                 .Build();
 
         m_DescriptorLayoutCache = Graphics::Descriptors::Liara_DescriptorLayoutCache::Builder(m_Device).Build();
+        m_CommandRecorder = std::make_unique<Graphics::Liara_SecondaryCommandRecorder>(
+            m_Device, m_JobSystem->GetThreadCount(), Graphics::Constants::MAX_FRAMES_IN_FLIGHT);
 
         LIARA_LOG_INFO(LogApplication, "Application created successfully");
     }
@@ -61,18 +82,49 @@ namespace Liara::Core
             Graphics::Liara_Texture::CreateFromFile(m_Device, "assets/textures/viking_room.png", *m_SettingsManager);
 
         Init();
+        InitReplay();
 
         auto currentTime = std::chrono::high_resolution_clock::now();
 
+        // A replay runs at the rate it was recorded with, to step the simulation exactly the same way
+        const uint32_t fixedHz = std::max(
+            m_ReplayPlayer ? m_ReplayPlayer->GetFixedHz() : m_SettingsManager->GetUInt("simulation.fixed_hz"), 1u);
+        const float fixedDeltaTime = 1.0f / static_cast<float>(fixedHz);
+        const uint32_t maxCatchUpSteps = std::max(m_SettingsManager->GetUInt("simulation.max_catchup_steps"), 1u);
+        float accumulator = 0.0f;
+
+        // Automated runs (benchmarks, headless) end by themselves, 0 means no limit
+        const uint32_t frameLimit = m_SettingsManager->GetUInt("app.frame_limit");
+        const float timeLimit = m_SettingsManager->GetFloat("app.time_limit");
+        const auto startTime = currentTime;
+        m_FrameTimings.Clear();
+        m_FrameTimings.Reserve(frameLimit);
+
         LIARA_LOG_INFO(LogApplication, "Starting main loop");
 
         while (!m_Window.ShouldClose() && !Liara_SignalHandler::ShouldExit()) {
             frameStats.Reset();
             auto newTime = std::chrono::high_resolution_clock::now();
-            const float frameTime = std::chrono::duration<float>(newTime - currentTime).count();
+            const float wallFrameTime = std::chrono::duration<float>(newTime - currentTime).count();
             currentTime = newTime;
 
+            float frameTime = wallFrameTime;
+            const Replay::ReplayFrame* replayFrame = nullptr;
+            if (m_ReplayPlayer) {
+                replayFrame = m_ReplayPlayer->NextFrame();
+                if (replayFrame == nullptr) {
+                    LIARA_LOG_INFO(LogApplication, "Replay finished after {} frames", m_ReplayPlayer->GetFrameCount());
+                    break;
+                }
+                frameTime = replayFrame->deltaTime;
+            }
+
             MasterProcessInput(frameTime);
+            if (replayFrame != nullptr) { m_Camera.SetView(replayFrame->view); }
+            // Every iteration is recorded, as a replay consumes one frame per iteration, rendered or not
+            if (m_ReplayRecorder) {
+                m_ReplayRecorder->RecordFrame(frameTime, m_Camera.GetViewMatrix(), GetKeyboardState());
+            }
 
             if (m_Window.WasMinimized()) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -83,34 +135,120 @@ namespace Liara::Core
             SetProjection(aspect);
 
             if (auto* const commandBuffer = m_RendererManager.BeginFrame()) {
+                const auto cpuStartTime = std::chrono::high_resolution_clock::now();
                 Systems::ImGuiSystem::NewFrame();
 
                 const int frameIndex = static_cast<int>(m_RendererManager.GetRenderer().GetFrameIndex());
+                // The renderer waited for this frame index to be free, its previous scratch data is no longer used
+                m_FrameAllocator->BeginFrame(static_cast<uint32_t>(frameIndex));
+
+                // Moves are recorded first, so that everything after draws from the new locations
+                const uint64_t defragBudgetKib = m_SettingsManager->GetBool("memory.defragmentation")
+                                                     ? m_SettingsManager->GetUInt("memory.defrag_budget_kib")
+                                                     : 0;
+                frameStats.defragmentedBytes +=
+                    m_Defragmenter.Step(commandBuffer, static_cast<uint32_t>(frameIndex), defragBudgetKib * 1024);
+                if ((m_StaleTextureFrames & (1u << frameIndex)) != 0) {
+                    // The previous submission of this frame is done with the set, it can be written again
+                    auto textureInfo = m_Texture->GetDescriptorInfo();
+                    Graphics::Descriptors::Liara_DescriptorBuilder(*m_DescriptorLayoutCache, *m_DescriptorAllocator)
+                        .BindImage(
+                            1, &textureInfo, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                        .Overwrite(m_GlobalDescriptorSets[frameIndex]);
+                    m_StaleTextureFrames &= static_cast<uint8_t>(~(1u << frameIndex));
+                }
+
+                // The simulation advances by fixed steps, whatever the frame rate
+                accumulator += frameTime;
+                uint32_t steps = 0;
+                while (accumulator >= fixedDeltaTime && steps < maxCatchUpSteps) {
+                    const FrameInfo stepInfo{.frameIndex = frameIndex,
+                                             .deltaTime = fixedDeltaTime,
+                                             .commandBuffer = commandBuffer,
+                                             .camera = m_Camera,
+                                             .globalDescriptorSet = m_GlobalDescriptorSets[frameIndex],
+                                             .registry = m_Registry,
+                                             .transformHierarchy = m_TransformHierarchy,
+                                             .jobSystem = *m_JobSystem,
+                                             .frameArena = m_FrameAllocator->GetArena(),
+                                             .sceneIndex = m_SceneIndex,
+                                             .renderQueue = m_RenderQueue};
+                    MasterFixedUpdate(stepInfo);
+                    accumulator -= fixedDeltaTime;
+                    ++steps;
+                }
+                if (accumulator >= fixedDeltaTime) {
+                    // Too far behind after a hitch: drop the time instead of spiraling into ever longer frames
+                    LIARA_LOG_VERBOSE(LogApplication,
+                                      "Simulation is {:.1f} ms behind, dropping the time after {} steps",
+                                      accumulator * 1000.0f,
+                                      steps);
+                    accumulator = std::fmod(accumulator, fixedDeltaTime);
+                }
+
+                const bool occlusionCulling = m_SettingsManager->GetBool("render.occlusion_culling");
+                m_RenderQueue.SetSortMode(m_SettingsManager->GetBool("render.queue_front_to_back")
+                                              ? Graphics::DrawSortMode::FRONT_TO_BACK
+                                              : Graphics::DrawSortMode::STATE);
+                m_RenderQueue.SetInstancing(m_SettingsManager->GetBool("render.instancing"));
                 const FrameInfo frameInfo{.frameIndex = frameIndex,
                                           .deltaTime = frameTime,
                                           .commandBuffer = commandBuffer,
                                           .camera = m_Camera,
                                           .globalDescriptorSet = m_GlobalDescriptorSets[frameIndex],
-                                          .gameObjects = m_GameObjects};
+                                          .registry = m_Registry,
+                                          .transformHierarchy = m_TransformHierarchy,
+                                          .jobSystem = *m_JobSystem,
+                                          .frameArena = m_FrameAllocator->GetArena(),
+                                          .sceneIndex = m_SceneIndex,
+                                          .renderQueue = m_RenderQueue,
+                                          .interpolationAlpha = accumulator / fixedDeltaTime,
+                                          .occlusionBuffer = occlusionCulling ? &m_OcclusionBuffer : nullptr};
 
                 MasterUpdate(frameInfo);
                 MasterRender(frameInfo);
                 m_RendererManager.EndFrame();
+
+                const auto cpuEndTime = std::chrono::high_resolution_clock::now();
+                m_FrameTimings.AddFrame(
+                    {.frameTime = wallFrameTime * 1000.0f,
+                     .cpuTime = std::chrono::duration<float, std::milli>(cpuEndTime - cpuStartTime).count(),
+                     .gpuTime = m_RendererManager.GetRenderer().GetGpuFrameTime(),
+                     .drawCallCount = frameStats.drawCallCount,
+                     .triangleCount = frameStats.triangleCount,
+                     .vertexCount = frameStats.vertexCount,
+                     .culledCount = frameStats.culledObjectCount,
+                     .occludedCount = frameStats.occludedObjectCount});
+
+                if (frameLimit != 0 && m_FrameTimings.GetFrameCount() >= frameLimit) {
+                    LIARA_LOG_INFO(LogApplication, "Frame limit of {} frames reached", frameLimit);
+                    break;
+                }
+                if (timeLimit > 0.0f && std::chrono::duration<float>(cpuEndTime - startTime).count() >= timeLimit) {
+                    LIARA_LOG_INFO(LogApplication, "Time limit of {:.1f} s reached", timeLimit);
+                    break;
+                }
             }
         }
 
         LIARA_LOG_INFO(LogApplication, "Main loop has ended, exiting application");
+        m_FrameTimings.LogSummary();
+
+        if (const std::string report = m_SettingsManager->GetString("replay.report"); !report.empty()) {
+            SaveRunReport(report, fixedHz);
+        }
+        m_ReplayRecorder.reset();
 
         Close();
     }
 
     void Liara_App::AddSystem(std::unique_ptr<Systems::Liara_System> system) {
-        m_Systems.push_back(std::move(system));
+        m_Systems.AddSystem(std::move(system));
         LIARA_LOG_VERBOSE(LogApplication,
                           "System \"{}(v{})\" added successfully, total systems: {}",
-                          m_Systems.back()->Name(),
-                          m_Systems.back()->Version().ToString(),
-                          m_Systems.size());
+                          m_Systems[m_Systems.Size() - 1].Name(),
+                          m_Systems[m_Systems.Size() - 1].Version().ToString(),
+                          m_Systems.Size());
     }
 
     void Liara_App::Init() {
@@ -157,21 +295,53 @@ namespace Liara::Core
                 .Build(m_GlobalDescriptorSets[i], m_GlobalSetLayout);
         }
 
+        // When the defragmenter moves the texture, each set is written again once its frame comes back
+        m_Texture->SetRelocationCallback([this](const Graphics::Liara_Texture&) {
+            m_StaleTextureFrames = static_cast<uint8_t>((1u << m_GlobalDescriptorSets.size()) - 1);
+        });
+
         LIARA_LOG_VERBOSE(LogApplication, "Descriptor sets initialized successfully");
     }
 
     void Liara_App::InitSystems() {
-        m_Systems.push_back(std::make_unique<Systems::SimpleRenderSystem>(
+        m_Systems.AddSystem(std::make_unique<Systems::SimpleRenderSystem>(
             m_Device, m_RendererManager.GetRenderer().GetRenderPass(), m_GlobalSetLayout, *m_SettingsManager));
-        m_Systems.push_back(std::make_unique<Systems::PointLightSystem>(
+        m_Systems.AddSystem(
+            std::make_unique<Systems::GpuDrivenRenderSystem>(m_Device,
+                                                             m_RendererManager,
+                                                             m_RendererManager.GetRenderer().GetRenderPass(),
+                                                             m_GlobalSetLayout,
+                                                             *m_SettingsManager));
+        m_Systems.AddSystem(std::make_unique<Systems::PointLightSystem>(
             m_Device, m_RendererManager.GetRenderer().GetRenderPass(), m_GlobalSetLayout, *m_SettingsManager));
-        m_Systems.push_back(std::make_unique<Systems::ImGuiSystem>(m_Window,
-                                                                   m_Device,
-                                                                   m_ApplicationInfo,
-                                                                   m_RendererManager.GetRenderer().GetRenderPass(),
-                                                                   m_RendererManager.GetRenderer().GetImageCount()));
+        // The UI needs a real window
+        if (!m_Window.IsHeadless()) {
+            m_Systems.AddSystem(
+                std::make_unique<Systems::ImGuiSystem>(m_Window,
+                                                       m_Device,
+                                                       m_ApplicationInfo,
+                                                       m_RendererManager.GetRenderer().GetRenderPass(),
+                                                       m_RendererManager.GetRenderer().GetImageCount()));
+        }
 
-        LIARA_LOG_VERBOSE(LogApplication, "{} systems initialized successfully", m_Systems.size());
+        LIARA_LOG_VERBOSE(LogApplication, "{} systems initialized successfully", m_Systems.Size());
+    }
+
+    void Liara_App::InitReplay() {
+        if (const std::string replay = m_SettingsManager->GetString("replay.play"); !replay.empty()) {
+            m_ReplayPlayer = std::make_unique<Replay::Liara_ReplayPlayer>(replay);
+            if (m_ReplayPlayer->GetFixedHz() != m_SettingsManager->GetUInt("simulation.fixed_hz")) {
+                LIARA_LOG_WARNING(LogApplication,
+                                  "Replay recorded at {} Hz, overriding simulation.fixed_hz={} for the playback",
+                                  m_ReplayPlayer->GetFixedHz(),
+                                  m_SettingsManager->GetUInt("simulation.fixed_hz"));
+            }
+        }
+
+        if (const std::string replay = m_SettingsManager->GetString("replay.record"); !replay.empty()) {
+            m_ReplayRecorder = std::make_unique<Replay::Liara_ReplayRecorder>(
+                replay, std::max(m_SettingsManager->GetUInt("simulation.fixed_hz"), 1u));
+        }
     }
 
     void Liara_App::InitCamera() {
@@ -191,19 +361,102 @@ namespace Liara::Core
         LIARA_LOG_INFO(LogApplication, "Application closed successfully");
     }
 
+    std::span<const uint8_t> Liara_App::GetKeyboardState() const {
+        if (m_ReplayPlayer) { return m_ReplayPlayer->GetKeyboardState(); }
+
+        int keyCount = 0;
+        const Uint8* state = SDL_GetKeyboardState(&keyCount);
+        return {state, static_cast<size_t>(keyCount)};
+    }
+
+    void Liara_App::SaveRunReport(const std::string& filename, const uint32_t fixedHz) const {
+        const auto summaryToJson = [](const FrameTimeSummary& summary) {
+            return nlohmann::json{
+                {"average", summary.average},
+                {    "min",     summary.min},
+                { "median",  summary.median},
+                {    "p95",     summary.p95},
+                {    "p99",     summary.p99},
+                {    "max",     summary.max}
+            };
+        };
+
+        nlohmann::json report;
+        report["application"] = m_SettingsManager->GetString("global.app_name");
+        report["version"] = m_SettingsManager->GetString("global.app_version_string");
+        report["build"] = m_SettingsManager->GetString("global.app_build_config");
+        report["device"] = std::string(m_Device.deviceProperties.deviceName);
+        report["headless"] = m_Window.IsHeadless();
+        report["extent"] = {m_Window.GetExtent().width, m_Window.GetExtent().height};
+        report["replay"] = m_SettingsManager->GetString("replay.play");
+        report["fixed_hz"] = fixedHz;
+        report["frame_count"] = m_FrameTimings.GetFrameCount();
+
+        report["summary"]["frame_ms"] = summaryToJson(m_FrameTimings.GetFrameTimeSummary());
+        report["summary"]["cpu_ms"] = summaryToJson(m_FrameTimings.GetCpuTimeSummary());
+        if (m_FrameTimings.HasGpuTimes()) {
+            report["summary"]["gpu_ms"] = summaryToJson(m_FrameTimings.GetGpuTimeSummary());
+        }
+
+        auto& frames = report["frames"] = nlohmann::json::array();
+        for (const auto& sample : m_FrameTimings.GetSamples()) {
+            frames.push_back({
+                {  "frame_ms",     sample.frameTime},
+                {    "cpu_ms",       sample.cpuTime},
+                {    "gpu_ms",       sample.gpuTime},
+                {"draw_calls", sample.drawCallCount},
+                { "triangles", sample.triangleCount},
+                {  "vertices",   sample.vertexCount},
+                {    "culled",   sample.culledCount},
+                {  "occluded", sample.occludedCount}
+            });
+        }
+
+        std::ofstream file(filename);
+        if (!file) {
+            LIARA_LOG_ERROR(LogApplication, "Failed to write the run report '{}'", filename);
+            return;
+        }
+        file << report.dump(2) << '\n';
+        LIARA_LOG_INFO(
+            LogApplication, "Run report of {} frames written to '{}'", m_FrameTimings.GetFrameCount(), filename);
+    }
+
     void Liara_App::MasterProcessInput(const float frameTime) {
         SDL_Event event;
-        while (SDL_PollEvent(&event) != 0) { ImGui_ImplSDL2_ProcessEvent(&event); }
+        // Headless runs have no ImGui backend, the queue is still drained for the window to see SDL_QUIT
+        const bool forwardToImGui = !m_Window.IsHeadless();
+        while (SDL_PollEvent(&event) != 0) {
+            if (forwardToImGui) { ImGui_ImplSDL2_ProcessEvent(&event); }
+        }
 
         ProcessInput(frameTime);
     }
 
+    void Liara_App::MasterFixedUpdate(const FrameInfo& frameInfo) {
+        m_TransformHierarchy.BeginStep();
+
+        FixedUpdate(frameInfo);
+        m_Systems.FixedUpdate(frameInfo);
+
+        m_TransformHierarchy.Update(m_JobSystem.get());
+        m_TransformHierarchy.EndStep();
+        m_SceneIndex.Update();
+    }
+
     void Liara_App::MasterUpdate(const FrameInfo& frameInfo) {
         Graphics::Ubo::GlobalUbo ubo(
             m_Camera.GetProjectionMatrix(), m_Camera.GetViewMatrix(), m_Camera.GetInverseViewMatrix());
 
         Update(frameInfo);
-        for (const auto& system : m_Systems) { system->Update(frameInfo, ubo); }
+
+        // Catch the transforms changed outside of the fixed steps, before the systems upload what they render:
+        // the state blended between the last two simulation steps
+        m_TransformHierarchy.Update(m_JobSystem.get());
+        m_TransformHierarchy.Interpolate(frameInfo.interpolationAlpha);
+        m_SceneIndex.Update();
+
+        m_Systems.Update(frameInfo, ubo);
 
         const auto& currentBuffer = m_UboBuffers[frameInfo.frameIndex];
         currentBuffer->WriteObject(ubo);
@@ -217,11 +470,64 @@ namespace Liara::Core
     }
 
     void Liara_App::MasterRender(const FrameInfo& frameInfo) {
-        m_RendererManager.BeginRenderPass(frameInfo.commandBuffer);
-
-        Render(frameInfo);
-        for (const auto& system : m_Systems) { system->Render(frameInfo); }
+        if (frameInfo.occlusionBuffer != nullptr) { RasterizeOccluders(); }
+        m_RenderQueue.BeginFrame(static_cast<uint32_t>(frameInfo.frameIndex));
+        m_Systems.PrepareRender(frameInfo);
+
+        // The main pass is recorded into secondary command buffers by the job threads, or inline by this one
+        const bool parallelRecording = m_SettingsManager->GetBool("render.parallel_recording");
+        const VkSubpassContents contents =
+            parallelRecording ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+
+        // Systems reading the depth of the frame draw a first part of it in an early pass, the main pass resumes after
+        if (m_Systems.HasEarlyPass()) {
+            m_RendererManager.BeginRenderPass(frameInfo.commandBuffer);
+            m_Systems.RenderEarly(frameInfo);
+            m_RendererManager.EndRenderPass(frameInfo.commandBuffer);
+            m_Systems.PrepareMainPass(frameInfo);
+            m_RendererManager.ResumeRenderPass(frameInfo.commandBuffer, contents);
+        }
+        else { m_RendererManager.BeginRenderPass(frameInfo.commandBuffer, contents); }
+
+        if (!parallelRecording) {
+            Render(frameInfo);
+            m_RenderQueue.Flush(frameInfo.commandBuffer);
+            m_Systems.Render(frameInfo);
+            m_RendererManager.EndRenderPass(frameInfo.commandBuffer);
+            return;
+        }
 
+        // The draws of the application come first, recorded here before the systems record theirs on the job system
+        const Graphics::Renderers::Liara_Renderer& renderer = m_RendererManager.GetRenderer();
+        m_CommandRecorder->BeginFrame(static_cast<uint32_t>(frameInfo.frameIndex),
+                                      renderer.GetRenderPass(),
+                                      renderer.GetCurrentFramebuffer(),
+                                      renderer.GetExtent());
+        m_SecondaryCommandBuffers.clear();
+        FrameInfo appInfo = frameInfo;
+        appInfo.commandBuffer = m_CommandRecorder->Begin(m_JobSystem->GetCurrentThreadIndex());
+        Render(appInfo);
+        m_CommandRecorder->End(appInfo.commandBuffer);
+        m_SecondaryCommandBuffers.push_back(appInfo.commandBuffer);
+        m_RenderQueue.Flush(*m_CommandRecorder, *m_JobSystem, m_SecondaryCommandBuffers);
+
+        m_Systems.RecordRender(frameInfo, *m_CommandRecorder, m_SecondaryCommandBuffers);
+        vkCmdExecuteCommands(frameInfo.commandBuffer,
+                             static_cast<uint32_t>(m_SecondaryCommandBuffers.size()),
+                             m_SecondaryCommandBuffers.data());
         m_RendererManager.EndRenderPass(frameInfo.commandBuffer);
     }
-}
\ No newline at end of file
+
+    void Liara_App::RasterizeOccluders() {
+        m_OcclusionBuffer.Begin(m_Camera.GetProjectionMatrix() * m_Camera.GetViewMatrix());
+        m_Registry.View<const Component::WorldTransformComponent, const Component::OccluderComponent>().Each(
+            [this](ECS::Entity,
+                   const Component::WorldTransformComponent& transform,
+                   const Component::OccluderComponent& occluder) {
+                if (occluder.mesh) {
+                    m_OcclusionBuffer.AddOccluder(*occluder.mesh, transform.interpolatedWorld, m_JobSystem.get());
+                }
+            });
+        m_OcclusionBuffer.Rasterize(m_JobSystem.get());
+    }
+}
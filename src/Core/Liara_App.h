@@ -1,18 +1,33 @@
 #pragma once
 
+#include "Core/Culling/Liara_OcclusionBuffer.h"
+#include "Core/ECS/Liara_Registry.h"
+#include "Core/ECS/Liara_TransformHierarchy.h"
+#include "Core/Jobs/Liara_JobSystem.h"
+#include "Core/Memory/Liara_FrameAllocator.h"
+#include "Core/Replay/Liara_Replay.h"
+#include "Core/Spatial/Liara_SceneIndex.h"
 #include "Graphics/Descriptors/Liara_Descriptor.h"
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/Liara_Defragmenter.h"
 #include "Graphics/Liara_Device.h"
+#include "Graphics/Liara_RenderQueue.h"
+#include "Graphics/Liara_SecondaryCommandRecorder.h"
 #include "Graphics/Liara_Texture.h"
 #include "Graphics/Renderers/Liara_RendererManager.h"
 #include "Plateform/Liara_Window.h"
 #include "Systems/Liara_System.h"
+#include "Systems/Liara_SystemScheduler.h"
 
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <string>
 
 #include "Application.h"
 #include "ApplicationInfo.h"
 #include "Liara_Camera.h"
-#include "Liara_GameObject.h"
+#include "Liara_FrameTimings.h"
 #include "Liara_SettingsManager.h"
 
 namespace Liara::Systems
@@ -59,19 +74,37 @@ namespace Liara::Core
         virtual void SetProjection(float aspect);
 
         virtual void ProcessInput(float /*frameTime*/) {}
+        virtual void FixedUpdate(const FrameInfo& /*frameInfo*/) {}
         virtual void Update(const FrameInfo& /*frameInfo*/) {}
         virtual void Render(const FrameInfo& /*frameInfo*/) {}
 
         virtual void Close();
 
+        /**
+         * @brief Keyboard state to drive ProcessInput with, one byte per scancode.
+         * It is the recorded one while playing a replay, so the input must be read from here to be replayed.
+         */
+        [[nodiscard]] std::span<const uint8_t> GetKeyboardState() const;
+
     private:
+        void InitReplay();
+        void SaveRunReport(const std::string& filename, uint32_t fixedHz) const;
+
         void MasterProcessInput(float frameTime);
+        void MasterFixedUpdate(const FrameInfo& frameInfo);
         void MasterUpdate(const FrameInfo& frameInfo);
         void MasterRender(const FrameInfo& frameInfo);
 
+        /**
+         * @brief Rasterizes the entities owning an `OccluderComponent` into the occlusion buffer, from the camera.
+         */
+        void RasterizeOccluders();
+
     protected:
         ApplicationInfo m_ApplicationInfo;
         std::shared_ptr<Liara_SettingsManager> m_SettingsManager;
+        std::unique_ptr<Jobs::Liara_JobSystem> m_JobSystem;
+        std::unique_ptr<Memory::Liara_FrameAllocator> m_FrameAllocator;
 
         Plateform::Liara_Window m_Window;
         Graphics::Liara_Device m_Device;
@@ -83,15 +116,27 @@ namespace Liara::Core
         std::unique_ptr<Graphics::Descriptors::Liara_DescriptorLayoutCache> m_DescriptorLayoutCache;
         VkDescriptorSetLayout m_GlobalSetLayout{};
         std::vector<VkDescriptorSet> m_GlobalDescriptorSets;
+        uint8_t m_StaleTextureFrames = 0;  ///< Bit per global set still pointing to the image the texture moved from
 
         Liara_Camera m_Camera;
-        Liara_GameObject::Map m_GameObjects;
-        std::vector<std::unique_ptr<Systems::Liara_System>> m_Systems;
+        ECS::Liara_Registry m_Registry;
+        ECS::Liara_TransformHierarchy m_TransformHierarchy{m_Registry};
+        Spatial::Liara_SceneIndex m_SceneIndex{m_Registry, m_TransformHierarchy};
+        Culling::Liara_OcclusionBuffer m_OcclusionBuffer;
+        Graphics::Liara_RenderQueue m_RenderQueue{m_Device, Graphics::Constants::MAX_FRAMES_IN_FLIGHT};
+        Graphics::Liara_Defragmenter m_Defragmenter{m_Device, Graphics::Constants::MAX_FRAMES_IN_FLIGHT};
+        std::unique_ptr<Graphics::Liara_SecondaryCommandRecorder> m_CommandRecorder;  ///< One pool per job thread
+        std::vector<VkCommandBuffer> m_SecondaryCommandBuffers;  ///< Executed by the main pass, in order
+        Systems::Liara_SystemScheduler m_Systems;
+        Liara_FrameTimings m_FrameTimings;  ///< Timings of the frames rendered by the last Run
 
         // TODO: Test texture, temporary
         std::unique_ptr<Graphics::Liara_Texture> m_Texture;
 
     private:
         std::vector<Graphics::Liara_Buffer::MappingGuard> m_UboMappings;
+
+        std::unique_ptr<Replay::Liara_ReplayRecorder> m_ReplayRecorder;
+        std::unique_ptr<Replay::Liara_ReplayPlayer> m_ReplayPlayer;
     };
 }
\ No newline at end of file
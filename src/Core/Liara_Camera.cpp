@@ -107,4 +107,17 @@ namespace Liara::Core
         m_InverseViewMatrix[3][1] = position.y;
         m_InverseViewMatrix[3][2] = position.z;
     }
+
+    void Liara_Camera::SetView(const glm::mat4& view)
+    {
+        m_ViewMatrix = view;
+
+        // The inverse of [R | t] is [R^T | -R^T t]
+        m_InverseViewMatrix = glm::mat4{1.f};
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++) { m_InverseViewMatrix[i][j] = view[j][i]; }
+            m_InverseViewMatrix[3][i] = -(view[i][0] * view[3][0] + view[i][1] * view[3][1] + view[i][2] * view[3][2]);
+        }
+    }
 }
\ No newline at end of file
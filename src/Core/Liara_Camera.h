@@ -19,6 +19,7 @@ namespace Liara::Core
         void SetViewDirection(const glm::vec3& position, const glm::vec3& direction, const glm::vec3& up = {0.0f, -1.0f, 0.0f});
         void SetViewTarget(const glm::vec3& position, const glm::vec3& target, const glm::vec3& up = {0.0f, -1.0f, 0.0f});
         void SetViewYXZ(const glm::vec3& position, const glm::vec3& rotation);
+        void SetView(const glm::mat4& view);  ///< Sets a rigid (rotation and translation only) view matrix
 
     private:
         glm::mat4 m_ProjectionMatrix{1.0f};
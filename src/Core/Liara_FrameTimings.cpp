@@ -0,0 +1,72 @@
+#include "Liara_FrameTimings.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include "Application.h"
+#include "Logging/LogMacros.h"
+
+namespace Liara::Core
+{
+    void Liara_FrameTimings::AddFrame(const FrameSample& sample) {
+        m_Samples.push_back(sample);
+        m_HasGpuTimes = m_HasGpuTimes || sample.gpuTime > 0.0f;
+    }
+
+    void Liara_FrameTimings::Clear() {
+        m_Samples.clear();
+        m_HasGpuTimes = false;
+    }
+
+    void Liara_FrameTimings::Reserve(const size_t frameCount) { m_Samples.reserve(frameCount); }
+
+    void Liara_FrameTimings::LogSummary() const {
+        if (m_Samples.empty()) {
+            LIARA_LOG_INFO(LogApplication, "No frame recorded");
+            return;
+        }
+
+        const auto log = [](const char* name, const FrameTimeSummary& summary) {
+            LIARA_LOG_INFO(LogApplication,
+                           "{} time (ms): avg {:.3f}, min {:.3f}, median {:.3f}, p95 {:.3f}, p99 {:.3f}, max {:.3f}",
+                           name,
+                           summary.average,
+                           summary.min,
+                           summary.median,
+                           summary.p95,
+                           summary.p99,
+                           summary.max);
+        };
+
+        LIARA_LOG_INFO(LogApplication, "Frame timings over {} frames", m_Samples.size());
+        log("Frame", GetFrameTimeSummary());
+        log("CPU", GetCpuTimeSummary());
+        if (m_HasGpuTimes) { log("GPU", GetGpuTimeSummary()); }
+    }
+
+    FrameTimeSummary Liara_FrameTimings::Summarize(float FrameSample::* time) const {
+        FrameTimeSummary summary;
+        if (m_Samples.empty()) { return summary; }
+
+        std::vector<float> times;
+        times.reserve(m_Samples.size());
+        for (const auto& sample : m_Samples) { times.push_back(sample.*time); }
+        std::ranges::sort(times);
+        // Nearest-rank percentile
+        const auto percentile = [&times](const double p) {
+            const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(times.size())));
+            return static_cast<double>(times[std::clamp<size_t>(rank, 1, times.size()) - 1]);
+        };
+
+        summary.average = std::accumulate(times.begin(), times.end(), 0.0) / static_cast<double>(times.size());
+        summary.min = times.front();
+        summary.median = percentile(0.5);
+        summary.p95 = percentile(0.95);
+        summary.p99 = percentile(0.99);
+        summary.max = times.back();
+        return summary;
+    }
+}
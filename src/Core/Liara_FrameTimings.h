@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Liara::Core
+{
+    /**
+     * @brief Distribution of one frame time over a run, in milliseconds
+     */
+    struct FrameTimeSummary
+    {
+        double average = 0.0;
+        double min = 0.0;
+        double median = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    /**
+     * @brief Measures of one frame, times in milliseconds
+     */
+    struct FrameSample
+    {
+        float frameTime = 0.0f;      ///< Wall time of the whole frame, waits included
+        float cpuTime = 0.0f;        ///< CPU time updating and recording the frame, without the GPU waits
+        float gpuTime = 0.0f;        ///< GPU time of the frame, 0 if not measured
+        uint64_t drawCallCount = 0;  ///< Draw calls recorded during the frame
+        uint64_t triangleCount = 0;  ///< Triangles drawn during the frame
+        uint64_t vertexCount = 0;    ///< Vertices drawn during the frame
+        uint64_t culledCount = 0;    ///< Objects skipped by frustum culling during the frame
+        uint64_t occludedCount = 0;  ///< Objects hidden behind occluders during the frame
+    };
+
+    /**
+     * @brief Records the frames of a run, to report the CPU and GPU frame cost at its end
+     */
+    class Liara_FrameTimings
+    {
+    public:
+        void AddFrame(const FrameSample& sample);
+
+        void Clear();
+        void Reserve(size_t frameCount);
+
+        [[nodiscard]] size_t GetFrameCount() const { return m_Samples.size(); }
+        [[nodiscard]] const std::vector<FrameSample>& GetSamples() const { return m_Samples; }
+        [[nodiscard]] bool HasGpuTimes() const { return m_HasGpuTimes; }
+
+        [[nodiscard]] FrameTimeSummary GetFrameTimeSummary() const { return Summarize(&FrameSample::frameTime); }
+        [[nodiscard]] FrameTimeSummary GetCpuTimeSummary() const { return Summarize(&FrameSample::cpuTime); }
+        [[nodiscard]] FrameTimeSummary GetGpuTimeSummary() const { return Summarize(&FrameSample::gpuTime); }
+
+        /**
+         * @brief Logs the summaries on the application category
+         */
+        void LogSummary() const;
+
+    private:
+        [[nodiscard]] FrameTimeSummary Summarize(float FrameSample::* time) const;
+
+        std::vector<FrameSample> m_Samples;
+        bool m_HasGpuTimes = false;
+    };
+}
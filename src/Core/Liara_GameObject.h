@@ -1,27 +1,34 @@
 #pragma once
 
+#include "Core/ECS/Liara_Registry.h"
 #include "Graphics/Liara_Model.h"
 
 #include <memory>
-#include <unordered_map>
+#include <utility>
 
+#include "Components/ColorComponent.h"
+#include "Components/ModelComponent.h"
+#include "Components/OccluderComponent.h"
 #include "Components/PointLightComponent.h"
 #include "Components/TransformComponent3d.h"
 #include "glm/ext/vector_float3.hpp"
 
-// TODO: Check Entity Component System
 namespace Liara::Core
 {
+    /**
+     * @class Liara_GameObject
+     * @brief Standalone game object, used to author an object before spawning it in a `ECS::Liara_Registry`.
+     *
+     * Systems only iterate the registry, a game object is not rendered nor updated until it is spawned.
+     */
     class Liara_GameObject
     {
     public:
-        using id_t = unsigned int;
-        using Map = std::unordered_map<id_t, Liara_GameObject>;
-
-        static Liara_GameObject CreateGameObject() {
-            static id_t id = 0;
-            return Liara_GameObject(id++);
-        }
+        /**
+         * @brief Creates an empty game object.
+         * It has no identity until it is spawned, the registry then gives it a generational `ECS::Entity` handle.
+         */
+        static Liara_GameObject CreateGameObject() { return Liara_GameObject(); }
 
         static Liara_GameObject MakePointLight(const float intensity = 10.0f,
                                               const float radius = 0.01f,
@@ -40,18 +47,29 @@ namespace Liara::Core
         Liara_GameObject(Liara_GameObject&&) = default;
         Liara_GameObject& operator=(Liara_GameObject&&) = default;
 
-        [[nodiscard]] id_t GetId() const { return m_Id; }
+        /**
+         * @brief Moves the game object into the registry, as an entity owning one component per field.
+         * @param registry The registry to spawn the object in.
+         * @return The created entity.
+         */
+        ECS::Entity Spawn(ECS::Liara_Registry& registry) && {
+            const ECS::Entity entity = registry.Create();
+            registry.Emplace<Component::TransformComponent3d>(entity, transform);
+            registry.Emplace<Component::ColorComponent>(entity, color);
+            if (pointLight) { registry.Emplace<Component::PointLightComponent>(entity, *pointLight); }
+            if (model) { registry.Emplace<Component::ModelComponent>(entity, std::move(model)); }
+            if (occluder) { registry.Emplace<Component::OccluderComponent>(entity, std::move(occluder)); }
+            return entity;
+        }
 
         Component::TransformComponent3d transform{};
         glm::vec3 color{};
 
         std::unique_ptr<Component::PointLightComponent> pointLight;
         std::shared_ptr<Graphics::Liara_Model> model;
+        std::shared_ptr<const Culling::OccluderMesh> occluder;  ///< Hides the objects behind it, see OccluderComponent
 
     private:
-        id_t m_Id;
-
-        explicit Liara_GameObject(const id_t id)
-            : m_Id(id) {}
+        Liara_GameObject() = default;
     };
-}
\ No newline at end of file
+}
@@ -41,6 +41,76 @@ namespace Liara::Core
         RegisterSetting("texture.max_size", 4096u, SettingFlags::SERIALIZABLE);
         RegisterSetting("texture.use_mipmaps", true, SettingFlags::SERIALIZABLE);
 
+        // Simulation steps per second, and maximum steps per frame before dropping time to catch up after a hitch
+        RegisterSetting("simulation.fixed_hz", 60u, SettingFlags::SERIALIZABLE);
+        RegisterSetting("simulation.max_catchup_steps", 5u, SettingFlags::SERIALIZABLE);
+
+        // Number of job system workers, 0 to use one per hardware thread minus the main thread
+        RegisterSetting("jobs.worker_count", 0u, SettingFlags::SERIALIZABLE);
+
+        // Skip the objects outside of the camera frustum before recording their draws
+        RegisterSetting("render.frustum_culling", true, SettingFlags::DEFAULT);
+        // Query the scene BVH for the frustum culling candidates, instead of testing every object
+        RegisterSetting("render.spatial_index", true, SettingFlags::DEFAULT);
+        // Rasterize the occluders into a small CPU depth buffer, and skip the objects hidden behind them
+        RegisterSetting("render.occlusion_culling", false, SettingFlags::DEFAULT);
+        // Sort the solid draws nearest first instead of by pipeline, material and mesh
+        RegisterSetting("render.queue_front_to_back", false, SettingFlags::DEFAULT);
+        // Draw the objects sharing a mesh and a pipeline with a single instanced draw
+        RegisterSetting("render.instancing", true, SettingFlags::DEFAULT);
+        // Record the main pass into secondary command buffers on the job threads, one per system and queue chunk
+        RegisterSetting("render.parallel_recording", true, SettingFlags::DEFAULT);
+        /**
+         * GPU-driven rendering: the indexed models are culled by compute shaders and drawn with indirect count draws,
+         * on devices supporting drawIndirectCount. gpu_max_objects and gpu_max_draws size its buffers at startup.
+         */
+        RegisterSetting("render.gpu_driven", false, SettingFlags::DEFAULT);
+        RegisterSetting("render.gpu_max_objects", 16384u, SettingFlags::SERIALIZABLE);
+        RegisterSetting("render.gpu_max_draws", 4096u, SettingFlags::SERIALIZABLE);
+        // Cull the GPU-driven objects against a depth pyramid of what was visible last frame, drawn in an early pass
+        RegisterSetting("render.gpu_occlusion_culling", true, SettingFlags::DEFAULT);
+
+        /**
+         * Levels of detail:
+         *      - mesh.*: simplified levels generated when a mesh is imported, lod_max_error is relative to its size
+         *      - render.lod_screen_error: coarsest level drawn is the one whose error covers less than this fraction
+         *        of the screen height, lod_hysteresis is the margin around it before switching level
+         */
+        RegisterSetting("mesh.lod_levels", 3u, SettingFlags::SERIALIZABLE);
+        RegisterSetting("mesh.lod_reduction", 0.5f, SettingFlags::SERIALIZABLE);
+        RegisterSetting("mesh.lod_max_error", 0.05f, SettingFlags::SERIALIZABLE);
+        RegisterSetting("render.lod_selection", true, SettingFlags::DEFAULT);
+        RegisterSetting("render.lod_screen_error", 0.001f, SettingFlags::DEFAULT);
+        RegisterSetting("render.lod_hysteresis", 0.25f, SettingFlags::DEFAULT);
+
+        // Initial size of each frame arena in bytes, an arena that overflows grows on its next frame
+        RegisterSetting("memory.frame_arena_size", 1u << 20, SettingFlags::SERIALIZABLE);
+        // Size in bytes of the persistently mapped staging ring uploads go through, larger uploads are staged alone
+        RegisterSetting("memory.staging_ring_size", 32u << 20, SettingFlags::SERIALIZABLE);
+        // Compact the geometry pool and evacuate sparse device memory blocks, copying at most defrag_budget_kib a frame
+        RegisterSetting("memory.defragmentation", true, SettingFlags::DEFAULT);
+        RegisterSetting("memory.defrag_budget_kib", 4096u, SettingFlags::SERIALIZABLE);
+
+        /**
+         * Headless mode renders into offscreen images, without window, surface or swap chain, to measure frame costs
+         * in automation (also works on software devices like lavapipe). Not serialized, it is meant for the command
+         * line: --app.headless --app.frame_limit=1000
+         * The run ends after frame_limit frames or time_limit seconds, 0 for no limit.
+         */
+        RegisterSetting("app.headless", false, SettingFlags::NONE);
+        RegisterSetting("app.frame_limit", 0u, SettingFlags::RUNTIME_MODIFIABLE);
+        RegisterSetting("app.time_limit", 0.0f, SettingFlags::RUNTIME_MODIFIABLE);
+
+        /**
+         * Replay files (see Core/Replay/Liara_Replay.h), empty to disable:
+         *      - record: captures the input, camera and frame times of the session
+         *      - play: runs the frames of a recorded session again, then ends the run
+         *      - report: JSON file receiving the per-frame timings and draw statistics of the run
+         */
+        RegisterSetting("replay.record", std::string(), SettingFlags::RUNTIME_MODIFIABLE);
+        RegisterSetting("replay.play", std::string(), SettingFlags::RUNTIME_MODIFIABLE);
+        RegisterSetting("replay.report", std::string(), SettingFlags::RUNTIME_MODIFIABLE);
+
         // Register application information settings
         static_assert(IsValidAppInfo({}), "DEFAULT ApplicationInfo must be valid");
         LIARA_CHECK_ARGUMENT(IsValidAppInfo(appInfo), LogCore, "Invalid ApplicationInfo provided");
@@ -69,9 +139,43 @@ namespace Liara::Core
                         VK_MAKE_VERSION(ENGINE_VERSION_MAJOR, ENGINE_VERSION_MINOR, ENGINE_VERSION_PATCH),
                         SettingFlags::NONE);
 
+        ApplyCommandLineArguments(false);
+
         LIARA_LOG_VERBOSE(LogCore, "SettingsManager initialized with {} settings", m_Settings.size());
     }
 
+    std::vector<std::string> Liara_SettingsManager::commandLineArguments;
+
+    void Liara_SettingsManager::SetCommandLineArguments(const int argc, const char* const* argv) {
+        commandLineArguments.clear();
+        for (int i = 1; i < argc; ++i) { commandLineArguments.emplace_back(argv[i]); }
+    }
+
+    void Liara_SettingsManager::ApplyCommandLineArguments(const bool reportUnknown) {
+        for (const auto& argument : commandLineArguments) {
+            if (!argument.starts_with("--")) {
+                if (reportUnknown) { LIARA_LOG_WARNING(LogCore, "Ignoring command line argument '{}'", argument); }
+                continue;
+            }
+
+            const size_t eqPos = argument.find('=');
+            const std::string key = argument.substr(2, eqPos == std::string::npos ? std::string::npos : eqPos - 2);
+            const std::string value = eqPos == std::string::npos ? "true" : argument.substr(eqPos + 1);
+
+            const auto it = m_Settings.find(key);
+            if (it == m_Settings.end()) {
+                if (reportUnknown) { LIARA_LOG_WARNING(LogCore, "Unknown setting '{}' on the command line", key); }
+                continue;
+            }
+
+            // Strings are taken as is, the shell already stripped their quotes (--replay.play=capture.lrpy)
+            const bool applied = it->second.HoldsType<std::string>() ? Set(key, value) : DeserializeSetting(key, value);
+
+            if (applied) { LIARA_LOG_VERBOSE(LogCore, "Command line: {}={}", key, value); }
+            else { LIARA_LOG_WARNING(LogCore, "Invalid value '{}' for setting '{}' on the command line", value, key); }
+        }
+    }
+
     std::vector<std::string> Liara_SettingsManager::GetAllSettingNames() const {
         const std::shared_lock lock(m_Mutex);
         std::vector<std::string> names;
@@ -141,6 +245,9 @@ namespace Liara::Core
             }
         }
 
+        // The command line has the last word over the settings files
+        ApplyCommandLineArguments(true);
+
         return true;
     }
 
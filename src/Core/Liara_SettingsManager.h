@@ -184,7 +184,20 @@ namespace Liara::Core
         bool SaveToFile(const std::string& filename, bool overwrite = true) const;
         bool LoadFromFile(const std::string& filename);
 
+        /**
+         * @brief Stores the command line arguments, applied over the defaults and over the loaded settings files.
+         * Arguments are "--name=value", with values in the settings file syntax, or "--name" for a boolean set to true.
+         * Must be called before the settings manager is created.
+         */
+        static void SetCommandLineArguments(int argc, const char* const* argv);
+
     private:
+        /**
+         * @brief Applies the stored command line arguments to the registered settings.
+         * @param reportUnknown Whether to warn about arguments naming no registered setting.
+         */
+        void ApplyCommandLineArguments(bool reportUnknown);
+
         template <typename Entry>
         bool SerializeFastEntry(std::ofstream& file, const std::string& name, const Entry& entry) const;
         static bool
@@ -199,6 +212,8 @@ namespace Liara::Core
 
         mutable std::shared_mutex m_Mutex;
         std::unordered_map<std::string, Liara_SettingStorage> m_Settings;
+
+        static std::vector<std::string> commandLineArguments;
     };
 }
 
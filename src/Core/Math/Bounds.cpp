@@ -0,0 +1,55 @@
+#include "Bounds.h"
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float3.hpp"
+#include "glm/geometric.hpp"
+
+namespace Liara::Core::Math
+{
+    Bounds ComputeBounds(const std::span<const glm::vec3> points) {
+        Bounds bounds;
+        if (points.empty()) { return bounds; }
+
+        bounds.box.min = points.front();
+        bounds.box.max = points.front();
+        for (const auto& point : points) {
+            bounds.box.min = glm::min(bounds.box.min, point);
+            bounds.box.max = glm::max(bounds.box.max, point);
+        }
+
+        // Centered on the box, the radius is the farthest point: tighter than the half diagonal for round meshes
+        bounds.sphere.center = bounds.box.GetCenter();
+        float radiusSquared = 0.0f;
+        for (const auto& point : points) {
+            const glm::vec3 offset = point - bounds.sphere.center;
+            radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+        }
+        bounds.sphere.radius = std::sqrt(radiusSquared);
+        return bounds;
+    }
+
+    AABB TransformAABB(const AABB& box, const glm::mat4& matrix) {
+        const glm::vec3 center = glm::vec3(matrix * glm::vec4(box.GetCenter(), 1.0f));
+        const glm::vec3 extents = box.GetExtents();
+
+        glm::vec3 newExtents{0.0f};
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                newExtents[row] += std::abs(matrix[column][row]) * extents[column];
+            }
+        }
+        return {.min = center - newExtents, .max = center + newExtents};
+    }
+
+    BoundingSphere TransformSphere(const BoundingSphere& sphere, const glm::mat4& matrix) {
+        const float scaleSquared = std::max({glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])),
+                                             glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1])),
+                                             glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2]))});
+        return {.center = glm::vec3(matrix * glm::vec4(sphere.center, 1.0f)),
+                .radius = sphere.radius * std::sqrt(scaleSquared)};
+    }
+}
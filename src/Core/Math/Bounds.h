@@ -0,0 +1,62 @@
+/**
+ * @file Bounds.h
+ * @brief Bounding volumes of meshes: an axis-aligned box and a sphere, both in the space of the vertices.
+ */
+
+#pragma once
+
+#include <span>
+
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float3.hpp"
+
+namespace Liara::Core::Math
+{
+    /**
+     * @struct AABB
+     * @brief Axis-aligned bounding box. An empty box has min > max.
+     */
+    struct AABB
+    {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+
+        [[nodiscard]] glm::vec3 GetCenter() const { return (min + max) * 0.5f; }
+        [[nodiscard]] glm::vec3 GetExtents() const { return (max - min) * 0.5f; }  ///< Half size on each axis
+    };
+
+    /**
+     * @struct BoundingSphere
+     */
+    struct BoundingSphere
+    {
+        glm::vec3 center{0.0f};
+        float radius = 0.0f;
+    };
+
+    /**
+     * @struct Bounds
+     * @brief Both volumes of a mesh: the sphere is the cheapest to test, the box the tightest.
+     */
+    struct Bounds
+    {
+        AABB box;
+        BoundingSphere sphere;
+    };
+
+    /**
+     * @brief Computes the box of the points, and a sphere centered on the box that contains every point.
+     * @return Zero-sized bounds at the origin if there are no points.
+     */
+    [[nodiscard]] Bounds ComputeBounds(std::span<const glm::vec3> points);
+
+    /**
+     * @brief Box containing the transformed box (Arvo's method, exact for affine matrices).
+     */
+    [[nodiscard]] AABB TransformAABB(const AABB& box, const glm::mat4& matrix);
+
+    /**
+     * @brief Sphere containing the transformed sphere, the radius is scaled by the largest axis scale of the matrix.
+     */
+    [[nodiscard]] BoundingSphere TransformSphere(const BoundingSphere& sphere, const glm::mat4& matrix);
+}
@@ -0,0 +1,150 @@
+#include "FrustumCulling.h"
+
+#include "Core/Logging/LogMacros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float3.hpp"
+#include "glm/ext/vector_float4.hpp"
+#include "glm/geometric.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LIARA_FRUSTUM_CULLING_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+namespace Liara::Core::Math
+{
+    namespace
+    {
+        glm::vec4 GetRow(const glm::mat4& matrix, const int row) {
+            return {matrix[0][row], matrix[1][row], matrix[2][row], matrix[3][row]};
+        }
+
+        glm::vec4 NormalizePlane(const glm::vec4& plane) { return plane / glm::length(glm::vec3(plane)); }
+
+        size_t CullSpheresScalar(const Frustum& frustum,
+                                 const SphereBatch& spheres,
+                                 const std::span<uint8_t> visible,
+                                 const size_t first) {
+            size_t visibleCount = 0;
+            for (size_t i = first; i < visible.size(); ++i) {
+                const BoundingSphere sphere{.center = {spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i]},
+                                            .radius = spheres.radius[i]};
+                visible[i] = frustum.IsSphereVisible(sphere) ? 1 : 0;
+                visibleCount += visible[i];
+            }
+            return visibleCount;
+        }
+
+#if defined(LIARA_FRUSTUM_CULLING_SSE2)
+        size_t CullSpheresSse2(const Frustum& frustum, const SphereBatch& spheres, const std::span<uint8_t> visible) {
+            // Every plane component broadcast once, instead of once per group of spheres
+            __m128 planeX[6];
+            __m128 planeY[6];
+            __m128 planeZ[6];
+            __m128 planeD[6];
+            for (size_t p = 0; p < 6; ++p) {
+                planeX[p] = _mm_set1_ps(frustum.planes[p].x);
+                planeY[p] = _mm_set1_ps(frustum.planes[p].y);
+                planeZ[p] = _mm_set1_ps(frustum.planes[p].z);
+                planeD[p] = _mm_set1_ps(frustum.planes[p].w);
+            }
+
+            const size_t count = visible.size();
+            const size_t simdCount = count - (count % 4);
+            size_t visibleCount = 0;
+            for (size_t i = 0; i < simdCount; i += 4) {
+                const __m128 x = _mm_loadu_ps(spheres.centerX.data() + i);
+                const __m128 y = _mm_loadu_ps(spheres.centerY.data() + i);
+                const __m128 z = _mm_loadu_ps(spheres.centerZ.data() + i);
+                const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radius.data() + i));
+
+                __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (size_t p = 0; p < 6; ++p) {
+                    const __m128 distance = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y)),
+                        _mm_add_ps(_mm_mul_ps(planeZ[p], z), planeD[p]));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+                }
+
+                const int mask = _mm_movemask_ps(inside);
+                for (size_t lane = 0; lane < 4; ++lane) {
+                    visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+                    visibleCount += visible[i + lane];
+                }
+            }
+            return visibleCount + CullSpheresScalar(frustum, spheres, visible, simdCount);
+        }
+#endif
+    }
+
+    Frustum Frustum::FromMatrix(const glm::mat4& viewProjection) {
+        const glm::vec4 row0 = GetRow(viewProjection, 0);
+        const glm::vec4 row1 = GetRow(viewProjection, 1);
+        const glm::vec4 row2 = GetRow(viewProjection, 2);
+        const glm::vec4 row3 = GetRow(viewProjection, 3);
+
+        // Clip space is -w <= x, y <= w and 0 <= z <= w
+        Frustum frustum;
+        frustum.planes[0] = NormalizePlane(row3 + row0);
+        frustum.planes[1] = NormalizePlane(row3 - row0);
+        frustum.planes[2] = NormalizePlane(row3 + row1);
+        frustum.planes[3] = NormalizePlane(row3 - row1);
+        frustum.planes[4] = NormalizePlane(row2);
+        frustum.planes[5] = NormalizePlane(row3 - row2);
+        return frustum;
+    }
+
+    bool Frustum::IsSphereVisible(const BoundingSphere& sphere) const {
+        for (const auto& plane : planes) {
+            if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius) { return false; }
+        }
+        return true;
+    }
+
+    bool Frustum::IsBoxVisible(const AABB& box) const {
+        for (const auto& plane : planes) {
+            // Corner of the box the farthest along the plane normal
+            const glm::vec3 corner{plane.x >= 0.0f ? box.max.x : box.min.x,
+                                   plane.y >= 0.0f ? box.max.y : box.min.y,
+                                   plane.z >= 0.0f ? box.max.z : box.min.z};
+            if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) { return false; }
+        }
+        return true;
+    }
+
+    Containment Frustum::ClassifyBox(const AABB& box) const {
+        Containment result = Containment::INSIDE;
+        for (const auto& plane : planes) {
+            // Corners of the box the farthest along and against the plane normal
+            const glm::vec3 positive{plane.x >= 0.0f ? box.max.x : box.min.x,
+                                     plane.y >= 0.0f ? box.max.y : box.min.y,
+                                     plane.z >= 0.0f ? box.max.z : box.min.z};
+            const glm::vec3 negative{plane.x >= 0.0f ? box.min.x : box.max.x,
+                                     plane.y >= 0.0f ? box.min.y : box.max.y,
+                                     plane.z >= 0.0f ? box.min.z : box.max.z};
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) { return Containment::OUTSIDE; }
+            if (glm::dot(glm::vec3(plane), negative) + plane.w < 0.0f) { result = Containment::INTERSECTS; }
+        }
+        return result;
+    }
+
+    size_t CullSpheres(const Frustum& frustum, const SphereBatch& spheres, const std::span<uint8_t> visible) {
+        const size_t count = visible.size();
+        LIARA_CHECK_ARGUMENT(spheres.centerX.size() == count && spheres.centerY.size() == count
+                                 && spheres.centerZ.size() == count && spheres.radius.size() == count,
+                             LogCore,
+                             "Sphere batch and visibility output must have the same size ({})",
+                             count);
+
+#if defined(LIARA_FRUSTUM_CULLING_SSE2)
+        return CullSpheresSse2(frustum, spheres, visible);
+#else
+        return CullSpheresScalar(frustum, spheres, visible, 0);
+#endif
+    }
+}
@@ -0,0 +1,73 @@
+/**
+ * @file FrustumCulling.h
+ * @brief View frustum extracted from the camera matrices, and batched sphere visibility tests against it.
+ *
+ * The spheres are tested 4 at a time with SSE2 on x86 (its baseline, no runtime dispatch needed),
+ * one at a time elsewhere. A sphere is visible unless it lies entirely behind one of the 6 planes:
+ * a few spheres near the frustum corners are kept although hidden, the test never culls a visible one.
+ */
+
+#pragma once
+
+#include "Core/Math/Bounds.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float3.hpp"
+#include "glm/ext/vector_float4.hpp"
+
+namespace Liara::Core::Math
+{
+    /**
+     * @brief Position of a volume relative to a frustum.
+     */
+    enum class Containment : uint8_t
+    {
+        OUTSIDE,     ///< Entirely outside
+        INTERSECTS,  ///< Crosses at least one plane
+        INSIDE,      ///< Entirely inside
+    };
+
+    /**
+     * @struct Frustum
+     * @brief The 6 planes of a view frustum, normals pointing inwards: a point p is inside when dot(n, p) + d >= 0.
+     */
+    struct Frustum
+    {
+        std::array<glm::vec4, 6> planes{};  ///< Left, right, bottom, top, near, far, as (normal, d)
+
+        /**
+         * @brief Extracts the planes from a projection * view matrix (Gribb-Hartmann), for a [0, 1] depth range.
+         * The planes are in world space, or in the space the matrix transforms from.
+         */
+        [[nodiscard]] static Frustum FromMatrix(const glm::mat4& viewProjection);
+
+        [[nodiscard]] bool IsSphereVisible(const BoundingSphere& sphere) const;
+        [[nodiscard]] bool IsBoxVisible(const AABB& box) const;
+        [[nodiscard]] Containment ClassifyBox(const AABB& box) const;
+    };
+
+    /**
+     * @struct SphereBatch
+     * @brief Spheres stored one component per array, so that consecutive spheres fill a SIMD register.
+     */
+    struct SphereBatch
+    {
+        std::span<const float> centerX;
+        std::span<const float> centerY;
+        std::span<const float> centerZ;
+        std::span<const float> radius;
+    };
+
+    /**
+     * @brief Tests every sphere of the batch against the frustum.
+     * @param visible Receives 1 for each visible sphere, 0 for each culled one.
+     * @return The number of visible spheres.
+     * @throws std::invalid_argument if the arrays of the batch or the output do not have the same size.
+     */
+    size_t CullSpheres(const Frustum& frustum, const SphereBatch& spheres, std::span<uint8_t> visible);
+}
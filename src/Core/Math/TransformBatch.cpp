@@ -0,0 +1,229 @@
+#include "TransformBatch.h"
+
+#include "Core/Components/TransformComponent3d.h"
+#include "Core/Logging/LogMacros.h"
+#include "Plateform/CpuFeatures.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+#include "glm/ext/matrix_float3x3.hpp"
+#include "glm/ext/matrix_float4x4.hpp"
+#include "TransformBatchKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LIARA_TRANSFORM_BATCH_SSE2 1
+    #include "TransformBatchSimd.tpp"
+#endif
+
+namespace Liara::Core::Math
+{
+    namespace Detail
+    {
+#if defined(LIARA_TRANSFORM_BATCH_SSE2)
+        namespace
+        {
+            struct Sse2Ops
+            {
+                using F = __m128;
+                using I = __m128i;
+                static constexpr size_t WIDTH = 4;
+
+                static F Set1(const float value) { return _mm_set1_ps(value); }
+                static I Set1I(const int value) { return _mm_set1_epi32(value); }
+                static F Load(const float* ptr) { return _mm_loadu_ps(ptr); }
+
+                static F Add(const F a, const F b) { return _mm_add_ps(a, b); }
+                static F Sub(const F a, const F b) { return _mm_sub_ps(a, b); }
+                static F Mul(const F a, const F b) { return _mm_mul_ps(a, b); }
+                static F Div(const F a, const F b) { return _mm_div_ps(a, b); }
+                static F And(const F a, const F b) { return _mm_and_ps(a, b); }
+                static F AndNot(const F a, const F b) { return _mm_andnot_ps(a, b); }
+                static F Xor(const F a, const F b) { return _mm_xor_ps(a, b); }
+                static F Select(const F mask, const F a, const F b) {
+                    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+                }
+
+                static I ToInt(const F a) { return _mm_cvttps_epi32(a); }
+                static F ToFloat(const I a) { return _mm_cvtepi32_ps(a); }
+                static F AsFloat(const I a) { return _mm_castsi128_ps(a); }
+                static I AddI(const I a, const I b) { return _mm_add_epi32(a, b); }
+                static I SubI(const I a, const I b) { return _mm_sub_epi32(a, b); }
+                static I AndI(const I a, const I b) { return _mm_and_si128(a, b); }
+                static I AndNotI(const I a, const I b) { return _mm_andnot_si128(a, b); }
+                static I CmpEqI(const I a, const I b) { return _mm_cmpeq_epi32(a, b); }
+                static I ShiftToSign(const I a) { return _mm_slli_epi32(a, 29); }
+
+                // Transposes the 16 lanes-of-4 into 4 consecutive column-major matrices
+                static void StoreMat4(float* out, const F (&m)[16]) {
+                    for (size_t column = 0; column < 4; ++column) {
+                        F r0 = m[column * 4 + 0];
+                        F r1 = m[column * 4 + 1];
+                        F r2 = m[column * 4 + 2];
+                        F r3 = m[column * 4 + 3];
+                        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                        _mm_storeu_ps(out + 0 * 16 + column * 4, r0);
+                        _mm_storeu_ps(out + 1 * 16 + column * 4, r1);
+                        _mm_storeu_ps(out + 2 * 16 + column * 4, r2);
+                        _mm_storeu_ps(out + 3 * 16 + column * 4, r3);
+                    }
+                }
+
+                static void StoreMat3(float* out, const F (&m)[9]) {
+                    const F zero = _mm_setzero_ps();
+                    for (size_t column = 0; column < 3; ++column) {
+                        F r0 = m[column * 3 + 0];
+                        F r1 = m[column * 3 + 1];
+                        F r2 = m[column * 3 + 2];
+                        F r3 = zero;
+                        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                        const F rows[4] = {r0, r1, r2, r3};
+                        for (size_t object = 0; object < 4; ++object) {
+                            float* dst = out + object * 9 + column * 3;
+                            _mm_storel_pi(reinterpret_cast<__m64*>(dst), rows[object]);
+                            _mm_store_ss(dst + 2, _mm_movehl_ps(rows[object], rows[object]));
+                        }
+                    }
+                }
+            };
+        }
+
+        void ComputeTransformsSse2(const TransformKernelArgs& args) { ComputeTransformsSimd<Sse2Ops>(args); }
+#else
+        void ComputeTransformsSse2(const TransformKernelArgs& args) { ComputeTransformsScalar(args); }
+#endif
+
+        void ComputeTransformsScalar(const TransformKernelArgs& args, const size_t first) {
+            for (size_t i = first; i < args.count; ++i) {
+                const float c3 = std::cos(args.rotationZ[i]);
+                const float s3 = std::sin(args.rotationZ[i]);
+                const float c2 = std::cos(args.rotationX[i]);
+                const float s2 = std::sin(args.rotationX[i]);
+                const float c1 = std::cos(args.rotationY[i]);
+                const float s1 = std::sin(args.rotationY[i]);
+
+                const float rotation[9] = {c1 * c3 + s1 * s2 * s3,
+                                           c2 * s3,
+                                           c1 * s2 * s3 - c3 * s1,
+                                           c3 * s1 * s2 - c1 * s3,
+                                           c2 * c3,
+                                           c1 * c3 * s2 + s1 * s3,
+                                           c2 * s1,
+                                           -s2,
+                                           c1 * c2};
+                const float scale[3] = {args.scaleX[i], args.scaleY[i], args.scaleZ[i]};
+
+                float* model = args.models + i * 16;
+                for (size_t column = 0; column < 3; ++column) {
+                    for (size_t row = 0; row < 3; ++row) {
+                        model[column * 4 + row] = scale[column] * rotation[column * 3 + row];
+                    }
+                    model[column * 4 + 3] = 0.0F;
+                }
+                model[12] = args.positionX[i];
+                model[13] = args.positionY[i];
+                model[14] = args.positionZ[i];
+                model[15] = 1.0F;
+
+                if (args.normals != nullptr) {
+                    float* normal = args.normals + i * 9;
+                    for (size_t column = 0; column < 3; ++column) {
+                        const float invScale = 1.0F / scale[column];
+                        for (size_t row = 0; row < 3; ++row) {
+                            normal[column * 3 + row] = invScale * rotation[column * 3 + row];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void TransformSoA::Reserve(const size_t capacity) {
+        for (auto* array :
+             {&positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &scaleX, &scaleY, &scaleZ}) {
+            array->reserve(capacity);
+        }
+    }
+
+    void TransformSoA::Clear() {
+        for (auto* array :
+             {&positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &scaleX, &scaleY, &scaleZ}) {
+            array->clear();
+        }
+    }
+
+    void TransformSoA::PushBack(const Component::TransformComponent3d& transform) {
+        positionX.push_back(transform.position.x);
+        positionY.push_back(transform.position.y);
+        positionZ.push_back(transform.position.z);
+        rotationX.push_back(transform.rotation.x);
+        rotationY.push_back(transform.rotation.y);
+        rotationZ.push_back(transform.rotation.z);
+        scaleX.push_back(transform.scale.x);
+        scaleY.push_back(transform.scale.y);
+        scaleZ.push_back(transform.scale.z);
+    }
+
+    namespace
+    {
+        void ComputeRange(const TransformSoA& transforms,
+                          const size_t first,
+                          const size_t count,
+                          const std::span<glm::mat4> models,
+                          const std::span<glm::mat3> normals,
+                          const Plateform::SimdLevel level) {
+            LIARA_CHECK_ARGUMENT(first + count <= transforms.Size(), LogCore, "Transform range is out of the batch");
+            LIARA_CHECK_ARGUMENT(
+                models.size() >= first + count, LogCore, "Model matrix output is too small for the batch");
+            LIARA_CHECK_ARGUMENT(normals.empty() || normals.size() >= first + count,
+                                 LogCore,
+                                 "Normal matrix output is too small for the batch");
+            if (count == 0) { return; }
+
+            // The kernels index from 0, offset every array to the start of the range
+            const Detail::TransformKernelArgs args{
+                .positionX = transforms.positionX.data() + first,
+                .positionY = transforms.positionY.data() + first,
+                .positionZ = transforms.positionZ.data() + first,
+                .rotationX = transforms.rotationX.data() + first,
+                .rotationY = transforms.rotationY.data() + first,
+                .rotationZ = transforms.rotationZ.data() + first,
+                .scaleX = transforms.scaleX.data() + first,
+                .scaleY = transforms.scaleY.data() + first,
+                .scaleZ = transforms.scaleZ.data() + first,
+                .models = &models[first][0][0],
+                .normals = normals.empty() ? nullptr : &normals[first][0][0],
+                .count = count,
+            };
+
+            switch (std::min(level, Plateform::GetSimdLevel())) {
+                case Plateform::SimdLevel::AVX2: Detail::ComputeTransformsAvx2(args); break;
+                case Plateform::SimdLevel::SSE2: Detail::ComputeTransformsSse2(args); break;
+                case Plateform::SimdLevel::SCALAR: Detail::ComputeTransformsScalar(args); break;
+            }
+        }
+    }
+
+    void ComputeTransformMatrices(const TransformSoA& transforms,
+                                  const std::span<glm::mat4> models,
+                                  const std::span<glm::mat3> normals) {
+        ComputeRange(transforms, 0, transforms.Size(), models, normals, Plateform::GetSimdLevel());
+    }
+
+    void ComputeTransformMatrixRange(const TransformSoA& transforms,
+                                     const size_t first,
+                                     const size_t count,
+                                     const std::span<glm::mat4> models,
+                                     const std::span<glm::mat3> normals) {
+        ComputeRange(transforms, first, count, models, normals, Plateform::GetSimdLevel());
+    }
+
+    void ComputeTransformMatrices(const TransformSoA& transforms,
+                                  const std::span<glm::mat4> models,
+                                  const std::span<glm::mat3> normals,
+                                  const Plateform::SimdLevel level) {
+        ComputeRange(transforms, 0, transforms.Size(), models, normals, level);
+    }
+}
@@ -0,0 +1,74 @@
+/**
+ * @file TransformBatch.h
+ * @brief Batched computation of model and normal matrices from a structure-of-arrays transform layout.
+ *
+ * The batch produces the same matrices as `TransformComponent3d::GetMat4` and `GetNormalMatrix`,
+ * but processes 4 (SSE2) or 8 (AVX2) objects per instruction, with a vectorized sine/cosine.
+ * The instruction set is selected at runtime from the CPU features.
+ */
+
+#pragma once
+
+#include "Core/Components/TransformComponent3d.h"
+#include "Plateform/CpuFeatures.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "glm/ext/matrix_float3x3.hpp"
+#include "glm/ext/matrix_float4x4.hpp"
+
+namespace Liara::Core::Math
+{
+    static_assert(sizeof(glm::mat4) == 16 * sizeof(float), "The kernels write glm::mat4 as 16 packed floats");
+    static_assert(sizeof(glm::mat3) == 9 * sizeof(float), "The kernels write glm::mat3 as 9 packed floats");
+
+    /**
+     * @struct TransformSoA
+     * @brief Transforms stored one component per array, so that consecutive objects fill a SIMD register.
+     */
+    struct TransformSoA
+    {
+        std::vector<float> positionX, positionY, positionZ;
+        std::vector<float> rotationX, rotationY, rotationZ;
+        std::vector<float> scaleX, scaleY, scaleZ;
+
+        [[nodiscard]] size_t Size() const { return positionX.size(); }
+        [[nodiscard]] bool Empty() const { return positionX.empty(); }
+
+        void Reserve(size_t capacity);
+        void Clear();
+        void PushBack(const Component::TransformComponent3d& transform);
+    };
+
+    /**
+     * @brief Computes the model matrix, and optionally the normal matrix, of every transform of the batch.
+     * @param transforms The transforms, in structure-of-arrays layout.
+     * @param models Receives one model matrix per transform.
+     * @param normals Receives one normal matrix per transform, may be empty to skip them.
+     * @throws std::invalid_argument if an output span is smaller than the batch.
+     */
+    void ComputeTransformMatrices(const TransformSoA& transforms,
+                                  std::span<glm::mat4> models,
+                                  std::span<glm::mat3> normals = {});
+
+    /**
+     * @brief Computes the matrices of the transforms [first, first + count) only, so that a batch can be split in jobs.
+     * The output spans cover the whole batch, matrices outside of the range are left untouched.
+     */
+    void ComputeTransformMatrixRange(const TransformSoA& transforms,
+                                     size_t first,
+                                     size_t count,
+                                     std::span<glm::mat4> models,
+                                     std::span<glm::mat3> normals = {});
+
+    /**
+     * @brief Same as ComputeTransformMatrices, with an explicit instruction set, mainly for benchmarks and comparisons.
+     * The level is clamped to the one supported by the CPU.
+     */
+    void ComputeTransformMatrices(const TransformSoA& transforms,
+                                  std::span<glm::mat4> models,
+                                  std::span<glm::mat3> normals,
+                                  Plateform::SimdLevel level);
+}
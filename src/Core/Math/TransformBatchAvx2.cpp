@@ -0,0 +1,98 @@
+/**
+ * AVX2 transform batch kernel.
+ * This translation unit is compiled with AVX2 and FMA enabled, it must only be called after a runtime check.
+ */
+
+#include <cstddef>
+
+#include "TransformBatchKernels.h"
+
+#if defined(__AVX2__)
+    #include "TransformBatchSimd.tpp"
+
+namespace Liara::Core::Math::Detail
+{
+    namespace
+    {
+        struct Avx2Ops
+        {
+            using F = __m256;
+            using I = __m256i;
+            static constexpr size_t WIDTH = 8;
+
+            static F Set1(const float value) { return _mm256_set1_ps(value); }
+            static I Set1I(const int value) { return _mm256_set1_epi32(value); }
+            static F Load(const float* ptr) { return _mm256_loadu_ps(ptr); }
+
+            static F Add(const F a, const F b) { return _mm256_add_ps(a, b); }
+            static F Sub(const F a, const F b) { return _mm256_sub_ps(a, b); }
+            static F Mul(const F a, const F b) { return _mm256_mul_ps(a, b); }
+            static F Div(const F a, const F b) { return _mm256_div_ps(a, b); }
+            static F And(const F a, const F b) { return _mm256_and_ps(a, b); }
+            static F AndNot(const F a, const F b) { return _mm256_andnot_ps(a, b); }
+            static F Xor(const F a, const F b) { return _mm256_xor_ps(a, b); }
+            static F Select(const F mask, const F a, const F b) { return _mm256_blendv_ps(b, a, mask); }
+
+            static I ToInt(const F a) { return _mm256_cvttps_epi32(a); }
+            static F ToFloat(const I a) { return _mm256_cvtepi32_ps(a); }
+            static F AsFloat(const I a) { return _mm256_castsi256_ps(a); }
+            static I AddI(const I a, const I b) { return _mm256_add_epi32(a, b); }
+            static I SubI(const I a, const I b) { return _mm256_sub_epi32(a, b); }
+            static I AndI(const I a, const I b) { return _mm256_and_si256(a, b); }
+            static I AndNotI(const I a, const I b) { return _mm256_andnot_si256(a, b); }
+            static I CmpEqI(const I a, const I b) { return _mm256_cmpeq_epi32(a, b); }
+            static I ShiftToSign(const I a) { return _mm256_slli_epi32(a, 29); }
+
+            /**
+             * Transposes 4 registers of 8 lanes: the low 128 bits hold one column of objects 0-3,
+             * the high 128 bits the same column of objects 4-7.
+             */
+            static void Transpose(F& r0, F& r1, F& r2, F& r3) {
+                const F t0 = _mm256_unpacklo_ps(r0, r1);
+                const F t1 = _mm256_unpackhi_ps(r0, r1);
+                const F t2 = _mm256_unpacklo_ps(r2, r3);
+                const F t3 = _mm256_unpackhi_ps(r2, r3);
+                r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+                r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+                r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+                r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            }
+
+            static void StoreMat4(float* out, const F (&m)[16]) {
+                for (size_t column = 0; column < 4; ++column) {
+                    F rows[4] = {m[column * 4 + 0], m[column * 4 + 1], m[column * 4 + 2], m[column * 4 + 3]};
+                    Transpose(rows[0], rows[1], rows[2], rows[3]);
+                    for (size_t object = 0; object < 4; ++object) {
+                        _mm_storeu_ps(out + object * 16 + column * 4, _mm256_castps256_ps128(rows[object]));
+                        _mm_storeu_ps(out + (object + 4) * 16 + column * 4, _mm256_extractf128_ps(rows[object], 1));
+                    }
+                }
+            }
+
+            static void StoreMat3(float* out, const F (&m)[9]) {
+                for (size_t column = 0; column < 3; ++column) {
+                    F rows[4] = {m[column * 3 + 0], m[column * 3 + 1], m[column * 3 + 2], _mm256_setzero_ps()};
+                    Transpose(rows[0], rows[1], rows[2], rows[3]);
+                    for (size_t object = 0; object < 4; ++object) {
+                        StoreVec3(out + object * 9 + column * 3, _mm256_castps256_ps128(rows[object]));
+                        StoreVec3(out + (object + 4) * 9 + column * 3, _mm256_extractf128_ps(rows[object], 1));
+                    }
+                }
+            }
+
+            static void StoreVec3(float* out, const __m128 value) {
+                _mm_storel_pi(reinterpret_cast<__m64*>(out), value);
+                _mm_store_ss(out + 2, _mm_movehl_ps(value, value));
+            }
+        };
+    }
+
+    void ComputeTransformsAvx2(const TransformKernelArgs& args) { ComputeTransformsSimd<Avx2Ops>(args); }
+}
+#else
+namespace Liara::Core::Math::Detail
+{
+    // Compiler without AVX2 support, or non-x86 target: the dispatcher never selects this level there
+    void ComputeTransformsAvx2(const TransformKernelArgs& args) { ComputeTransformsSse2(args); }
+}
+#endif
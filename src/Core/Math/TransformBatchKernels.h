@@ -0,0 +1,39 @@
+/**
+ * @file TransformBatchKernels.h
+ * @brief Internal interface between the transform batch dispatcher and its per-instruction-set kernels.
+ *
+ * The kernels are compiled in separate translation units with their own instruction set flags,
+ * so this header must stay free of inline functions (no glm, no standard containers).
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace Liara::Core::Math::Detail
+{
+    struct TransformKernelArgs
+    {
+        const float* positionX;
+        const float* positionY;
+        const float* positionZ;
+        const float* rotationX;
+        const float* rotationY;
+        const float* rotationZ;
+        const float* scaleX;
+        const float* scaleY;
+        const float* scaleZ;
+
+        float* models;   ///< 16 floats per object, column-major
+        float* normals;  ///< 9 floats per object, column-major, may be null
+        size_t count;
+    };
+
+    /**
+     * @brief Computes the matrices of the objects [first, count) one at a time.
+     */
+    void ComputeTransformsScalar(const TransformKernelArgs& args, size_t first = 0);
+
+    void ComputeTransformsSse2(const TransformKernelArgs& args);
+    void ComputeTransformsAvx2(const TransformKernelArgs& args);
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+/**
+ * SIMD implementation of the transform batch kernel, shared by the SSE2 and AVX2 translation units.
+ * Ops wraps the intrinsics of one instruction set, every lane of a vector is a different object.
+ * Everything lives in an anonymous namespace so that each translation unit keeps its own copy,
+ * compiled with its own instruction set flags.
+ */
+
+#include <cstddef>
+#include <immintrin.h>
+
+#include "TransformBatchKernels.h"
+
+namespace Liara::Core::Math::Detail
+{
+    namespace
+    {
+        /**
+         * Computes sin(x) and cos(x) for every lane, following the Cephes single precision implementation:
+         * range reduction to [-pi/4, pi/4] with an extended precision pi/4, then a minimax polynomial.
+         * The error stays under 1e-6 for |x| < 8192.
+         */
+        template <typename Ops>
+        inline void SinCos(typename Ops::F x, typename Ops::F& sinOut, typename Ops::F& cosOut) {
+            using F = typename Ops::F;
+            using I = typename Ops::I;
+
+            const F signMask = Ops::AsFloat(Ops::Set1I(static_cast<int>(0x80000000u)));
+            F sinSign = Ops::And(x, signMask);
+            x = Ops::AndNot(signMask, x);
+
+            // Octant of x, rounded up to an even number
+            I octant = Ops::ToInt(Ops::Mul(x, Ops::Set1(1.27323954473516f)));  // 4 / pi
+            octant = Ops::AndI(Ops::AddI(octant, Ops::Set1I(1)), Ops::Set1I(~1));
+            const F y = Ops::ToFloat(octant);
+
+            const F sinSwap = Ops::AsFloat(Ops::ShiftToSign(Ops::AndI(octant, Ops::Set1I(4))));
+            const F cosSign =
+                Ops::AsFloat(Ops::ShiftToSign(Ops::AndNotI(Ops::SubI(octant, Ops::Set1I(2)), Ops::Set1I(4))));
+            const F polyMask = Ops::AsFloat(Ops::CmpEqI(Ops::AndI(octant, Ops::Set1I(2)), Ops::Set1I(0)));
+            sinSign = Ops::Xor(sinSign, sinSwap);
+
+            // x - y * pi / 4, with pi / 4 split in three parts to keep the precision
+            x = Ops::Sub(x, Ops::Mul(y, Ops::Set1(0.78515625f)));
+            x = Ops::Sub(x, Ops::Mul(y, Ops::Set1(2.4187564849853515625e-4f)));
+            x = Ops::Sub(x, Ops::Mul(y, Ops::Set1(3.77489497744594108e-8f)));
+            const F z = Ops::Mul(x, x);
+
+            F cosPoly = Ops::Set1(2.443315711809948e-5f);
+            cosPoly = Ops::Add(Ops::Mul(cosPoly, z), Ops::Set1(-1.388731625493765e-3f));
+            cosPoly = Ops::Add(Ops::Mul(cosPoly, z), Ops::Set1(4.166664568298827e-2f));
+            cosPoly = Ops::Mul(Ops::Mul(cosPoly, z), z);
+            cosPoly = Ops::Sub(cosPoly, Ops::Mul(z, Ops::Set1(0.5f)));
+            cosPoly = Ops::Add(cosPoly, Ops::Set1(1.0f));
+
+            F sinPoly = Ops::Set1(-1.9515295891e-4f);
+            sinPoly = Ops::Add(Ops::Mul(sinPoly, z), Ops::Set1(8.3321608736e-3f));
+            sinPoly = Ops::Add(Ops::Mul(sinPoly, z), Ops::Set1(-1.6666654611e-1f));
+            sinPoly = Ops::Add(Ops::Mul(Ops::Mul(sinPoly, z), x), x);
+
+            sinOut = Ops::Xor(Ops::Select(polyMask, sinPoly, cosPoly), sinSign);
+            cosOut = Ops::Xor(Ops::Select(polyMask, cosPoly, sinPoly), cosSign);
+        }
+
+        /**
+         * Same formulas as TransformComponent3d::GetMat4 and GetNormalMatrix (Translate * Ry * Rx * Rz * Scale).
+         */
+        template <typename Ops> void ComputeTransformsSimd(const TransformKernelArgs& args) {
+            using F = typename Ops::F;
+            constexpr size_t WIDTH = Ops::WIDTH;
+
+            const F zero = Ops::Set1(0.0f);
+            const F one = Ops::Set1(1.0f);
+
+            size_t i = 0;
+            for (; i + WIDTH <= args.count; i += WIDTH) {
+                F s1, c1, s2, c2, s3, c3;
+                SinCos<Ops>(Ops::Load(args.rotationY + i), s1, c1);
+                SinCos<Ops>(Ops::Load(args.rotationX + i), s2, c2);
+                SinCos<Ops>(Ops::Load(args.rotationZ + i), s3, c3);
+
+                const F s2s3 = Ops::Mul(s2, s3);
+                const F c3s2 = Ops::Mul(c3, s2);
+                const F rotation[9] = {
+                    Ops::Add(Ops::Mul(c1, c3), Ops::Mul(s1, s2s3)),
+                    Ops::Mul(c2, s3),
+                    Ops::Sub(Ops::Mul(c1, s2s3), Ops::Mul(c3, s1)),
+                    Ops::Sub(Ops::Mul(c3s2, s1), Ops::Mul(c1, s3)),
+                    Ops::Mul(c2, c3),
+                    Ops::Add(Ops::Mul(c1, c3s2), Ops::Mul(s1, s3)),
+                    Ops::Mul(c2, s1),
+                    Ops::Sub(zero, s2),
+                    Ops::Mul(c1, c2),
+                };
+
+                const F scale[3] = {
+                    Ops::Load(args.scaleX + i), Ops::Load(args.scaleY + i), Ops::Load(args.scaleZ + i)};
+
+                F model[16];
+                for (size_t column = 0; column < 3; ++column) {
+                    for (size_t row = 0; row < 3; ++row) {
+                        model[column * 4 + row] = Ops::Mul(scale[column], rotation[column * 3 + row]);
+                    }
+                    model[column * 4 + 3] = zero;
+                }
+                model[12] = Ops::Load(args.positionX + i);
+                model[13] = Ops::Load(args.positionY + i);
+                model[14] = Ops::Load(args.positionZ + i);
+                model[15] = one;
+                Ops::StoreMat4(args.models + i * 16, model);
+
+                if (args.normals != nullptr) {
+                    F normal[9];
+                    for (size_t column = 0; column < 3; ++column) {
+                        const F invScale = Ops::Div(one, scale[column]);
+                        for (size_t row = 0; row < 3; ++row) {
+                            normal[column * 3 + row] = Ops::Mul(invScale, rotation[column * 3 + row]);
+                        }
+                    }
+                    Ops::StoreMat3(args.normals + i * 9, normal);
+                }
+            }
+
+            ComputeTransformsScalar(args, i);
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#include "Liara_FrameAllocator.h"
+
+#include "Core/Logging/LogMacros.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace Liara::Core::Memory
+{
+    namespace
+    {
+        uintptr_t AlignUp(const uintptr_t address, const size_t alignment) {
+            return (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        }
+    }
+
+    Liara_LinearArena::Liara_LinearArena(const size_t capacity)
+        : m_Block(std::make_unique_for_overwrite<std::byte[]>(capacity))
+        , m_Capacity(capacity) {}
+
+    void* Liara_LinearArena::Allocate(const size_t size, const size_t alignment) {
+        LIARA_CHECK_ARGUMENT(std::has_single_bit(alignment), LogCore, "Alignment {} is not a power of two", alignment);
+
+        const auto base = reinterpret_cast<uintptr_t>(m_Block.get());
+        size_t offset = m_Offset.load(std::memory_order_relaxed);
+        while (true) {
+            const size_t begin = AlignUp(base + offset, alignment) - base;
+            if (begin > m_Capacity || size > m_Capacity - begin) { return AllocateOverflow(size, alignment); }
+            if (m_Offset.compare_exchange_weak(offset, begin + size, std::memory_order_relaxed)) {
+                return m_Block.get() + begin;
+            }
+        }
+    }
+
+    void* Liara_LinearArena::AllocateOverflow(const size_t size, const size_t alignment) {
+        const std::scoped_lock lock(m_OverflowMutex);
+        auto& block = m_OverflowBlocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(size + alignment));
+        m_OverflowBytes += size + alignment;
+
+        const auto address = reinterpret_cast<uintptr_t>(block.get());
+        return block.get() + (AlignUp(address, alignment) - address);
+    }
+
+    void Liara_LinearArena::Reset() {
+        const std::scoped_lock lock(m_OverflowMutex);
+        const size_t used = m_Offset.load(std::memory_order_relaxed) + m_OverflowBytes;
+        m_HighWaterMark = std::max(m_HighWaterMark, used);
+
+        if (!m_OverflowBlocks.empty()) {
+            // Grow once to hold a whole frame, instead of paying the heap fallback every frame from now on
+            const size_t capacity = std::bit_ceil(used);
+            LIARA_LOG_WARNING(LogCore,
+                              "Linear arena overflowed {} times ({} bytes used), growing from {} to {} bytes",
+                              m_OverflowBlocks.size(),
+                              used,
+                              m_Capacity,
+                              capacity);
+            m_Block = std::make_unique_for_overwrite<std::byte[]>(capacity);
+            m_Capacity = capacity;
+            m_OverflowBlocks.clear();
+            m_OverflowBytes = 0;
+        }
+
+        m_Offset.store(0, std::memory_order_relaxed);
+    }
+
+    ArenaStats Liara_LinearArena::GetStats() const {
+        const std::scoped_lock lock(m_OverflowMutex);
+        const size_t used = m_Offset.load(std::memory_order_relaxed) + m_OverflowBytes;
+        return {.capacity = m_Capacity,
+                .used = used,
+                .highWaterMark = std::max(m_HighWaterMark, used),
+                .overflowCount = m_OverflowBlocks.size()};
+    }
+
+    Liara_FrameAllocator::Liara_FrameAllocator(const uint32_t frameCount, const size_t capacityPerFrame) {
+        LIARA_CHECK_ARGUMENT(frameCount > 0, LogCore, "A frame allocator needs at least one frame");
+
+        m_Arenas.reserve(frameCount);
+        for (uint32_t i = 0; i < frameCount; ++i) {
+            m_Arenas.push_back(std::make_unique<Liara_LinearArena>(capacityPerFrame));
+        }
+    }
+
+    void Liara_FrameAllocator::BeginFrame(const uint32_t frameIndex) {
+        LIARA_CHECK_ARGUMENT(frameIndex < m_Arenas.size(),
+                             LogCore,
+                             "Frame index {} out of range, {} frames in flight",
+                             frameIndex,
+                             m_Arenas.size());
+
+        m_CurrentFrame = frameIndex;
+        m_Arenas[frameIndex]->Reset();
+    }
+
+    ArenaStats Liara_FrameAllocator::GetStats() const {
+        ArenaStats stats = m_Arenas[m_CurrentFrame]->GetStats();
+        for (const auto& arena : m_Arenas) {
+            stats.highWaterMark = std::max(stats.highWaterMark, arena->GetStats().highWaterMark);
+        }
+        return stats;
+    }
+}
@@ -0,0 +1,169 @@
+/**
+ * @file Liara_FrameAllocator.h
+ * @brief Defines the linear arenas holding the transient data of a frame, and their STL allocator adapter.
+ *
+ * Allocating from an arena is a pointer bump, and nothing is freed individually: the whole arena is reset at once
+ * when its frame starts again. The frame allocator keeps one arena per frame in flight, so the scratch data of a frame
+ * (culling results, sort keys, command lists...) stays valid while the next frame is being built.
+ *
+ * Only trivially destructible data should live in an arena, destructors are never run.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace Liara::Core::Memory
+{
+    /**
+     * @struct ArenaStats
+     * @brief Usage of an arena, in bytes.
+     */
+    struct ArenaStats
+    {
+        size_t capacity = 0;       ///< Size of the main block
+        size_t used = 0;           ///< Bytes allocated since the last reset, overflow included
+        size_t highWaterMark = 0;  ///< Most bytes used between two resets
+        size_t overflowCount = 0;  ///< Allocations since the last reset that did not fit in the main block
+    };
+
+    /**
+     * @class Liara_LinearArena
+     * @brief Bump allocator over a single block, safe to allocate from several threads at once.
+     *
+     * An allocation that does not fit falls back to a dedicated heap allocation, so running out of space is slow
+     * but never fatal. On the next reset, the main block grows to hold everything that was allocated.
+     */
+    class Liara_LinearArena
+    {
+    public:
+        /**
+         * @param capacity Initial size of the main block, in bytes.
+         */
+        explicit Liara_LinearArena(size_t capacity);
+
+        Liara_LinearArena(const Liara_LinearArena&) = delete;
+        Liara_LinearArena& operator=(const Liara_LinearArena&) = delete;
+        Liara_LinearArena(Liara_LinearArena&&) = delete;
+        Liara_LinearArena& operator=(Liara_LinearArena&&) = delete;
+
+        /**
+         * @brief Allocates uninitialized memory, valid until the next Reset.
+         * @param size Size of the allocation, in bytes.
+         * @param alignment Alignment of the allocation, must be a power of two.
+         */
+        [[nodiscard]] void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Allocates an uninitialized array of count T.
+         */
+        template <typename T> [[nodiscard]] T* AllocateArray(size_t count);
+
+        /**
+         * @brief Frees every allocation at once. No allocation may be in progress on another thread.
+         */
+        void Reset();
+
+        [[nodiscard]] ArenaStats GetStats() const;
+        [[nodiscard]] size_t GetCapacity() const { return m_Capacity; }
+
+    private:
+        void* AllocateOverflow(size_t size, size_t alignment);
+
+        std::unique_ptr<std::byte[]> m_Block;
+        size_t m_Capacity = 0;
+        std::atomic<size_t> m_Offset{0};
+
+        mutable std::mutex m_OverflowMutex;
+        std::vector<std::unique_ptr<std::byte[]>> m_OverflowBlocks;  ///< Freed on reset
+        size_t m_OverflowBytes = 0;
+
+        size_t m_HighWaterMark = 0;
+    };
+
+    /**
+     * @class ArenaAllocator
+     * @brief STL allocator drawing from a linear arena, deallocate does nothing.
+     * Containers using it must not outlive the arena's next reset.
+     */
+    template <typename T> class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(Liara_LinearArena& arena) noexcept
+            : m_Arena(&arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+            : m_Arena(other.GetArena()) {}
+
+        [[nodiscard]] T* allocate(const size_t count) { return m_Arena->AllocateArray<T>(count); }
+        void deallocate(T*, size_t) noexcept {}
+
+        [[nodiscard]] Liara_LinearArena* GetArena() const noexcept { return m_Arena; }
+
+        template <typename U> bool operator==(const ArenaAllocator<U>& other) const noexcept {
+            return m_Arena == other.GetArena();
+        }
+
+    private:
+        Liara_LinearArena* m_Arena;
+    };
+
+    /**
+     * @brief Vector living in a frame arena: reserve it upfront, growing it leaves its old storage unused until reset.
+     */
+    template <typename T> using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+    /**
+     * @brief String living in a frame arena, for text built every frame.
+     */
+    using FrameString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+    /**
+     * @class Liara_FrameAllocator
+     * @brief One linear arena per frame in flight, the arena of a frame is reset when that frame starts again.
+     */
+    class Liara_FrameAllocator
+    {
+    public:
+        /**
+         * @param frameCount Number of frames in flight, one arena each.
+         * @param capacityPerFrame Initial size of each arena, in bytes.
+         */
+        Liara_FrameAllocator(uint32_t frameCount, size_t capacityPerFrame);
+
+        /**
+         * @brief Resets the arena of the frame and makes it the current one.
+         * @param frameIndex Index of the frame in flight, in [0, frameCount).
+         */
+        void BeginFrame(uint32_t frameIndex);
+
+        [[nodiscard]] Liara_LinearArena& GetArena() { return *m_Arenas[m_CurrentFrame]; }
+        [[nodiscard]] Liara_LinearArena& GetArena(const uint32_t frameIndex) { return *m_Arenas[frameIndex]; }
+        [[nodiscard]] uint32_t GetFrameCount() const { return static_cast<uint32_t>(m_Arenas.size()); }
+
+        /**
+         * @brief Stats of the current arena, with the high-water mark over all of them.
+         */
+        [[nodiscard]] ArenaStats GetStats() const;
+
+    private:
+        std::vector<std::unique_ptr<Liara_LinearArena>> m_Arenas;
+        uint32_t m_CurrentFrame = 0;
+    };
+
+    template <typename T> T* Liara_LinearArena::AllocateArray(const size_t count) {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) { throw std::bad_array_new_length(); }
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+}
@@ -0,0 +1,102 @@
+#include "Liara_FreeListAllocator.h"
+
+#include "Core/Logging/LogMacros.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Liara::Core::Memory
+{
+    Liara_FreeListAllocator::Liara_FreeListAllocator(const uint64_t capacity)
+        : m_Capacity(capacity) {
+        if (capacity > 0) { m_FreeRanges.emplace(0, capacity); }
+    }
+
+    std::optional<uint64_t>
+    Liara_FreeListAllocator::Allocate(const uint64_t size, const uint64_t alignment, const uint64_t limit) {
+        LIARA_CHECK_ARGUMENT(std::has_single_bit(alignment), LogCore, "Alignment {} is not a power of two", alignment);
+        if (size == 0) { return std::nullopt; }
+
+        // Smallest range the aligned allocation fits in, so that the large ones stay whole
+        auto best = m_FreeRanges.end();
+        uint64_t bestOffset = 0;
+        for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end() && it->first < limit; ++it) {
+            const auto [offset, rangeSize] = *it;
+            const uint64_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+            if (aligned + size > offset + rangeSize || aligned + size > limit) { continue; }
+            if (best == m_FreeRanges.end() || rangeSize < best->second) {
+                best = it;
+                bestOffset = aligned;
+                if (rangeSize == size) { break; }
+            }
+        }
+        if (best == m_FreeRanges.end()) { return std::nullopt; }
+
+        // What is left on each side of the allocation stays free
+        const auto [rangeOffset, rangeSize] = *best;
+        m_FreeRanges.erase(best);
+        if (bestOffset > rangeOffset) { m_FreeRanges.emplace(rangeOffset, bestOffset - rangeOffset); }
+        const uint64_t end = bestOffset + size;
+        if (end < rangeOffset + rangeSize) { m_FreeRanges.emplace(end, rangeOffset + rangeSize - end); }
+
+        m_Used += size;
+        ++m_AllocationCount;
+        return bestOffset;
+    }
+
+    void Liara_FreeListAllocator::Free(const uint64_t offset, const uint64_t size) {
+        LIARA_CHECK_ARGUMENT(
+            size > 0 && offset + size <= m_Capacity && m_AllocationCount > 0, LogCore, "Invalid range freed");
+
+        uint64_t start = offset;
+        uint64_t end = offset + size;
+        auto next = m_FreeRanges.lower_bound(offset);
+        LIARA_CHECK_ARGUMENT(next == m_FreeRanges.end() || next->first >= end, LogCore, "Range freed twice");
+
+        // Merges with the free range right before, and the one right after
+        if (next != m_FreeRanges.begin()) {
+            const auto previous = std::prev(next);
+            LIARA_CHECK_ARGUMENT(previous->first + previous->second <= start, LogCore, "Range freed twice");
+            if (previous->first + previous->second == start) {
+                start = previous->first;
+                m_FreeRanges.erase(previous);
+            }
+        }
+        if (next != m_FreeRanges.end() && next->first == end) {
+            end += next->second;
+            m_FreeRanges.erase(next);
+        }
+        m_FreeRanges.emplace(start, end - start);
+
+        m_Used -= size;
+        --m_AllocationCount;
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> Liara_FreeListAllocator::GetUsedRanges() const {
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+        uint64_t start = 0;
+        for (const auto& [offset, size] : m_FreeRanges) {
+            if (offset > start) { ranges.emplace_back(start, offset - start); }
+            start = offset + size;
+        }
+        if (start < m_Capacity) { ranges.emplace_back(start, m_Capacity - start); }
+        return ranges;
+    }
+
+    FreeListStats Liara_FreeListAllocator::GetStats() const {
+        FreeListStats stats{.capacity = m_Capacity,
+                            .used = m_Used,
+                            .freeRangeCount = m_FreeRanges.size(),
+                            .allocationCount = m_AllocationCount};
+        for (const auto& [offset, size] : m_FreeRanges) {
+            stats.largestFreeRange = std::max(stats.largestFreeRange, size);
+        }
+        return stats;
+    }
+}
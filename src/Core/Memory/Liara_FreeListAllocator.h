@@ -0,0 +1,72 @@
+/**
+ * @file Liara_FreeListAllocator.h
+ * @brief Defines the `Liara_FreeListAllocator` class, which hands out ranges of a fixed size space.
+ *
+ * The allocator only does the bookkeeping, in abstract units (bytes, vertices, indices...): the memory itself lives
+ * elsewhere, typically in a GPU buffer. Free ranges are kept sorted by offset, an allocation takes the smallest one it
+ * fits in, and a freed range merges with its free neighbours so that the space does not crumble over time.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Liara::Core::Memory
+{
+    /**
+     * @struct FreeListStats
+     * @brief Usage of a free-list allocator, in its units.
+     */
+    struct FreeListStats
+    {
+        uint64_t capacity = 0;
+        uint64_t used = 0;
+        uint64_t largestFreeRange = 0;  ///< Largest allocation that would succeed, without alignment
+        uint64_t freeRangeCount = 0;    ///< More ranges for the same free space means more fragmentation
+        uint64_t allocationCount = 0;
+    };
+
+    /**
+     * @class Liara_FreeListAllocator
+     * @brief Best-fit allocator of ranges in [0, capacity), merging freed neighbours. Not thread safe.
+     */
+    class Liara_FreeListAllocator
+    {
+    public:
+        explicit Liara_FreeListAllocator(uint64_t capacity);
+
+        /**
+         * @brief Reserves a range of size units.
+         * @param alignment Alignment of the offset, must be a power of two.
+         * @param limit The range must end at or before it, to move an allocation lower when compacting.
+         * @return Offset of the range, or nothing if no free range is large enough.
+         */
+        [[nodiscard]] std::optional<uint64_t>
+        Allocate(uint64_t size, uint64_t alignment = 1, uint64_t limit = std::numeric_limits<uint64_t>::max());
+
+        /**
+         * @brief Releases a range returned by Allocate, with the same size.
+         */
+        void Free(uint64_t offset, uint64_t size);
+
+        /**
+         * @brief Spans between the free ranges, as offset and size. Adjacent allocations come as a single span.
+         */
+        [[nodiscard]] std::vector<std::pair<uint64_t, uint64_t>> GetUsedRanges() const;
+
+        [[nodiscard]] FreeListStats GetStats() const;
+        [[nodiscard]] uint64_t GetCapacity() const { return m_Capacity; }
+        [[nodiscard]] bool IsEmpty() const { return m_AllocationCount == 0; }
+
+    private:
+        uint64_t m_Capacity;
+        uint64_t m_Used = 0;
+        uint64_t m_AllocationCount = 0;
+        std::map<uint64_t, uint64_t> m_FreeRanges;  ///< Size of each free range, by offset
+    };
+}
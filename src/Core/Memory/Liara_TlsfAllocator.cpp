@@ -0,0 +1,186 @@
+#include "Liara_TlsfAllocator.h"
+
+#include "Core/Logging/LogMacros.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <optional>
+
+namespace Liara::Core::Memory
+{
+    Liara_TlsfAllocator::Liara_TlsfAllocator(const uint64_t capacity)
+        : m_Capacity(capacity) {
+        m_FreeHeads.fill(NO_NODE);
+        if (capacity > 0) { InsertFree(CreateNode(0, capacity)); }
+    }
+
+    std::optional<Liara_TlsfAllocator::Allocation> Liara_TlsfAllocator::Allocate(const uint64_t size,
+                                                                                 const uint64_t alignment) {
+        LIARA_CHECK_ARGUMENT(std::has_single_bit(alignment), LogCore, "Alignment {} is not a power of two", alignment);
+        if (size == 0 || size > m_Capacity) { return std::nullopt; }
+
+        // Looking for size + alignment - 1 guarantees the aligned range fits, whatever the offset of the free one
+        const uint32_t index = FindFree(size + alignment - 1);
+        if (index == NO_NODE) { return std::nullopt; }
+        RemoveFree(index);
+
+        // The padding in front becomes a free range of its own. The range before is in use, or it would have merged
+        const uint64_t offset = m_Nodes[index].offset;
+        const uint64_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+        if (aligned > offset) {
+            const uint32_t padding = CreateNode(offset, aligned - offset);
+            m_Nodes[padding].prevPhysical = m_Nodes[index].prevPhysical;
+            m_Nodes[padding].nextPhysical = index;
+            if (m_Nodes[index].prevPhysical != NO_NODE) { m_Nodes[m_Nodes[index].prevPhysical].nextPhysical = padding; }
+            m_Nodes[index].prevPhysical = padding;
+            m_Nodes[index].offset = aligned;
+            m_Nodes[index].size -= aligned - offset;
+            InsertFree(padding);
+        }
+
+        // So does what is left after it
+        if (m_Nodes[index].size > size) {
+            const uint32_t rest = CreateNode(aligned + size, m_Nodes[index].size - size);
+            m_Nodes[rest].prevPhysical = index;
+            m_Nodes[rest].nextPhysical = m_Nodes[index].nextPhysical;
+            if (m_Nodes[index].nextPhysical != NO_NODE) { m_Nodes[m_Nodes[index].nextPhysical].prevPhysical = rest; }
+            m_Nodes[index].nextPhysical = rest;
+            m_Nodes[index].size = size;
+            InsertFree(rest);
+        }
+
+        m_Used += size;
+        ++m_AllocationCount;
+        return Allocation{.offset = aligned, .node = index};
+    }
+
+    void Liara_TlsfAllocator::Free(uint32_t node) {
+        LIARA_CHECK_ARGUMENT(node < m_Nodes.size() && !m_Nodes[node].free && m_Nodes[node].size > 0,
+                             LogCore,
+                             "Invalid node {} freed",
+                             node);
+        m_Used -= m_Nodes[node].size;
+        --m_AllocationCount;
+
+        // Merges with the free range right before, and the one right after
+        if (const uint32_t previous = m_Nodes[node].prevPhysical; previous != NO_NODE && m_Nodes[previous].free) {
+            RemoveFree(previous);
+            m_Nodes[previous].size += m_Nodes[node].size;
+            m_Nodes[previous].nextPhysical = m_Nodes[node].nextPhysical;
+            if (m_Nodes[node].nextPhysical != NO_NODE) { m_Nodes[m_Nodes[node].nextPhysical].prevPhysical = previous; }
+            ReleaseNode(node);
+            node = previous;
+        }
+        if (const uint32_t next = m_Nodes[node].nextPhysical; next != NO_NODE && m_Nodes[next].free) {
+            RemoveFree(next);
+            m_Nodes[node].size += m_Nodes[next].size;
+            m_Nodes[node].nextPhysical = m_Nodes[next].nextPhysical;
+            if (m_Nodes[next].nextPhysical != NO_NODE) { m_Nodes[m_Nodes[next].nextPhysical].prevPhysical = node; }
+            ReleaseNode(next);
+        }
+        InsertFree(node);
+    }
+
+    uint64_t Liara_TlsfAllocator::GetSize(const uint32_t node) const {
+        LIARA_CHECK_OUT_OF_RANGE(node < m_Nodes.size(), LogCore, "Node {} out of range", node);
+        return m_Nodes[node].size;
+    }
+
+    FreeListStats Liara_TlsfAllocator::GetStats() const {
+        FreeListStats stats{.capacity = m_Capacity,
+                            .used = m_Used,
+                            .freeRangeCount = m_FreeCount,
+                            .allocationCount = m_AllocationCount};
+
+        // The largest range is in the highest non-empty bucket
+        if (m_FirstLevelMap != 0) {
+            const auto first = static_cast<uint32_t>(std::bit_width(m_FirstLevelMap) - 1);
+            const auto second = static_cast<uint32_t>(std::bit_width(m_SecondLevelMaps[first]) - 1);
+            for (uint32_t node = m_FreeHeads[first * SL_COUNT + second]; node != NO_NODE;
+                 node = m_Nodes[node].nextFree) {
+                stats.largestFreeRange = std::max(stats.largestFreeRange, m_Nodes[node].size);
+            }
+        }
+        return stats;
+    }
+
+    Liara_TlsfAllocator::Bucket Liara_TlsfAllocator::Mapping(const uint64_t size) {
+        // Below SL_COUNT, one bucket per size
+        if (size < SL_COUNT) { return {.first = 0, .second = static_cast<uint32_t>(size)}; }
+        const auto msb = static_cast<uint32_t>(std::bit_width(size) - 1);
+        return {.first = msb - SL_BITS + 1, .second = static_cast<uint32_t>(size >> (msb - SL_BITS)) - SL_COUNT};
+    }
+
+    uint32_t Liara_TlsfAllocator::FindFree(uint64_t size) const {
+        // Rounded up to the next bucket boundary, so that any range of the bucket found is large enough
+        if (size >= SL_COUNT) {
+            const auto msb = static_cast<uint32_t>(std::bit_width(size) - 1);
+            size += (uint64_t{1} << (msb - SL_BITS)) - 1;
+        }
+        auto [first, second] = Mapping(size);
+
+        uint32_t secondMap = m_SecondLevelMaps[first] & (~0u << second);
+        if (secondMap == 0) {
+            const uint64_t firstMap = first + 1 < 64 ? m_FirstLevelMap & (~uint64_t{0} << (first + 1)) : 0;
+            if (firstMap == 0) { return NO_NODE; }
+            first = static_cast<uint32_t>(std::countr_zero(firstMap));
+            secondMap = m_SecondLevelMaps[first];
+        }
+        second = static_cast<uint32_t>(std::countr_zero(secondMap));
+        return m_FreeHeads[first * SL_COUNT + second];
+    }
+
+    uint32_t Liara_TlsfAllocator::CreateNode(const uint64_t offset, const uint64_t size) {
+        uint32_t index = 0;
+        if (!m_UnusedNodes.empty()) {
+            index = m_UnusedNodes.back();
+            m_UnusedNodes.pop_back();
+        }
+        else {
+            index = static_cast<uint32_t>(m_Nodes.size());
+            m_Nodes.emplace_back();
+        }
+        m_Nodes[index] = Node{.offset = offset, .size = size};
+        return index;
+    }
+
+    void Liara_TlsfAllocator::ReleaseNode(const uint32_t node) {
+        m_Nodes[node] = Node{};
+        m_UnusedNodes.push_back(node);
+    }
+
+    void Liara_TlsfAllocator::InsertFree(const uint32_t node) {
+        const auto [first, second] = Mapping(m_Nodes[node].size);
+        uint32_t& head = m_FreeHeads[first * SL_COUNT + second];
+
+        m_Nodes[node].free = true;
+        m_Nodes[node].prevFree = NO_NODE;
+        m_Nodes[node].nextFree = head;
+        if (head != NO_NODE) { m_Nodes[head].prevFree = node; }
+        head = node;
+
+        m_FirstLevelMap |= uint64_t{1} << first;
+        m_SecondLevelMaps[first] |= 1u << second;
+        ++m_FreeCount;
+    }
+
+    void Liara_TlsfAllocator::RemoveFree(const uint32_t node) {
+        const auto [first, second] = Mapping(m_Nodes[node].size);
+        uint32_t& head = m_FreeHeads[first * SL_COUNT + second];
+
+        Node& removed = m_Nodes[node];
+        if (removed.prevFree != NO_NODE) { m_Nodes[removed.prevFree].nextFree = removed.nextFree; }
+        else { head = removed.nextFree; }
+        if (removed.nextFree != NO_NODE) { m_Nodes[removed.nextFree].prevFree = removed.prevFree; }
+        removed.free = false;
+        removed.prevFree = NO_NODE;
+        removed.nextFree = NO_NODE;
+
+        if (head == NO_NODE) {
+            m_SecondLevelMaps[first] &= ~(1u << second);
+            if (m_SecondLevelMaps[first] == 0) { m_FirstLevelMap &= ~(uint64_t{1} << first); }
+        }
+        --m_FreeCount;
+    }
+}
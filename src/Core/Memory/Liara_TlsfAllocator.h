@@ -0,0 +1,108 @@
+/**
+ * @file Liara_TlsfAllocator.h
+ * @brief Defines the `Liara_TlsfAllocator` class, a two-level segregated fit allocator of ranges.
+ *
+ * Like the free-list allocator, it only does the bookkeeping of a fixed size space, here in bytes of a device memory
+ * block. Free ranges are sorted into buckets, one per power of two split in SL_COUNT linear steps, and two levels of
+ * bitmaps tell which buckets hold a range: finding a range that fits, splitting it and merging a freed one with its
+ * neighbours all take constant time, whatever the number of allocations in the block.
+ *
+ * An allocation is identified by a node, which also knows its size: the owner only has to keep the node around.
+ */
+
+#pragma once
+
+#include "Core/Memory/Liara_FreeListAllocator.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace Liara::Core::Memory
+{
+    /**
+     * @class Liara_TlsfAllocator
+     * @brief Constant time allocator of ranges in [0, capacity), merging freed neighbours. Not thread safe.
+     */
+    class Liara_TlsfAllocator
+    {
+    public:
+        static constexpr uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+
+        struct Allocation
+        {
+            uint64_t offset = 0;
+            uint32_t node = NO_NODE;  ///< To give back to Free
+        };
+
+        explicit Liara_TlsfAllocator(uint64_t capacity);
+
+        /**
+         * @brief Reserves a range of size units.
+         * @param alignment Alignment of the offset, must be a power of two.
+         * @return The range, or nothing if no free range is large enough.
+         */
+        [[nodiscard]] std::optional<Allocation> Allocate(uint64_t size, uint64_t alignment = 1);
+
+        /**
+         * @brief Releases the range of a node returned by Allocate.
+         */
+        void Free(uint32_t node);
+
+        [[nodiscard]] uint64_t GetSize(uint32_t node) const;
+        [[nodiscard]] FreeListStats GetStats() const;
+        [[nodiscard]] uint64_t GetCapacity() const { return m_Capacity; }
+        [[nodiscard]] bool IsEmpty() const { return m_AllocationCount == 0; }
+
+    private:
+        static constexpr uint32_t SL_BITS = 4;
+        static constexpr uint32_t SL_COUNT = 1u << SL_BITS;  ///< Linear steps per power of two
+        static constexpr uint32_t FL_COUNT = 64 - SL_BITS + 1;
+
+        struct Node
+        {
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            uint32_t prevPhysical = NO_NODE;  ///< Range right before in the space
+            uint32_t nextPhysical = NO_NODE;  ///< Range right after in the space
+            uint32_t prevFree = NO_NODE;      ///< Neighbours in the bucket, while free
+            uint32_t nextFree = NO_NODE;
+            bool free = false;
+        };
+
+        struct Bucket
+        {
+            uint32_t first;
+            uint32_t second;
+        };
+
+        /**
+         * @brief Bucket a free range of this size goes to.
+         */
+        static Bucket Mapping(uint64_t size);
+
+        /**
+         * @brief First free range of at least size, from the smallest bucket all of whose ranges are large enough.
+         */
+        [[nodiscard]] uint32_t FindFree(uint64_t size) const;
+
+        uint32_t CreateNode(uint64_t offset, uint64_t size);
+        void ReleaseNode(uint32_t node);
+        void InsertFree(uint32_t node);
+        void RemoveFree(uint32_t node);
+
+        uint64_t m_Capacity;
+        uint64_t m_Used = 0;
+        uint64_t m_AllocationCount = 0;
+        uint64_t m_FreeCount = 0;
+
+        std::vector<Node> m_Nodes;
+        std::vector<uint32_t> m_UnusedNodes;  ///< Released nodes, reused before growing m_Nodes
+
+        uint64_t m_FirstLevelMap = 0;                             ///< Bit per first level with a non-empty bucket
+        std::array<uint32_t, FL_COUNT> m_SecondLevelMaps{};       ///< Bit per non-empty bucket of each first level
+        std::array<uint32_t, FL_COUNT * SL_COUNT> m_FreeHeads{};  ///< First free range of each bucket
+    };
+}
@@ -0,0 +1,115 @@
+#include "Liara_Replay.h"
+
+#include "Core/Logging/LogMacros.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Liara::Core::Replay
+{
+    namespace
+    {
+        constexpr std::array<char, 4> REPLAY_MAGIC = {'L', 'R', 'P', 'Y'};
+        constexpr uint32_t REPLAY_VERSION = 1;
+
+        template <typename T> void Write(std::ofstream& file, const T& value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <typename T> bool Read(std::ifstream& file, T& value) {
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+    }
+
+    Liara_ReplayRecorder::Liara_ReplayRecorder(const std::string& filename, const uint32_t fixedHz)
+        : m_File(filename, std::ios::binary | std::ios::trunc) {
+        LIARA_CHECK_RUNTIME(m_File.is_open(), LogCore, "Failed to create the replay file '{}'", filename);
+
+        m_File.write(REPLAY_MAGIC.data(), REPLAY_MAGIC.size());
+        Write(m_File, REPLAY_VERSION);
+        Write(m_File, fixedHz);
+
+        LIARA_LOG_INFO(LogCore, "Recording replay to '{}'", filename);
+    }
+
+    void Liara_ReplayRecorder::RecordFrame(const float deltaTime,
+                                           const glm::mat4& view,
+                                           const std::span<const uint8_t> keyboardState) {
+        Write(m_File, deltaTime);
+        // The last row of an affine view matrix is always (0, 0, 0, 1)
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 3; ++row) { Write(m_File, view[column][row]); }
+        }
+
+        std::array<uint16_t, std::numeric_limits<uint8_t>::max()> pressedKeys{};
+        uint8_t keyCount = 0;
+        const size_t scancodeCount = std::min(keyboardState.size(), MAX_SCANCODES);
+        for (size_t scancode = 0; scancode < scancodeCount && keyCount < pressedKeys.size(); ++scancode) {
+            if (keyboardState[scancode] != 0) { pressedKeys[keyCount++] = static_cast<uint16_t>(scancode); }
+        }
+
+        Write(m_File, keyCount);
+        m_File.write(reinterpret_cast<const char*>(pressedKeys.data()),
+                     static_cast<std::streamsize>(keyCount * sizeof(uint16_t)));
+
+        ++m_FrameCount;
+    }
+
+    Liara_ReplayPlayer::Liara_ReplayPlayer(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        LIARA_CHECK_RUNTIME(file.is_open(), LogCore, "Failed to open the replay file '{}'", filename);
+
+        std::array<char, 4> magic{};
+        uint32_t version = 0;
+        file.read(magic.data(), magic.size());
+        LIARA_CHECK_RUNTIME(file && magic == REPLAY_MAGIC, LogCore, "'{}' is not a replay file", filename);
+        LIARA_CHECK_RUNTIME(Read(file, version) && version == REPLAY_VERSION,
+                            LogCore,
+                            "Unsupported replay version {} in '{}'",
+                            version,
+                            filename);
+        LIARA_CHECK_RUNTIME(Read(file, m_FixedHz), LogCore, "Truncated replay header in '{}'", filename);
+
+        ReplayFrame frame;
+        while (Read(file, frame.deltaTime)) {
+            bool complete = true;
+            for (int column = 0; column < 4; ++column) {
+                for (int row = 0; row < 3; ++row) { complete = complete && Read(file, frame.view[column][row]); }
+                frame.view[column][3] = column == 3 ? 1.0f : 0.0f;
+            }
+
+            uint8_t keyCount = 0;
+            complete = complete && Read(file, keyCount);
+            frame.pressedKeys.resize(keyCount);
+            for (auto& key : frame.pressedKeys) { complete = complete && Read(file, key); }
+
+            if (!complete) {
+                // A session killed while recording leaves a partial last frame
+                LIARA_LOG_WARNING(LogCore, "Ignoring the truncated last frame of '{}'", filename);
+                break;
+            }
+            m_Frames.push_back(frame);
+        }
+
+        LIARA_LOG_INFO(LogCore, "Loaded replay '{}': {} frames at {} Hz", filename, m_Frames.size(), m_FixedHz);
+    }
+
+    const ReplayFrame* Liara_ReplayPlayer::NextFrame() {
+        if (m_NextFrame >= m_Frames.size()) { return nullptr; }
+
+        const ReplayFrame& frame = m_Frames[m_NextFrame++];
+        m_KeyboardState.fill(0);
+        for (const uint16_t key : frame.pressedKeys) {
+            if (key < m_KeyboardState.size()) { m_KeyboardState[key] = 1; }
+        }
+        return &frame;
+    }
+}
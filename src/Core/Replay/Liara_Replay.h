@@ -0,0 +1,109 @@
+/**
+ * @file Liara_Replay.h
+ * @brief Defines the replay recorder and player, to capture a session and run the exact same frames again.
+ *
+ * A replay stores, for each frame, its delta time, the keyboard state read by the input processing and the camera view.
+ * Played back, the frames get the recorded delta time instead of the wall clock, so the fixed simulation steps,
+ * the input and the camera are the same on every run: two engine builds can be compared on identical frames.
+ *
+ * The file is a small header followed by the frames, in native (little endian) byte order:
+ *      header: "LRPY", uint32 version, uint32 simulation steps per second
+ *      frame:  float deltaTime, float view[12] (3 rows of the 4 columns), uint8 key count, uint16 scancodes[count]
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace Liara::Core::Replay
+{
+    constexpr size_t MAX_SCANCODES = 512;  ///< Size of the keyboard state, matches SDL_NUM_SCANCODES
+
+    /**
+     * @struct ReplayFrame
+     * @brief One recorded frame.
+     */
+    struct ReplayFrame
+    {
+        float deltaTime = 0.0f;             ///< Frame time, in seconds
+        glm::mat4 view{1.0f};               ///< Camera view matrix after the input processing
+        std::vector<uint16_t> pressedKeys;  ///< Scancodes held during the frame
+    };
+
+    /**
+     * @class Liara_ReplayRecorder
+     * @brief Appends the frames of a session to a replay file.
+     */
+    class Liara_ReplayRecorder
+    {
+    public:
+        /**
+         * @brief Creates (or truncates) the replay file and writes its header.
+         * @param filename Path of the replay file.
+         * @param fixedHz Simulation steps per second of the session, checked on playback.
+         */
+        Liara_ReplayRecorder(const std::string& filename, uint32_t fixedHz);
+
+        Liara_ReplayRecorder(const Liara_ReplayRecorder&) = delete;
+        Liara_ReplayRecorder& operator=(const Liara_ReplayRecorder&) = delete;
+
+        /**
+         * @brief Records a frame.
+         * @param deltaTime Frame time, in seconds.
+         * @param view Camera view matrix, must be affine.
+         * @param keyboardState One byte per scancode, non-zero when the key is held.
+         */
+        void RecordFrame(float deltaTime, const glm::mat4& view, std::span<const uint8_t> keyboardState);
+
+        [[nodiscard]] size_t GetFrameCount() const { return m_FrameCount; }
+
+    private:
+        std::ofstream m_File;
+        size_t m_FrameCount = 0;
+    };
+
+    /**
+     * @class Liara_ReplayPlayer
+     * @brief Loads a whole replay file, then hands out its frames in order.
+     * Everything is read upfront, so playing back does no disk access during the measured frames.
+     */
+    class Liara_ReplayPlayer
+    {
+    public:
+        /**
+         * @brief Loads the replay file, throws if it cannot be read or is not a valid replay.
+         */
+        explicit Liara_ReplayPlayer(const std::string& filename);
+
+        /**
+         * @brief Moves to the next frame and updates the keyboard state.
+         * @return The frame, or nullptr once every frame has been played.
+         */
+        const ReplayFrame* NextFrame();
+
+        /**
+         * @brief Keyboard state of the current frame, one byte per scancode.
+         */
+        [[nodiscard]] std::span<const uint8_t> GetKeyboardState() const { return m_KeyboardState; }
+
+        [[nodiscard]] size_t GetFrameCount() const { return m_Frames.size(); }
+        [[nodiscard]] size_t GetFrameIndex() const { return m_NextFrame; }  ///< Number of frames played so far
+        [[nodiscard]] uint32_t GetFixedHz() const { return m_FixedHz; }
+
+    private:
+        std::vector<ReplayFrame> m_Frames;
+        std::array<uint8_t, MAX_SCANCODES> m_KeyboardState{};
+        size_t m_NextFrame = 0;
+        uint32_t m_FixedHz = 0;
+    };
+}
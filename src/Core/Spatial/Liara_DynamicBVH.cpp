@@ -0,0 +1,374 @@
+#include "Liara_DynamicBVH.h"
+
+#include "Core/Logging/LogMacros.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "glm/common.hpp"
+#include "glm/ext/vector_float3.hpp"
+
+namespace Liara::Core::Spatial
+{
+    namespace
+    {
+        /// Multiplier of the displacement added to the fat box of a moving object, to anticipate its next moves
+        constexpr float DISPLACEMENT_MULTIPLIER = 2.0f;
+
+        float SurfaceArea(const Math::AABB& box) {
+            const glm::vec3 size = box.max - box.min;
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+
+        Math::AABB Union(const Math::AABB& a, const Math::AABB& b) {
+            return {.min = glm::min(a.min, b.min), .max = glm::max(a.max, b.max)};
+        }
+
+        bool Contains(const Math::AABB& outer, const Math::AABB& inner) {
+            return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+                   && inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+        }
+    }
+
+    Liara_DynamicBVH::Liara_DynamicBVH(const float margin)
+        : m_Margin(margin) {}
+
+    ProxyId Liara_DynamicBVH::Insert(const Math::AABB& box, const uint32_t userData) {
+        const ProxyId proxy = AllocateNode();
+        Node& node = m_Nodes[proxy];
+        node.box = Fatten(box);
+        node.height = 0;
+        node.userData = userData;
+        m_LeafBoxes[proxy] = box;
+
+        InsertLeaf(proxy);
+        ++m_ProxyCount;
+        return proxy;
+    }
+
+    void Liara_DynamicBVH::Remove(const ProxyId proxy) {
+        LIARA_CHECK_ARGUMENT(proxy >= 0 && static_cast<size_t>(proxy) < m_Nodes.size() && m_Nodes[proxy].height == 0,
+                             LogCore,
+                             "Invalid BVH proxy {}",
+                             proxy);
+
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        --m_ProxyCount;
+    }
+
+    bool Liara_DynamicBVH::Move(const ProxyId proxy, const Math::AABB& box, const glm::vec3& displacement) {
+        LIARA_CHECK_ARGUMENT(proxy >= 0 && static_cast<size_t>(proxy) < m_Nodes.size() && m_Nodes[proxy].height == 0,
+                             LogCore,
+                             "Invalid BVH proxy {}",
+                             proxy);
+
+        m_LeafBoxes[proxy] = box;
+        if (Contains(m_Nodes[proxy].box, box)) { return false; }
+
+        RemoveLeaf(proxy);
+
+        Math::AABB fatBox = Fatten(box);
+        const glm::vec3 prediction = displacement * DISPLACEMENT_MULTIPLIER;
+        fatBox.min = glm::min(fatBox.min, fatBox.min + prediction);
+        fatBox.max = glm::max(fatBox.max, fatBox.max + prediction);
+        m_Nodes[proxy].box = fatBox;
+
+        InsertLeaf(proxy);
+        return true;
+    }
+
+    void Liara_DynamicBVH::Build(const std::span<const Math::AABB> boxes, const std::span<const uint32_t> userData) {
+        LIARA_CHECK_ARGUMENT(userData.empty() || userData.size() == boxes.size(),
+                             LogCore,
+                             "{} user data given for {} boxes",
+                             userData.size(),
+                             boxes.size());
+
+        Clear();
+        if (boxes.empty()) { return; }
+
+        // n leaves and n - 1 internal nodes, allocated in order: the leaf of box i is node i
+        m_Nodes.reserve(boxes.size() * 2 - 1);
+        m_LeafBoxes.reserve(boxes.size() * 2 - 1);
+
+        std::vector<ProxyId> leaves(boxes.size());
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            const ProxyId proxy = AllocateNode();
+            Node& node = m_Nodes[proxy];
+            node.box = Fatten(boxes[i]);
+            node.height = 0;
+            node.userData = userData.empty() ? static_cast<uint32_t>(i) : userData[i];
+            m_LeafBoxes[proxy] = boxes[i];
+            leaves[i] = proxy;
+        }
+        m_ProxyCount = boxes.size();
+
+        m_Root = BuildRange(leaves);
+        m_Nodes[m_Root].parent = NULL_PROXY;
+    }
+
+    void Liara_DynamicBVH::Clear() {
+        m_Nodes.clear();
+        m_LeafBoxes.clear();
+        m_Root = NULL_PROXY;
+        m_FreeList = NULL_PROXY;
+        m_ProxyCount = 0;
+    }
+
+    ProxyId Liara_DynamicBVH::FindNearest(const glm::vec3& point, const float maxDistance) const {
+        if (m_Root == NULL_PROXY) { return NULL_PROXY; }
+
+        float bestDistanceSquared = maxDistance * maxDistance;
+        ProxyId nearest = NULL_PROXY;
+
+        Detail::NodeStack stack;
+        stack.Push(m_Root);
+        while (!stack.Empty()) {
+            const ProxyId nodeId = stack.Pop();
+            const Node& node = m_Nodes[nodeId];
+            // The fat box contains the exact one, its distance is a lower bound
+            if (Detail::DistanceSquared(node.box, point) > bestDistanceSquared) { continue; }
+
+            if (node.IsLeaf()) {
+                const float distanceSquared = Detail::DistanceSquared(m_LeafBoxes[nodeId], point);
+                if (distanceSquared < bestDistanceSquared
+                    || (nearest == NULL_PROXY && distanceSquared <= bestDistanceSquared)) {
+                    bestDistanceSquared = distanceSquared;
+                    nearest = nodeId;
+                }
+                continue;
+            }
+
+            // The closest child is popped first, so that the best distance shrinks as early as possible
+            const float distance1 = Detail::DistanceSquared(m_Nodes[node.child1].box, point);
+            const float distance2 = Detail::DistanceSquared(m_Nodes[node.child2].box, point);
+            if (distance1 <= distance2) {
+                stack.Push(node.child2);
+                stack.Push(node.child1);
+            }
+            else {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+        return nearest;
+    }
+
+    float Liara_DynamicBVH::GetAreaRatio() const {
+        if (m_Root == NULL_PROXY) { return 0.0f; }
+
+        float totalArea = 0.0f;
+        for (const auto& node : m_Nodes) {
+            if (node.height > 0) { totalArea += SurfaceArea(node.box); }
+        }
+        const float rootArea = SurfaceArea(m_Nodes[m_Root].box);
+        return rootArea > 0.0f ? totalArea / rootArea : 0.0f;
+    }
+
+    ProxyId Liara_DynamicBVH::AllocateNode() {
+        if (m_FreeList == NULL_PROXY) {
+            m_Nodes.emplace_back();
+            m_LeafBoxes.emplace_back();
+            return static_cast<ProxyId>(m_Nodes.size() - 1);
+        }
+
+        const ProxyId node = m_FreeList;
+        m_FreeList = m_Nodes[node].parent;
+        m_Nodes[node] = Node{};
+        return node;
+    }
+
+    void Liara_DynamicBVH::FreeNode(const ProxyId node) {
+        m_Nodes[node].parent = m_FreeList;
+        m_Nodes[node].height = -1;
+        m_FreeList = node;
+    }
+
+    void Liara_DynamicBVH::InsertLeaf(const ProxyId leaf) {
+        if (m_Root == NULL_PROXY) {
+            m_Root = leaf;
+            m_Nodes[leaf].parent = NULL_PROXY;
+            return;
+        }
+
+        // Descend towards the sibling whose pairing with the leaf adds the least surface area to the tree
+        const Math::AABB leafBox = m_Nodes[leaf].box;
+        ProxyId index = m_Root;
+        while (!m_Nodes[index].IsLeaf()) {
+            const Node& node = m_Nodes[index];
+            const float combinedArea = SurfaceArea(Union(node.box, leafBox));
+
+            // Cost of pairing the leaf with this node, and cost added to every ancestor when descending further
+            const float cost = 2.0f * combinedArea;
+            const float inheritanceCost = 2.0f * (combinedArea - SurfaceArea(node.box));
+
+            const auto descendCost = [&](const ProxyId child) {
+                const Node& childNode = m_Nodes[child];
+                const float area = SurfaceArea(Union(leafBox, childNode.box));
+                return (childNode.IsLeaf() ? area : area - SurfaceArea(childNode.box)) + inheritanceCost;
+            };
+            const float cost1 = descendCost(node.child1);
+            const float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) { break; }
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+        const ProxyId sibling = index;
+
+        // Allocating may move the nodes, no reference is kept across it
+        const ProxyId newParent = AllocateNode();
+        const ProxyId oldParent = m_Nodes[sibling].parent;
+        Node& parent = m_Nodes[newParent];
+        parent.parent = oldParent;
+        parent.box = Union(leafBox, m_Nodes[sibling].box);
+        parent.height = m_Nodes[sibling].height + 1;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+
+        if (oldParent != NULL_PROXY) {
+            Node& grandParent = m_Nodes[oldParent];
+            if (grandParent.child1 == sibling) { grandParent.child1 = newParent; }
+            else { grandParent.child2 = newParent; }
+        }
+        else { m_Root = newParent; }
+        m_Nodes[sibling].parent = newParent;
+        m_Nodes[leaf].parent = newParent;
+
+        RefitAncestors(m_Nodes[leaf].parent);
+    }
+
+    void Liara_DynamicBVH::RemoveLeaf(const ProxyId leaf) {
+        if (leaf == m_Root) {
+            m_Root = NULL_PROXY;
+            return;
+        }
+
+        const ProxyId parent = m_Nodes[leaf].parent;
+        const ProxyId grandParent = m_Nodes[parent].parent;
+        const ProxyId sibling = m_Nodes[parent].child1 == leaf ? m_Nodes[parent].child2 : m_Nodes[parent].child1;
+
+        // The sibling takes the place of the parent
+        m_Nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+        if (grandParent == NULL_PROXY) {
+            m_Root = sibling;
+            return;
+        }
+
+        Node& grandParentNode = m_Nodes[grandParent];
+        if (grandParentNode.child1 == parent) { grandParentNode.child1 = sibling; }
+        else { grandParentNode.child2 = sibling; }
+        RefitAncestors(grandParent);
+    }
+
+    void Liara_DynamicBVH::RefitAncestors(ProxyId node) {
+        while (node != NULL_PROXY) {
+            node = Balance(node);
+
+            Node& current = m_Nodes[node];
+            const Node& child1 = m_Nodes[current.child1];
+            const Node& child2 = m_Nodes[current.child2];
+            current.height = 1 + std::max(child1.height, child2.height);
+            current.box = Union(child1.box, child2.box);
+
+            node = current.parent;
+        }
+    }
+
+    ProxyId Liara_DynamicBVH::Balance(const ProxyId iA) {
+        Node& a = m_Nodes[iA];
+        if (a.IsLeaf() || a.height < 2) { return iA; }
+
+        const ProxyId iB = a.child1;
+        const ProxyId iC = a.child2;
+        Node& b = m_Nodes[iB];
+        Node& c = m_Nodes[iC];
+
+        // Rotates the higher child up: it takes the place of A, and A takes its lower child
+        const auto rotateUp = [&](const ProxyId iUp, Node& up, Node& other, const bool upIsChild2) {
+            const ProxyId iF = up.child1;
+            const ProxyId iG = up.child2;
+            Node& f = m_Nodes[iF];
+            Node& g = m_Nodes[iG];
+
+            up.child1 = iA;
+            up.parent = a.parent;
+            a.parent = iUp;
+            if (up.parent != NULL_PROXY) {
+                Node& upParent = m_Nodes[up.parent];
+                if (upParent.child1 == iA) { upParent.child1 = iUp; }
+                else { upParent.child2 = iUp; }
+            }
+            else { m_Root = iUp; }
+
+            // The higher grandchild stays under the rotated node, the lower one moves under A
+            const bool keepF = f.height > g.height;
+            const ProxyId iKept = keepF ? iF : iG;
+            const ProxyId iMoved = keepF ? iG : iF;
+            Node& kept = keepF ? f : g;
+            Node& moved = keepF ? g : f;
+
+            up.child2 = iKept;
+            if (upIsChild2) { a.child2 = iMoved; }
+            else { a.child1 = iMoved; }
+            moved.parent = iA;
+
+            a.box = Union(other.box, moved.box);
+            a.height = 1 + std::max(other.height, moved.height);
+            up.box = Union(a.box, kept.box);
+            up.height = 1 + std::max(a.height, kept.height);
+            return iUp;
+        };
+
+        const int32_t balance = c.height - b.height;
+        if (balance > 1) { return rotateUp(iC, c, b, true); }
+        if (balance < -1) { return rotateUp(iB, b, c, false); }
+        return iA;
+    }
+
+    ProxyId Liara_DynamicBVH::BuildRange(const std::span<ProxyId> leaves) {
+        if (leaves.size() == 1) { return leaves.front(); }
+
+        // Median split along the axis where the box centers spread the most
+        glm::vec3 centerMin = m_Nodes[leaves.front()].box.GetCenter();
+        glm::vec3 centerMax = centerMin;
+        for (const ProxyId leaf : leaves) {
+            const glm::vec3 center = m_Nodes[leaf].box.GetCenter();
+            centerMin = glm::min(centerMin, center);
+            centerMax = glm::max(centerMax, center);
+        }
+        const glm::vec3 spread = centerMax - centerMin;
+        const int axis = spread.x >= spread.y && spread.x >= spread.z ? 0 : (spread.y >= spread.z ? 1 : 2);
+
+        const size_t middle = leaves.size() / 2;
+        std::nth_element(leaves.begin(),
+                         leaves.begin() + static_cast<std::ptrdiff_t>(middle),
+                         leaves.end(),
+                         [this, axis](const ProxyId lhs, const ProxyId rhs) {
+                             const Math::AABB& lhsBox = m_Nodes[lhs].box;
+                             const Math::AABB& rhsBox = m_Nodes[rhs].box;
+                             return lhsBox.min[axis] + lhsBox.max[axis] < rhsBox.min[axis] + rhsBox.max[axis];
+                         });
+
+        const ProxyId child1 = BuildRange(leaves.first(middle));
+        const ProxyId child2 = BuildRange(leaves.subspan(middle));
+
+        const ProxyId nodeId = AllocateNode();
+        Node& node = m_Nodes[nodeId];
+        node.child1 = child1;
+        node.child2 = child2;
+        node.box = Union(m_Nodes[child1].box, m_Nodes[child2].box);
+        node.height = 1 + std::max(m_Nodes[child1].height, m_Nodes[child2].height);
+        m_Nodes[child1].parent = nodeId;
+        m_Nodes[child2].parent = nodeId;
+        return nodeId;
+    }
+
+    Math::AABB Liara_DynamicBVH::Fatten(const Math::AABB& box) const {
+        return {.min = box.min - glm::vec3(m_Margin), .max = box.max + glm::vec3(m_Margin)};
+    }
+}
@@ -0,0 +1,159 @@
+/**
+ * @file Liara_DynamicBVH.h
+ * @brief Defines the `Liara_DynamicBVH` class, an incrementally updated bounding volume hierarchy of boxes.
+ *
+ * The tree is built by insertion (the sibling that grows the total surface area the least is chosen) and kept
+ * balanced by rotations, like the dynamic trees of Box2D and Bullet. It can also be bulk built from a set of boxes.
+ *
+ * Leaves store a "fat" box: the box of the object grown by a margin. An object moving inside its fat box costs
+ * nothing, only objects leaving it are removed and reinserted, with their fat box extended along the motion.
+ * Queries test the fat boxes, so they may report an object a little outside the queried volume.
+ */
+
+#pragma once
+
+#include "Core/Math/Bounds.h"
+#include "Core/Math/FrustumCulling.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "glm/ext/vector_float3.hpp"
+
+namespace Liara::Core::Spatial
+{
+    using ProxyId = int32_t;            ///< Handle of an object in the tree, stable until the object is removed
+    constexpr ProxyId NULL_PROXY = -1;  ///< Value representing the absence of a proxy
+
+    /**
+     * @struct Ray
+     * @brief Half-line origin + t * direction, for t in [0, maxDistance]. The direction does not need to be normalized,
+     * distances are then in multiples of its length.
+     */
+    struct Ray
+    {
+        glm::vec3 origin{0.0f};
+        glm::vec3 direction{0.0f, 0.0f, 1.0f};
+        float maxDistance = std::numeric_limits<float>::max();
+    };
+
+    /**
+     * @class Liara_DynamicBVH
+     * @brief Bounding volume hierarchy over object boxes, updated as objects are added, moved and removed.
+     */
+    class Liara_DynamicBVH
+    {
+    public:
+        /**
+         * @param margin Distance the fat boxes extend beyond the object boxes, on each side.
+         */
+        explicit Liara_DynamicBVH(float margin = 0.1f);
+
+        /**
+         * @brief Adds an object.
+         * @param box Box of the object.
+         * @param userData Value given back by GetUserData, usually the index of the object.
+         * @return The proxy of the object.
+         */
+        ProxyId Insert(const Math::AABB& box, uint32_t userData);
+
+        /**
+         * @brief Removes an object, its proxy may be reused by the next insertion.
+         */
+        void Remove(ProxyId proxy);
+
+        /**
+         * @brief Updates the box of an object, reinserting it only if it left its fat box.
+         * @param displacement Motion of the object since its last update, the new fat box is extended along it.
+         * @return true if the object was reinserted.
+         */
+        bool Move(ProxyId proxy, const Math::AABB& box, const glm::vec3& displacement = glm::vec3(0.0f));
+
+        /**
+         * @brief Replaces the whole tree by a top-down build over the boxes, faster than inserting them one by one.
+         * The proxies are the indices of the boxes, the user data are taken from userData or are the indices too.
+         */
+        void Build(std::span<const Math::AABB> boxes, std::span<const uint32_t> userData = {});
+
+        void Clear();
+
+        /**
+         * @brief Calls callback(ProxyId) for each object whose fat box overlaps the box.
+         */
+        template <typename Callback> void QueryBox(const Math::AABB& box, Callback&& callback) const;
+
+        /**
+         * @brief Calls callback(ProxyId) for each object whose fat box overlaps the sphere.
+         */
+        template <typename Callback> void QuerySphere(const glm::vec3& center, float radius, Callback&& callback) const;
+
+        /**
+         * @brief Calls callback(ProxyId) for each object whose fat box is in the frustum.
+         * Subtrees entirely inside the frustum are reported without testing their boxes.
+         */
+        template <typename Callback> void QueryFrustum(const Math::Frustum& frustum, Callback&& callback) const;
+
+        /**
+         * @brief Calls callback(ProxyId, const Ray&) for each object whose fat box the ray crosses.
+         * The callback returns the distance at which the ray hits the object, or a negative value if it misses:
+         * the ray is then clipped to that distance, which skips the objects behind. Returning 0 stops the cast.
+         */
+        template <typename Callback> void Raycast(const Ray& ray, Callback&& callback) const;
+
+        /**
+         * @brief Finds the object whose box (not fat box) is the closest to the point.
+         * @return The proxy of the object, or NULL_PROXY if no object is within maxDistance.
+         */
+        [[nodiscard]] ProxyId FindNearest(const glm::vec3& point,
+                                          float maxDistance = std::numeric_limits<float>::max()) const;
+
+        [[nodiscard]] uint32_t GetUserData(const ProxyId proxy) const { return m_Nodes[proxy].userData; }
+        [[nodiscard]] const Math::AABB& GetFatBox(const ProxyId proxy) const { return m_Nodes[proxy].box; }
+        [[nodiscard]] const Math::AABB& GetBox(const ProxyId proxy) const { return m_LeafBoxes[proxy]; }
+
+        [[nodiscard]] size_t GetProxyCount() const { return m_ProxyCount; }
+        [[nodiscard]] int32_t GetHeight() const { return m_Root == NULL_PROXY ? 0 : m_Nodes[m_Root].height; }
+        [[nodiscard]] float GetMargin() const { return m_Margin; }
+
+        /**
+         * @brief Sum of the internal node areas divided by the root area, lower is better.
+         */
+        [[nodiscard]] float GetAreaRatio() const;
+
+    private:
+        struct Node
+        {
+            Math::AABB box;               ///< Fat box for the leaves, union of the children for the others
+            ProxyId parent = NULL_PROXY;  ///< Next free node while the node is in the free list
+            ProxyId child1 = NULL_PROXY;
+            ProxyId child2 = NULL_PROXY;
+            int32_t height = -1;  ///< 0 for leaves, -1 for free nodes
+            uint32_t userData = 0;
+
+            [[nodiscard]] bool IsLeaf() const { return child1 == NULL_PROXY; }
+        };
+
+        ProxyId AllocateNode();
+        void FreeNode(ProxyId node);
+
+        void InsertLeaf(ProxyId leaf);
+        void RemoveLeaf(ProxyId leaf);
+        ProxyId Balance(ProxyId node);
+        void RefitAncestors(ProxyId node);
+        ProxyId BuildRange(std::span<ProxyId> leaves);
+
+        [[nodiscard]] Math::AABB Fatten(const Math::AABB& box) const;
+
+        std::vector<Node> m_Nodes;
+        std::vector<Math::AABB> m_LeafBoxes;  ///< Exact boxes of the leaves, indexed like the nodes
+        ProxyId m_Root = NULL_PROXY;
+        ProxyId m_FreeList = NULL_PROXY;
+        size_t m_ProxyCount = 0;
+        float m_Margin;
+    };
+}
+
+#include "Liara_DynamicBVH.tpp"
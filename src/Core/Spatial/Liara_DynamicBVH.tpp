@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Liara_DynamicBVH.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+
+namespace Liara::Core::Spatial
+{
+    namespace Detail
+    {
+        /**
+         * @brief Traversal stack living on the call stack, it only allocates for trees deeper than any balanced one.
+         */
+        class NodeStack
+        {
+        public:
+            void Push(const ProxyId node) {
+                if (m_Size < m_Inline.size()) { m_Inline[m_Size] = node; }
+                else { m_Overflow.push_back(node); }
+                ++m_Size;
+            }
+
+            ProxyId Pop() {
+                --m_Size;
+                if (m_Size < m_Inline.size()) { return m_Inline[m_Size]; }
+                const ProxyId node = m_Overflow.back();
+                m_Overflow.pop_back();
+                return node;
+            }
+
+            [[nodiscard]] bool Empty() const { return m_Size == 0; }
+
+        private:
+            std::array<ProxyId, 128> m_Inline{};
+            std::vector<ProxyId> m_Overflow;
+            size_t m_Size = 0;
+        };
+
+        inline bool Overlaps(const Math::AABB& a, const Math::AABB& b) {
+            return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y
+                   && a.min.z <= b.max.z && a.max.z >= b.min.z;
+        }
+
+        inline float DistanceSquared(const Math::AABB& box, const glm::vec3& point) {
+            const glm::vec3 offset = glm::max(glm::max(box.min - point, point - box.max), glm::vec3(0.0f));
+            return glm::dot(offset, offset);
+        }
+
+        /**
+         * @brief Slab test, returns the distance at which the ray enters the box, or a negative value if it misses it.
+         */
+        inline float IntersectRay(const Math::AABB& box,
+                                  const glm::vec3& origin,
+                                  const glm::vec3& inverseDirection,
+                                  const float maxDistance) {
+            float entry = 0.0f;
+            float exit = maxDistance;
+            for (int axis = 0; axis < 3; ++axis) {
+                float t1 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+                float t2 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+                if (t1 > t2) { std::swap(t1, t2); }
+                // NaN (0 * inf, ray in the plane of a slab face) must not reject the box: max/min keep the other value
+                entry = std::max(entry, t1);
+                exit = std::min(exit, t2);
+                if (entry > exit) { return -1.0f; }
+            }
+            return entry;
+        }
+    }
+
+    template <typename Callback> void Liara_DynamicBVH::QueryBox(const Math::AABB& box, Callback&& callback) const {
+        if (m_Root == NULL_PROXY) { return; }
+
+        Detail::NodeStack stack;
+        stack.Push(m_Root);
+        while (!stack.Empty()) {
+            const ProxyId nodeId = stack.Pop();
+            const Node& node = m_Nodes[nodeId];
+            if (!Detail::Overlaps(node.box, box)) { continue; }
+
+            if (node.IsLeaf()) { callback(nodeId); }
+            else {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+
+    template <typename Callback>
+    void Liara_DynamicBVH::QuerySphere(const glm::vec3& center, const float radius, Callback&& callback) const {
+        if (m_Root == NULL_PROXY) { return; }
+
+        const float radiusSquared = radius * radius;
+        Detail::NodeStack stack;
+        stack.Push(m_Root);
+        while (!stack.Empty()) {
+            const ProxyId nodeId = stack.Pop();
+            const Node& node = m_Nodes[nodeId];
+            if (Detail::DistanceSquared(node.box, center) > radiusSquared) { continue; }
+
+            if (node.IsLeaf()) { callback(nodeId); }
+            else {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+
+    template <typename Callback>
+    void Liara_DynamicBVH::QueryFrustum(const Math::Frustum& frustum, Callback&& callback) const {
+        if (m_Root == NULL_PROXY) { return; }
+
+        Detail::NodeStack stack;
+        Detail::NodeStack insideStack;
+        stack.Push(m_Root);
+        while (!stack.Empty()) {
+            const ProxyId nodeId = stack.Pop();
+            const Node& node = m_Nodes[nodeId];
+
+            const Math::Containment containment = frustum.ClassifyBox(node.box);
+            if (containment == Math::Containment::OUTSIDE) { continue; }
+
+            if (node.IsLeaf()) { callback(nodeId); }
+            else if (containment == Math::Containment::INTERSECTS) {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+            else {
+                // The whole subtree is visible, its leaves are reported without any test
+                insideStack.Push(nodeId);
+                while (!insideStack.Empty()) {
+                    const ProxyId insideId = insideStack.Pop();
+                    const Node& inside = m_Nodes[insideId];
+                    if (inside.IsLeaf()) { callback(insideId); }
+                    else {
+                        insideStack.Push(inside.child1);
+                        insideStack.Push(inside.child2);
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename Callback> void Liara_DynamicBVH::Raycast(const Ray& ray, Callback&& callback) const {
+        if (m_Root == NULL_PROXY) { return; }
+
+        const glm::vec3 inverseDirection = 1.0f / ray.direction;
+        Ray clipped = ray;
+
+        Detail::NodeStack stack;
+        stack.Push(m_Root);
+        while (!stack.Empty()) {
+            const ProxyId nodeId = stack.Pop();
+            const Node& node = m_Nodes[nodeId];
+            if (Detail::IntersectRay(node.box, ray.origin, inverseDirection, clipped.maxDistance) < 0.0f) { continue; }
+
+            if (node.IsLeaf()) {
+                const float hit = callback(nodeId, static_cast<const Ray&>(clipped));
+                if (hit == 0.0f) { return; }
+                if (hit > 0.0f) { clipped.maxDistance = std::min(clipped.maxDistance, hit); }
+            }
+            else {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#include "Liara_SceneIndex.h"
+
+#include "Core/Components/ModelComponent.h"
+#include "Core/Components/WorldTransformComponent.h"
+#include "Graphics/Liara_Model.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "glm/common.hpp"
+#include "glm/ext/vector_float3.hpp"
+
+namespace Liara::Core::Spatial
+{
+    Liara_SceneIndex::Liara_SceneIndex(ECS::Liara_Registry& registry,
+                                       const ECS::Liara_TransformHierarchy& hierarchy,
+                                       const float margin)
+        : m_Registry(registry)
+        , m_Hierarchy(hierarchy)
+        , m_Tree(margin) {}
+
+    void Liara_SceneIndex::Update() {
+        m_LastUpdateCount = 0;
+        m_LastReinsertCount = 0;
+
+        // Models or transforms added or removed, or entities destroyed: the moved entities do not tell which ones
+        auto& models = m_Registry.Storage<Component::ModelComponent>();
+        const uint64_t worldsVersion = m_Registry.Storage<Component::WorldTransformComponent>().GetVersion();
+        if (models.GetVersion() != m_ModelsVersion || worldsVersion != m_WorldsVersion) {
+            m_ModelsVersion = models.GetVersion();
+            m_WorldsVersion = worldsVersion;
+            Rescan();
+        }
+        else {
+            // Entities that stopped moving get back a box covering their current step only
+            for (const ECS::Entity entity : m_Moving) { Refresh(entity); }
+            for (const ECS::Entity entity : m_Hierarchy.GetMovedEntities()) { Refresh(entity); }
+
+            // A model replaced in place changes the box without moving the entity
+            const auto entities = models.Entities();
+            const auto components = models.Components();
+            for (size_t i = 0; i < entities.size(); ++i) {
+                const Graphics::Liara_Model* indexed =
+                    entities[i].index < m_Slots.size() ? m_Slots[entities[i].index].model : nullptr;
+                if (components[i].model.get() != indexed) { Refresh(entities[i]); }
+            }
+        }
+
+        const auto moved = m_Hierarchy.GetMovedEntities();
+        m_Moving.assign(moved.begin(), moved.end());
+    }
+
+    ECS::Entity Liara_SceneIndex::FindNearest(const glm::vec3& point, const float maxDistance) const {
+        const ProxyId proxy = m_Tree.FindNearest(point, maxDistance);
+        return proxy == NULL_PROXY ? ECS::NULL_ENTITY : ToEntity(proxy);
+    }
+
+    const Math::AABB* Liara_SceneIndex::GetBox(const ECS::Entity entity) const {
+        if (entity.index >= m_Slots.size()) { return nullptr; }
+
+        const Slot& slot = m_Slots[entity.index];
+        if (slot.proxy == NULL_PROXY || slot.generation != entity.generation) { return nullptr; }
+        return &m_Tree.GetBox(slot.proxy);
+    }
+
+    void Liara_SceneIndex::Refresh(const ECS::Entity entity) {
+        const auto* world = m_Registry.TryGet<Component::WorldTransformComponent>(entity);
+        const auto* model = m_Registry.TryGet<Component::ModelComponent>(entity);
+        if (entity.index >= m_Slots.size()) { m_Slots.resize(entity.index + 1); }
+
+        Slot& slot = m_Slots[entity.index];
+        if (slot.proxy != NULL_PROXY && slot.generation != entity.generation) { Untrack(entity.index); }
+        if (world == nullptr || model == nullptr || !model->model) {
+            Untrack(entity.index);
+            return;
+        }
+
+        // Union of both steps, the interpolated matrix stays between them
+        const Math::AABB& bounds = model->model->GetBounds().box;
+        const Math::AABB previous = Math::TransformAABB(bounds, world->previousWorld);
+        const Math::AABB current = Math::TransformAABB(bounds, world->world);
+        const Math::AABB box{.min = glm::min(previous.min, current.min), .max = glm::max(previous.max, current.max)};
+
+        ++m_LastUpdateCount;
+        slot.model = model->model.get();
+        if (slot.proxy == NULL_PROXY) {
+            slot.proxy = m_Tree.Insert(box, entity.index);
+            slot.generation = entity.generation;
+            ++m_LastReinsertCount;
+            return;
+        }
+
+        const glm::vec3 displacement = box.GetCenter() - m_Tree.GetBox(slot.proxy).GetCenter();
+        if (m_Tree.Move(slot.proxy, box, displacement)) { ++m_LastReinsertCount; }
+    }
+
+    void Liara_SceneIndex::Untrack(const uint32_t index) {
+        Slot& slot = m_Slots[index];
+        slot.model = nullptr;
+        if (slot.proxy == NULL_PROXY) { return; }
+
+        m_Tree.Remove(slot.proxy);
+        slot.proxy = NULL_PROXY;
+    }
+
+    void Liara_SceneIndex::Rescan() {
+        ++m_Scan;
+        for (const ECS::Entity entity : m_Registry.Storage<Component::ModelComponent>().Entities()) {
+            Refresh(entity);
+            m_Slots[entity.index].scan = m_Scan;
+        }
+
+        // Entities no longer owning a model, or destroyed
+        for (uint32_t index = 0; index < m_Slots.size(); ++index) {
+            if (m_Slots[index].scan != m_Scan) { Untrack(index); }
+        }
+    }
+
+    ECS::Entity Liara_SceneIndex::ToEntity(const ProxyId proxy) const {
+        const uint32_t index = m_Tree.GetUserData(proxy);
+        const ECS::Entity entity{.index = index, .generation = m_Slots[index].generation};
+        return m_Registry.IsAlive(entity) ? entity : ECS::NULL_ENTITY;
+    }
+}
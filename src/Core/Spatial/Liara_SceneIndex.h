@@ -0,0 +1,116 @@
+/**
+ * @file Liara_SceneIndex.h
+ * @brief Defines the `Liara_SceneIndex` class, a `Liara_DynamicBVH` over the renderable entities of a registry.
+ */
+
+#pragma once
+
+#include "Core/ECS/Entity.h"
+#include "Core/ECS/Liara_Registry.h"
+#include "Core/ECS/Liara_TransformHierarchy.h"
+#include "Core/Math/Bounds.h"
+#include "Core/Math/FrustumCulling.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "glm/ext/vector_float3.hpp"
+#include "Liara_DynamicBVH.h"
+
+namespace Liara::Graphics
+{
+    class Liara_Model;
+}
+
+namespace Liara::Core::Spatial
+{
+    /**
+     * @class Liara_SceneIndex
+     * @brief Indexes the world boxes of the entities owning a `WorldTransformComponent` and a `ModelComponent`.
+     *
+     * Update() only refreshes the entities the transform hierarchy reports as moved. The box of an entity covers
+     * its previous and current step, so it contains every interpolated position rendered in between.
+     * The whole registry is scanned again only when models or world transforms are added or removed, entity
+     * destruction included. A model replaced in its component is caught by comparing it with the indexed one.
+     * Queries report alive entities only.
+     */
+    class Liara_SceneIndex
+    {
+    public:
+        /**
+         * @param margin Margin of the fat boxes of the BVH, in world units.
+         */
+        Liara_SceneIndex(ECS::Liara_Registry& registry,
+                         const ECS::Liara_TransformHierarchy& hierarchy,
+                         float margin = 0.5f);
+
+        /**
+         * @brief Brings the index up to date with the registry, called after the transform hierarchy was updated.
+         */
+        void Update();
+
+        /**
+         * @brief Calls callback(Entity) for each entity whose box may be in the frustum.
+         */
+        template <typename Callback> void QueryFrustum(const Math::Frustum& frustum, Callback&& callback) const;
+
+        /**
+         * @brief Calls callback(Entity) for each entity whose box may overlap the sphere.
+         */
+        template <typename Callback> void QuerySphere(const glm::vec3& center, float radius, Callback&& callback) const;
+
+        /**
+         * @brief Calls callback(Entity, const Ray&) for each entity whose box the ray may cross.
+         * The callback returns the hit distance or a negative value, see Liara_DynamicBVH::Raycast.
+         */
+        template <typename Callback> void Raycast(const Ray& ray, Callback&& callback) const;
+
+        /**
+         * @brief Returns the entity whose box is the closest to the point, or NULL_ENTITY if none is within reach.
+         */
+        [[nodiscard]] ECS::Entity FindNearest(const glm::vec3& point,
+                                              float maxDistance = std::numeric_limits<float>::max()) const;
+
+        /**
+         * @brief Returns the world box of the entity, as last indexed.
+         */
+        [[nodiscard]] const Math::AABB* GetBox(ECS::Entity entity) const;
+
+        [[nodiscard]] const Liara_DynamicBVH& GetTree() const { return m_Tree; }
+        [[nodiscard]] size_t GetEntityCount() const { return m_Tree.GetProxyCount(); }
+        [[nodiscard]] size_t GetLastUpdateCount() const { return m_LastUpdateCount; }  ///< Entities refreshed
+        [[nodiscard]] size_t GetLastReinsertCount() const { return m_LastReinsertCount; }  ///< Entities reinserted
+
+    private:
+        struct Slot
+        {
+            ProxyId proxy = NULL_PROXY;
+            uint32_t generation = 0;                       ///< Of the indexed entity, the slot index being its index
+            uint32_t scan = 0;                             ///< Last full scan that found the entity
+            const Graphics::Liara_Model* model = nullptr;  ///< Whose bounds the box was computed from
+        };
+
+        void Refresh(ECS::Entity entity);
+        void Untrack(uint32_t index);
+        void Rescan();
+
+        [[nodiscard]] ECS::Entity ToEntity(ProxyId proxy) const;
+
+        ECS::Liara_Registry& m_Registry;
+        const ECS::Liara_TransformHierarchy& m_Hierarchy;
+        Liara_DynamicBVH m_Tree;
+
+        std::vector<Slot> m_Slots;          ///< Indexed by Entity::index
+        std::vector<ECS::Entity> m_Moving;  ///< Entities moved at the last update, their box spans two steps
+        uint64_t m_ModelsVersion = 0;       ///< Of the model pool, at the last update
+        uint64_t m_WorldsVersion = 0;       ///< Of the world transform pool, at the last update
+        uint32_t m_Scan = 0;
+
+        size_t m_LastUpdateCount = 0;
+        size_t m_LastReinsertCount = 0;
+    };
+}
+
+#include "Liara_SceneIndex.tpp"
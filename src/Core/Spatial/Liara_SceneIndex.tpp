@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Liara_SceneIndex.h"
+
+namespace Liara::Core::Spatial
+{
+    template <typename Callback>
+    void Liara_SceneIndex::QueryFrustum(const Math::Frustum& frustum, Callback&& callback) const {
+        m_Tree.QueryFrustum(frustum, [&](const ProxyId proxy) {
+            if (const ECS::Entity entity = ToEntity(proxy); !entity.IsNull()) { callback(entity); }
+        });
+    }
+
+    template <typename Callback>
+    void Liara_SceneIndex::QuerySphere(const glm::vec3& center, const float radius, Callback&& callback) const {
+        m_Tree.QuerySphere(center, radius, [&](const ProxyId proxy) {
+            if (const ECS::Entity entity = ToEntity(proxy); !entity.IsNull()) { callback(entity); }
+        });
+    }
+
+    template <typename Callback> void Liara_SceneIndex::Raycast(const Ray& ray, Callback&& callback) const {
+        m_Tree.Raycast(ray, [&](const ProxyId proxy, const Ray& clipped) -> float {
+            const ECS::Entity entity = ToEntity(proxy);
+            return entity.IsNull() ? -1.0f : callback(entity, clipped);
+        });
+    }
+}
@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <span>
 #include <stdexcept>
 #include <utility>
@@ -35,7 +36,7 @@ namespace Liara::Graphics
         : m_Device(other.m_Device)
         , m_Mapped(std::exchange(other.m_Mapped, nullptr))
         , m_Buffer(std::exchange(other.m_Buffer, VK_NULL_HANDLE))
-        , m_Memory(std::exchange(other.m_Memory, VK_NULL_HANDLE))
+        , m_Allocation(std::exchange(other.m_Allocation, MemoryAllocation{}))
         , m_BufferSize(other.m_BufferSize)
         , m_InstanceCount(other.m_InstanceCount)
         , m_InstanceSize(other.m_InstanceSize)
@@ -49,12 +50,12 @@ namespace Liara::Graphics
             // Cleanup current resources
             Unmap();
             if (m_Buffer != VK_NULL_HANDLE) { vkDestroyBuffer(m_Device.GetDevice(), m_Buffer, nullptr); }
-            if (m_Memory != VK_NULL_HANDLE) { vkFreeMemory(m_Device.GetDevice(), m_Memory, nullptr); }
+            m_Device.FreeMemory(m_Allocation);
 
             // Move from other
             m_Mapped = std::exchange(other.m_Mapped, nullptr);
             m_Buffer = std::exchange(other.m_Buffer, VK_NULL_HANDLE);
-            m_Memory = std::exchange(other.m_Memory, VK_NULL_HANDLE);
+            m_Allocation = std::exchange(other.m_Allocation, MemoryAllocation{});
             m_BufferSize = other.m_BufferSize;
             m_InstanceCount = other.m_InstanceCount;
             m_InstanceSize = other.m_InstanceSize;
@@ -69,7 +70,7 @@ namespace Liara::Graphics
     Liara_Buffer::~Liara_Buffer() {
         Unmap();
         if (m_Buffer != VK_NULL_HANDLE) { vkDestroyBuffer(m_Device.GetDevice(), m_Buffer, nullptr); }
-        if (m_Memory != VK_NULL_HANDLE) { vkFreeMemory(m_Device.GetDevice(), m_Memory, nullptr); }
+        m_Device.FreeMemory(m_Allocation);
     }
 
     void Liara_Buffer::WriteBytes(const std::span<const std::byte> data, const VkDeviceSize byteOffset) const {
@@ -83,7 +84,25 @@ namespace Liara::Graphics
     }
 
     void Liara_Buffer::CreateBuffer() {
-        m_Device.CreateBuffer(m_BufferSize, m_UsageFlags, m_MemoryPropertyFlags, m_Buffer, m_Memory);
+        m_Device.CreateBuffer(m_BufferSize, m_UsageFlags, m_MemoryPropertyFlags, m_Buffer, m_Allocation);
+    }
+
+    std::unique_ptr<Liara_Buffer> Liara_Buffer::Duplicate(VkCommandBuffer commandBuffer,
+                                                          const std::span<const VkBufferCopy> regions) const {
+        auto duplicate = std::make_unique<Liara_Buffer>(m_Device,
+                                                        m_BufferSize,
+                                                        BufferConfig{.usage = m_UsageFlags,
+                                                                     .memoryProperties = m_MemoryPropertyFlags,
+                                                                     .minOffsetAlignment = m_MinOffsetAlignment});
+        if (regions.empty()) {
+            const VkBufferCopy copy{.srcOffset = 0, .dstOffset = 0, .size = m_BufferSize};
+            vkCmdCopyBuffer(commandBuffer, m_Buffer, duplicate->m_Buffer, 1, &copy);
+        }
+        else {
+            vkCmdCopyBuffer(
+                commandBuffer, m_Buffer, duplicate->m_Buffer, static_cast<uint32_t>(regions.size()), regions.data());
+        }
+        return duplicate;
     }
 
     VkDeviceSize Liara_Buffer::GetAlignment(const VkDeviceSize instanceSize, const VkDeviceSize minOffsetAlignment) {
@@ -91,34 +110,22 @@ namespace Liara::Graphics
         return instanceSize;
     }
 
-    VkResult Liara_Buffer::Map(const VkDeviceSize size, const VkDeviceSize offset) {
-        assert(m_Buffer && m_Memory && "Called map on buffer before create");
-        return vkMapMemory(m_Device.GetDevice(), m_Memory, offset, size, 0, &m_Mapped);
+    VkResult Liara_Buffer::Map(const VkDeviceSize /*size*/, const VkDeviceSize offset) {
+        assert(m_Buffer && m_Allocation.IsValid() && "Called map on buffer before create");
+        // Host visible memory stays mapped by the allocator, mapping only points into it
+        if (m_Allocation.mapped == nullptr) { return VK_ERROR_MEMORY_MAP_FAILED; }
+        m_Mapped = static_cast<std::byte*>(m_Allocation.mapped) + offset;
+        return VK_SUCCESS;
     }
 
-    void Liara_Buffer::Unmap() {
-        if (m_Mapped != nullptr) {
-            vkUnmapMemory(m_Device.GetDevice(), m_Memory);
-            m_Mapped = nullptr;
-        }
-    }
+    void Liara_Buffer::Unmap() { m_Mapped = nullptr; }
 
     VkResult Liara_Buffer::Flush(const VkDeviceSize size, const VkDeviceSize offset) const {
-        const VkMappedMemoryRange mappedRange{.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
-                                              .pNext = nullptr,
-                                              .memory = m_Memory,
-                                              .offset = offset,
-                                              .size = size};
-        return vkFlushMappedMemoryRanges(m_Device.GetDevice(), 1, &mappedRange);
+        return m_Device.GetMemoryAllocator().Flush(m_Allocation, size, offset);
     }
 
     VkResult Liara_Buffer::Invalidate(const VkDeviceSize size, const VkDeviceSize offset) const {
-        const VkMappedMemoryRange mappedRange{.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
-                                              .pNext = nullptr,
-                                              .memory = m_Memory,
-                                              .offset = offset,
-                                              .size = size};
-        return vkInvalidateMappedMemoryRanges(m_Device.GetDevice(), 1, &mappedRange);
+        return m_Device.GetMemoryAllocator().Invalidate(m_Allocation, size, offset);
     }
 
     VkResult Liara_Buffer::FlushIndex(const uint32_t index) const {
@@ -34,13 +34,35 @@ namespace Liara::Graphics
         VkDeviceSize minOffsetAlignment = 1;
 
         // Predefined configurations for common buffer types
+        /// Transfer source too, for the defragmenter to copy it elsewhere
         static constexpr BufferConfig Vertex() {
-            return {.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            return {.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                             | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                     .memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT};
         }
 
         static constexpr BufferConfig Index() {
-            return {.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            return {.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                             | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                    .memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT};
+        }
+
+        /// Per-instance vertex attributes, rewritten by the CPU every frame
+        static constexpr BufferConfig Instance() {
+            return {.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                    .memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
+        }
+
+        /// Shader storage rewritten by the CPU every frame
+        static constexpr BufferConfig Storage() {
+            return {.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                    .memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
+        }
+
+        /// Shader storage written on the GPU by compute shaders, also readable as indirect draw parameters
+        static constexpr BufferConfig DeviceStorage() {
+            return {.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+                             | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                     .memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT};
         }
 
@@ -183,6 +205,15 @@ namespace Liara::Graphics
         [[nodiscard]] VkDeviceSize GetAlignmentSize() const noexcept { return m_AlignmentSize; }
         [[nodiscard]] VkBufferUsageFlags GetUsageFlags() const noexcept { return m_UsageFlags; }
         [[nodiscard]] VkMemoryPropertyFlags GetMemoryPropertyFlags() const noexcept { return m_MemoryPropertyFlags; }
+        [[nodiscard]] const MemoryAllocation& GetAllocation() const noexcept { return m_Allocation; }
+
+        /**
+         * @brief Creates a buffer of the same size and configuration, and records the copy of the content into it.
+         * This buffer must be a transfer source and a transfer destination.
+         * @param regions Ranges to copy, at the same offsets in both buffers. The whole content if empty.
+         */
+        [[nodiscard]] std::unique_ptr<Liara_Buffer> Duplicate(VkCommandBuffer commandBuffer,
+                                                              std::span<const VkBufferCopy> regions = {}) const;
 
     private:
         void CreateBuffer();
@@ -193,7 +224,7 @@ namespace Liara::Graphics
         Liara_Device& m_Device;
         void* m_Mapped = nullptr;
         VkBuffer m_Buffer = VK_NULL_HANDLE;
-        VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+        MemoryAllocation m_Allocation;
 
         VkDeviceSize m_BufferSize;
         uint32_t m_InstanceCount = 1;
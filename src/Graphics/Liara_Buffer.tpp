@@ -2,12 +2,14 @@
 
 #include "Liara_Buffer.h"
 #include "Graphics/Liara_Device.h"
+#include "Graphics/Liara_UploadContext.h"
 
 #include <vulkan/vulkan_core.h>
 
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <span>
 #include <stdexcept>
 
 #include "glm/fwd.hpp"
@@ -35,12 +37,10 @@ namespace Liara::Graphics
             WriteData(data);
         }
         else {
-            Liara_Buffer stagingBuffer(device, data, BufferConfig::Staging());
-            auto stagingMapping = stagingBuffer.CreateMappingGuard();
-            stagingBuffer.WriteData(data);
-            stagingMapping.~MappingGuard();  // Explicit unmap
-
-            device.CopyBuffer(stagingBuffer.GetBuffer(), m_Buffer, data.size_bytes());
+            // Staged in the upload ring, the work submitted after the batch sees the data
+            Liara_UploadBatch batch = device.GetUploadContext().Begin();
+            batch.CopyToBuffer(std::as_bytes(data), m_Buffer, 0);
+            batch.Submit();
         }
     }
 
@@ -0,0 +1,114 @@
+#include "Liara_Defragmenter.h"
+
+#include "Core/Logging/LogMacros.h"
+#include "Graphics/Liara_Buffer.h"
+#include "Graphics/Liara_Device.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    RetiredResource::RetiredResource() = default;
+    RetiredResource::~RetiredResource() = default;
+    RetiredResource::RetiredResource(RetiredResource&&) noexcept = default;
+    RetiredResource& RetiredResource::operator=(RetiredResource&&) noexcept = default;
+
+    Liara_Defragmenter::Liara_Defragmenter(Liara_Device& device, const uint32_t framesInFlight)
+        : m_Device(device)
+        , m_Retired(framesInFlight)
+        , m_RetiredGeometry(framesInFlight) {
+        LIARA_CHECK_ARGUMENT(framesInFlight > 0, LogGraphics, "The defragmenter needs at least one frame in flight");
+    }
+
+    Liara_Defragmenter::~Liara_Defragmenter() {
+        for (uint32_t frameIndex = 0; frameIndex < m_Retired.size(); ++frameIndex) { ReleaseRetired(frameIndex); }
+    }
+
+    VkDeviceSize Liara_Defragmenter::Step(VkCommandBuffer commandBuffer,
+                                          const uint32_t frameIndex,
+                                          const VkDeviceSize budget) {
+        LIARA_CHECK_OUT_OF_RANGE(frameIndex < m_Retired.size(), LogGraphics, "Frame index {} out of range", frameIndex);
+        ReleaseRetired(frameIndex);
+        // The previous frame, that copied the relocated geometry, is submitted
+        m_Device.GetGeometryPool().RetireDeferred(m_RetiredGeometry[frameIndex]);
+        if (budget == 0) { return 0; }
+
+        // Compacting the geometry frees whole ranges at the end of the blocks, before any block is evacuated
+        VkDeviceSize moved = m_Device.GetGeometryPool().Compact(commandBuffer, budget, m_RetiredGeometry[frameIndex]);
+        if (moved > 0) {
+            // An evacuated geometry buffer is read once compacted
+            const VkMemoryBarrier barrier{.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                          .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                                          .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT};
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 0,
+                                 1,
+                                 &barrier,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr);
+        }
+
+        Liara_MemoryAllocator& allocator = m_Device.GetMemoryAllocator();
+        if (!m_Evacuation) { m_Evacuation = allocator.BeginEvacuation(); }
+        if (m_Evacuation) {
+            const auto relocatables = allocator.GetRelocatables(*m_Evacuation);
+            if (relocatables.empty()) {
+                LIARA_LOG_VERBOSE(LogGraphics,
+                                  "Memory block {} of pool {} evacuated",
+                                  m_Evacuation->block,
+                                  m_Evacuation->pool);
+                m_Evacuation.reset();
+            }
+
+            for (const auto& [allocation, owner] : relocatables) {
+                if (moved > 0 && moved + allocation.size > budget) { break; }
+
+                // Forgotten first, the owner registers the new allocation itself
+                allocator.SetRelocatable(allocation, nullptr);
+                RetiredResource retired;
+                moved += owner->Relocate(allocation, commandBuffer, retired);
+                m_Retired[frameIndex].push_back(std::move(retired));
+            }
+        }
+
+        // Everything recorded after reads the new locations
+        if (moved > 0) {
+            const VkMemoryBarrier barrier{.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                          .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                                          .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT};
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                 0,
+                                 1,
+                                 &barrier,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr);
+        }
+        return moved;
+    }
+
+    void Liara_Defragmenter::ReleaseRetired(const uint32_t frameIndex) {
+        for (RetiredResource& retired : m_Retired[frameIndex]) {
+            retired.buffer.reset();
+            if (retired.view != VK_NULL_HANDLE) { vkDestroyImageView(m_Device.GetDevice(), retired.view, nullptr); }
+            if (retired.image != VK_NULL_HANDLE) { vkDestroyImage(m_Device.GetDevice(), retired.image, nullptr); }
+            m_Device.FreeMemory(retired.memory);
+        }
+        m_Retired[frameIndex].clear();
+
+        for (GeometryAllocation& range : m_RetiredGeometry[frameIndex]) { m_Device.GetGeometryPool().Free(range); }
+        m_RetiredGeometry[frameIndex].clear();
+    }
+}
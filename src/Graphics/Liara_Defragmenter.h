@@ -0,0 +1,61 @@
+/**
+ * @file Liara_Defragmenter.h
+ * @brief Defines the `Liara_Defragmenter` class, which compacts the GPU memory a little every frame.
+ *
+ * Streaming resources in and out over a long session leaves holes in the geometry pool and sparse device memory
+ * blocks. Every frame, within a byte budget, the defragmenter records transfer commands at the start of the frame:
+ *      - models at the end of a geometry block move into the holes before them, their offsets patched in place
+ *      - relocatable buffers and images move out of the sparsest memory block, one block at a time, their owners
+ *        recreating them and patching what refers to them. The block goes back to the driver once empty.
+ *
+ * The draws of the frame already use the new locations. What was moved away is only released when the frame index
+ * comes back, the frames in flight that could still read it being done by then.
+ */
+
+#pragma once
+
+#include "Graphics/Liara_GeometryPool.h"
+#include "Graphics/Liara_MemoryAllocator.h"
+#include "Graphics/Liara_Relocatable.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    class Liara_Device;
+
+    /**
+     * @class Liara_Defragmenter
+     * @brief Incremental compaction of the geometry pool and the device memory blocks. Main thread only.
+     */
+    class Liara_Defragmenter
+    {
+    public:
+        Liara_Defragmenter(Liara_Device& device, uint32_t framesInFlight);
+        ~Liara_Defragmenter();
+
+        Liara_Defragmenter(const Liara_Defragmenter&) = delete;
+        Liara_Defragmenter& operator=(const Liara_Defragmenter&) = delete;
+
+        /**
+         * @brief Releases what the frame moved last time, then records this frame's moves.
+         * Must be recorded before anything in the command buffer reads the moved resources.
+         * @param frameIndex Frame the command buffer belongs to, its previous submission must be done.
+         * @param budget Bytes to copy at most, a single resource larger than it still moves alone. 0 only releases.
+         * @return Bytes copied.
+         */
+        VkDeviceSize Step(VkCommandBuffer commandBuffer, uint32_t frameIndex, VkDeviceSize budget);
+
+    private:
+        void ReleaseRetired(uint32_t frameIndex);
+
+        Liara_Device& m_Device;
+        std::vector<std::vector<RetiredResource>> m_Retired;             ///< By frame index
+        std::vector<std::vector<GeometryAllocation>> m_RetiredGeometry;  ///< Ranges given back to the pool, by frame
+        std::optional<MemoryBlockRef> m_Evacuation;                      ///< Block being emptied, if any
+    };
+}
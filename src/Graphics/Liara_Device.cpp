@@ -1,6 +1,11 @@
 #include "Liara_Device.h"
 
 #include "Core/Liara_SettingsManager.h"
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/Liara_GeometryPool.h"
+#include "Graphics/Liara_MemoryAllocator.h"
+#include "Graphics/Liara_Model.h"
+#include "Graphics/Liara_UploadContext.h"
 #include "Plateform/Liara_Window.h"
 
 #include <vulkan/vk_platform.h>
@@ -9,6 +14,8 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <memory>
 #include <SDL2/SDL_stdinc.h>
 #include <SDL2/SDL_vulkan.h>
 #include <set>
@@ -60,17 +67,27 @@ namespace Liara::Graphics
 #ifndef NDEBUG
         SetupDebugMessenger();
 #endif
-        CreateSurface();
+        if (!IsHeadless()) {
+            CreateSurface();
+            m_DeviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
         PickPhysicalDevice();
         CreateLogicalDevice();
         CreateCommandPool();
+        m_MemoryAllocator = std::make_unique<Liara_MemoryAllocator>(*this);
+        m_UploadContext = std::make_unique<Liara_UploadContext>(
+            *this, m_SettingsManager.GetUInt("memory.staging_ring_size"), Constants::MAX_FRAMES_IN_FLIGHT);
+        m_GeometryPool = std::make_unique<Liara_GeometryPool>(*this, sizeof(Liara_Model::Vertex));
     }
 
     Liara_Device::~Liara_Device() {
+        m_GeometryPool.reset();
+        m_UploadContext.reset();
+        m_MemoryAllocator.reset();
         vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
         vkDestroyDevice(m_Device, nullptr);
         DestroyDebugUtilsMessengerEXT(m_Instance, m_DebugMessenger, nullptr);
-        vkDestroySurfaceKHR(m_Instance, m_Surface, nullptr);
+        if (m_Surface != VK_NULL_HANDLE) { vkDestroySurfaceKHR(m_Instance, m_Surface, nullptr); }
         vkDestroyInstance(m_Instance, nullptr);
     }
 
@@ -146,7 +163,8 @@ namespace Liara::Graphics
         const QueueFamilyIndices indices = FindQueueFamilies(m_PhysicalDevice);
 
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-        const std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily, indices.presentFamily};
+        const std::set<uint32_t> uniqueQueueFamilies = {
+            indices.graphicsFamily, indices.presentFamily, indices.transferFamily};
 
         constexpr float queuePriority = 1.0f;
         for (const uint32_t queueFamily : uniqueQueueFamilies) {
@@ -162,6 +180,35 @@ namespace Liara::Graphics
         deviceFeatures.samplerAnisotropy =
             m_SettingsManager.GetBool("texture.use_anisotropic_filtering") ? VK_TRUE : VK_FALSE;
 
+        // GPU-driven rendering records one indirect draw per mesh, with the draw count written by a compute shader.
+        // Each draw carries the first instance of its mesh, which needs drawIndirectFirstInstance
+        VkPhysicalDeviceVulkan12Features supportedVulkan12Features{};
+        supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        VkPhysicalDeviceFeatures2 supportedFeatures{};
+        supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures.pNext = &supportedVulkan12Features;
+        vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &supportedFeatures);
+
+        m_DrawIndirectCountSupported = supportedFeatures.features.multiDrawIndirect == VK_TRUE
+                                       && supportedFeatures.features.drawIndirectFirstInstance == VK_TRUE
+                                       && supportedVulkan12Features.drawIndirectCount == VK_TRUE;
+        deviceFeatures.multiDrawIndirect = supportedFeatures.features.multiDrawIndirect;
+        deviceFeatures.drawIndirectFirstInstance = supportedFeatures.features.drawIndirectFirstInstance;
+        VkPhysicalDeviceVulkan12Features vulkan12Features{};
+        vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        vulkan12Features.drawIndirectCount = supportedVulkan12Features.drawIndirectCount;
+        // The uploads signal their completion on a timeline semaphore, the frames wait on it
+        LIARA_CHECK_RUNTIME(supportedVulkan12Features.timelineSemaphore == VK_TRUE,
+                            LogVulkan,
+                            "Device does not support timeline semaphores!");
+        vulkan12Features.timelineSemaphore = VK_TRUE;
+        if (!m_DrawIndirectCountSupported && m_SettingsManager.GetBool("render.gpu_driven")) {
+            LIARA_LOG_WARNING(LogVulkan,
+                              "Device does not support multi-draw indirect with draw counts and first instances, "
+                              "disabling GPU-driven rendering");
+            m_SettingsManager.SetBool("render.gpu_driven", false);
+        }
+
         VkPhysicalDeviceProperties properties{};
         vkGetPhysicalDeviceProperties(m_PhysicalDevice, &properties);
         m_SettingsManager.SetUInt("texture.max_anisotropy",
@@ -174,7 +221,12 @@ namespace Liara::Graphics
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
 
-        createInfo.pEnabledFeatures = &deviceFeatures;
+        VkPhysicalDeviceFeatures2 enabledFeatures{};
+        enabledFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        enabledFeatures.pNext = &vulkan12Features;
+        enabledFeatures.features = deviceFeatures;
+        createInfo.pNext = &enabledFeatures;
+        createInfo.pEnabledFeatures = nullptr;  // Given by enabledFeatures instead
         createInfo.enabledExtensionCount = static_cast<uint32_t>(m_DeviceExtensions.size());
         createInfo.ppEnabledExtensionNames = m_DeviceExtensions.data();
 
@@ -191,6 +243,18 @@ namespace Liara::Graphics
 
         vkGetDeviceQueue(m_Device, indices.graphicsFamily, 0, &m_GraphicsQueue);
         vkGetDeviceQueue(m_Device, indices.presentFamily, 0, &m_PresentQueue);
+        vkGetDeviceQueue(m_Device, indices.transferFamily, 0, &m_TransferQueue);
+        if (indices.transferFamily != indices.graphicsFamily) {
+            uint32_t familyCount = 0;
+            vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &familyCount, nullptr);
+            std::vector<VkQueueFamilyProperties> families(familyCount);
+            vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &familyCount, families.data());
+            const bool asyncCompute = (families[indices.transferFamily].queueFlags & VK_QUEUE_COMPUTE_BIT) != 0u;
+            LIARA_LOG_INFO(LogVulkan,
+                           "Uploading on the {} queue family {}",
+                           asyncCompute ? "async compute" : "transfer-only",
+                           indices.transferFamily);
+        }
     }
 
     void Liara_Device::CreateCommandPool() {
@@ -213,8 +277,9 @@ namespace Liara::Graphics
 
         const bool extensionsSupported = CheckDeviceExtensionSupport(device);
 
-        bool swapChainAdequate = false;
-        if (extensionsSupported) {
+        // Nothing is presented without a surface
+        bool swapChainAdequate = IsHeadless();
+        if (extensionsSupported && !IsHeadless()) {
             const SwapChainSupportDetails swapChainSupport = QuerySwapChainSupport(device);
             swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
         }
@@ -294,6 +359,14 @@ namespace Liara::Graphics
     }
 
     std::vector<const char*> Liara_Device::GetRequiredExtensions() const {
+        if (IsHeadless()) {
+            std::vector<const char*> extensions;
+#ifndef NDEBUG
+            extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+#endif
+            return extensions;
+        }
+
         // Get the count
         uint32_t sdlExtensionCount = 0;
         if (SDL_Vulkan_GetInstanceExtensions(m_Window.GetWindow(), &sdlExtensionCount, nullptr) == 0u) {
@@ -368,17 +441,45 @@ namespace Liara::Graphics
                 indices.graphicsFamily = i;
                 indices.graphicsFamilyHasValue = true;
             }
-            VkBool32 presentSupport = 0u;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupport);
-            if (queueFamily.queueCount > 0 && presentSupport != 0u) {
-                indices.presentFamily = i;
-                indices.presentFamilyHasValue = true;
+            if (IsHeadless()) {
+                // No present queue needed, the graphics queue stands in for it
+                indices.presentFamily = indices.graphicsFamily;
+                indices.presentFamilyHasValue = indices.graphicsFamilyHasValue;
+            }
+            else {
+                VkBool32 presentSupport = 0u;
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupport);
+                if (queueFamily.queueCount > 0 && presentSupport != 0u) {
+                    indices.presentFamily = i;
+                    indices.presentFamilyHasValue = true;
+                }
             }
             if (indices.IsComplete()) { break; }
 
             i++;
         }
 
+        // A family without graphics or compute maps to the copy engines, uploads there run alongside the frames.
+        // Any graphics family supports transfers, even when it does not report it.
+        indices.transferFamily = indices.graphicsFamily;
+        bool asyncCompute = false;
+        for (uint32_t family = 0; family < queueFamilyCount; ++family) {
+            const VkQueueFlags flags = queueFamilies[family].queueFlags;
+            if (queueFamilies[family].queueCount == 0 || (flags & VK_QUEUE_TRANSFER_BIT) == 0u
+                || (flags & VK_QUEUE_GRAPHICS_BIT) != 0u) {
+                continue;
+            }
+            if ((flags & VK_QUEUE_COMPUTE_BIT) == 0u) {
+                indices.transferFamily = family;
+                break;
+            }
+            if (!asyncCompute) {
+                // An async compute family still has its own queue, unless a transfer-only one comes later
+                indices.transferFamily = family;
+                asyncCompute = true;
+            }
+        }
+
         return indices;
     }
 
@@ -438,7 +539,7 @@ namespace Liara::Graphics
                                     const VkBufferUsageFlags usage,
                                     const VkMemoryPropertyFlags properties,
                                     VkBuffer& buffer,
-                                    VkDeviceMemory& bufferMemory) const {
+                                    MemoryAllocation& bufferMemory) const {
         VkBufferCreateInfo bufferInfo{};
         bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         bufferInfo.size = size;
@@ -449,19 +550,7 @@ namespace Liara::Graphics
             LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to create buffer!");
         }
 
-        VkMemoryRequirements memRequirements;
-        vkGetBufferMemoryRequirements(m_Device, buffer, &memRequirements);
-
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
-
-        if (vkAllocateMemory(m_Device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to allocate buffer memory!");
-        }
-
-        vkBindBufferMemory(m_Device, buffer, bufferMemory, 0);
+        bufferMemory = m_MemoryAllocator->AllocateBufferMemory(buffer, properties);
     }
 
     VkCommandBuffer Liara_Device::BeginSingleTimeCommands() const {
@@ -490,27 +579,36 @@ namespace Liara::Graphics
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &commandBuffer;
 
-        vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(m_GraphicsQueue);
+        // Waits for this submission only, not for the frames in flight on the same queue
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        VkFence fence = VK_NULL_HANDLE;
+        if (vkCreateFence(m_Device, &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to create a fence for single-time commands!");
+        }
+        vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, fence);
+        vkWaitForFences(m_Device, 1, &fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        vkDestroyFence(m_Device, fence, nullptr);
 
         vkFreeCommandBuffers(m_Device, m_CommandPool, 1, &commandBuffer);
     }
 
-    void Liara_Device::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkDeviceSize size) const {
-        VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
+    UploadTicket Liara_Device::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkDeviceSize size) const {
+        Liara_UploadBatch batch = m_UploadContext->Begin();
 
         VkBufferCopy copyRegion{};
         copyRegion.srcOffset = 0;  // Optional
         copyRegion.dstOffset = 0;  // Optional
         copyRegion.size = size;
-        vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+        vkCmdCopyBuffer(batch.GetCommandBuffer(), srcBuffer, dstBuffer, 1, &copyRegion);
+        batch.ReleaseBuffer(dstBuffer, 0, size);
 
-        EndSingleTimeCommands(commandBuffer);
+        return batch.Submit();
     }
 
-    void Liara_Device::CopyBufferToImage(
+    UploadTicket Liara_Device::CopyBufferToImage(
         VkBuffer buffer, VkImage image, const uint32_t width, const uint32_t height, const uint32_t layerCount) const {
-        VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
+        Liara_UploadBatch batch = m_UploadContext->Begin();
 
         VkBufferImageCopy region{};
         region.bufferOffset = 0;
@@ -525,32 +623,29 @@ namespace Liara::Graphics
         region.imageOffset = {.x = 0, .y = 0, .z = 0};
         region.imageExtent = {.width = width, .height = height, .depth = 1};
 
-        vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-        EndSingleTimeCommands(commandBuffer);
+        vkCmdCopyBufferToImage(
+            batch.GetCommandBuffer(), buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        batch.ReleaseImage(image,
+                           VkImageSubresourceRange{.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                                                   .baseMipLevel = 0,
+                                                   .levelCount = 1,
+                                                   .baseArrayLayer = 0,
+                                                   .layerCount = layerCount},
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        return batch.Submit();
     }
 
     void Liara_Device::CreateImageWithInfo(const VkImageCreateInfo& imageInfo,
                                            const VkMemoryPropertyFlags properties,
                                            VkImage& image,
-                                           VkDeviceMemory& imageMemory) const {
+                                           MemoryAllocation& imageMemory) const {
         if (vkCreateImage(m_Device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
             LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to create image!");
         }
 
-        VkMemoryRequirements memRequirements;
-        vkGetImageMemoryRequirements(m_Device, image, &memRequirements);
-
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
-
-        if (vkAllocateMemory(m_Device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to allocate image memory!");
-        }
-
-        if (vkBindImageMemory(m_Device, image, imageMemory, 0) != VK_SUCCESS) {
-            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to bind image memory!");
-        }
+        imageMemory = m_MemoryAllocator->AllocateImageMemory(image, imageInfo.tiling, properties);
     }
+
+    void Liara_Device::FreeMemory(MemoryAllocation& memory) const { m_MemoryAllocator->Free(memory); }
 }
\ No newline at end of file
@@ -4,20 +4,26 @@
  *
  * This class is responsible for creating and managing a Vulkan logical device, command pool, and surface
  * as well as providing helper functions for buffer and image creation, and swap chain support.
+ * With a headless window, the device is created without surface, present support nor swap chain extension.
  */
 
 #pragma once
 #include "Core/Liara_SettingsManager.h"
+#include "Graphics/Liara_MemoryAllocator.h"
+#include "Graphics/Liara_UploadContext.h"
 #include "Plateform/Liara_Window.h"
 
 #include <vulkan/vulkan_core.h>
 
 #include <cstdint>
+#include <memory>
 #include <SDL2/SDL_vulkan.h>
 #include <vector>
 
 namespace Liara::Graphics
 {
+    class Liara_GeometryPool;
+
     /**
      * @struct SwapChainSupportDetails
      * @brief Structure holding the swap chain support details for a Vulkan physical device.
@@ -31,12 +37,13 @@ namespace Liara::Graphics
 
     /**
      * @struct QueueFamilyIndices
-     * @brief Structure holding the indices of the graphics and present families for Vulkan queues.
+     * @brief Structure holding the indices of the graphics, present and transfer families for Vulkan queues.
      */
     struct QueueFamilyIndices
     {
         uint32_t graphicsFamily{};            ///< Graphics family index
         uint32_t presentFamily{};             ///< Present family index
+        uint32_t transferFamily{};            ///< Transfer-only family, else async compute, else the graphics family
         bool graphicsFamilyHasValue = false;  ///< Graphics family has value
         bool presentFamilyHasValue = false;   ///< Present family has value
 
@@ -79,9 +86,21 @@ namespace Liara::Graphics
         [[nodiscard]] VkSurfaceKHR GetSurface() const { return m_Surface; }
         [[nodiscard]] VkQueue GetGraphicsQueue() const { return m_GraphicsQueue; }
         [[nodiscard]] VkQueue GetPresentQueue() const { return m_PresentQueue; }
+        /// Queue the uploads are submitted to, the graphics queue itself without another family supporting transfers
+        [[nodiscard]] VkQueue GetTransferQueue() const { return m_TransferQueue; }
         [[nodiscard]] VkInstance GetInstance() const { return m_Instance; }
         [[nodiscard]] VkPhysicalDevice GetPhysicalDevice() const { return m_PhysicalDevice; }
         [[nodiscard]] uint32_t GetGraphicsQueueFamily() const { return FindPhysicalQueueFamilies().graphicsFamily; }
+        [[nodiscard]] uint32_t GetTransferQueueFamily() const { return FindPhysicalQueueFamilies().transferFamily; }
+        [[nodiscard]] bool IsHeadless() const { return m_Window.IsHeadless(); }
+        /// multiDrawIndirect, drawIndirectFirstInstance and drawIndirectCount are enabled, for GPU-driven rendering
+        [[nodiscard]] bool IsDrawIndirectCountSupported() const { return m_DrawIndirectCountSupported; }
+        /// Shared vertex and index buffers the models suballocate their geometry from
+        [[nodiscard]] Liara_GeometryPool& GetGeometryPool() const { return *m_GeometryPool; }
+        /// Suballocator the memory of every buffer and image comes from
+        [[nodiscard]] Liara_MemoryAllocator& GetMemoryAllocator() const { return *m_MemoryAllocator; }
+        /// Staging ring and batches the uploads to device local resources go through
+        [[nodiscard]] Liara_UploadContext& GetUploadContext() const { return *m_UploadContext; }
 
         /**
          * @brief Retrieves swap chain support details for the physical device.
@@ -101,7 +120,7 @@ namespace Liara::Graphics
 
         /**
          * @brief Finds queue families for the physical device.
-         * @return A `QueueFamilyIndices` structure with indices for graphics and present families.
+         * @return A `QueueFamilyIndices` structure with indices for graphics, present and transfer families.
          */
         [[nodiscard]] QueueFamilyIndices FindPhysicalQueueFamilies() const {
             return FindQueueFamilies(m_PhysicalDevice);
@@ -125,13 +144,13 @@ namespace Liara::Graphics
          * @param usage The buffer usage flags.
          * @param properties The memory properties for the buffer.
          * @param buffer The buffer to be created.
-         * @param bufferMemory The memory to be allocated for the buffer.
+         * @param bufferMemory The memory suballocated for the buffer, to give back with FreeMemory.
          */
         void CreateBuffer(VkDeviceSize size,
                           VkBufferUsageFlags usage,
                           VkMemoryPropertyFlags properties,
                           VkBuffer& buffer,
-                          VkDeviceMemory& bufferMemory) const;
+                          MemoryAllocation& bufferMemory) const;
 
         /**
          * @brief Begins a single-time command buffer for immediate commands.
@@ -140,28 +159,32 @@ namespace Liara::Graphics
         [[nodiscard]] VkCommandBuffer BeginSingleTimeCommands() const;
 
         /**
-         * @brief Ends the single-time command buffer and submits the command.
+         * @brief Ends the single-time command buffer, submits it and waits for it to complete.
+         * Uploads should go through an upload batch instead, which does not wait.
          * @param commandBuffer The command buffer to submit.
          */
         void EndSingleTimeCommands(VkCommandBuffer commandBuffer) const;
 
         /**
-         * @brief Copies data from one buffer to another.
+         * @brief Copies data from one buffer to another, in an upload batch of its own.
          * @param srcBuffer The source buffer.
          * @param dstBuffer The destination buffer.
          * @param size The size of data to copy.
+         * @return The ticket of the batch, the source must be kept until it completes.
          */
-        void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) const;
+        UploadTicket CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) const;
 
         /**
-         * @brief Copies data from a buffer to an image.
+         * @brief Copies data from a buffer to the first mip level of an image, which stays in the transfer destination
+         * layout.
          * @param buffer The buffer containing the data.
          * @param image The image to copy the data to.
          * @param width The width of the image.
          * @param height The height of the image.
          * @param layerCount The number of layers in the image.
+         * @return The ticket of the batch, the buffer must be kept until it completes.
          */
-        void
+        UploadTicket
         CopyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount) const;
 
         /**
@@ -169,12 +192,18 @@ namespace Liara::Graphics
          * @param imageInfo The Vulkan image creation info structure.
          * @param properties The desired memory properties for the image.
          * @param image The created image.
-         * @param imageMemory The allocated memory for the image.
+         * @param imageMemory The memory suballocated for the image, to give back with FreeMemory.
          */
         void CreateImageWithInfo(const VkImageCreateInfo& imageInfo,
                                  VkMemoryPropertyFlags properties,
                                  VkImage& image,
-                                 VkDeviceMemory& imageMemory) const;
+                                 MemoryAllocation& imageMemory) const;
+
+        /**
+         * @brief Gives back the memory of a buffer or an image, once the resource is destroyed.
+         * @param memory The allocation, reset on return.
+         */
+        void FreeMemory(MemoryAllocation& memory) const;
 
         VkPhysicalDeviceProperties deviceProperties{};  ///< Physical device properties
 
@@ -281,9 +310,15 @@ namespace Liara::Graphics
         VkSurfaceKHR m_Surface{};   ///< Vulkan surface
         VkQueue m_GraphicsQueue{};  ///< Vulkan graphics queue
         VkQueue m_PresentQueue{};   ///< Vulkan present queue
+        VkQueue m_TransferQueue{};  ///< Vulkan transfer queue
+
+        bool m_DrawIndirectCountSupported = false;
+        std::unique_ptr<Liara_MemoryAllocator> m_MemoryAllocator;  ///< Destroyed before the logical device
+        std::unique_ptr<Liara_UploadContext> m_UploadContext;      ///< Destroyed before the memory allocator
+        std::unique_ptr<Liara_GeometryPool> m_GeometryPool;        ///< Destroyed before the upload context
 
         // Validation layers and device extensions required by the application
         const std::vector<const char*> m_ValidationLayers = {"VK_LAYER_KHRONOS_validation"};
-        const std::vector<const char*> m_DeviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+        std::vector<const char*> m_DeviceExtensions;  ///< Swap chain extension, unless headless
     };
 }
@@ -0,0 +1,271 @@
+#include "Liara_GeometryPool.h"
+
+#include "Core/Logging/LogMacros.h"
+#include "Graphics/Liara_Buffer.h"
+#include "Graphics/Liara_Device.h"
+#include "Graphics/Liara_MemoryAllocator.h"
+#include "Graphics/Liara_UploadContext.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    Liara_GeometryPool::Liara_GeometryPool(Liara_Device& device, const uint32_t vertexStride)
+        : m_Device(device)
+        , m_VertexStride(vertexStride) {
+        LIARA_CHECK_ARGUMENT(vertexStride > 0, LogGraphics, "The vertex stride of a geometry pool cannot be 0");
+    }
+
+    Liara_GeometryPool::~Liara_GeometryPool() = default;
+
+    GeometryAllocation Liara_GeometryPool::Allocate(const std::span<const std::byte> vertices,
+                                                    const std::span<const uint32_t> indices) {
+        LIARA_CHECK_ARGUMENT(!vertices.empty() && vertices.size() % m_VertexStride == 0,
+                             LogGraphics,
+                             "Vertices must be a non-empty multiple of the vertex stride");
+
+        GeometryAllocation allocation{.vertexCount = static_cast<uint32_t>(vertices.size() / m_VertexStride),
+                                      .indexCount = static_cast<uint32_t>(indices.size())};
+
+        // Both ranges must come from the same block, the draw binds a single one
+        const auto tryAllocate = [&](Block& block, const uint32_t blockIndex) {
+            const std::optional<uint64_t> vertexOffset = block.vertices.Allocate(allocation.vertexCount);
+            if (!vertexOffset) { return false; }
+            if (allocation.indexCount > 0) {
+                const std::optional<uint64_t> firstIndex = block.indices.Allocate(allocation.indexCount);
+                if (!firstIndex) {
+                    block.vertices.Free(*vertexOffset, allocation.vertexCount);
+                    return false;
+                }
+                allocation.firstIndex = static_cast<uint32_t>(*firstIndex);
+            }
+            allocation.block = blockIndex;
+            allocation.vertexOffset = static_cast<uint32_t>(*vertexOffset);
+            return true;
+        };
+
+        const std::scoped_lock lock(m_Mutex);
+        for (uint32_t b = 0; b < m_Blocks.size() && !allocation.IsValid(); ++b) { tryAllocate(*m_Blocks[b], b); }
+        if (!allocation.IsValid()) {
+            const uint32_t blockIndex = CreateBlock(allocation.vertexCount, allocation.indexCount);
+            LIARA_CHECK_RUNTIME(tryAllocate(*m_Blocks[blockIndex], blockIndex),
+                                LogGraphics,
+                                "A new geometry block is too small for its model");
+        }
+
+        // Recorded under the lock, the defragmenter could otherwise move the buffers of the block in between
+        Upload(allocation,
+               m_Blocks[allocation.block]->vertexBuffer->GetBuffer(),
+               m_Blocks[allocation.block]->indexBuffer->GetBuffer(),
+               vertices,
+               indices);
+        return allocation;
+    }
+
+    void Liara_GeometryPool::Track(GeometryAllocation& allocation) {
+        if (!allocation.IsValid()) { return; }
+
+        const std::scoped_lock lock(m_Mutex);
+        m_Tracked.insert(&allocation);
+    }
+
+    void Liara_GeometryPool::Free(GeometryAllocation& allocation) {
+        if (!allocation.IsValid()) { return; }
+
+        {
+            const std::scoped_lock lock(m_Mutex);
+            LIARA_CHECK_OUT_OF_RANGE(allocation.block < m_Blocks.size(), LogGraphics, "Geometry block out of range");
+            Block& block = *m_Blocks[allocation.block];
+            m_Tracked.erase(&allocation);
+            if (block.relocated) {
+                m_Deferred.push_back(allocation);
+                allocation = {};
+                return;
+            }
+            if (allocation.vertexCount > 0) { block.vertices.Free(allocation.vertexOffset, allocation.vertexCount); }
+            if (allocation.indexCount > 0) { block.indices.Free(allocation.firstIndex, allocation.indexCount); }
+        }
+        allocation = {};
+    }
+
+    void Liara_GeometryPool::RetireDeferred(std::vector<GeometryAllocation>& retired) {
+        const std::scoped_lock lock(m_Mutex);
+        for (const std::unique_ptr<Block>& block : m_Blocks) { block->relocated = false; }
+        retired.insert(retired.end(), m_Deferred.begin(), m_Deferred.end());
+        m_Deferred.clear();
+    }
+
+    VkDeviceSize Liara_GeometryPool::Compact(VkCommandBuffer commandBuffer,
+                                             const VkDeviceSize budget,
+                                             std::vector<GeometryAllocation>& retired) {
+        const std::scoped_lock lock(m_Mutex);
+        std::vector<GeometryAllocation*> allocations(m_Tracked.begin(), m_Tracked.end());
+        VkDeviceSize moved = 0;
+
+        // Vertices then indices. The range a model leaves stays reserved until retired, so a copy never overlaps
+        // another one, and the new range ends before the old one starts
+        const auto compact = [&](const bool vertices) {
+            const VkDeviceSize unitSize = vertices ? m_VertexStride : sizeof(uint32_t);
+            const auto offsetOf = [vertices](const GeometryAllocation* allocation) {
+                return vertices ? allocation->vertexOffset : allocation->firstIndex;
+            };
+            std::ranges::sort(allocations, std::greater{}, offsetOf);
+
+            for (uint32_t b = 0; b < m_Blocks.size(); ++b) {
+                Block& block = *m_Blocks[b];
+                Core::Memory::Liara_FreeListAllocator& ranges = vertices ? block.vertices : block.indices;
+
+                // A single free range is as large as all the free space, there is nothing to gain
+                if (ranges.GetStats().freeRangeCount <= 1) { continue; }
+
+                std::vector<VkBufferCopy> copies;
+                for (GeometryAllocation* allocation : allocations) {
+                    const uint32_t count = vertices ? allocation->vertexCount : allocation->indexCount;
+                    if (allocation->block != b || count == 0) { continue; }
+                    const VkDeviceSize size = count * unitSize;
+                    if (moved > 0 && moved + size > budget) { break; }
+
+                    const uint32_t offset = offsetOf(allocation);
+                    const std::optional<uint64_t> target = ranges.Allocate(count, 1, offset);
+                    if (!target) { continue; }
+
+                    copies.push_back({.srcOffset = offset * unitSize, .dstOffset = *target * unitSize, .size = size});
+                    if (vertices) {
+                        retired.push_back({.block = b, .vertexOffset = offset, .vertexCount = count});
+                        allocation->vertexOffset = static_cast<uint32_t>(*target);
+                    }
+                    else {
+                        retired.push_back({.block = b, .firstIndex = offset, .indexCount = count});
+                        allocation->firstIndex = static_cast<uint32_t>(*target);
+                    }
+                    moved += size;
+                }
+
+                if (!copies.empty()) {
+                    const VkBuffer buffer = (vertices ? block.vertexBuffer : block.indexBuffer)->GetBuffer();
+                    vkCmdCopyBuffer(commandBuffer, buffer, buffer, static_cast<uint32_t>(copies.size()), copies.data());
+                }
+            }
+        };
+        compact(true);
+        compact(false);
+        return moved;
+    }
+
+    VkDeviceSize Liara_GeometryPool::Relocate(const MemoryAllocation& allocation,
+                                              VkCommandBuffer commandBuffer,
+                                              RetiredResource& retired) {
+        const std::scoped_lock lock(m_Mutex);
+        for (const std::unique_ptr<Block>& block : m_Blocks) {
+            for (const bool vertices : {true, false}) {
+                std::unique_ptr<Liara_Buffer>& buffer = vertices ? block->vertexBuffer : block->indexBuffer;
+                const MemoryAllocation& current = buffer->GetAllocation();
+                if (current.memory != allocation.memory || current.offset != allocation.offset) { continue; }
+
+                // Only the reserved ranges, the uploads into the free ones land in the new buffer before the copy
+                const VkDeviceSize unitSize = vertices ? m_VertexStride : sizeof(uint32_t);
+                std::vector<VkBufferCopy> copies;
+                VkDeviceSize moved = 0;
+                for (const auto [offset, count] : (vertices ? block->vertices : block->indices).GetUsedRanges()) {
+                    const VkDeviceSize byteOffset = offset * unitSize;
+                    copies.push_back({.srcOffset = byteOffset, .dstOffset = byteOffset, .size = count * unitSize});
+                    moved += count * unitSize;
+                }
+
+                // Duplicate copies everything when given no range
+                std::unique_ptr<Liara_Buffer> duplicate;
+                if (copies.empty()) {
+                    duplicate = std::make_unique<Liara_Buffer>(
+                        m_Device, buffer->GetSize(), vertices ? BufferConfig::Vertex() : BufferConfig::Index());
+                }
+                else { duplicate = buffer->Duplicate(commandBuffer, copies); }
+                m_Device.GetMemoryAllocator().SetRelocatable(duplicate->GetAllocation(), this);
+                retired.buffer = std::exchange(buffer, std::move(duplicate));
+                block->relocated = true;
+                return moved;
+            }
+        }
+        LIARA_LOG_WARNING(LogGraphics, "No geometry buffer to relocate at offset {}", allocation.offset);
+        return 0;
+    }
+
+    void Liara_GeometryPool::Bind(VkCommandBuffer commandBuffer, const uint32_t block) const {
+        const std::scoped_lock lock(m_Mutex);
+        LIARA_CHECK_OUT_OF_RANGE(block < m_Blocks.size(), LogGraphics, "Geometry block out of range");
+        const VkBuffer vertexBuffer = m_Blocks[block]->vertexBuffer->GetBuffer();
+        constexpr VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &offset);
+        vkCmdBindIndexBuffer(commandBuffer, m_Blocks[block]->indexBuffer->GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
+    }
+
+    GeometryPoolStats Liara_GeometryPool::GetStats() const {
+        const std::scoped_lock lock(m_Mutex);
+        GeometryPoolStats stats{.blockCount = static_cast<uint32_t>(m_Blocks.size())};
+        uint64_t largestFree = 0;  // In bytes
+        for (const std::unique_ptr<Block>& block : m_Blocks) {
+            const Core::Memory::FreeListStats vertices = block->vertices.GetStats();
+            const Core::Memory::FreeListStats indices = block->indices.GetStats();
+            stats.allocationCount += static_cast<uint32_t>(vertices.allocationCount);
+            stats.vertexCapacity += vertices.capacity;
+            stats.vertexUsed += vertices.used;
+            stats.indexCapacity += indices.capacity;
+            stats.indexUsed += indices.used;
+            largestFree += vertices.largestFreeRange * m_VertexStride + indices.largestFreeRange * sizeof(uint32_t);
+        }
+
+        const uint64_t freeBytes = (stats.vertexCapacity - stats.vertexUsed) * m_VertexStride
+                                   + (stats.indexCapacity - stats.indexUsed) * sizeof(uint32_t);
+        if (freeBytes > 0) {
+            stats.fragmentation = 1.0f - static_cast<float>(largestFree) / static_cast<float>(freeBytes);
+        }
+        return stats;
+    }
+
+    uint32_t Liara_GeometryPool::CreateBlock(const uint32_t vertexCount, const uint32_t indexCount) {
+        const uint32_t vertexCapacity = std::max(vertexCount, DEFAULT_BLOCK_VERTICES);
+        const uint32_t indexCapacity = std::max(indexCount, DEFAULT_BLOCK_INDICES);
+
+        auto block = std::make_unique<Block>(Block{
+            .vertexBuffer = std::make_unique<Liara_Buffer>(
+                m_Device, static_cast<VkDeviceSize>(vertexCapacity) * m_VertexStride, BufferConfig::Vertex()),
+            .indexBuffer = std::make_unique<Liara_Buffer>(
+                m_Device, static_cast<VkDeviceSize>(indexCapacity) * sizeof(uint32_t), BufferConfig::Index()),
+            .vertices = Core::Memory::Liara_FreeListAllocator(vertexCapacity),
+            .indices = Core::Memory::Liara_FreeListAllocator(indexCapacity)});
+        m_Device.GetMemoryAllocator().SetRelocatable(block->vertexBuffer->GetAllocation(), this);
+        m_Device.GetMemoryAllocator().SetRelocatable(block->indexBuffer->GetAllocation(), this);
+        m_Blocks.push_back(std::move(block));
+
+        LIARA_LOG_VERBOSE(LogGraphics,
+                          "Geometry block {} created for {} vertices and {} indices",
+                          m_Blocks.size() - 1,
+                          vertexCapacity,
+                          indexCapacity);
+        return static_cast<uint32_t>(m_Blocks.size() - 1);
+    }
+
+    void Liara_GeometryPool::Upload(const GeometryAllocation& allocation,
+                                    VkBuffer vertexBuffer,
+                                    VkBuffer indexBuffer,
+                                    const std::span<const std::byte> vertices,
+                                    const std::span<const uint32_t> indices) const {
+        // Vertices then indices, in one batch not waited on: the draws are submitted after it
+        Liara_UploadBatch batch = m_Device.GetUploadContext().Begin();
+        batch.CopyToBuffer(vertices, vertexBuffer, static_cast<VkDeviceSize>(allocation.vertexOffset) * m_VertexStride);
+        batch.CopyToBuffer(std::as_bytes(indices),
+                           indexBuffer,
+                           static_cast<VkDeviceSize>(allocation.firstIndex) * sizeof(uint32_t));
+        batch.Submit();
+    }
+}
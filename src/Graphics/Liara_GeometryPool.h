@@ -0,0 +1,169 @@
+/**
+ * @file Liara_GeometryPool.h
+ * @brief Defines the `Liara_GeometryPool` class, which suballocates the geometry of every model from shared buffers.
+ *
+ * Instead of a vertex and an index buffer per model, the pool keeps a few large blocks, each a vertex buffer and an
+ * index buffer with a free-list allocator over them. A model only records where its vertices and indices start:
+ * its indices stay relative to its first vertex, which is passed as the vertexOffset of the draw.
+ * Models of the same block are drawn with the block bound once, and a single indirect draw can span several of them.
+ *
+ * A block is created when a model fits in none of the existing ones, as large as the default or as the model.
+ * Blocks are kept once created, freed ranges being reused by the next models. The defragmenter moves tracked models
+ * into the holes before them, and the buffers of the blocks out of sparse device memory.
+ *
+ * Moving a buffer only copies its reserved ranges, the uploads of the same frame run before the copy and may write
+ * the free ones. A range freed in the frame its block moved stays reserved until the defragmenter retires it, another
+ * model would otherwise be uploaded where the copy writes.
+ */
+
+#pragma once
+
+#include "Core/Memory/Liara_FreeListAllocator.h"
+#include "Graphics/Liara_Relocatable.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    class Liara_Buffer;
+    class Liara_Device;
+
+    /**
+     * @struct GeometryAllocation
+     * @brief Ranges of a model in the vertex and index buffers of a block, in vertices and indices.
+     */
+    struct GeometryAllocation
+    {
+        static constexpr uint32_t NO_BLOCK = std::numeric_limits<uint32_t>::max();
+
+        uint32_t block = NO_BLOCK;
+        uint32_t vertexOffset = 0;
+        uint32_t vertexCount = 0;
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;  ///< 0 for a model drawn without indices
+
+        [[nodiscard]] bool IsValid() const { return block != NO_BLOCK; }
+    };
+
+    /**
+     * @struct GeometryPoolStats
+     * @brief Usage of the pool, summed over its blocks.
+     */
+    struct GeometryPoolStats
+    {
+        uint32_t blockCount = 0;
+        uint32_t allocationCount = 0;
+        uint64_t vertexCapacity = 0;
+        uint64_t vertexUsed = 0;
+        uint64_t indexCapacity = 0;
+        uint64_t indexUsed = 0;
+        float fragmentation = 0.0f;  ///< 1 - largest free range / free space, vertices and indices of all blocks
+    };
+
+    /**
+     * @class Liara_GeometryPool
+     * @brief Shared vertex and index buffers the models suballocate their geometry from. Thread safe.
+     */
+    class Liara_GeometryPool final : public Liara_Relocatable
+    {
+    public:
+        static constexpr uint32_t DEFAULT_BLOCK_VERTICES = 1u << 18;  ///< Vertices per block, unless a model needs more
+        static constexpr uint32_t DEFAULT_BLOCK_INDICES = 1u << 20;   ///< Indices per block, unless a model needs more
+
+        /**
+         * @param device Device to create the blocks on.
+         * @param vertexStride Size of one vertex, in bytes.
+         */
+        Liara_GeometryPool(Liara_Device& device, uint32_t vertexStride);
+        ~Liara_GeometryPool() override;
+
+        Liara_GeometryPool(const Liara_GeometryPool&) = delete;
+        Liara_GeometryPool& operator=(const Liara_GeometryPool&) = delete;
+
+        /**
+         * @brief Reserves room for a model in one block and uploads its geometry there.
+         * @param vertices Vertices of the model, a multiple of the vertex stride.
+         * @param indices Indices of the model, relative to its first vertex. May be empty.
+         */
+        [[nodiscard]] GeometryAllocation Allocate(std::span<const std::byte> vertices,
+                                                  std::span<const uint32_t> indices);
+
+        /**
+         * @brief Lets Compact move an allocation, patching it in place. It must stay at this address until freed.
+         */
+        void Track(GeometryAllocation& allocation);
+
+        /**
+         * @brief Releases the ranges of a model, and stops tracking it. The GPU must be done drawing it.
+         * A range with a count of 0 is skipped. Resets the allocation.
+         */
+        void Free(GeometryAllocation& allocation);
+
+        /**
+         * @brief Ends the frame the blocks were moved in, see Relocate.
+         * @param retired Receives the ranges freed since, to free once no frame in flight reads them.
+         */
+        void RetireDeferred(std::vector<GeometryAllocation>& retired);
+
+        /**
+         * @brief Records the moves of tracked allocations into free ranges before them, last ones first.
+         * @param budget Bytes to copy at most, a single range larger than it still moves alone.
+         * @param retired Receives the ranges moved away, to free once no frame in flight reads them.
+         * @return Bytes copied.
+         */
+        VkDeviceSize
+        Compact(VkCommandBuffer commandBuffer, VkDeviceSize budget, std::vector<GeometryAllocation>& retired);
+
+        VkDeviceSize
+        Relocate(const MemoryAllocation& allocation, VkCommandBuffer commandBuffer, RetiredResource& retired) override;
+
+        /**
+         * @brief Binds the vertex buffer of a block at binding 0, and its index buffer.
+         */
+        void Bind(VkCommandBuffer commandBuffer, uint32_t block) const;
+
+        [[nodiscard]] GeometryPoolStats GetStats() const;
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<Liara_Buffer> vertexBuffer;
+            std::unique_ptr<Liara_Buffer> indexBuffer;
+            Core::Memory::Liara_FreeListAllocator vertices;
+            Core::Memory::Liara_FreeListAllocator indices;
+            bool relocated = false;  ///< A buffer of the block moved since the last RetireDeferred
+        };
+
+        /**
+         * @brief Creates a block holding at least the given counts.
+         * @return Index of the new block.
+         */
+        uint32_t CreateBlock(uint32_t vertexCount, uint32_t indexCount);
+
+        /**
+         * @brief Stages the geometry into the ranges of an allocation, in one upload batch. Pool mutex held.
+         */
+        void Upload(const GeometryAllocation& allocation,
+                    VkBuffer vertexBuffer,
+                    VkBuffer indexBuffer,
+                    std::span<const std::byte> vertices,
+                    std::span<const uint32_t> indices) const;
+
+        Liara_Device& m_Device;
+        uint32_t m_VertexStride;
+
+        mutable std::mutex m_Mutex;
+        std::vector<std::unique_ptr<Block>> m_Blocks;  ///< Never removed, allocations refer to them by index
+        std::unordered_set<GeometryAllocation*> m_Tracked;
+        std::vector<GeometryAllocation> m_Deferred;  ///< Freed from relocated blocks, still reserved
+    };
+}
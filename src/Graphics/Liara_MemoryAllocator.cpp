@@ -0,0 +1,367 @@
+#include "Liara_MemoryAllocator.h"
+
+#include "Core/Logging/LogMacros.h"
+#include "Graphics/Liara_Device.h"
+#include "Graphics/VkResultToString.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    Liara_MemoryAllocator::Liara_MemoryAllocator(const Liara_Device& device)
+        : m_Device(device) {
+        vkGetPhysicalDeviceMemoryProperties(m_Device.GetPhysicalDevice(), &m_MemoryProperties);
+        m_NonCoherentAtomSize = std::max<VkDeviceSize>(m_Device.deviceProperties.limits.nonCoherentAtomSize, 1);
+        m_SeparateOptimalImages = m_Device.deviceProperties.limits.bufferImageGranularity > 1;
+
+        // Blocks of small heaps are smaller, so that one block does not take a large share of the heap
+        m_Pools.resize(static_cast<size_t>(m_MemoryProperties.memoryTypeCount) * 2);
+        for (uint32_t type = 0; type < m_MemoryProperties.memoryTypeCount; ++type) {
+            const uint32_t heap = m_MemoryProperties.memoryTypes[type].heapIndex;
+            const VkDeviceSize heapSize = m_MemoryProperties.memoryHeaps[heap].size;
+            const VkDeviceSize blockSize = heapSize <= VkDeviceSize{1} << 30 ? heapSize / 8 : DEFAULT_BLOCK_SIZE;
+            for (uint32_t kind = 0; kind < 2; ++kind) {
+                m_Pools[type * 2 + kind].memoryType = type;
+                m_Pools[type * 2 + kind].blockSize = blockSize;
+            }
+        }
+    }
+
+    Liara_MemoryAllocator::~Liara_MemoryAllocator() {
+        const MemoryStats stats = GetStats();
+        if (stats.allocationCount > 0 || stats.dedicatedCount > 0) {
+            LIARA_LOG_WARNING(LogVulkan,
+                              "{} suballocations and {} dedicated allocations still alive at shutdown",
+                              stats.allocationCount,
+                              stats.dedicatedCount);
+        }
+        for (const Pool& pool : m_Pools) {
+            for (const std::unique_ptr<Block>& block : pool.blocks) {
+                if (block) { vkFreeMemory(m_Device.GetDevice(), block->memory, nullptr); }
+            }
+        }
+    }
+
+    MemoryAllocation Liara_MemoryAllocator::AllocateBufferMemory(VkBuffer buffer,
+                                                                 const VkMemoryPropertyFlags properties) {
+        const VkBufferMemoryRequirementsInfo2 info{.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2,
+                                                   .buffer = buffer};
+        VkMemoryDedicatedRequirements dedicated{.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS};
+        VkMemoryRequirements2 requirements{.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2, .pNext = &dedicated};
+        vkGetBufferMemoryRequirements2(m_Device.GetDevice(), &info, &requirements);
+
+        const VkMemoryDedicatedAllocateInfo dedicatedInfo{.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+                                                          .buffer = buffer};
+        MemoryAllocation allocation = Allocate(requirements.memoryRequirements,
+                                               dedicated.prefersDedicatedAllocation == VK_TRUE
+                                                   || dedicated.requiresDedicatedAllocation == VK_TRUE,
+                                               properties,
+                                               ResourceKind::Linear,
+                                               dedicatedInfo);
+
+        if (const VkResult result =
+                vkBindBufferMemory(m_Device.GetDevice(), buffer, allocation.memory, allocation.offset);
+            result != VK_SUCCESS) {
+            Free(allocation);
+            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to bind buffer memory: {}", VkResultToString(result));
+        }
+        return allocation;
+    }
+
+    MemoryAllocation Liara_MemoryAllocator::AllocateImageMemory(VkImage image,
+                                                                const VkImageTiling tiling,
+                                                                const VkMemoryPropertyFlags properties) {
+        const VkImageMemoryRequirementsInfo2 info{.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2,
+                                                  .image = image};
+        VkMemoryDedicatedRequirements dedicated{.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS};
+        VkMemoryRequirements2 requirements{.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2, .pNext = &dedicated};
+        vkGetImageMemoryRequirements2(m_Device.GetDevice(), &info, &requirements);
+
+        const VkMemoryDedicatedAllocateInfo dedicatedInfo{.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+                                                          .image = image};
+        MemoryAllocation allocation = Allocate(requirements.memoryRequirements,
+                                               dedicated.prefersDedicatedAllocation == VK_TRUE
+                                                   || dedicated.requiresDedicatedAllocation == VK_TRUE,
+                                               properties,
+                                               tiling == VK_IMAGE_TILING_OPTIMAL ? ResourceKind::Optimal
+                                                                                 : ResourceKind::Linear,
+                                               dedicatedInfo);
+
+        if (const VkResult result =
+                vkBindImageMemory(m_Device.GetDevice(), image, allocation.memory, allocation.offset);
+            result != VK_SUCCESS) {
+            Free(allocation);
+            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to bind image memory: {}", VkResultToString(result));
+        }
+        return allocation;
+    }
+
+    void Liara_MemoryAllocator::Free(MemoryAllocation& allocation) {
+        if (!allocation.IsValid()) { return; }
+
+        const std::scoped_lock lock(m_Mutex);
+        if (allocation.IsDedicated()) {
+            vkFreeMemory(m_Device.GetDevice(), allocation.memory, nullptr);
+            --m_DedicatedCount;
+            m_DedicatedBytes -= allocation.size;
+            allocation = MemoryAllocation{};
+            return;
+        }
+
+        LIARA_CHECK_OUT_OF_RANGE(allocation.pool < m_Pools.size(), LogVulkan, "Memory pool out of range");
+        Pool& pool = m_Pools[allocation.pool];
+        LIARA_CHECK_OUT_OF_RANGE(allocation.block < pool.blocks.size() && pool.blocks[allocation.block],
+                                 LogVulkan,
+                                 "Memory block out of range");
+        std::unique_ptr<Block>& block = pool.blocks[allocation.block];
+        block->allocator.Free(allocation.node);
+        block->relocatables.erase(allocation.node);
+
+        // An empty block goes back to the driver, unless it is the last one: the next allocation would take it back.
+        // An evacuated one always does, no allocation would take it
+        if (block->allocator.IsEmpty()
+            && (block->evacuating
+                || std::ranges::count_if(pool.blocks, [](const std::unique_ptr<Block>& b) { return b != nullptr; })
+                       > 1)) {
+            vkFreeMemory(m_Device.GetDevice(), block->memory, nullptr);
+            block.reset();
+            LIARA_LOG_VERBOSE(LogVulkan, "Memory block {} of type {} freed", allocation.block, pool.memoryType);
+        }
+        allocation = MemoryAllocation{};
+    }
+
+    VkResult Liara_MemoryAllocator::Flush(const MemoryAllocation& allocation,
+                                          const VkDeviceSize size,
+                                          const VkDeviceSize offset) const {
+        if (IsCoherent(allocation.memoryType)) { return VK_SUCCESS; }
+        const VkMappedMemoryRange range = GetMappedRange(allocation, size, offset);
+        return vkFlushMappedMemoryRanges(m_Device.GetDevice(), 1, &range);
+    }
+
+    VkResult Liara_MemoryAllocator::Invalidate(const MemoryAllocation& allocation,
+                                               const VkDeviceSize size,
+                                               const VkDeviceSize offset) const {
+        if (IsCoherent(allocation.memoryType)) { return VK_SUCCESS; }
+        const VkMappedMemoryRange range = GetMappedRange(allocation, size, offset);
+        return vkInvalidateMappedMemoryRanges(m_Device.GetDevice(), 1, &range);
+    }
+
+    MemoryStats Liara_MemoryAllocator::GetStats() const {
+        const std::scoped_lock lock(m_Mutex);
+        MemoryStats stats{.dedicatedCount = m_DedicatedCount, .dedicatedBytes = m_DedicatedBytes};
+        uint64_t largestFreeRanges = 0;
+        for (const Pool& pool : m_Pools) {
+            for (const std::unique_ptr<Block>& block : pool.blocks) {
+                if (!block) { continue; }
+                const Core::Memory::FreeListStats blockStats = block->allocator.GetStats();
+                ++stats.blockCount;
+                stats.allocationCount += blockStats.allocationCount;
+                stats.blockBytes += blockStats.capacity;
+                stats.blockUsedBytes += blockStats.used;
+                stats.freeRangeCount += blockStats.freeRangeCount;
+                largestFreeRanges += blockStats.largestFreeRange;
+            }
+        }
+        if (const uint64_t freeBytes = stats.blockBytes - stats.blockUsedBytes; freeBytes > 0) {
+            stats.fragmentation =
+                1.0f - static_cast<float>(static_cast<double>(largestFreeRanges) / static_cast<double>(freeBytes));
+        }
+        return stats;
+    }
+
+    void Liara_MemoryAllocator::SetRelocatable(const MemoryAllocation& allocation, Liara_Relocatable* owner) {
+        if (!allocation.IsValid() || allocation.IsDedicated()) { return; }
+
+        const std::scoped_lock lock(m_Mutex);
+        Block& block = *m_Pools[allocation.pool].blocks[allocation.block];
+        if (owner != nullptr) { block.relocatables[allocation.node] = {allocation, owner}; }
+        else { block.relocatables.erase(allocation.node); }
+    }
+
+    std::optional<MemoryBlockRef> Liara_MemoryAllocator::BeginEvacuation() {
+        const std::scoped_lock lock(m_Mutex);
+
+        // Blocks more than half full are left alone, moving them would cost more than the space it gives back
+        std::optional<MemoryBlockRef> best;
+        double bestUsage = MAX_EVACUATED_USAGE;
+        for (uint32_t p = 0; p < m_Pools.size(); ++p) {
+            const Pool& pool = m_Pools[p];
+            uint32_t liveBlocks = 0;
+            uint64_t poolFree = 0;
+            for (const std::unique_ptr<Block>& block : pool.blocks) {
+                if (!block || block->evacuating) { continue; }
+                ++liveBlocks;
+                poolFree += block->allocator.GetCapacity() - block->allocator.GetStats().used;
+            }
+            if (liveBlocks < 2) { continue; }
+
+            for (uint32_t b = 0; b < pool.blocks.size(); ++b) {
+                const Block* block = pool.blocks[b].get();
+                if (block == nullptr || block->evacuating) { continue; }
+                const Core::Memory::FreeListStats stats = block->allocator.GetStats();
+                if (stats.allocationCount == 0 || block->relocatables.size() != stats.allocationCount) { continue; }
+                const double usage = static_cast<double>(stats.used) / static_cast<double>(stats.capacity);
+                const uint64_t otherFree = poolFree - (stats.capacity - stats.used);
+                if (usage < bestUsage && otherFree >= stats.used) {
+                    best = MemoryBlockRef{.pool = p, .block = b};
+                    bestUsage = usage;
+                }
+            }
+        }
+
+        if (best) {
+            m_Pools[best->pool].blocks[best->block]->evacuating = true;
+            LIARA_LOG_VERBOSE(LogVulkan,
+                              "Evacuating memory block {} of type {}, {:.0f}% used",
+                              best->block,
+                              m_Pools[best->pool].memoryType,
+                              bestUsage * 100.0);
+        }
+        return best;
+    }
+
+    std::vector<std::pair<MemoryAllocation, Liara_Relocatable*>>
+    Liara_MemoryAllocator::GetRelocatables(const MemoryBlockRef block) const {
+        const std::scoped_lock lock(m_Mutex);
+        std::vector<std::pair<MemoryAllocation, Liara_Relocatable*>> relocatables;
+        if (block.pool >= m_Pools.size() || block.block >= m_Pools[block.pool].blocks.size()) { return relocatables; }
+
+        // A block created in the slot of the evacuated one is not evacuating
+        const Block* evacuated = m_Pools[block.pool].blocks[block.block].get();
+        if (evacuated == nullptr || !evacuated->evacuating) { return relocatables; }
+        relocatables.reserve(evacuated->relocatables.size());
+        for (const auto& [node, relocatable] : evacuated->relocatables) { relocatables.push_back(relocatable); }
+        return relocatables;
+    }
+
+    MemoryAllocation Liara_MemoryAllocator::Allocate(const VkMemoryRequirements& requirements,
+                                                     const bool dedicatedPreferred,
+                                                     const VkMemoryPropertyFlags properties,
+                                                     ResourceKind kind,
+                                                     const VkMemoryDedicatedAllocateInfo& dedicatedInfo) {
+        const uint32_t memoryType = m_Device.FindMemoryType(requirements.memoryTypeBits, properties);
+        if (!m_SeparateOptimalImages) { kind = ResourceKind::Linear; }
+        const uint32_t poolIndex = memoryType * 2 + static_cast<uint32_t>(kind);
+        Pool& pool = m_Pools[poolIndex];
+
+        // Ranges of non-coherent memory start on an atom, so that flushing one never rounds into its neighbour
+        VkDeviceSize alignment = requirements.alignment;
+        if (!IsCoherent(memoryType)) { alignment = std::max(alignment, m_NonCoherentAtomSize); }
+
+        const std::scoped_lock lock(m_Mutex);
+        if (!dedicatedPreferred && requirements.size <= pool.blockSize / 2) {
+            std::optional<Core::Memory::Liara_TlsfAllocator::Allocation> range;
+            uint32_t blockIndex = 0;
+            for (uint32_t b = 0; b < pool.blocks.size() && !range; ++b) {
+                if (!pool.blocks[b] || pool.blocks[b]->evacuating) { continue; }
+                range = pool.blocks[b]->allocator.Allocate(requirements.size, alignment);
+                blockIndex = b;
+            }
+            if (!range) {
+                void* mapped = nullptr;
+                if (VkDeviceMemory memory = AllocateDeviceMemory(pool.blockSize, memoryType, nullptr, &mapped);
+                    memory != VK_NULL_HANDLE) {
+                    // A freed block leaves a hole that the next one fills
+                    const auto hole = std::ranges::find(pool.blocks, nullptr);
+                    blockIndex = static_cast<uint32_t>(hole - pool.blocks.begin());
+                    auto block = std::make_unique<Block>(
+                        Block{.memory = memory,
+                              .mapped = mapped,
+                              .allocator = Core::Memory::Liara_TlsfAllocator(pool.blockSize)});
+                    if (hole == pool.blocks.end()) { pool.blocks.push_back(std::move(block)); }
+                    else { *hole = std::move(block); }
+                    range = pool.blocks[blockIndex]->allocator.Allocate(requirements.size, alignment);
+                    LIARA_LOG_VERBOSE(LogVulkan,
+                                      "Memory block {} of type {} created, {} bytes",
+                                      blockIndex,
+                                      memoryType,
+                                      pool.blockSize);
+                }
+            }
+
+            // Without room for a new block, the resource may still fit in an allocation of its own size
+            if (range) {
+                const Block& block = *pool.blocks[blockIndex];
+                return MemoryAllocation{
+                    .memory = block.memory,
+                    .offset = range->offset,
+                    .size = requirements.size,
+                    .mapped = block.mapped != nullptr ? static_cast<std::byte*>(block.mapped) + range->offset : nullptr,
+                    .memoryType = memoryType,
+                    .pool = poolIndex,
+                    .block = blockIndex,
+                    .node = range->node};
+            }
+        }
+
+        void* mapped = nullptr;
+        VkDeviceMemory memory = AllocateDeviceMemory(requirements.size, memoryType, &dedicatedInfo, &mapped);
+        LIARA_CHECK_RUNTIME(memory != VK_NULL_HANDLE, LogVulkan, "Out of device memory");
+        ++m_DedicatedCount;
+        m_DedicatedBytes += requirements.size;
+        return MemoryAllocation{.memory = memory,
+                                .offset = 0,
+                                .size = requirements.size,
+                                .mapped = mapped,
+                                .memoryType = memoryType,
+                                .pool = poolIndex};
+    }
+
+    VkDeviceMemory Liara_MemoryAllocator::AllocateDeviceMemory(const VkDeviceSize size,
+                                                               const uint32_t memoryType,
+                                                               const void* pNext,
+                                                               void** mapped) {
+        const VkMemoryAllocateInfo allocInfo{.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+                                             .pNext = pNext,
+                                             .allocationSize = size,
+                                             .memoryTypeIndex = memoryType};
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        if (const VkResult result = vkAllocateMemory(m_Device.GetDevice(), &allocInfo, nullptr, &memory);
+            result != VK_SUCCESS) {
+            LIARA_LOG_WARNING(LogVulkan,
+                              "Failed to allocate {} bytes of memory type {}: {}",
+                              size,
+                              memoryType,
+                              VkResultToString(result));
+            return VK_NULL_HANDLE;
+        }
+
+        if ((m_MemoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0) {
+            if (const VkResult result = vkMapMemory(m_Device.GetDevice(), memory, 0, VK_WHOLE_SIZE, 0, mapped);
+                result != VK_SUCCESS) {
+                vkFreeMemory(m_Device.GetDevice(), memory, nullptr);
+                LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to map device memory: {}", VkResultToString(result));
+            }
+        }
+        return memory;
+    }
+
+    VkMappedMemoryRange Liara_MemoryAllocator::GetMappedRange(const MemoryAllocation& allocation,
+                                                              const VkDeviceSize size,
+                                                              const VkDeviceSize offset) const {
+        // The range is widened to whole atoms, without going past the end of the memory
+        const VkDeviceSize memorySize = allocation.IsDedicated() ? allocation.size : m_Pools[allocation.pool].blockSize;
+        const VkDeviceSize begin = allocation.offset + offset;
+        const VkDeviceSize end = size == VK_WHOLE_SIZE ? allocation.offset + allocation.size : begin + size;
+        const VkDeviceSize alignedBegin = begin / m_NonCoherentAtomSize * m_NonCoherentAtomSize;
+        const VkDeviceSize alignedEnd =
+            std::min((end + m_NonCoherentAtomSize - 1) / m_NonCoherentAtomSize * m_NonCoherentAtomSize, memorySize);
+        return VkMappedMemoryRange{.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+                                   .memory = allocation.memory,
+                                   .offset = alignedBegin,
+                                   .size = alignedEnd - alignedBegin};
+    }
+
+    bool Liara_MemoryAllocator::IsCoherent(const uint32_t memoryType) const {
+        return (m_MemoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+    }
+}
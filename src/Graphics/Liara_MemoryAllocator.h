@@ -0,0 +1,209 @@
+/**
+ * @file Liara_MemoryAllocator.h
+ * @brief Defines the `Liara_MemoryAllocator` class, which suballocates the device memory of buffers and images.
+ *
+ * Drivers cap the number of live device memory allocations (maxMemoryAllocationCount, as low as 4096), and each
+ * vkAllocateMemory is slow. The allocator instead takes large blocks from the driver, one memory type at a time,
+ * and places the resources inside them with a TLSF allocator. Host visible blocks are mapped once for their whole
+ * life, so mapping a buffer is only pointer arithmetic.
+ *
+ * Buffers and linear images never share a block with optimal images when the device has a bufferImageGranularity
+ * above 1, which is all that granularity requires. Resources the driver wants in their own allocation, or larger
+ * than half a block, get a dedicated one. A block left empty is given back, unless it is the last of its pool.
+ *
+ * Owners that can recreate their resource elsewhere register their allocations as relocatable. The defragmenter
+ * then evacuates the sparsest blocks into the others, one block at a time, so that they can be given back.
+ */
+
+#pragma once
+
+#include "Core/Memory/Liara_TlsfAllocator.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    class Liara_Device;
+    class Liara_Relocatable;
+
+    /**
+     * @struct MemoryAllocation
+     * @brief Range of device memory a resource is bound to.
+     */
+    struct MemoryAllocation
+    {
+        static constexpr uint32_t DEDICATED = std::numeric_limits<uint32_t>::max();
+
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;  ///< Where the resource starts in memory
+        VkDeviceSize size = 0;
+        void* mapped = nullptr;  ///< Start of the range, when the memory is host visible
+        uint32_t memoryType = 0;
+        uint32_t pool = 0;
+        uint32_t block = DEDICATED;
+        uint32_t node = Core::Memory::Liara_TlsfAllocator::NO_NODE;
+
+        [[nodiscard]] bool IsValid() const { return memory != VK_NULL_HANDLE; }
+        [[nodiscard]] bool IsDedicated() const { return block == DEDICATED; }
+    };
+
+    /**
+     * @struct MemoryStats
+     * @brief Device memory taken from the driver, and how much of it is used.
+     */
+    struct MemoryStats
+    {
+        uint32_t blockCount = 0;
+        uint32_t dedicatedCount = 0;
+        uint64_t allocationCount = 0;  ///< Resources in blocks, the dedicated ones not included
+        uint64_t blockBytes = 0;
+        uint64_t blockUsedBytes = 0;
+        uint64_t dedicatedBytes = 0;
+        uint64_t freeRangeCount = 0;  ///< Free ranges over all blocks, more for the same free space is more fragmented
+        float fragmentation = 0.0f;   ///< 1 - largest free range / free bytes, summed over the blocks
+    };
+
+    /**
+     * @struct MemoryBlockRef
+     * @brief Identifies a block of the allocator.
+     */
+    struct MemoryBlockRef
+    {
+        uint32_t pool = 0;
+        uint32_t block = 0;
+    };
+
+    /**
+     * @class Liara_MemoryAllocator
+     * @brief Block based suballocator of device memory, keyed by memory type. Thread safe.
+     */
+    class Liara_MemoryAllocator
+    {
+    public:
+        static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = VkDeviceSize{64} << 20;
+        static constexpr double MAX_EVACUATED_USAGE = 0.5;  ///< Fullest block worth evacuating, as a used fraction
+
+        /**
+         * @param device Device to allocate on. Its logical device must exist, and outlive the allocator.
+         */
+        explicit Liara_MemoryAllocator(const Liara_Device& device);
+        ~Liara_MemoryAllocator();
+
+        Liara_MemoryAllocator(const Liara_MemoryAllocator&) = delete;
+        Liara_MemoryAllocator& operator=(const Liara_MemoryAllocator&) = delete;
+
+        /**
+         * @brief Allocates memory for a buffer and binds it.
+         */
+        [[nodiscard]] MemoryAllocation AllocateBufferMemory(VkBuffer buffer, VkMemoryPropertyFlags properties);
+
+        /**
+         * @brief Allocates memory for an image and binds it.
+         * @param tiling Tiling the image was created with, optimal images are kept apart from buffers.
+         */
+        [[nodiscard]] MemoryAllocation
+        AllocateImageMemory(VkImage image, VkImageTiling tiling, VkMemoryPropertyFlags properties);
+
+        /**
+         * @brief Gives the range back. The resource bound to it must be destroyed first. Resets the allocation.
+         */
+        void Free(MemoryAllocation& allocation);
+
+        /**
+         * @brief Makes host writes to a range of an allocation visible to the device, a no-op on coherent memory.
+         * @param size Size of the range, or VK_WHOLE_SIZE for the rest of the allocation.
+         * @param offset Offset of the range, from the start of the allocation.
+         */
+        [[nodiscard]] VkResult Flush(const MemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const;
+
+        /**
+         * @brief Makes device writes to a range of an allocation visible to the host, a no-op on coherent memory.
+         */
+        [[nodiscard]] VkResult
+        Invalidate(const MemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const;
+
+        [[nodiscard]] MemoryStats GetStats() const;
+
+        /**
+         * @brief Records the owner able to move an allocation elsewhere, or forgets it with nullptr.
+         * Dedicated allocations are ignored, they do not fragment anything.
+         */
+        void SetRelocatable(const MemoryAllocation& allocation, Liara_Relocatable* owner);
+
+        /**
+         * @brief Picks the sparsest block that the other blocks of its pool have room for, and whose allocations
+         * are all relocatable, then stops allocating from it.
+         * @return The block to move the allocations out of, or nothing if no block is worth it.
+         */
+        [[nodiscard]] std::optional<MemoryBlockRef> BeginEvacuation();
+
+        /**
+         * @brief Relocatable allocations left in a block being evacuated, with their owner.
+         * Empty once they have all been moved, or if the block is gone.
+         */
+        [[nodiscard]] std::vector<std::pair<MemoryAllocation, Liara_Relocatable*>>
+        GetRelocatables(MemoryBlockRef block) const;
+
+    private:
+        enum class ResourceKind : uint8_t
+        {
+            Linear,   ///< Buffers and linear images
+            Optimal,  ///< Optimal images
+        };
+
+        struct Block
+        {
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            void* mapped = nullptr;
+            Core::Memory::Liara_TlsfAllocator allocator;
+            std::unordered_map<uint32_t, std::pair<MemoryAllocation, Liara_Relocatable*>> relocatables;  ///< By node
+            bool evacuating = false;  ///< Skipped by new allocations, until the defragmenter has emptied it
+        };
+
+        struct Pool
+        {
+            uint32_t memoryType = 0;
+            VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE;
+            std::vector<std::unique_ptr<Block>> blocks;  ///< Null once freed, allocations refer to them by index
+        };
+
+        /**
+         * @brief Finds room for a resource in a block of its pool, or gives it a dedicated allocation.
+         * @param dedicatedInfo Chained to the dedicated allocations, naming the resource.
+         */
+        MemoryAllocation Allocate(const VkMemoryRequirements& requirements,
+                                  bool dedicatedPreferred,
+                                  VkMemoryPropertyFlags properties,
+                                  ResourceKind kind,
+                                  const VkMemoryDedicatedAllocateInfo& dedicatedInfo);
+
+        /**
+         * @brief Allocates device memory from the driver, and maps it when host visible.
+         * @return The memory, or VK_NULL_HANDLE when the heap is exhausted.
+         */
+        VkDeviceMemory AllocateDeviceMemory(VkDeviceSize size, uint32_t memoryType, const void* pNext, void** mapped);
+
+        [[nodiscard]] VkMappedMemoryRange
+        GetMappedRange(const MemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const;
+        [[nodiscard]] bool IsCoherent(uint32_t memoryType) const;
+
+        const Liara_Device& m_Device;
+        VkPhysicalDeviceMemoryProperties m_MemoryProperties{};
+        VkDeviceSize m_NonCoherentAtomSize = 1;
+        bool m_SeparateOptimalImages = true;  ///< bufferImageGranularity above 1
+
+        mutable std::mutex m_Mutex;
+        std::vector<Pool> m_Pools;  ///< Two per memory type, one per resource kind
+        uint32_t m_DedicatedCount = 0;
+        uint64_t m_DedicatedBytes = 0;
+    };
+}
@@ -1,20 +1,27 @@
 #include "Liara_Model.h"
 
+#include "Core/Culling/Liara_OcclusionBuffer.h"
 #include "Core/FrameInfo.h"
 #include "Graphics/Liara_Buffer.h"
+#include "Core/Math/Bounds.h"
 #include "Graphics/Liara_Device.h"
+#include "Graphics/Liara_GeometryPool.h"
+#include "Graphics/MeshSimplifier.h"
 
 #include <Liara/Utils.h>
 
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "PrimitiveGenerator.h"
 
@@ -45,92 +52,127 @@ namespace Liara::Graphics
                                                              const std::span<const uint32_t> indices) {
         LIARA_CHECK_ARGUMENT(!vertices.empty(), LogCore, "Vertices cannot be empty");
         LIARA_CHECK_ARGUMENT(vertices.size() >= 3, LogCore, "At least 3 vertices required");
-        return std::unique_ptr<Liara_Model>(new Liara_Model(device, vertices, indices));
+        return std::unique_ptr<Liara_Model>(new Liara_Model(device, vertices, indices, ComputeMeshBounds(vertices)));
+    }
+
+    std::unique_ptr<Liara_Model> Liara_Model::CreateFromMeshData(Liara_Device& device, const MeshData& meshData) {
+        LIARA_CHECK_ARGUMENT(meshData.vertices.size() >= 3, LogCore, "At least 3 vertices required");
+        return std::unique_ptr<Liara_Model>(
+            new Liara_Model(device, meshData.GetVertices(), meshData.GetIndices(), meshData.bounds, meshData.lods));
     }
 
     std::unique_ptr<Liara_Model> Liara_Model::CreateFromFile(Liara_Device& device,
                                                              const std::string_view filename,
-                                                             const uint32_t specularExponent) {
-        const auto meshData = LoadMeshFromOBJ(filename, specularExponent);
+                                                             const uint32_t specularExponent,
+                                                             const LodGenerationSettings& lodSettings,
+                                                             Core::Jobs::Liara_JobSystem* jobSystem) {
+        auto meshData = LoadMeshFromOBJ(filename, specularExponent);
         LIARA_CHECK_RUNTIME(!meshData.Empty(), LogCore, "Failed to load model from file: {}", std::string(filename));
+        GenerateMeshLods(meshData, lodSettings, jobSystem);
 
-        return CreateFromData(device, meshData.GetVertices(), meshData.GetIndices());
+        return CreateFromMeshData(device, meshData);
     }
 
     // === PRIMITIVES ===
 
     std::unique_ptr<Liara_Model> Liara_Model::Primitives::CreateQuad(Liara_Device& device) {
         const auto meshData = PrimitiveGenerator::GenerateQuad();
-        return CreateFromData(device, meshData.GetVertices(), meshData.GetIndices());
+        return CreateFromMeshData(device, meshData);
     }
 
     std::unique_ptr<Liara_Model> Liara_Model::Primitives::CreateCube(Liara_Device& device) {
         const auto meshData = PrimitiveGenerator::GenerateCube();
-        return CreateFromData(device, meshData.GetVertices(), meshData.GetIndices());
+        return CreateFromMeshData(device, meshData);
     }
 
     std::unique_ptr<Liara_Model> Liara_Model::Primitives::CreateSphere(Liara_Device& device, const uint32_t segments) {
         const auto meshData = PrimitiveGenerator::GenerateSphere(segments);
-        return CreateFromData(device, meshData.GetVertices(), meshData.GetIndices());
+        return CreateFromMeshData(device, meshData);
     }
 
     std::unique_ptr<Liara_Model> Liara_Model::Primitives::CreatePlane(Liara_Device& device, const float size) {
         const auto meshData = PrimitiveGenerator::GeneratePlane(size);
-        return CreateFromData(device, meshData.GetVertices(), meshData.GetIndices());
+        return CreateFromMeshData(device, meshData);
     }
 
     std::unique_ptr<Liara_Model>
     Liara_Model::Primitives::CreateCylinder(Liara_Device& device, const float height, const uint32_t segments) {
         const auto meshData = PrimitiveGenerator::GenerateCylinder(height, segments);
-        return CreateFromData(device, meshData.GetVertices(), meshData.GetIndices());
+        return CreateFromMeshData(device, meshData);
     }
 
     // === CONSTRUCTOR ===
 
     Liara_Model::Liara_Model(Liara_Device& device,
                              const std::span<const Vertex> vertices,
-                             const std::span<const uint32_t> indices)
-        : m_Device(device) {
-        CreateVertexBuffer(vertices);
-        CreateIndexBuffer(indices);
+                             const std::span<const uint32_t> indices,
+                             const Core::Math::Bounds& bounds,
+                             const std::span<const MeshLod> lods)
+        : m_Device(device)
+        , m_Bounds(bounds) {
+        CreateGeometry(vertices, indices, lods);
     }
 
+    Liara_Model::~Liara_Model() { m_Device.GetGeometryPool().Free(m_Geometry); }
+
     // === CORE METHODS ===
 
-    void Liara_Model::CreateVertexBuffer(std::span<const Vertex> vertices) {
+    void Liara_Model::CreateGeometry(const std::span<const Vertex> vertices,
+                                     const std::span<const uint32_t> indices,
+                                     const std::span<const MeshLod> lods) {
         m_VertexCount = static_cast<uint32_t>(vertices.size());
         assert(m_VertexCount >= 3 && "Vertex count must be at least 3!");
-
-        m_VertexBuffer = std::make_unique<Liara_Buffer>(m_Device, vertices, BufferConfig::Vertex());
-    }
-
-    void Liara_Model::CreateIndexBuffer(std::span<const uint32_t> indices) {
         m_IndexCount = static_cast<uint32_t>(indices.size());
         m_HasIndexBuffer = m_IndexCount > 0;
-        if (!m_HasIndexBuffer) { return; }
+        m_Lods = {
+            {.firstIndex = 0, .indexCount = m_HasIndexBuffer ? m_IndexCount : m_VertexCount, .error = 0.0f}
+        };
+        // Tracked, for the defragmenter to move it within its block
+        Liara_GeometryPool& pool = m_Device.GetGeometryPool();
+        if (!m_HasIndexBuffer || lods.empty()) {
+            m_Geometry = pool.Allocate(std::as_bytes(vertices), indices);
+            pool.Track(m_Geometry);
+            return;
+        }
 
-        m_IndexBuffer = std::make_unique<Liara_Buffer>(m_Device, indices, BufferConfig::Index());
+        // Every level goes after the original indices, in a single range of the pool
+        std::vector<uint32_t> allIndices(indices.begin(), indices.end());
+        for (const auto& lod : lods) {
+            m_Lods.push_back({.firstIndex = static_cast<uint32_t>(allIndices.size()),
+                              .indexCount = static_cast<uint32_t>(lod.indices.size()),
+                              .error = lod.error});
+            allIndices.insert(allIndices.end(), lod.indices.begin(), lod.indices.end());
+        }
+        m_Geometry = pool.Allocate(std::as_bytes(vertices), allIndices);
+        pool.Track(m_Geometry);
     }
 
     void Liara_Model::Bind(VkCommandBuffer commandBuffer) const {
-        const VkBuffer buffers[] = {m_VertexBuffer->GetBuffer()};
-        constexpr VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
-
-        if (m_HasIndexBuffer) {
-            vkCmdBindIndexBuffer(commandBuffer, m_IndexBuffer->GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
-        }
+        m_Device.GetGeometryPool().Bind(commandBuffer, m_Geometry.block);
     }
 
-    void Liara_Model::Draw(VkCommandBuffer commandBuffer) const {
-        frameStats.triangleCount += GetTriangleCount();
-        frameStats.vertexCount += m_VertexCount;
+    void Liara_Model::Draw(VkCommandBuffer commandBuffer,
+                           const uint32_t lodLevel,
+                           const uint32_t instanceCount,
+                           const uint32_t firstInstance) const {
+        const LodRange& lod = m_Lods[std::min(lodLevel, GetLodCount() - 1)];
+        frameStats.triangleCount += static_cast<uint64_t>(lod.indexCount / 3) * instanceCount;
+        frameStats.vertexCount += static_cast<uint64_t>(m_VertexCount) * instanceCount;
         frameStats.drawCallCount++;
 
         const auto start = std::chrono::high_resolution_clock::now();
 
-        if (m_HasIndexBuffer) { vkCmdDrawIndexed(commandBuffer, m_IndexCount, 1, 0, 0, 0); }
-        else { vkCmdDraw(commandBuffer, m_VertexCount, 1, 0, 0); }
+        // Indices are relative to the first vertex of the model in its block
+        const auto vertexOffset = static_cast<int32_t>(m_Geometry.vertexOffset);
+        if (m_HasIndexBuffer) {
+            vkCmdDrawIndexed(commandBuffer,
+                             lod.indexCount,
+                             instanceCount,
+                             m_Geometry.firstIndex + lod.firstIndex,
+                             vertexOffset,
+                             firstInstance);
+        }
+        else { vkCmdDraw(commandBuffer, m_VertexCount, instanceCount, m_Geometry.vertexOffset, firstInstance); }
 
         const auto end = std::chrono::high_resolution_clock::now();
         frameStats.meshDrawTime += std::chrono::duration<float, std::milli>(end - start).count();
@@ -220,6 +262,30 @@ namespace Liara::Graphics
             }
         }
 
+        meshData.UpdateBounds();
         return meshData;
     }
+
+    void MeshData::UpdateBounds() { bounds = ComputeMeshBounds(vertices); }
+
+    Core::Math::Bounds ComputeMeshBounds(const std::span<const Liara_Model::Vertex> vertices) {
+        std::vector<glm::vec3> positions;
+        positions.reserve(vertices.size());
+        for (const auto& vertex : vertices) { positions.push_back(vertex.position); }
+        return Core::Math::ComputeBounds(positions);
+    }
+
+    std::shared_ptr<const Core::Culling::OccluderMesh> CreateOccluderMesh(const MeshData& meshData) {
+        auto occluder = std::make_shared<Core::Culling::OccluderMesh>();
+        occluder->positions.reserve(meshData.vertices.size());
+        for (const auto& vertex : meshData.vertices) { occluder->positions.push_back(vertex.position); }
+
+        if (meshData.indices.empty()) {
+            // Non-indexed meshes list their triangles vertex by vertex
+            occluder->indices.resize(meshData.vertices.size() - (meshData.vertices.size() % 3));
+            for (size_t i = 0; i < occluder->indices.size(); ++i) { occluder->indices[i] = static_cast<uint32_t>(i); }
+        }
+        else { occluder->indices = meshData.indices; }
+        return occluder;
+    }
 }
\ No newline at end of file
@@ -1,19 +1,49 @@
 #pragma once
 
+#include "Core/Culling/Liara_OcclusionBuffer.h"
+#include "Core/Math/Bounds.h"
+
 #include <vulkan/vulkan_core.h>
 
 #include <concepts>
 #include <memory>
 #include <span>
 #include <string_view>
+#include <vector>
 
 #include "glm/ext/vector_float2.hpp"
 #include "glm/ext/vector_float3.hpp"
 #include "Liara_Buffer.h"
 #include "Liara_Device.h"
+#include "Liara_GeometryPool.h"
+
+namespace Liara::Core::Jobs
+{
+    class Liara_JobSystem;
+}
 
 namespace Liara::Graphics
 {
+    struct MeshData;
+
+    /**
+     * @brief Simplified level of a mesh, indexing the vertices of the original mesh
+     */
+    struct MeshLod
+    {
+        std::vector<uint32_t> indices;
+        float error = 0.0f;  ///< Geometric error of the level, relative to the radius of the mesh bounding sphere
+    };
+
+    /**
+     * @brief How many LOD levels to build for a mesh at import time, and how coarse they may get
+     */
+    struct LodGenerationSettings
+    {
+        uint32_t levelCount = 0;  ///< Levels besides the original mesh, 0 to build none
+        float reduction = 0.5f;   ///< Triangle ratio between two consecutive levels
+        float maxError = 0.05f;   ///< Largest error allowed, relative to the radius of the mesh bounding sphere
+    };
 
     template <typename T>
     concept VertexType = requires {
@@ -63,15 +93,28 @@ namespace Liara::Graphics
         static std::unique_ptr<Liara_Model>
         CreateFromData(Liara_Device& device, std::span<const Vertex> vertices, std::span<const uint32_t> indices = {});
 
+        /**
+         * @brief Create model from loaded mesh data, reusing its precomputed bounds
+         * @param device Vulkan device
+         * @param meshData Vertices, indices and bounds of the mesh
+         * @return Unique pointer to model
+         */
+        static std::unique_ptr<Liara_Model> CreateFromMeshData(Liara_Device& device, const MeshData& meshData);
+
         /**
          * @brief Create model from file (OBJ format)
          * @param device Vulkan device
          * @param filename Path to model file
          * @param specularExponent Default specular value (TODO: remove)
+         * @param lodSettings LOD levels to generate from the loaded mesh, none by default
+         * @param jobSystem Optional job system to simplify the LOD levels on
          * @return Unique pointer to model
          */
-        static std::unique_ptr<Liara_Model>
-        CreateFromFile(Liara_Device& device, std::string_view filename, uint32_t specularExponent = 1);
+        static std::unique_ptr<Liara_Model> CreateFromFile(Liara_Device& device,
+                                                           std::string_view filename,
+                                                           uint32_t specularExponent = 1,
+                                                           const LodGenerationSettings& lodSettings = {},
+                                                           Core::Jobs::Liara_JobSystem* jobSystem = nullptr);
 
         /**
          * @brief Create basic geometric primitives
@@ -86,12 +129,33 @@ namespace Liara::Graphics
             CreateCylinder(Liara_Device& device, float height = 1.0f, uint32_t segments = 32);
         };
 
-        ~Liara_Model() = default;
+        ~Liara_Model();
         Liara_Model(const Liara_Model&) = delete;
         Liara_Model& operator=(const Liara_Model&) = delete;
 
+        /**
+         * @brief Range of the indices of the model drawn for one level of detail, from its first index in the pool
+         */
+        struct LodRange
+        {
+            uint32_t firstIndex = 0;
+            uint32_t indexCount = 0;
+            float error = 0.0f;  ///< Relative to the radius of the bounding sphere, 0 for the original mesh
+        };
+
+        /**
+         * @brief Bind the geometry block of the model, shared with the other models of the block
+         */
         void Bind(VkCommandBuffer commandBuffer) const;
-        void Draw(VkCommandBuffer commandBuffer) const;
+
+        /**
+         * @brief Draw one level of detail, clamped to the coarsest level available
+         * @param instanceCount Number of instances, read from firstInstance on in the bound instance buffer
+         */
+        void Draw(VkCommandBuffer commandBuffer,
+                  uint32_t lodLevel = 0,
+                  uint32_t instanceCount = 1,
+                  uint32_t firstInstance = 0) const;
 
         [[nodiscard]] uint32_t GetVertexCount() const noexcept { return m_VertexCount; }
         [[nodiscard]] uint32_t GetIndexCount() const noexcept { return m_IndexCount; }
@@ -99,21 +163,36 @@ namespace Liara::Graphics
         [[nodiscard]] size_t GetTriangleCount() const noexcept {
             return HasIndices() ? m_IndexCount / 3 : m_VertexCount / 3;
         }
+        [[nodiscard]] const Core::Math::Bounds& GetBounds() const noexcept { return m_Bounds; }  ///< In model space
+        /// Where the vertices and indices of the model live in the geometry pool
+        [[nodiscard]] const GeometryAllocation& GetGeometry() const noexcept { return m_Geometry; }
+
+        [[nodiscard]] uint32_t GetLodCount() const noexcept { return static_cast<uint32_t>(m_Lods.size()); }
+        [[nodiscard]] const LodRange& GetLod(const uint32_t level) const { return m_Lods[level]; }
 
     private:
-        explicit Liara_Model(Liara_Device& device, std::span<const Vertex> vertices, std::span<const uint32_t> indices);
+        explicit Liara_Model(Liara_Device& device,
+                             std::span<const Vertex> vertices,
+                             std::span<const uint32_t> indices,
+                             const Core::Math::Bounds& bounds,
+                             std::span<const MeshLod> lods = {});
 
-        void CreateVertexBuffer(std::span<const Vertex> vertices);
-        void CreateIndexBuffer(std::span<const uint32_t> indices);
+        /**
+         * @brief Allocate the geometry from the pool of the device, the LOD levels after the original indices
+         */
+        void CreateGeometry(std::span<const Vertex> vertices,
+                            std::span<const uint32_t> indices,
+                            std::span<const MeshLod> lods);
 
         Liara_Device& m_Device;
 
-        std::unique_ptr<Liara_Buffer> m_VertexBuffer;
+        GeometryAllocation m_Geometry;
         uint32_t m_VertexCount{};
-
-        std::unique_ptr<Liara_Buffer> m_IndexBuffer;
         uint32_t m_IndexCount{};
         bool m_HasIndexBuffer{false};
+
+        Core::Math::Bounds m_Bounds;
+        std::vector<LodRange> m_Lods;  ///< Level 0 is the original mesh, the levels share the index range
     };
 
     /**
@@ -124,15 +203,24 @@ namespace Liara::Graphics
     {
         std::vector<Liara_Model::Vertex> vertices;
         std::vector<uint32_t> indices;
+        Core::Math::Bounds bounds{};  ///< Computed by the loaders once the vertices are final
+        std::vector<MeshLod> lods;    ///< Simplified levels, coarser and coarser, see GenerateMeshLods
 
         [[nodiscard]] std::span<const Liara_Model::Vertex> GetVertices() const noexcept { return vertices; }
         [[nodiscard]] std::span<const uint32_t> GetIndices() const noexcept { return indices; }
 
         [[nodiscard]] bool Empty() const noexcept { return vertices.empty(); }
 
+        /**
+         * @brief Recomputes the bounds from the vertex positions
+         */
+        void UpdateBounds();
+
         void Clear() noexcept {
             vertices.clear();
             indices.clear();
+            bounds = {};
+            lods.clear();
         }
     };
 
@@ -143,4 +231,14 @@ namespace Liara::Graphics
      * @return MeshData structure
      */
     [[nodiscard]] MeshData LoadMeshFromOBJ(std::string_view filename, uint32_t specularExponent = 1);
+
+    /**
+     * @brief Compute the model space bounds of vertices
+     */
+    [[nodiscard]] Core::Math::Bounds ComputeMeshBounds(std::span<const Liara_Model::Vertex> vertices);
+
+    /**
+     * @brief Copy the positions and indices of a mesh, to use it as an occluder
+     */
+    [[nodiscard]] std::shared_ptr<const Core::Culling::OccluderMesh> CreateOccluderMesh(const MeshData& meshData);
 }
\ No newline at end of file
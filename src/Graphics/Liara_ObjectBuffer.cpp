@@ -0,0 +1,121 @@
+#include "Liara_ObjectBuffer.h"
+
+#include "Core/Logging/LogMacros.h"
+#include "Graphics/Descriptors/Liara_Descriptor.h"
+#include "Graphics/Liara_Buffer.h"
+#include "Graphics/Liara_Device.h"
+#include "Graphics/VkResultToString.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    Liara_ObjectBuffer::Liara_ObjectBuffer(Liara_Device& device,
+                                           const uint32_t framesInFlight,
+                                           const VkShaderStageFlags stages)
+        : m_Device(device)
+        , m_Stages(stages)
+        , m_Frames(framesInFlight) {
+        // The stale frames of a slot are the bits of a byte
+        LIARA_CHECK_ARGUMENT(framesInFlight > 0 && framesInFlight <= 8,
+                             LogGraphics,
+                             "An object buffer needs between 1 and 8 frames in flight");
+
+        m_DescriptorAllocator = Descriptors::Liara_DescriptorAllocator::Builder(m_Device)
+                                    .SetMaxSets(framesInFlight)
+                                    .AddPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight)
+                                    .Build();
+        m_DescriptorLayoutCache = Descriptors::Liara_DescriptorLayoutCache::Builder(m_Device).Build();
+
+        for (FrameBuffer& frame : m_Frames) { GrowFrame(frame); }
+    }
+
+    Liara_ObjectBuffer::~Liara_ObjectBuffer() = default;
+
+    void Liara_ObjectBuffer::Write(const uint32_t slot, const ObjectData& object) {
+        if (slot >= m_Objects.size()) {
+            // A new slot is stale whatever its data, the buffers hold garbage there
+            m_Objects.resize(static_cast<size_t>(slot) + 1);
+            m_StaleFrames.resize(m_Objects.size(), 0);
+            while (m_Capacity < m_Objects.size()) { m_Capacity *= 2; }
+        }
+        else if (m_Objects[slot] == object) { return; }
+
+        m_Objects[slot] = object;
+        if (m_StaleFrames[slot] == 0) { m_StaleSlots.push_back(slot); }
+        m_StaleFrames[slot] = static_cast<uint8_t>((1u << m_Frames.size()) - 1);
+    }
+
+    uint32_t Liara_ObjectBuffer::Upload(const uint32_t frameIndex) {
+        LIARA_CHECK_OUT_OF_RANGE(frameIndex < m_Frames.size(), LogGraphics, "Frame index out of range");
+        FrameBuffer& frame = m_Frames[frameIndex];
+        const auto frameBit = static_cast<uint8_t>(1u << frameIndex);
+
+        // A grown buffer gets every slot, stale or not
+        uint32_t copied = 0;
+        const bool grown = frame.capacity < m_Capacity;
+        if (grown) {
+            GrowFrame(frame);
+            copied = static_cast<uint32_t>(m_Objects.size());
+        }
+
+        // Consecutive stale slots are copied in one go
+        std::ranges::sort(m_StaleSlots);
+        auto* const mapped = static_cast<ObjectData*>(frame.buffer->GetMappedMemory());
+        size_t i = 0;
+        while (i < m_StaleSlots.size()) {
+            const uint32_t first = m_StaleSlots[i];
+            if ((m_StaleFrames[first] & frameBit) == 0) {
+                ++i;
+                continue;
+            }
+            uint32_t count = 0;
+            while (i < m_StaleSlots.size() && m_StaleSlots[i] == first + count
+                   && (m_StaleFrames[m_StaleSlots[i]] & frameBit) != 0) {
+                m_StaleFrames[m_StaleSlots[i]] &= static_cast<uint8_t>(~frameBit);
+                ++count;
+                ++i;
+            }
+            if (!grown) {
+                std::copy_n(m_Objects.data() + first, count, mapped + first);
+                copied += count;
+            }
+        }
+
+        // Slots up to date in every frame no longer need to be looked at
+        std::erase_if(m_StaleSlots, [&](const uint32_t slot) { return m_StaleFrames[slot] == 0; });
+        return copied;
+    }
+
+    VkDescriptorSet Liara_ObjectBuffer::GetDescriptorSet(const uint32_t frameIndex) const {
+        LIARA_CHECK_OUT_OF_RANGE(frameIndex < m_Frames.size(), LogGraphics, "Frame index out of range");
+        return m_Frames[frameIndex].descriptorSet;
+    }
+
+    void Liara_ObjectBuffer::GrowFrame(FrameBuffer& frame) {
+        // The frame is no longer read by the GPU, its previous buffer can go right away
+        frame.buffer = std::make_unique<Liara_Buffer>(
+            m_Device, static_cast<VkDeviceSize>(m_Capacity) * sizeof(ObjectData), BufferConfig::Storage());
+        if (const VkResult result = frame.buffer->Map(); result != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to map an object buffer: {}", VkResultToString(result));
+        }
+        frame.capacity = m_Capacity;
+        std::ranges::copy(m_Objects, static_cast<ObjectData*>(frame.buffer->GetMappedMemory()));
+
+        const VkDescriptorBufferInfo bufferInfo = frame.buffer->DescriptorInfo();
+        Descriptors::Liara_DescriptorBuilder builder(*m_DescriptorLayoutCache, *m_DescriptorAllocator);
+        builder.BindBuffer(0, &bufferInfo, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_Stages);
+        if (frame.descriptorSet == VK_NULL_HANDLE) {
+            LIARA_CHECK_RUNTIME(builder.Build(frame.descriptorSet, m_SetLayout),
+                                LogGraphics,
+                                "Failed to build an object descriptor set");
+        }
+        else { builder.Overwrite(frame.descriptorSet); }
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file Liara_ObjectBuffer.h
+ * @brief Defines the `Liara_ObjectBuffer` class, which keeps the per-object data of the frame in a storage buffer.
+ *
+ * Each object has a fixed slot, its entity index, in a storage buffer per frame in flight that stays mapped. Draws
+ * only carry the slot of their object (a 4-byte instance attribute), and the vertex shader reads the matrices from
+ * the buffer instead of receiving them with every draw.
+ *
+ * Writes are compared with a CPU copy of the latest data, so an object that did not move costs no upload at all.
+ * A changed slot is marked stale in every frame buffer, and each frame only copies its stale slots when it comes
+ * back, in ranges of consecutive slots. The buffers grow with the highest slot written, a frame replacing its own
+ * buffer when its index comes back.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float4.hpp"
+
+namespace Liara::Graphics
+{
+    class Liara_Buffer;
+    class Liara_Device;
+}
+namespace Liara::Graphics::Descriptors
+{
+    class Liara_DescriptorAllocator;
+    class Liara_DescriptorLayoutCache;
+}
+
+namespace Liara::Graphics
+{
+    /**
+     * @struct ObjectData
+     * @brief One object, as read by the vertex shaders (std430).
+     */
+    struct ObjectData
+    {
+        glm::mat4 modelMatrix{1.0f};
+        std::array<glm::vec4, 3> normalMatrix{};  ///< Columns of the 3x3 normal matrix, w unused
+        uint32_t materialIndex = 0;
+        uint32_t padding[3]{};
+
+        bool operator==(const ObjectData& other) const = default;
+    };
+    static_assert(sizeof(ObjectData) == 128, "ObjectData must match its std430 layout");
+
+    /**
+     * @class Liara_ObjectBuffer
+     * @brief Per-frame, persistently mapped storage buffers of object data, only rewritten where it changed.
+     * Not thread safe: objects are written and uploaded from one thread at a time.
+     */
+    class Liara_ObjectBuffer
+    {
+    public:
+        static constexpr uint32_t DEFAULT_CAPACITY = 1024;  ///< Slots per buffer before growing
+
+        /**
+         * @param device Device to create the buffers and descriptor sets with.
+         * @param framesInFlight Number of frames recorded before the GPU is done with the oldest one.
+         * @param stages Shader stages reading the buffer.
+         */
+        Liara_ObjectBuffer(Liara_Device& device, uint32_t framesInFlight, VkShaderStageFlags stages);
+        ~Liara_ObjectBuffer();
+
+        Liara_ObjectBuffer(const Liara_ObjectBuffer&) = delete;
+        Liara_ObjectBuffer& operator=(const Liara_ObjectBuffer&) = delete;
+
+        /**
+         * @brief Sets the data of a slot, marking it stale in every frame if it changed.
+         */
+        void Write(uint32_t slot, const ObjectData& object);
+
+        /**
+         * @brief Copies the slots changed since the last time the frame came back into its buffer.
+         * The buffer of the frame must no longer be read by the GPU.
+         * @return Number of slots copied.
+         */
+        uint32_t Upload(uint32_t frameIndex);
+
+        /**
+         * @brief Descriptor set binding the buffer of a frame at binding 0.
+         */
+        [[nodiscard]] VkDescriptorSet GetDescriptorSet(uint32_t frameIndex) const;
+        [[nodiscard]] VkDescriptorSetLayout GetSetLayout() const { return m_SetLayout; }
+
+    private:
+        struct FrameBuffer
+        {
+            std::unique_ptr<Liara_Buffer> buffer;
+            uint32_t capacity = 0;
+            VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        };
+
+        /**
+         * @brief Replaces the buffer of a frame with one of the current capacity, and copies every slot into it.
+         */
+        void GrowFrame(FrameBuffer& frame);
+
+        Liara_Device& m_Device;
+        VkShaderStageFlags m_Stages;
+        std::unique_ptr<Descriptors::Liara_DescriptorAllocator> m_DescriptorAllocator;
+        std::unique_ptr<Descriptors::Liara_DescriptorLayoutCache> m_DescriptorLayoutCache;
+        VkDescriptorSetLayout m_SetLayout = VK_NULL_HANDLE;
+        std::vector<FrameBuffer> m_Frames;
+
+        std::vector<ObjectData> m_Objects;       ///< Latest data of each slot
+        std::vector<uint8_t> m_StaleFrames;      ///< Bit per frame whose buffer misses the latest data of the slot
+        std::vector<uint32_t> m_StaleSlots;      ///< Slots with at least one stale frame
+        uint32_t m_Capacity = DEFAULT_CAPACITY;  ///< Capacity the frame buffers grow to
+    };
+}
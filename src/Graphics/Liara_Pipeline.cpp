@@ -5,15 +5,18 @@
 #include <vulkan/vulkan_core.h>
 
 #include <cassert>
+#include <filesystem>
 #include <fstream>
 #include <ios>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Liara_Model.h"
 #include "Liara_ShaderLoader.h"
 #include "SpecConstant/SpecializationConstant.h"
+#include "VkResultToString.h"
 
 #ifndef ENGINE_DIR
     #define ENGINE_DIR "./"
@@ -21,6 +24,24 @@
 
 namespace Liara::Graphics
 {
+    namespace
+    {
+        /**
+         * @brief SPIR-V of a shader, from the embedded shaders or from the shader directory.
+         */
+        std::vector<char> LoadShaderCode(const std::string& filepath, const std::string_view stage) {
+            const std::string name = std::filesystem::path(filepath).filename().string();
+#ifdef LIARA_EMBED_SHADERS
+            auto result = ShaderLoader::LoadShaderSpan(name);
+            LIARA_CHECK_RUNTIME(result, LogGraphics, "Failed to load {} shader: {}", stage, ToString(result.Error()));
+            return ConvertToCharVector(std::vector(result->begin(), result->end()));
+#else
+            auto result = ShaderLoader::LoadShader(name);
+            LIARA_CHECK_RUNTIME(result, LogGraphics, "Failed to load {} shader: {}", stage, ToString(result.Error()));
+            return ConvertToCharVector(result.Value());
+#endif
+        }
+    }
 
     Liara_Pipeline::Liara_Pipeline(Liara_Device& device,
                                    const std::string& vertFilepath,
@@ -147,28 +168,8 @@ namespace Liara::Graphics
         assert(configInfo.renderPass != VK_NULL_HANDLE
                && "Cannot create graphics pipeline:: no renderPass provided in configInfo");
 
-#ifdef LIARA_EMBED_SHADERS
-        auto vertResult = ShaderLoader::LoadShaderSpan(std::filesystem::path(vertFilepath).filename().string());
-        auto fragResult = ShaderLoader::LoadShaderSpan(std::filesystem::path(fragFilepath).filename().string());
-
-        LIARA_CHECK_RUNTIME(vertResult, LogGraphics, "Failed to load vertex shader: {}", ToString(vertResult.Error()));
-        LIARA_CHECK_RUNTIME(
-            fragResult, LogGraphics, "Failed to load fragment shader: {}", ToString(fragResult.Error()));
-
-        const auto vertCode = ConvertToCharVector(std::vector(vertResult->begin(), vertResult->end()));
-        const auto fragCode = ConvertToCharVector(std::vector(fragResult->begin(), fragResult->end()));
-#else
-        auto vertResult = ShaderLoader::LoadShader(std::filesystem::path(vertFilepath).filename().string());
-        auto fragResult = ShaderLoader::LoadShader(std::filesystem::path(fragFilepath).filename().string());
-
-        LIARA_CHECK_RUNTIME(vertResult, LogGraphics, "Failed to load vertex shader: {}", ToString(vertResult.Error()));
-        LIARA_CHECK_RUNTIME(
-            fragResult, LogGraphics, "Failed to load fragment shader: {}", ToString(fragResult.Error()));
-
-        const auto vertCode = ConvertToCharVector(vertResult.Value());
-        const auto fragCode = ConvertToCharVector(fragResult.Value());
-#endif
-
+        const auto vertCode = LoadShaderCode(vertFilepath, "vertex");
+        const auto fragCode = LoadShaderCode(fragFilepath, "fragment");
 
         CreateShaderModule(vertCode, &m_VertShaderModule);
         CreateShaderModule(fragCode, &m_FragShaderModule);
@@ -252,4 +253,45 @@ namespace Liara::Graphics
             LIARA_THROW_RUNTIME_ERROR(LogGraphics, "Failed to create shader module!");
         }
     }
-}
\ No newline at end of file
+
+    Liara_ComputePipeline::Liara_ComputePipeline(Liara_Device& device,
+                                                 const std::string& compFilepath,
+                                                 VkPipelineLayout pipelineLayout)
+        : m_Device(device) {
+        assert(pipelineLayout != VK_NULL_HANDLE && "Cannot create compute pipeline: no pipeline layout provided");
+
+        const auto code = LoadShaderCode(compFilepath, "compute");
+        VkShaderModuleCreateInfo moduleInfo{};
+        moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleInfo.codeSize = code.size();
+        moduleInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+        if (vkCreateShaderModule(m_Device.GetDevice(), &moduleInfo, nullptr, &m_ShaderModule) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogGraphics, "Failed to create shader module!");
+        }
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = m_ShaderModule;
+        pipelineInfo.stage.pName = "main";
+        pipelineInfo.layout = pipelineLayout;
+        pipelineInfo.basePipelineIndex = -1;
+
+        if (const VkResult result = vkCreateComputePipelines(
+                m_Device.GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_ComputePipeline);
+            result != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(
+                LogGraphics, "Failed to create compute pipeline {}: {}", compFilepath, VkResultToString(result));
+        }
+    }
+
+    Liara_ComputePipeline::~Liara_ComputePipeline() {
+        vkDestroyShaderModule(m_Device.GetDevice(), m_ShaderModule, nullptr);
+        vkDestroyPipeline(m_Device.GetDevice(), m_ComputePipeline, nullptr);
+    }
+
+    void Liara_ComputePipeline::Bind(VkCommandBuffer commandBuffer) const {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_ComputePipeline);
+    }
+}
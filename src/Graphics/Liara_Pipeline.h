@@ -70,4 +70,25 @@ namespace Liara::Graphics
 
         void CreateShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule) const;
     };
+
+    /**
+     * @class Liara_ComputePipeline
+     * @brief A compute shader and its pipeline, dispatched outside of the render pass.
+     */
+    class Liara_ComputePipeline
+    {
+    public:
+        Liara_ComputePipeline(Liara_Device& device, const std::string& compFilepath, VkPipelineLayout pipelineLayout);
+        ~Liara_ComputePipeline();
+
+        Liara_ComputePipeline(const Liara_ComputePipeline&) = delete;
+        Liara_ComputePipeline& operator=(const Liara_ComputePipeline&) = delete;
+
+        void Bind(VkCommandBuffer commandBuffer) const;
+
+    private:
+        Liara_Device& m_Device;
+        VkPipeline m_ComputePipeline{};
+        VkShaderModule m_ShaderModule{};
+    };
 }
@@ -0,0 +1,52 @@
+/**
+ * @file Liara_Relocatable.h
+ * @brief Defines the `Liara_Relocatable` interface, implemented by the owners of resources the defragmenter may move.
+ */
+
+#pragma once
+
+#include "Graphics/Liara_MemoryAllocator.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <memory>
+
+namespace Liara::Graphics
+{
+    class Liara_Buffer;
+
+    /**
+     * @struct RetiredResource
+     * @brief What a move leaves behind, destroyed once no frame in flight can read it. Unused members stay null.
+     */
+    struct RetiredResource
+    {
+        std::unique_ptr<Liara_Buffer> buffer;
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        MemoryAllocation memory;  ///< Of the image, a buffer frees its own
+
+        RetiredResource();
+        ~RetiredResource();
+        RetiredResource(RetiredResource&&) noexcept;
+        RetiredResource& operator=(RetiredResource&&) noexcept;
+    };
+
+    /**
+     * @class Liara_Relocatable
+     * @brief Owner of resources the defragmenter may move, registered with Liara_MemoryAllocator::SetRelocatable.
+     */
+    class Liara_Relocatable
+    {
+    public:
+        virtual ~Liara_Relocatable() = default;
+
+        /**
+         * @brief Recreates the resource bound to an allocation in new memory, and records the copy of its content.
+         * The resource is used from its new location from this frame on, the old one is handed over in retired.
+         * @return Bytes copied.
+         */
+        virtual VkDeviceSize
+        Relocate(const MemoryAllocation& allocation, VkCommandBuffer commandBuffer, RetiredResource& retired) = 0;
+    };
+}
@@ -0,0 +1,362 @@
+#include "Liara_RenderQueue.h"
+
+#include "Core/FrameInfo.h"
+#include "Core/Jobs/Liara_JobSystem.h"
+#include "Core/Logging/LogMacros.h"
+#include "Graphics/Liara_Model.h"
+#include "Graphics/Liara_Buffer.h"
+#include "Graphics/Liara_GeometryPool.h"
+#include "Graphics/Liara_Pipeline.h"
+#include "Graphics/Liara_SecondaryCommandRecorder.h"
+#include "Graphics/VkResultToString.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    namespace
+    {
+        constexpr uint64_t LAYER_BITS = 4;
+        constexpr uint64_t PIPELINE_BITS = 12;
+        constexpr uint64_t MATERIAL_BITS = 12;
+        constexpr uint64_t MESH_BITS = 16;
+        constexpr uint64_t LOD_BITS = 4;  ///< Lowest bits of the mesh bits
+        constexpr uint64_t DEPTH_BITS = 20;
+        static_assert(LAYER_BITS + PIPELINE_BITS + MATERIAL_BITS + MESH_BITS + DEPTH_BITS == 64);
+
+        constexpr uint64_t Mask(const uint64_t bits) { return (uint64_t{1} << bits) - 1; }
+
+        /**
+         * @brief Vulkan handles are pointers on 64-bit platforms and integers elsewhere.
+         */
+        template <typename Handle> uint64_t HandleToInteger(const Handle handle) {
+            if constexpr (std::is_pointer_v<Handle>) {
+                return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+            }
+            else { return static_cast<uint64_t>(handle); }
+        }
+
+        /**
+         * @brief Depth as an integer that keeps the order: the bits of a positive float increase with its value.
+         * The 20 kept bits are the exponent and the 11 first bits of the mantissa, about 3 significant digits.
+         */
+        uint64_t QuantizeDepth(const float depth) {
+            const float clamped = depth > 0.0f ? depth : 0.0f;
+            return (static_cast<uint64_t>(std::bit_cast<uint32_t>(clamped)) >> (31 - DEPTH_BITS)) & Mask(DEPTH_BITS);
+        }
+    }
+
+    VkVertexInputBindingDescription InstanceData::GetBindingDescription() {
+        return {.binding = Liara_RenderQueue::INSTANCE_BINDING,
+                .stride = sizeof(InstanceData),
+                .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE};
+    }
+
+    std::vector<VkVertexInputAttributeDescription> InstanceData::GetAttributeDescriptions() {
+        return {{.location = FIRST_LOCATION,
+                 .binding = Liara_RenderQueue::INSTANCE_BINDING,
+                 .format = VK_FORMAT_R32_UINT,
+                 .offset = static_cast<uint32_t>(offsetof(InstanceData, objectIndex))}};
+    }
+
+    Liara_RenderQueue::Liara_RenderQueue(Liara_Device& device, const uint32_t framesInFlight)
+        : m_Device(device)
+        , m_FrameInstances(framesInFlight) {
+        LIARA_CHECK_ARGUMENT(framesInFlight > 0, LogGraphics, "A render queue needs at least one frame in flight");
+    }
+
+    void Liara_RenderQueue::BeginFrame(const uint32_t frameIndex) {
+        LIARA_CHECK_OUT_OF_RANGE(frameIndex < m_FrameInstances.size(), LogGraphics, "Frame index out of range");
+        m_FrameIndex = frameIndex;
+        FrameInstances& frame = m_FrameInstances[m_FrameIndex];
+        frame.used = 0;
+        frame.retired.clear();
+
+        // Scanning the tables every frame would cost more than the ids it frees
+        if (++m_FrameCount % ID_RETIREMENT_FRAMES == 0) {
+            RetireIds(m_PipelineIds);
+            RetireIds(m_MaterialIds);
+            RetireIds(m_MeshIds);
+        }
+    }
+
+    uint64_t Liara_RenderQueue::MakeSortKey(const DrawLayer layer,
+                                            const Liara_Pipeline* pipeline,
+                                            const VkDescriptorSet descriptorSet,
+                                            const Liara_Model* model,
+                                            const uint32_t lodLevel,
+                                            const float viewDepth) {
+        const uint64_t mesh = GetId(m_MeshIds, HandleToInteger(model)) << LOD_BITS
+                              | std::min<uint64_t>(lodLevel, Mask(LOD_BITS));
+        const uint64_t state =
+            (GetId(m_PipelineIds, HandleToInteger(pipeline)) & Mask(PIPELINE_BITS)) << (MATERIAL_BITS + MESH_BITS)
+            | (GetId(m_MaterialIds, HandleToInteger(descriptorSet)) & Mask(MATERIAL_BITS)) << MESH_BITS
+            | (mesh & Mask(MESH_BITS));
+        const uint64_t layerBits = static_cast<uint64_t>(layer) << (64 - LAYER_BITS);
+        const uint64_t depth = QuantizeDepth(viewDepth);
+
+        // Blended draws must be composed back to front whatever the state changes cost
+        if (layer == DrawLayer::BLENDED) {
+            return layerBits | ((Mask(DEPTH_BITS) - depth) << (PIPELINE_BITS + MATERIAL_BITS + MESH_BITS)) | state;
+        }
+        if (m_SortMode == DrawSortMode::FRONT_TO_BACK) {
+            return layerBits | (depth << (PIPELINE_BITS + MATERIAL_BITS + MESH_BITS)) | state;
+        }
+        return layerBits | (state << DEPTH_BITS) | depth;
+    }
+
+    void Liara_RenderQueue::Submit(const DrawPacket& packet, const std::span<const std::byte> pushConstants) {
+        LIARA_CHECK_ARGUMENT(packet.pipeline != nullptr && packet.model != nullptr,
+                             LogGraphics,
+                             "A draw packet needs a pipeline and a model");
+
+        const auto offset = static_cast<uint32_t>(m_PushConstants.size());
+        m_PushConstants.insert(m_PushConstants.end(), pushConstants.begin(), pushConstants.end());
+        m_Packets.push_back({.packet = packet,
+                             .pushConstantOffset = offset,
+                             .pushConstantSize = static_cast<uint32_t>(pushConstants.size())});
+    }
+
+    void Liara_RenderQueue::SubmitInstance(const DrawPacket& packet, const InstanceData& instance) {
+        LIARA_CHECK_ARGUMENT(packet.pipeline != nullptr && packet.model != nullptr,
+                             LogGraphics,
+                             "A draw packet needs a pipeline and a model");
+
+        m_Packets.push_back({.packet = packet, .instanceIndex = static_cast<uint32_t>(m_Instances.size())});
+        m_Instances.push_back(instance);
+    }
+
+    void Liara_RenderQueue::Flush(VkCommandBuffer commandBuffer) {
+        if (m_Packets.empty()) { return; }
+        BuildDraws();
+        RecordDraws(commandBuffer, m_Draws);
+        Clear();
+    }
+
+    void Liara_RenderQueue::Flush(Liara_SecondaryCommandRecorder& recorder,
+                                  Core::Jobs::Liara_JobSystem& jobSystem,
+                                  std::vector<VkCommandBuffer>& commandBuffers) {
+        if (m_Packets.empty()) { return; }
+        BuildDraws();
+
+        // Each chunk starts with nothing bound, so a few binds are repeated at the chunk boundaries
+        const size_t chunkCount = (m_Draws.size() + RECORDING_CHUNK_SIZE - 1) / RECORDING_CHUNK_SIZE;
+        const size_t firstBuffer = commandBuffers.size();
+        commandBuffers.resize(firstBuffer + chunkCount);
+        jobSystem.ParallelFor(chunkCount, 1, [&](const size_t begin, const size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                const size_t first = chunk * RECORDING_CHUNK_SIZE;
+                const size_t count = std::min(RECORDING_CHUNK_SIZE, m_Draws.size() - first);
+                VkCommandBuffer commandBuffer = recorder.Begin(jobSystem.GetCurrentThreadIndex());
+                RecordDraws(commandBuffer, std::span(m_Draws).subspan(first, count));
+                recorder.End(commandBuffer);
+                commandBuffers[firstBuffer + chunk] = commandBuffer;
+            }
+        });
+        Clear();
+    }
+
+    void Liara_RenderQueue::BuildDraws() {
+        SortPackets();
+        m_Draws.clear();
+
+        // Every instance of the flush goes in one range of the frame buffer
+        FrameInstances& frame = m_FrameInstances[m_FrameIndex];
+        InstanceData* instances = nullptr;
+        if (!m_Instances.empty()) {
+            ReserveInstances(static_cast<uint32_t>(m_Instances.size()));
+            instances = static_cast<InstanceData*>(frame.buffer->GetMappedMemory());
+        }
+
+        for (size_t i = 0; i < m_Order.size();) {
+            const QueuedPacket& queued = m_Packets[m_Order[i]];
+            if (queued.instanceIndex == NO_INSTANCE) {
+                m_Draws.push_back({.packetIndex = m_Order[i], .instanceCount = 0});
+                ++i;
+                continue;
+            }
+
+            // The sort put the packets sharing this state next to each other, they become one draw
+            size_t end = i + 1;
+            if (m_Instancing) {
+                while (end < m_Order.size() && m_Packets[m_Order[end]].instanceIndex != NO_INSTANCE
+                       && CanMerge(queued.packet, m_Packets[m_Order[end]].packet)) {
+                    ++end;
+                }
+            }
+            m_Draws.push_back({.packetIndex = m_Order[i],
+                               .instanceCount = static_cast<uint32_t>(end - i),
+                               .firstInstance = frame.used});
+            for (size_t j = i; j < end; ++j) {
+                instances[frame.used++] = m_Instances[m_Packets[m_Order[j]].instanceIndex];
+            }
+            i = end;
+        }
+    }
+
+    void Liara_RenderQueue::RecordDraws(VkCommandBuffer commandBuffer, const std::span<const QueuedDraw> draws) const {
+        const FrameInstances& frame = m_FrameInstances[m_FrameIndex];
+        if (!m_Instances.empty()) {
+            const VkBuffer buffer = frame.buffer->GetBuffer();
+            constexpr VkDeviceSize offset = 0;
+            vkCmdBindVertexBuffers(commandBuffer, INSTANCE_BINDING, 1, &buffer, &offset);
+            ++frameStats.bindCount;
+        }
+
+        const Liara_Pipeline* boundPipeline = nullptr;
+        VkPipelineLayout boundLayout = VK_NULL_HANDLE;
+        VkDescriptorSet boundDescriptorSet = VK_NULL_HANDLE;
+        VkDescriptorSet boundObjectSet = VK_NULL_HANDLE;
+        uint32_t boundGeometryBlock = GeometryAllocation::NO_BLOCK;
+        for (const QueuedDraw& draw : draws) {
+            const QueuedPacket& queued = m_Packets[draw.packetIndex];
+            const DrawPacket& packet = queued.packet;
+
+            if (packet.pipeline != boundPipeline) {
+                packet.pipeline->Bind(commandBuffer);
+                boundPipeline = packet.pipeline;
+                ++frameStats.bindCount;
+            }
+            // A set stays bound across pipelines of the same layout
+            if (packet.descriptorSet != VK_NULL_HANDLE
+                && (packet.descriptorSet != boundDescriptorSet || packet.pipelineLayout != boundLayout)) {
+                vkCmdBindDescriptorSets(commandBuffer,
+                                        VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                        packet.pipelineLayout,
+                                        0,
+                                        1,
+                                        &packet.descriptorSet,
+                                        0,
+                                        nullptr);
+                boundDescriptorSet = packet.descriptorSet;
+                boundLayout = packet.pipelineLayout;
+                boundObjectSet = VK_NULL_HANDLE;
+                ++frameStats.bindCount;
+            }
+            if (packet.objectDescriptorSet != VK_NULL_HANDLE && packet.objectDescriptorSet != boundObjectSet) {
+                vkCmdBindDescriptorSets(commandBuffer,
+                                        VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                        packet.pipelineLayout,
+                                        1,
+                                        1,
+                                        &packet.objectDescriptorSet,
+                                        0,
+                                        nullptr);
+                boundObjectSet = packet.objectDescriptorSet;
+                ++frameStats.bindCount;
+            }
+            if (queued.pushConstantSize > 0) {
+                vkCmdPushConstants(commandBuffer,
+                                   packet.pipelineLayout,
+                                   packet.pushConstantStages,
+                                   0,
+                                   queued.pushConstantSize,
+                                   m_PushConstants.data() + queued.pushConstantOffset);
+            }
+            // Models of the same geometry block share their vertex and index buffers
+            if (packet.model->GetGeometry().block != boundGeometryBlock) {
+                packet.model->Bind(commandBuffer);
+                boundGeometryBlock = packet.model->GetGeometry().block;
+                ++frameStats.bindCount;
+            }
+
+            if (draw.instanceCount == 0) { packet.model->Draw(commandBuffer, packet.lodLevel); }
+            else { packet.model->Draw(commandBuffer, packet.lodLevel, draw.instanceCount, draw.firstInstance); }
+        }
+    }
+
+    void Liara_RenderQueue::Clear() {
+        m_Packets.clear();
+        m_PushConstants.clear();
+        m_Instances.clear();
+        m_Draws.clear();
+    }
+
+    uint64_t Liara_RenderQueue::GetId(IdTable& ids, const uint64_t handle) const {
+        const auto [it, inserted] = ids.entries.try_emplace(handle);
+        if (inserted) {
+            if (ids.freeIds.empty()) { it->second.id = ids.nextId++; }
+            else {
+                it->second.id = ids.freeIds.back();
+                ids.freeIds.pop_back();
+            }
+        }
+        it->second.lastFrame = m_FrameCount;
+        return it->second.id;
+    }
+
+    void Liara_RenderQueue::RetireIds(IdTable& ids) const {
+        std::erase_if(ids.entries, [&](const auto& entry) {
+            if (entry.second.lastFrame + ID_RETIREMENT_FRAMES > m_FrameCount) { return false; }
+            ids.freeIds.push_back(entry.second.id);
+            return true;
+        });
+    }
+
+    bool Liara_RenderQueue::CanMerge(const DrawPacket& first, const DrawPacket& other) {
+        return other.pipeline == first.pipeline && other.pipelineLayout == first.pipelineLayout
+               && other.descriptorSet == first.descriptorSet && other.objectDescriptorSet == first.objectDescriptorSet
+               && other.model == first.model
+               && other.lodLevel == first.lodLevel;
+    }
+
+    void Liara_RenderQueue::SortPackets() {
+        const size_t count = m_Packets.size();
+        m_Keys.resize(count);
+        m_KeysScratch.resize(count);
+        m_Order.resize(count);
+        m_OrderScratch.resize(count);
+        for (size_t i = 0; i < count; ++i) { m_Keys[i] = m_Packets[i].packet.sortKey; }
+        std::iota(m_Order.begin(), m_Order.end(), 0u);
+
+        // LSD radix sort, one byte per pass. Stable, so packets with equal keys keep their submission order
+        for (uint32_t shift = 0; shift < 64; shift += 8) {
+            std::array<uint32_t, 256> histogram{};
+            for (const uint64_t key : m_Keys) { ++histogram[(key >> shift) & 0xFF]; }
+            // Every key has the same byte, the pass would not move anything
+            if (histogram[(m_Keys[0] >> shift) & 0xFF] == count) { continue; }
+
+            uint32_t offset = 0;
+            for (uint32_t& bucket : histogram) { offset += std::exchange(bucket, offset); }
+            for (size_t i = 0; i < count; ++i) {
+                const uint32_t destination = histogram[(m_Keys[i] >> shift) & 0xFF]++;
+                m_KeysScratch[destination] = m_Keys[i];
+                m_OrderScratch[destination] = m_Order[i];
+            }
+            m_Keys.swap(m_KeysScratch);
+            m_Order.swap(m_OrderScratch);
+        }
+    }
+
+    void Liara_RenderQueue::ReserveInstances(const uint32_t count) {
+        FrameInstances& frame = m_FrameInstances[m_FrameIndex];
+        if (frame.used + count <= frame.capacity) { return; }
+
+        // The draws already recorded this frame still read the old buffer, it is kept until the frame comes back
+        const uint32_t capacity = std::max({count, frame.capacity * 2, DEFAULT_INSTANCE_CAPACITY});
+        auto buffer = std::make_unique<Liara_Buffer>(
+            m_Device, static_cast<VkDeviceSize>(capacity) * sizeof(InstanceData), BufferConfig::Instance());
+        if (const VkResult result = buffer->Map(); result != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogGraphics, "Failed to map the instance buffer: {}", VkResultToString(result));
+        }
+        if (frame.buffer) { frame.retired.push_back(std::move(frame.buffer)); }
+        frame.buffer = std::move(buffer);
+        frame.capacity = capacity;
+        frame.used = 0;
+
+        LIARA_LOG_VERBOSE(LogGraphics, "Instance buffer of frame {} grown to {} instances", m_FrameIndex, capacity);
+    }
+}
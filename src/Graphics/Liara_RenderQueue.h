@@ -0,0 +1,271 @@
+/**
+ * @file Liara_RenderQueue.h
+ * @brief Defines the `Liara_RenderQueue` class, which sorts the draws of the frame before recording them.
+ *
+ * Systems submit draw packets instead of recording their draws directly. Each packet carries a 64-bit sort key
+ * built from its layer, pipeline, descriptor set, mesh and view depth. On flush the packets are radix sorted by key,
+ * and recorded with the redundant pipeline, descriptor set and vertex/index buffer binds removed.
+ *
+ * Key layouts, most significant bits first:
+ *      - state order:    layer (4) | pipeline (12) | material (12) | mesh (16) | depth (20)
+ *      - front to back:  layer (4) | depth (20) | pipeline (12) | material (12) | mesh (16)
+ * The mesh bits hold the model id and its level of detail (4 lowest bits), so each level is its own mesh.
+ * Ids are given back once their resource has not been drawn for a while, so that they stay within their bits as
+ * models come and go. More live resources than the bits can tell share ids, which only costs some binds.
+ * Solid draws use the sort mode of the queue, blended (transparent) draws are always sorted back to front.
+ *
+ * Packets submitted with per-instance data instead of push constants are instanced: once sorted, consecutive
+ * packets drawing the same mesh with the same state are merged into a single instanced draw. Their data is copied
+ * into a per-frame vertex buffer, bound at binding INSTANCE_BINDING and read by the shaders as instance attributes.
+ * The instance data is only the slot of the object in a Liara_ObjectBuffer, bound at set 1, where the shaders read
+ * the matrices of the object.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Liara_Buffer.h"
+#include "Liara_Device.h"
+
+namespace Liara::Core::Jobs
+{
+    class Liara_JobSystem;
+}
+
+namespace Liara::Graphics
+{
+    class Liara_Model;
+    class Liara_Pipeline;
+    class Liara_SecondaryCommandRecorder;
+
+    /**
+     * @brief Group of draws recorded in order, before any sorting inside of them.
+     */
+    enum class DrawLayer : uint8_t
+    {
+        SOLID = 0,    ///< Opaque geometry
+        BLENDED = 1,  ///< Transparent geometry, drawn after the solid one
+    };
+
+    /**
+     * @brief Order of the solid draws inside their layer.
+     */
+    enum class DrawSortMode : uint8_t
+    {
+        STATE,          ///< Fewest state changes: by pipeline, material, then mesh
+        FRONT_TO_BACK,  ///< Nearest first, so that early depth testing rejects the hidden fragments
+    };
+
+    /**
+     * @struct InstanceData
+     * @brief Per-instance vertex attribute of an instanced draw, at location 5 of the vertex shader.
+     */
+    struct InstanceData
+    {
+        uint32_t objectIndex = 0;  ///< Slot of the object in the object buffer of the packet
+
+        static constexpr uint32_t FIRST_LOCATION = 5;  ///< After the attributes of Liara_Model::Vertex
+
+        static VkVertexInputBindingDescription GetBindingDescription();
+        static std::vector<VkVertexInputAttributeDescription> GetAttributeDescriptions();
+    };
+
+    /**
+     * @struct DrawPacket
+     * @brief Everything needed to record one draw.
+     */
+    struct DrawPacket
+    {
+        uint64_t sortKey = 0;  ///< See Liara_RenderQueue::MakeSortKey
+        const Liara_Pipeline* pipeline = nullptr;
+        VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;        ///< Bound at set 0
+        VkDescriptorSet objectDescriptorSet = VK_NULL_HANDLE;  ///< Bound at set 1 if set, see Liara_ObjectBuffer
+        const Liara_Model* model = nullptr;
+        uint32_t lodLevel = 0;
+        VkShaderStageFlags pushConstantStages = 0;
+    };
+
+    /**
+     * @class Liara_RenderQueue
+     * @brief Collects the draw packets of the frame, sorts them and records them with the fewest binds.
+     * Not thread safe: packets are submitted and flushed from one thread at a time.
+     */
+    class Liara_RenderQueue
+    {
+    public:
+        static constexpr uint32_t INSTANCE_BINDING = 1;          ///< Vertex binding of the instance buffer
+        static constexpr uint32_t DEFAULT_INSTANCE_CAPACITY = 1024;  ///< Instances per frame before growing
+        static constexpr size_t RECORDING_CHUNK_SIZE = 256;          ///< Draws per secondary command buffer
+
+        /**
+         * @param device Device to create the per-frame instance buffers with.
+         * @param framesInFlight Number of frames recorded before the GPU is done with the oldest one.
+         */
+        explicit Liara_RenderQueue(Liara_Device& device, uint32_t framesInFlight);
+
+        /**
+         * @brief Starts recording a frame. The instance buffer of its index is no longer read by the GPU.
+         */
+        void BeginFrame(uint32_t frameIndex);
+
+        /**
+         * @brief Builds the sort key of a draw. Resources get small ids the first time they are seen.
+         * @param viewDepth Distance of the draw from the camera, negative values are clamped to 0.
+         */
+        [[nodiscard]] uint64_t MakeSortKey(DrawLayer layer,
+                                           const Liara_Pipeline* pipeline,
+                                           VkDescriptorSet descriptorSet,
+                                           const Liara_Model* model,
+                                           uint32_t lodLevel,
+                                           float viewDepth);
+
+        /**
+         * @brief Queues a draw, with the push constants to set before it.
+         */
+        void Submit(const DrawPacket& packet, std::span<const std::byte> pushConstants = {});
+
+        template <typename T> void Submit(const DrawPacket& packet, const T& pushConstants) {
+            static_assert(std::is_trivially_copyable_v<T>, "Push constants are copied byte by byte");
+            Submit(packet, std::as_bytes(std::span(&pushConstants, 1)));
+        }
+
+        /**
+         * @brief Queues one instance of an instanced draw. The pipeline must read InstanceData at INSTANCE_BINDING.
+         */
+        void SubmitInstance(const DrawPacket& packet, const InstanceData& instance);
+
+        /**
+         * @brief Sorts the queued packets, records them into the command buffer and empties the queue.
+         */
+        void Flush(VkCommandBuffer commandBuffer);
+
+        /**
+         * @brief Sorts the queued packets, records them in chunks of secondary command buffers on the job system and
+         * empties the queue. The draws are split after sorting and merging, so the result is the same as one flush.
+         * @param commandBuffers Receives the recorded buffers in draw order, after the ones it already holds.
+         */
+        void Flush(Liara_SecondaryCommandRecorder& recorder,
+                   Core::Jobs::Liara_JobSystem& jobSystem,
+                   std::vector<VkCommandBuffer>& commandBuffers);
+
+        void SetSortMode(const DrawSortMode sortMode) { m_SortMode = sortMode; }
+        [[nodiscard]] DrawSortMode GetSortMode() const { return m_SortMode; }
+
+        /**
+         * @brief Whether compatible instanced packets are merged, each one is drawn on its own otherwise.
+         */
+        void SetInstancing(const bool instancing) { m_Instancing = instancing; }
+        [[nodiscard]] bool IsInstancing() const { return m_Instancing; }
+
+        [[nodiscard]] size_t Size() const { return m_Packets.size(); }
+
+    private:
+        static constexpr uint32_t NO_INSTANCE = UINT32_MAX;
+        static constexpr uint64_t ID_RETIREMENT_FRAMES = 64;  ///< Frames without a draw before an id is given back
+
+        /**
+         * @brief Small ids of the resources seen by the queue, by handle.
+         */
+        struct IdTable
+        {
+            struct Entry
+            {
+                uint64_t id = 0;
+                uint64_t lastFrame = 0;  ///< Last frame the resource was drawn in
+            };
+
+            std::unordered_map<uint64_t, Entry> entries;
+            std::vector<uint64_t> freeIds;  ///< Given back, reused before new ones
+            uint64_t nextId = 0;
+        };
+
+        struct QueuedPacket
+        {
+            DrawPacket packet;
+            uint32_t pushConstantOffset = 0;
+            uint32_t pushConstantSize = 0;
+            uint32_t instanceIndex = NO_INSTANCE;  ///< Index in m_Instances of an instanced packet
+        };
+
+        /**
+         * @brief One draw of the flush, after sorting and merging.
+         */
+        struct QueuedDraw
+        {
+            uint32_t packetIndex = 0;    ///< Packet whose state the draw uses
+            uint32_t instanceCount = 0;  ///< 0 for a packet drawn without instance data
+            uint32_t firstInstance = 0;
+        };
+
+        /**
+         * @brief Instance buffer of one frame in flight.
+         */
+        struct FrameInstances
+        {
+            std::unique_ptr<Liara_Buffer> buffer;
+            uint32_t capacity = 0;
+            uint32_t used = 0;  ///< Instances written by the flushes of the frame so far
+            std::vector<std::unique_ptr<Liara_Buffer>> retired;  ///< Outgrown buffers, still read by the frame
+        };
+
+        [[nodiscard]] uint64_t GetId(IdTable& ids, uint64_t handle) const;
+
+        /**
+         * @brief Gives back the ids of the resources not drawn for ID_RETIREMENT_FRAMES frames, they may be gone.
+         */
+        void RetireIds(IdTable& ids) const;
+        [[nodiscard]] static bool CanMerge(const DrawPacket& first, const DrawPacket& other);
+
+        void SortPackets();
+
+        /**
+         * @brief Sorts the packets, merges the instanced ones and copies their instance data into the frame buffer.
+         */
+        void BuildDraws();
+
+        /**
+         * @brief Records draws with nothing bound beforehand. Only reads the queue, so chunks can record in parallel.
+         */
+        void RecordDraws(VkCommandBuffer commandBuffer, std::span<const QueuedDraw> draws) const;
+        void Clear();
+
+        /**
+         * @brief Makes room for count more instances in the frame buffer, replacing it with a larger one if needed.
+         */
+        void ReserveInstances(uint32_t count);
+
+        Liara_Device& m_Device;
+        DrawSortMode m_SortMode = DrawSortMode::STATE;
+        bool m_Instancing = true;
+
+        std::vector<QueuedPacket> m_Packets;
+        std::vector<std::byte> m_PushConstants;
+        std::vector<InstanceData> m_Instances;
+        std::vector<QueuedDraw> m_Draws;
+
+        std::vector<FrameInstances> m_FrameInstances;
+        uint32_t m_FrameIndex = 0;
+        uint64_t m_FrameCount = 0;  ///< Frames begun, to age the ids
+
+        // Radix sort buffers, kept to avoid allocating every frame
+        std::vector<uint64_t> m_Keys;
+        std::vector<uint64_t> m_KeysScratch;
+        std::vector<uint32_t> m_Order;
+        std::vector<uint32_t> m_OrderScratch;
+
+        // Ids stay the same from one frame to the next, so that equal states keep the same order
+        IdTable m_PipelineIds;
+        IdTable m_MaterialIds;
+        IdTable m_MeshIds;
+    };
+}
@@ -0,0 +1,114 @@
+#include "Liara_SecondaryCommandRecorder.h"
+
+#include "Core/Logging/LogMacros.h"
+#include "Graphics/Liara_Device.h"
+#include "Graphics/VkResultToString.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    Liara_SecondaryCommandRecorder::Liara_SecondaryCommandRecorder(Liara_Device& device,
+                                                                   const uint32_t threadCount,
+                                                                   const uint32_t framesInFlight)
+        : m_Device(device)
+        , m_ThreadCount(threadCount)
+        , m_Pools(static_cast<size_t>(threadCount) * framesInFlight) {
+        LIARA_CHECK_ARGUMENT(threadCount > 0 && framesInFlight > 0,
+                             LogGraphics,
+                             "A secondary command recorder needs at least one thread and one frame in flight");
+
+        // The buffers only live for one frame, and are reset all at once with their pool
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = m_Device.GetGraphicsQueueFamily();
+        for (ThreadPool& pool : m_Pools) {
+            if (const VkResult result = vkCreateCommandPool(m_Device.GetDevice(), &poolInfo, nullptr, &pool.pool);
+                result != VK_SUCCESS) {
+                LIARA_THROW_RUNTIME_ERROR(
+                    LogVulkan, "Failed to create a secondary command pool: {}", VkResultToString(result));
+            }
+        }
+    }
+
+    Liara_SecondaryCommandRecorder::~Liara_SecondaryCommandRecorder() {
+        // Destroying a pool frees its command buffers
+        for (const ThreadPool& pool : m_Pools) { vkDestroyCommandPool(m_Device.GetDevice(), pool.pool, nullptr); }
+    }
+
+    void Liara_SecondaryCommandRecorder::BeginFrame(const uint32_t frameIndex,
+                                                    VkRenderPass renderPass,
+                                                    VkFramebuffer framebuffer,
+                                                    const VkExtent2D extent) {
+        LIARA_CHECK_OUT_OF_RANGE(
+            (frameIndex + 1) * m_ThreadCount <= m_Pools.size(), LogGraphics, "Frame index out of range");
+        m_FrameIndex = frameIndex;
+        m_RenderPass = renderPass;
+        m_Framebuffer = framebuffer;
+        m_Extent = extent;
+
+        for (uint32_t thread = 0; thread < m_ThreadCount; ++thread) {
+            ThreadPool& pool = m_Pools[m_FrameIndex * m_ThreadCount + thread];
+            if (pool.used == 0) { continue; }
+            vkResetCommandPool(m_Device.GetDevice(), pool.pool, 0);
+            pool.used = 0;
+        }
+    }
+
+    VkCommandBuffer Liara_SecondaryCommandRecorder::Begin(const uint32_t threadIndex) {
+        LIARA_CHECK_OUT_OF_RANGE(threadIndex < m_ThreadCount, LogGraphics, "Thread index out of range");
+        ThreadPool& pool = m_Pools[m_FrameIndex * m_ThreadCount + threadIndex];
+
+        if (pool.used == pool.commandBuffers.size()) {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = pool.pool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocInfo.commandBufferCount = 1;
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            if (const VkResult result = vkAllocateCommandBuffers(m_Device.GetDevice(), &allocInfo, &commandBuffer);
+                result != VK_SUCCESS) {
+                LIARA_THROW_RUNTIME_ERROR(
+                    LogVulkan, "Failed to allocate a secondary command buffer: {}", VkResultToString(result));
+            }
+            pool.commandBuffers.push_back(commandBuffer);
+        }
+        VkCommandBuffer commandBuffer = pool.commandBuffers[pool.used++];
+
+        VkCommandBufferInheritanceInfo inheritanceInfo{};
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.renderPass = m_RenderPass;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = m_Framebuffer;
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+                          | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+        if (const VkResult result = vkBeginCommandBuffer(commandBuffer, &beginInfo); result != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(
+                LogVulkan, "Failed to begin a secondary command buffer: {}", VkResultToString(result));
+        }
+
+        VkViewport viewport{};
+        viewport.width = static_cast<float>(m_Extent.width);
+        viewport.height = static_cast<float>(m_Extent.height);
+        viewport.maxDepth = 1.0f;
+        const VkRect2D scissor{{0, 0}, m_Extent};
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+        return commandBuffer;
+    }
+
+    void Liara_SecondaryCommandRecorder::End(VkCommandBuffer commandBuffer) const {
+        if (const VkResult result = vkEndCommandBuffer(commandBuffer); result != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(
+                LogVulkan, "Failed to end a secondary command buffer: {}", VkResultToString(result));
+        }
+    }
+}
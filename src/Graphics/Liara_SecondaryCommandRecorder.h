@@ -0,0 +1,76 @@
+/**
+ * @file Liara_SecondaryCommandRecorder.h
+ * @brief Defines the `Liara_SecondaryCommandRecorder` class, which hands out secondary command buffers to the threads
+ * recording the main render pass.
+ *
+ * Command pools are externally synchronized, so each thread of the job system owns one pool per frame in flight.
+ * The pools of a frame are reset when its index comes back, the GPU being done with it, and their command buffers are
+ * reused from one frame to the next. The primary command buffer executes the recorded buffers in the order it wants.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    class Liara_Device;
+
+    /**
+     * @class Liara_SecondaryCommandRecorder
+     * @brief Per-thread and per-frame pools of secondary command buffers continuing a render pass.
+     */
+    class Liara_SecondaryCommandRecorder
+    {
+    public:
+        /**
+         * @param device Device to create the command pools on, for its graphics queue family.
+         * @param threadCount Number of threads recording, see Liara_JobSystem::GetThreadCount.
+         * @param framesInFlight Number of frames recorded before the GPU is done with the oldest one.
+         */
+        Liara_SecondaryCommandRecorder(Liara_Device& device, uint32_t threadCount, uint32_t framesInFlight);
+        ~Liara_SecondaryCommandRecorder();
+
+        Liara_SecondaryCommandRecorder(const Liara_SecondaryCommandRecorder&) = delete;
+        Liara_SecondaryCommandRecorder& operator=(const Liara_SecondaryCommandRecorder&) = delete;
+
+        /**
+         * @brief Starts recording a frame, resetting the pools of its index.
+         * @param renderPass Render pass the buffers continue, or one compatible with it.
+         * @param framebuffer Framebuffer of the render pass instance, VK_NULL_HANDLE if unknown.
+         * @param extent Size of the viewport and scissor set at the start of each buffer.
+         */
+        void BeginFrame(uint32_t frameIndex, VkRenderPass renderPass, VkFramebuffer framebuffer, VkExtent2D extent);
+
+        /**
+         * @brief Begins a secondary command buffer from the pool of a thread, with the viewport and scissor set.
+         * Secondary command buffers do not inherit the dynamic state of the primary one.
+         * @param threadIndex Index of the calling thread, see Liara_JobSystem::GetCurrentThreadIndex.
+         */
+        [[nodiscard]] VkCommandBuffer Begin(uint32_t threadIndex);
+
+        void End(VkCommandBuffer commandBuffer) const;
+
+        [[nodiscard]] uint32_t GetThreadCount() const { return m_ThreadCount; }
+
+    private:
+        struct ThreadPool
+        {
+            VkCommandPool pool = VK_NULL_HANDLE;
+            std::vector<VkCommandBuffer> commandBuffers;  ///< Allocated so far, kept across frames
+            uint32_t used = 0;                            ///< Buffers begun this frame
+        };
+
+        Liara_Device& m_Device;
+        uint32_t m_ThreadCount;
+        std::vector<ThreadPool> m_Pools;  ///< Indexed by frameIndex * m_ThreadCount + threadIndex
+        uint32_t m_FrameIndex = 0;
+
+        VkRenderPass m_RenderPass = VK_NULL_HANDLE;
+        VkFramebuffer m_Framebuffer = VK_NULL_HANDLE;
+        VkExtent2D m_Extent{};
+    };
+}
@@ -27,9 +27,14 @@ namespace Liara::Graphics
 
         [[nodiscard]] VkFramebuffer GetFrameBuffer(const int index) const { return m_SwapChainFramebuffers[index]; }
         [[nodiscard]] VkRenderPass GetRenderPass() const { return m_RenderPass; }
+        /// Compatible with GetRenderPass, loads the attachments instead of clearing them
+        [[nodiscard]] VkRenderPass GetResumeRenderPass() const { return m_ResumeRenderPass; }
         [[nodiscard]] VkImageView GetImageView(const int index) const { return m_SwapChainImageViews[index]; }
+        [[nodiscard]] VkImage GetDepthImage(const int index) const { return m_DepthImages[index]; }
+        [[nodiscard]] VkImageView GetDepthImageView(const int index) const { return m_DepthImageViews[index]; }
         [[nodiscard]] size_t ImageCount() const { return m_SwapChainImages.size(); }
         [[nodiscard]] VkFormat GetSwapChainImageFormat() const { return m_SwapChainImageFormat; }
+        [[nodiscard]] VkFormat GetDepthFormat() const { return m_SwapChainDepthFormat; }
         [[nodiscard]] VkExtent2D GetSwapChainExtent() const { return m_SwapChainExtent; }
         [[nodiscard]] uint32_t Width() const { return m_SwapChainExtent.width; }
         [[nodiscard]] uint32_t Height() const { return m_SwapChainExtent.height; }
@@ -70,9 +75,10 @@ namespace Liara::Graphics
 
         std::vector<VkFramebuffer> m_SwapChainFramebuffers;
         VkRenderPass m_RenderPass{};
+        VkRenderPass m_ResumeRenderPass{};
 
         std::vector<VkImage> m_DepthImages;
-        std::vector<VkDeviceMemory> m_DepthImageMemorys;
+        std::vector<MemoryAllocation> m_DepthImageMemorys;
         std::vector<VkImageView> m_DepthImageViews;
         std::vector<VkImage> m_SwapChainImages;
         std::vector<VkImageView> m_SwapChainImageViews;
@@ -2,15 +2,19 @@
 
 #include "Core/Liara_SettingsManager.h"
 #include "Graphics/Liara_Device.h"
+#include "Graphics/Liara_UploadContext.h"
 
 #include <vulkan/vulkan_core.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "Liara_Buffer.h"
 
@@ -94,7 +98,7 @@ namespace Liara::Graphics
         vkDestroySampler(m_Device.GetDevice(), m_Sampler, nullptr);
         vkDestroyImageView(m_Device.GetDevice(), m_ImageView, nullptr);
         vkDestroyImage(m_Device.GetDevice(), m_Image, nullptr);
-        vkFreeMemory(m_Device.GetDevice(), m_ImageMemory, nullptr);
+        m_Device.FreeMemory(m_ImageMemory);
     }
 
     VkDescriptorImageInfo Liara_Texture::GetDescriptorInfo() const {
@@ -102,6 +106,98 @@ namespace Liara::Graphics
             .sampler = m_Sampler, .imageView = m_ImageView, .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
     }
 
+    VkDeviceSize Liara_Texture::Relocate(const MemoryAllocation& allocation,
+                                         VkCommandBuffer commandBuffer,
+                                         RetiredResource& retired) {
+        LIARA_CHECK_ARGUMENT(allocation.memory == m_ImageMemory.memory && allocation.offset == m_ImageMemory.offset,
+                             LogRendering,
+                             "The allocation to relocate is not the one of the texture");
+
+        const VkImage oldImage = m_Image;
+        retired.image = std::exchange(m_Image, VK_NULL_HANDLE);
+        retired.view = std::exchange(m_ImageView, VK_NULL_HANDLE);
+        retired.memory = std::exchange(m_ImageMemory, {});
+
+        // The allocator skips the block being evacuated, the new image lands in another one
+        CreateImage(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, IMAGE_USAGE);
+        m_Device.GetMemoryAllocator().SetRelocatable(m_ImageMemory, this);
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = m_MipLevels;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+
+        // Once the previous frames are done sampling the old image, from which every level is copied
+        VkImageMemoryBarrier source = barrier;
+        source.image = oldImage;
+        source.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        source.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        source.srcAccessMask = 0;
+        source.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        VkImageMemoryBarrier destination = barrier;
+        destination.image = m_Image;
+        destination.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        destination.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        destination.srcAccessMask = 0;
+        destination.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        const std::array before{source, destination};
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             static_cast<uint32_t>(before.size()),
+                             before.data());
+
+        std::vector<VkImageCopy> copies(m_MipLevels);
+        for (uint32_t level = 0; level < m_MipLevels; ++level) {
+            VkImageCopy& copy = copies[level];
+            copy.srcSubresource = {.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                                   .mipLevel = level,
+                                   .baseArrayLayer = 0,
+                                   .layerCount = 1};
+            copy.dstSubresource = copy.srcSubresource;
+            copy.extent = {
+                .width = std::max(1u, m_Width >> level), .height = std::max(1u, m_Height >> level), .depth = 1};
+        }
+        vkCmdCopyImage(commandBuffer,
+                       oldImage,
+                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       m_Image,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       static_cast<uint32_t>(copies.size()),
+                       copies.data());
+
+        destination.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        destination.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        destination.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        destination.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &destination);
+
+        CreateTextureImageView();
+        if (m_RelocationCallback) { m_RelocationCallback(*this); }
+        return retired.memory.size;
+    }
+
     void Liara_Texture::CreateTextureImage(std::span<const std::byte> pixelData) {
         assert(!pixelData.empty() && "No pixel data to create texture image");
         assert(m_Width > 0 && m_Height > 0 && "Invalid texture size");
@@ -112,14 +208,36 @@ namespace Liara::Graphics
                              static_cast<VkDeviceSize>(m_Width) * m_Height * STBI_rgb_alpha,
                              pixelData.size_bytes());
 
-        const auto stagingBuffer = std::make_unique<Liara_Buffer>(m_Device, pixelData, BufferConfig::Staging());
+        CreateImage(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, IMAGE_USAGE);
 
-        CreateImage(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                    VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+        // Copied on the transfer queue, the mipmaps are blitted on the graphics queue before the next frame
+        Liara_UploadBatch batch = m_Device.GetUploadContext().Begin();
+        TransitionImageLayout(batch.GetCommandBuffer(),
+                              m_Image,
+                              VK_IMAGE_LAYOUT_UNDEFINED,
+                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
-        TransitionImageLayout(m_Image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-        CopyBufferToImage(stagingBuffer->GetBuffer(), m_Image);
-        GenerateMipmaps();
+        VkBufferImageCopy region{};
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = {.x = 0, .y = 0, .z = 0};
+        region.imageExtent = {.width = m_Width, .height = m_Height, .depth = 1};
+        batch.CopyToImage(pixelData, m_Image, region);
+
+        const VkImageSubresourceRange range{.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                                            .baseMipLevel = 0,
+                                            .levelCount = m_MipLevels,
+                                            .baseArrayLayer = 0,
+                                            .layerCount = 1};
+        batch.ReleaseImage(m_Image, range, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        batch.OnGraphicsQueue([this](VkCommandBuffer commandBuffer) {
+            GenerateMipmaps(commandBuffer);
+            // Movable once the graphics queue owns the final contents, the defragmenter copies it there
+            m_Device.GetMemoryAllocator().SetRelocatable(m_ImageMemory, this);
+        });
+        batch.Submit();
     }
 
     void Liara_Texture::CreateImage(const VkMemoryPropertyFlags properties, VkImageUsageFlags usage) {
@@ -141,9 +259,10 @@ namespace Liara::Graphics
         m_Device.CreateImageWithInfo(imageInfo, properties, m_Image, m_ImageMemory);
     }
 
-    void Liara_Texture::TransitionImageLayout(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout) const {
-        VkCommandBuffer commandBuffer = m_Device.BeginSingleTimeCommands();
-
+    void Liara_Texture::TransitionImageLayout(VkCommandBuffer commandBuffer,
+                                              VkImage image,
+                                              VkImageLayout oldLayout,
+                                              VkImageLayout newLayout) const {
         VkImageMemoryBarrier barrier{};
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
         barrier.oldLayout = oldLayout;
@@ -177,29 +296,6 @@ namespace Liara::Graphics
 
 
         vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-        m_Device.EndSingleTimeCommands(commandBuffer);
-    }
-
-    void Liara_Texture::CopyBufferToImage(VkBuffer buffer, VkImage image) const {
-        VkCommandBuffer commandBuffer = m_Device.BeginSingleTimeCommands();
-
-        VkBufferImageCopy region{};
-        region.bufferOffset = 0;
-        region.bufferRowLength = 0;
-        region.bufferImageHeight = 0;
-
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel = 0;
-        region.imageSubresource.baseArrayLayer = 0;
-        region.imageSubresource.layerCount = 1;
-
-        region.imageOffset = {.x = 0, .y = 0, .z = 0};
-        region.imageExtent = {.width = m_Width, .height = m_Height, .depth = 1};
-
-        vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-        m_Device.EndSingleTimeCommands(commandBuffer);
     }
 
     void Liara_Texture::CreateTextureImageView() {
@@ -255,7 +351,7 @@ namespace Liara::Graphics
     // Generate mipmaps at runtime is not recommended.
     // It is better to generate them offline and load them directly.
     // So, it can be useful to create a tool to generate mipmaps offline in the future.
-    void Liara_Texture::GenerateMipmaps() const {
+    void Liara_Texture::GenerateMipmaps(VkCommandBuffer commandBuffer) const {
         VkFormatProperties formatProperties;
         vkGetPhysicalDeviceFormatProperties(m_Device.GetPhysicalDevice(), m_Format, &formatProperties);
 
@@ -265,8 +361,6 @@ namespace Liara::Graphics
             return;
         }
 
-        VkCommandBuffer commandBuffer = m_Device.BeginSingleTimeCommands();
-
         VkImageMemoryBarrier barrier{};
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
         barrier.image = m_Image;
@@ -357,8 +451,6 @@ namespace Liara::Graphics
                              nullptr,
                              1,
                              &barrier);
-
-        m_Device.EndSingleTimeCommands(commandBuffer);
     }
 
     Liara_Texture::TextureLoadResult
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "Core/Liara_SettingsManager.h"
+#include "Graphics/Liara_Relocatable.h"
 
 #include <vulkan/vulkan_core.h>
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <span>
 #include <stb/stb_image.h>
@@ -18,8 +20,9 @@ namespace Liara::Graphics
 {
     /**
      * @brief Main texture class for managing Vulkan textures.
+     * The defragmenter may move its image, the descriptors using it must then be written again.
      */
-    class Liara_Texture
+    class Liara_Texture final : public Liara_Relocatable
     {
     public:
         enum class TextureLoadResult : uint8_t
@@ -49,14 +52,27 @@ namespace Liara::Graphics
                                                              std::string_view filename,
                                                              const Core::Liara_SettingsManager& settingsManager);
 
-        ~Liara_Texture();  ///< Destructor to clean up the texture
+        ~Liara_Texture() override;  ///< Destructor to clean up the texture
         Liara_Texture(const Liara_Texture&) = delete;
         Liara_Texture& operator=(const Liara_Texture&) = delete;
 
         [[nodiscard]] VkFormat GetFormat() const { return m_Format; }   ///< Get the format of the texture
         [[nodiscard]] VkDescriptorImageInfo GetDescriptorInfo() const;  ///< Get the descriptor info of the texture
 
+        /**
+         * @brief Sets the function called once the image has moved, to write the descriptors using it again.
+         */
+        void SetRelocationCallback(std::function<void(const Liara_Texture&)> callback) {
+            m_RelocationCallback = std::move(callback);
+        }
+
+        VkDeviceSize
+        Relocate(const MemoryAllocation& allocation, VkCommandBuffer commandBuffer, RetiredResource& retired) override;
+
     private:
+        static constexpr VkImageUsageFlags IMAGE_USAGE =
+            VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
         Liara_Texture(Liara_Device& device,
                       uint32_t width,
                       uint32_t height,
@@ -66,17 +82,19 @@ namespace Liara::Graphics
 
         void CreateTextureImage(std::span<const std::byte> pixelData);
         void CreateImage(VkMemoryPropertyFlags properties, VkImageUsageFlags usage);
-        void TransitionImageLayout(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout) const;
-        void CopyBufferToImage(VkBuffer buffer, VkImage image) const;
+        void TransitionImageLayout(VkCommandBuffer commandBuffer,
+                                   VkImage image,
+                                   VkImageLayout oldLayout,
+                                   VkImageLayout newLayout) const;
         void CreateTextureImageView();
         void CreateTextureSampler();
-        void GenerateMipmaps() const;
+        void GenerateMipmaps(VkCommandBuffer commandBuffer) const;
 
         Liara_Device& m_Device;
         const Core::Liara_SettingsManager& m_SettingsManager;
 
         VkImage m_Image{};
-        VkDeviceMemory m_ImageMemory{};
+        MemoryAllocation m_ImageMemory;
         VkImageView m_ImageView{};
         VkSampler m_Sampler{};
         uint16_t m_MipLevels = 1;
@@ -85,6 +103,8 @@ namespace Liara::Graphics
         uint32_t m_Height;
         VkFormat m_Format;
 
+        std::function<void(const Liara_Texture&)> m_RelocationCallback;
+
         struct Builder
         {
             int width{}, height{}, channels{};
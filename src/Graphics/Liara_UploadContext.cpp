@@ -0,0 +1,429 @@
+#include "Liara_UploadContext.h"
+
+#include "Core/Logging/LogMacros.h"
+#include "Graphics/Liara_Buffer.h"
+#include "Graphics/Liara_Device.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace Liara::Graphics
+{
+    Liara_UploadBatch::Liara_UploadBatch(Liara_UploadContext& context)
+        : m_Context(context)
+        , m_Lock(context.m_BatchMutex)
+        , m_CommandBuffer(context.BeginRecording()) {}
+
+    Liara_UploadBatch::~Liara_UploadBatch() {
+        if (m_Lock.owns_lock()) { Submit(); }
+    }
+
+    VkCommandBuffer Liara_UploadBatch::GetCommandBuffer() const {
+        LIARA_CHECK_RUNTIME(m_Lock.owns_lock(), LogGraphics, "The upload batch was already submitted");
+        return m_CommandBuffer;
+    }
+
+    void Liara_UploadBatch::CopyToBuffer(const std::span<const std::byte> data,
+                                         VkBuffer buffer,
+                                         const VkDeviceSize offset) {
+        if (data.empty()) { return; }
+        const auto [source, sourceOffset] = m_Context.Stage(data);
+        const VkBufferCopy copy{.srcOffset = sourceOffset, .dstOffset = offset, .size = data.size()};
+        vkCmdCopyBuffer(GetCommandBuffer(), source, buffer, 1, &copy);
+        ReleaseBuffer(buffer, offset, data.size());
+    }
+
+    void Liara_UploadBatch::CopyToImage(const std::span<const std::byte> data,
+                                        VkImage image,
+                                        VkBufferImageCopy region) {
+        if (data.empty()) { return; }
+        const auto [source, sourceOffset] = m_Context.Stage(data);
+        region.bufferOffset = sourceOffset;
+        vkCmdCopyBufferToImage(GetCommandBuffer(), source, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    }
+
+    void Liara_UploadBatch::ReleaseBuffer(VkBuffer buffer, const VkDeviceSize offset, const VkDeviceSize size) {
+        LIARA_CHECK_RUNTIME(m_Lock.owns_lock(), LogGraphics, "The upload batch was already submitted");
+        m_Context.m_BatchHandoff.buffers.push_back(VkBufferMemoryBarrier{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = 0,
+            .srcQueueFamilyIndex = m_Context.m_TransferFamily,
+            .dstQueueFamilyIndex = m_Context.m_GraphicsFamily,
+            .buffer = buffer,
+            .offset = offset,
+            .size = size});
+    }
+
+    void Liara_UploadBatch::ReleaseImage(VkImage image,
+                                         const VkImageSubresourceRange& range,
+                                         const VkImageLayout oldLayout,
+                                         const VkImageLayout newLayout) {
+        LIARA_CHECK_RUNTIME(m_Lock.owns_lock(), LogGraphics, "The upload batch was already submitted");
+        m_Context.m_BatchHandoff.images.push_back(
+            VkImageMemoryBarrier{.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                                 .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                                 .dstAccessMask = 0,
+                                 .oldLayout = oldLayout,
+                                 .newLayout = newLayout,
+                                 .srcQueueFamilyIndex = m_Context.m_TransferFamily,
+                                 .dstQueueFamilyIndex = m_Context.m_GraphicsFamily,
+                                 .image = image,
+                                 .subresourceRange = range});
+    }
+
+    void Liara_UploadBatch::OnGraphicsQueue(std::function<void(VkCommandBuffer)> record) {
+        LIARA_CHECK_RUNTIME(m_Lock.owns_lock(), LogGraphics, "The upload batch was already submitted");
+        m_Context.m_BatchHandoff.graphicsWork.push_back(std::move(record));
+    }
+
+    UploadTicket Liara_UploadBatch::Submit() {
+        const UploadTicket ticket = m_Context.Submit(GetCommandBuffer());
+        m_CommandBuffer = VK_NULL_HANDLE;
+        m_Lock.unlock();
+        return ticket;
+    }
+
+    Liara_UploadContext::Liara_UploadContext(Liara_Device& device,
+                                             const VkDeviceSize ringSize,
+                                             const uint32_t framesInFlight)
+        : m_Device(device)
+        , m_GraphicsFamily(device.GetGraphicsQueueFamily())
+        , m_TransferFamily(device.GetTransferQueueFamily())
+        , m_Queue(device.GetTransferQueue()) {
+        LIARA_CHECK_ARGUMENT(ringSize > 0, LogGraphics, "The staging ring cannot be empty");
+
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.queueFamilyIndex = m_TransferFamily;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        if (vkCreateCommandPool(device.GetDevice(), &poolInfo, nullptr, &m_CommandPool) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogGraphics, "Failed to create the upload command pool!");
+        }
+
+        poolInfo.queueFamilyIndex = m_GraphicsFamily;
+        if (vkCreateCommandPool(device.GetDevice(), &poolInfo, nullptr, &m_HandoffPool) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogGraphics, "Failed to create the upload handoff command pool!");
+        }
+        m_HandoffCommandBuffers.resize(framesInFlight);
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandPool = m_HandoffPool;
+        allocInfo.commandBufferCount = framesInFlight;
+        if (vkAllocateCommandBuffers(device.GetDevice(), &allocInfo, m_HandoffCommandBuffers.data()) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogGraphics, "Failed to allocate the upload handoff command buffers!");
+        }
+
+        VkSemaphoreTypeCreateInfo timelineInfo{};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timelineInfo.initialValue = 0;
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = &timelineInfo;
+        if (vkCreateSemaphore(device.GetDevice(), &semaphoreInfo, nullptr, &m_Timeline) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogGraphics, "Failed to create the upload timeline semaphore!");
+        }
+
+        // Mapped for its whole life, the memory is host coherent
+        m_Ring = std::make_unique<Liara_Buffer>(device, ringSize, BufferConfig::Staging());
+        LIARA_CHECK_RUNTIME(m_Ring->Map() == VK_SUCCESS, LogGraphics, "Failed to map the staging ring");
+    }
+
+    Liara_UploadContext::~Liara_UploadContext() {
+        {
+            const std::scoped_lock lock(m_Mutex);
+            while (!m_InFlight.empty()) { RetireOldest(); }
+        }
+        vkDestroySemaphore(m_Device.GetDevice(), m_Timeline, nullptr);
+        vkDestroyCommandPool(m_Device.GetDevice(), m_HandoffPool, nullptr);
+        vkDestroyCommandPool(m_Device.GetDevice(), m_CommandPool, nullptr);
+        m_Ring.reset();
+    }
+
+    Liara_UploadBatch Liara_UploadContext::Begin() { return Liara_UploadBatch(*this); }
+
+    bool Liara_UploadContext::IsComplete(const UploadTicket ticket) {
+        const std::scoped_lock lock(m_Mutex);
+        RetireCompleted();
+        return ticket <= m_CompletedTicket;
+    }
+
+    void Liara_UploadContext::Wait(const UploadTicket ticket) {
+        const std::scoped_lock lock(m_Mutex);
+        LIARA_CHECK_ARGUMENT(ticket < m_NextTicket, LogGraphics, "Upload ticket {} was never given", ticket);
+        while (m_CompletedTicket < ticket) { RetireOldest(); }
+    }
+
+    UploadHandoff Liara_UploadContext::PrepareHandoff(const uint32_t frameIndex) {
+        LIARA_CHECK_OUT_OF_RANGE(
+            frameIndex < m_HandoffCommandBuffers.size(), LogGraphics, "Frame index {} out of range", frameIndex);
+
+        // The frame waits for every batch submitted so far, free once the timeline is past them
+        const std::scoped_lock lock(m_Mutex);
+        UploadHandoff handoff{.timeline = m_Timeline, .ticket = m_NextTicket - 1};
+        if (m_Handoff.IsEmpty()) { return handoff; }
+
+        // Its previous submission is done, beginning resets it
+        handoff.commandBuffer = m_HandoffCommandBuffers[frameIndex];
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(handoff.commandBuffer, &beginInfo);
+
+        // The acquire half of the ownership transfers, then the graphics work of the batches
+        if (!m_Handoff.buffers.empty() || !m_Handoff.images.empty()) {
+            vkCmdPipelineBarrier(handoff.commandBuffer,
+                                 VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                 VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 static_cast<uint32_t>(m_Handoff.buffers.size()),
+                                 m_Handoff.buffers.data(),
+                                 static_cast<uint32_t>(m_Handoff.images.size()),
+                                 m_Handoff.images.data());
+        }
+        for (const auto& record : m_Handoff.graphicsWork) { record(handoff.commandBuffer); }
+        vkEndCommandBuffer(handoff.commandBuffer);
+
+        m_Handoff = Handoff{};
+        return handoff;
+    }
+
+    UploadStats Liara_UploadContext::GetStats() const {
+        const std::scoped_lock lock(m_Mutex);
+        return UploadStats{.ringCapacity = m_Ring->GetSize(),
+                           .ringUsed = m_Used,
+                           .pendingBatches = static_cast<uint32_t>(m_InFlight.size()),
+                           .overflowCount = m_OverflowCount,
+                           .lastTicket = m_NextTicket - 1,
+                           .dedicatedQueue = m_TransferFamily != m_GraphicsFamily};
+    }
+
+    VkCommandBuffer Liara_UploadContext::BeginRecording() {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        {
+            const std::scoped_lock lock(m_Mutex);
+            RetireCompleted();
+            if (!m_FreeCommandBuffers.empty()) {
+                commandBuffer = m_FreeCommandBuffers.back();
+                m_FreeCommandBuffers.pop_back();
+            }
+        }
+
+        if (commandBuffer == VK_NULL_HANDLE) {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool = m_CommandPool;
+            allocInfo.commandBufferCount = 1;
+            if (vkAllocateCommandBuffers(m_Device.GetDevice(), &allocInfo, &commandBuffer) != VK_SUCCESS) {
+                LIARA_THROW_RUNTIME_ERROR(LogGraphics, "Failed to allocate an upload command buffer!");
+            }
+        }
+
+        // Beginning resets it, a recycled command buffer is done executing
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        return commandBuffer;
+    }
+
+    std::pair<VkBuffer, VkDeviceSize> Liara_UploadContext::Stage(const std::span<const std::byte> data) {
+        const std::scoped_lock lock(m_Mutex);
+
+        // The batches in flight give their space back in order, the one being recorded only once submitted
+        std::optional<VkDeviceSize> offset = AllocateRing(data.size());
+        while (!offset && !m_InFlight.empty()) {
+            RetireOldest();
+            offset = AllocateRing(data.size());
+        }
+        if (offset) {
+            m_Ring->WriteBytes(data, *offset);
+            return {m_Ring->GetBuffer(), *offset};
+        }
+
+        ++m_OverflowCount;
+        LIARA_LOG_VERBOSE(LogGraphics, "{} bytes do not fit in the staging ring, staged on their own", data.size());
+        const auto& buffer =
+            m_BatchOverflow.emplace_back(std::make_unique<Liara_Buffer>(m_Device, data, BufferConfig::Staging()));
+        return {buffer->GetBuffer(), 0};
+    }
+
+    UploadTicket Liara_UploadContext::Submit(VkCommandBuffer commandBuffer) {
+        RecordRelease(commandBuffer);
+        vkEndCommandBuffer(commandBuffer);
+
+        const std::scoped_lock lock(m_Mutex);
+        const UploadTicket ticket = m_NextTicket++;
+
+        // Signalled in ticket order, the submissions are made under the lock
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &ticket;
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &m_Timeline;
+        if (vkQueueSubmit(m_Queue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogGraphics, "Failed to submit an upload batch!");
+        }
+
+        m_InFlight.push_back(Submission{.ticket = ticket,
+                                        .commandBuffer = commandBuffer,
+                                        .ringEnd = m_Head,
+                                        .ringBytes = m_BatchBytes,
+                                        .overflow = std::move(m_BatchOverflow)});
+        m_BatchBytes = 0;
+        m_BatchOverflow.clear();
+
+        // Acquired by the next frame submitted
+        std::ranges::move(m_BatchHandoff.buffers, std::back_inserter(m_Handoff.buffers));
+        std::ranges::move(m_BatchHandoff.images, std::back_inserter(m_Handoff.images));
+        std::ranges::move(m_BatchHandoff.graphicsWork, std::back_inserter(m_Handoff.graphicsWork));
+        m_BatchHandoff = Handoff{};
+        return ticket;
+    }
+
+    void Liara_UploadContext::RecordRelease(VkCommandBuffer commandBuffer) {
+        if (m_TransferFamily != m_GraphicsFamily) {
+            // The release half of the ownership transfers, the graphics queue acquires them in the handoff
+            if (!m_BatchHandoff.buffers.empty() || !m_BatchHandoff.images.empty()) {
+                vkCmdPipelineBarrier(commandBuffer,
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                     0,
+                                     0,
+                                     nullptr,
+                                     static_cast<uint32_t>(m_BatchHandoff.buffers.size()),
+                                     m_BatchHandoff.buffers.data(),
+                                     static_cast<uint32_t>(m_BatchHandoff.images.size()),
+                                     m_BatchHandoff.images.data());
+            }
+
+            // The acquire half is the same barrier, with the accesses of the graphics queue instead
+            for (VkBufferMemoryBarrier& barrier : m_BatchHandoff.buffers) {
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            }
+            for (VkImageMemoryBarrier& barrier : m_BatchHandoff.images) {
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            }
+            return;
+        }
+
+        // One family, no ownership to transfer: the layouts change here and the graphics work follows the copies
+        for (VkImageMemoryBarrier& barrier : m_BatchHandoff.images) {
+            barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        }
+        if (!m_BatchHandoff.images.empty()) {
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr,
+                                 static_cast<uint32_t>(m_BatchHandoff.images.size()),
+                                 m_BatchHandoff.images.data());
+        }
+        for (const auto& record : m_BatchHandoff.graphicsWork) { record(commandBuffer); }
+        m_BatchHandoff = Handoff{};
+
+        // Everything submitted after the batch sees what it wrote
+        const VkMemoryBarrier barrier{.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                      .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                                      .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT};
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+    }
+
+    std::optional<VkDeviceSize> Liara_UploadContext::AllocateRing(const VkDeviceSize size) {
+        // Once empty, starting over from the beginning leaves the most contiguous room
+        if (m_Used == 0) {
+            m_Head = 0;
+            m_Tail = 0;
+        }
+
+        const VkDeviceSize capacity = m_Ring->GetSize();
+        const VkDeviceSize aligned = (m_Head + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+
+        VkDeviceSize offset = 0;
+        VkDeviceSize taken = 0;
+        if (m_Head < m_Tail || (m_Head == m_Tail && m_Used > 0)) {
+            // Wrapped around, the free space is between the head and the tail
+            if (aligned + size > m_Tail) { return std::nullopt; }
+            offset = aligned;
+            taken = aligned + size - m_Head;
+        }
+        else if (aligned + size <= capacity) {
+            offset = aligned;
+            taken = aligned + size - m_Head;
+        }
+        else if (size <= m_Tail) {
+            // Wraps around, the end of the ring is padding until the batch is done
+            offset = 0;
+            taken = capacity - m_Head + size;
+        }
+        else { return std::nullopt; }
+
+        m_Head = offset + size;
+        m_Used += taken;
+        m_BatchBytes += taken;
+        return offset;
+    }
+
+    void Liara_UploadContext::RetireCompleted() {
+        uint64_t completed = 0;
+        vkGetSemaphoreCounterValue(m_Device.GetDevice(), m_Timeline, &completed);
+        while (!m_InFlight.empty() && m_InFlight.front().ticket <= completed) { RetireOldest(); }
+    }
+
+    void Liara_UploadContext::RetireOldest() {
+        Submission& oldest = m_InFlight.front();
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &m_Timeline;
+        waitInfo.pValues = &oldest.ticket;
+        vkWaitSemaphores(m_Device.GetDevice(), &waitInfo, std::numeric_limits<uint64_t>::max());
+        m_FreeCommandBuffers.push_back(oldest.commandBuffer);
+
+        // A batch that staged nothing may end before a restart of the ring, it leaves the tail alone
+        if (oldest.ringBytes > 0) { m_Tail = oldest.ringEnd; }
+        m_Used -= oldest.ringBytes;
+        m_CompletedTicket = oldest.ticket;
+        m_InFlight.pop_front();
+    }
+}
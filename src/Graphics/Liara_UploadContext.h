@@ -0,0 +1,273 @@
+/**
+ * @file Liara_UploadContext.h
+ * @brief Defines the `Liara_UploadContext` class, which streams data into device local resources in batches.
+ *
+ * An upload used to create a staging buffer of its own, record a one-shot command buffer and wait for the queue to
+ * idle, so that loading a scene was serialised on the GPU. The context instead keeps one persistently mapped staging
+ * buffer used as a ring: the data of an upload is written after the previous ones, and its space is reclaimed once
+ * the batch that read it is done.
+ *
+ * A batch records any number of copies into one command buffer, submitted once to the transfer queue, and gives back
+ * a ticket. The batch signals its ticket on a timeline semaphore, that the frames wait on: large uploads run on the
+ * copy engines alongside the rendering, and a frame only waits for those submitted before it.
+ * With a queue family other than graphics (transfer-only if available, else async compute), the resources written
+ * by a batch are released to the graphics family at its end, and acquired back by a command buffer the frame
+ * submission executes first. Work that needs the graphics queue, like blitting mipmaps, is recorded there too.
+ *
+ * Data larger than what the ring has left, even once the batches in flight are done, goes through a staging buffer
+ * of its own, released with its batch.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Liara::Graphics
+{
+    class Liara_Buffer;
+    class Liara_Device;
+    class Liara_UploadContext;
+
+    /// Identifies a submitted batch, later batches have larger tickets. 0 is never given, and always complete.
+    using UploadTicket = uint64_t;
+
+    /**
+     * @struct UploadStats
+     * @brief Usage of the staging ring.
+     */
+    struct UploadStats
+    {
+        uint64_t ringCapacity = 0;
+        uint64_t ringUsed = 0;        ///< Written by batches the GPU may still read
+        uint32_t pendingBatches = 0;  ///< Submitted and not known to be complete
+        uint64_t overflowCount = 0;   ///< Uploads that did not fit in the ring, since the start
+        UploadTicket lastTicket = 0;
+        bool dedicatedQueue = false;  ///< Uploads run on a family other than graphics, transfer-only or async compute
+    };
+
+    /**
+     * @struct UploadHandoff
+     * @brief What a graphics submission needs to use everything uploaded before it.
+     */
+    struct UploadHandoff
+    {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;  ///< To execute before the frame, if not null
+        VkSemaphore timeline = VK_NULL_HANDLE;
+        UploadTicket ticket = 0;  ///< Value of the timeline to wait for, no wait if 0
+    };
+
+    /**
+     * @class Liara_UploadBatch
+     * @brief Uploads recorded into one command buffer and submitted together.
+     * A single batch is recorded at a time, Begin waits for the open one to be submitted. A batch destroyed
+     * unsubmitted is submitted then.
+     * The command buffer runs on the transfer queue: only transfer commands and barriers may be recorded into it.
+     */
+    class Liara_UploadBatch
+    {
+    public:
+        ~Liara_UploadBatch();
+
+        Liara_UploadBatch(const Liara_UploadBatch&) = delete;
+        Liara_UploadBatch& operator=(const Liara_UploadBatch&) = delete;
+        Liara_UploadBatch(Liara_UploadBatch&&) = delete;
+        Liara_UploadBatch& operator=(Liara_UploadBatch&&) = delete;
+
+        /**
+         * @brief Command buffer of the batch, to record barriers and other transfer work around the copies.
+         */
+        [[nodiscard]] VkCommandBuffer GetCommandBuffer() const;
+
+        /**
+         * @brief Stages data and records its copy into a buffer, handed to the graphics queue with the batch.
+         */
+        void CopyToBuffer(std::span<const std::byte> data, VkBuffer buffer, VkDeviceSize offset);
+
+        /**
+         * @brief Stages data and records its copy into an image, which must be in the transfer destination layout.
+         * The image is not handed to the graphics queue, see ReleaseImage.
+         * @param region Subresource and area to copy to, its buffer offset is set by the batch.
+         */
+        void CopyToImage(std::span<const std::byte> data, VkImage image, VkBufferImageCopy region);
+
+        /**
+         * @brief Hands a range the batch wrote to the graphics queue, once the batch is done.
+         */
+        void ReleaseBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size);
+
+        /**
+         * @brief Hands subresources the batch wrote to the graphics queue, moving them to a new layout on the way.
+         */
+        void ReleaseImage(VkImage image,
+                          const VkImageSubresourceRange& range,
+                          VkImageLayout oldLayout,
+                          VkImageLayout newLayout);
+
+        /**
+         * @brief Records work on the graphics queue once the resources of the batch are there, before the next frame.
+         * Recorded into the batch itself when uploads run on the graphics family. What it refers to must live until
+         * the next frame is submitted.
+         */
+        void OnGraphicsQueue(std::function<void(VkCommandBuffer)> record);
+
+        /**
+         * @brief Submits the recorded work, without waiting for it.
+         * @return The ticket of the batch.
+         */
+        UploadTicket Submit();
+
+    private:
+        friend class Liara_UploadContext;
+
+        explicit Liara_UploadBatch(Liara_UploadContext& context);
+
+        Liara_UploadContext& m_Context;
+        std::unique_lock<std::mutex> m_Lock;  ///< On the context, until submitted
+        VkCommandBuffer m_CommandBuffer = VK_NULL_HANDLE;
+    };
+
+    /**
+     * @class Liara_UploadContext
+     * @brief Staging ring and batched submission of the uploads. Thread safe.
+     * Without a family other than graphics, batches are submitted to the graphics queue, which the frames also
+     * submit to: a batch must then not be submitted while another thread submits a frame.
+     */
+    class Liara_UploadContext
+    {
+    public:
+        /// Offset alignment of the staged data, enough for the texel size of every format copied to images
+        static constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+        /**
+         * @param device Device to upload to.
+         * @param ringSize Size of the staging ring, in bytes.
+         * @param framesInFlight Frames the handoff command buffers are kept for.
+         */
+        Liara_UploadContext(Liara_Device& device, VkDeviceSize ringSize, uint32_t framesInFlight);
+        ~Liara_UploadContext();
+
+        Liara_UploadContext(const Liara_UploadContext&) = delete;
+        Liara_UploadContext& operator=(const Liara_UploadContext&) = delete;
+
+        /**
+         * @brief Opens a batch. Waits for the batch being recorded by another thread, if any.
+         */
+        [[nodiscard]] Liara_UploadBatch Begin();
+
+        /**
+         * @brief Whether the GPU is done with a batch, without waiting.
+         */
+        [[nodiscard]] bool IsComplete(UploadTicket ticket);
+
+        /**
+         * @brief Waits for a batch, and those submitted before it, to be done.
+         */
+        void Wait(UploadTicket ticket);
+
+        /**
+         * @brief Records the acquisition of what the batches released since the last handoff, and their graphics
+         * work, for a frame about to be submitted.
+         * @param frameIndex Frame being submitted, its previous submission must be done.
+         */
+        [[nodiscard]] UploadHandoff PrepareHandoff(uint32_t frameIndex);
+
+        [[nodiscard]] UploadStats GetStats() const;
+
+    private:
+        friend class Liara_UploadBatch;
+
+        /**
+         * @struct Handoff
+         * @brief Resources released by the transfer queue, to acquire on the graphics queue.
+         */
+        struct Handoff
+        {
+            std::vector<VkBufferMemoryBarrier> buffers;
+            std::vector<VkImageMemoryBarrier> images;
+            std::vector<std::function<void(VkCommandBuffer)>> graphicsWork;
+
+            [[nodiscard]] bool IsEmpty() const { return buffers.empty() && images.empty() && graphicsWork.empty(); }
+        };
+
+        struct Submission
+        {
+            UploadTicket ticket = 0;
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            VkDeviceSize ringEnd = 0;    ///< Head of the ring once the batch was submitted
+            VkDeviceSize ringBytes = 0;  ///< Taken by the batch, padding included
+            std::vector<std::unique_ptr<Liara_Buffer>> overflow;
+        };
+
+        /**
+         * @brief Starts recording a command buffer, the batch mutex being held.
+         */
+        VkCommandBuffer BeginRecording();
+
+        /**
+         * @brief Copies data into the ring, or into a staging buffer of the batch if the ring has no room for it.
+         * @return The buffer holding the data, and its offset.
+         */
+        std::pair<VkBuffer, VkDeviceSize> Stage(std::span<const std::byte> data);
+
+        UploadTicket Submit(VkCommandBuffer commandBuffer);
+
+        /**
+         * @brief Records the release barriers of the batch, or plain barriers and its graphics work on one family.
+         */
+        void RecordRelease(VkCommandBuffer commandBuffer);
+
+        /**
+         * @brief Reserves a range at the head of the ring.
+         * @return Its offset, or nothing if the ring has no room for it.
+         */
+        std::optional<VkDeviceSize> AllocateRing(VkDeviceSize size);
+
+        /**
+         * @brief Retires the oldest submissions the GPU is done with, giving their ring space back.
+         */
+        void RetireCompleted();
+
+        /**
+         * @brief Waits for the oldest submission, and retires it.
+         */
+        void RetireOldest();
+
+        Liara_Device& m_Device;
+        uint32_t m_GraphicsFamily = 0;
+        uint32_t m_TransferFamily = 0;
+        VkQueue m_Queue = VK_NULL_HANDLE;
+        VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+        VkCommandPool m_HandoffPool = VK_NULL_HANDLE;          ///< On the graphics family
+        std::vector<VkCommandBuffer> m_HandoffCommandBuffers;  ///< By frame index
+        VkSemaphore m_Timeline = VK_NULL_HANDLE;               ///< Reaches the ticket of each batch once it is done
+        std::unique_ptr<Liara_Buffer> m_Ring;
+
+        std::mutex m_BatchMutex;  ///< Held by the batch being recorded
+        mutable std::mutex m_Mutex;
+
+        VkDeviceSize m_Head = 0;  ///< Where the next data goes
+        VkDeviceSize m_Tail = 0;  ///< Start of the oldest data the GPU may still read
+        VkDeviceSize m_Used = 0;  ///< From the tail to the head, padding at the end included
+        VkDeviceSize m_BatchBytes = 0;
+        std::vector<std::unique_ptr<Liara_Buffer>> m_BatchOverflow;
+        Handoff m_BatchHandoff;  ///< Released by the batch being recorded
+        Handoff m_Handoff;       ///< Released by the submitted batches, until the next frame acquires it
+
+        std::deque<Submission> m_InFlight;  ///< In submission order
+        std::vector<VkCommandBuffer> m_FreeCommandBuffers;
+        UploadTicket m_NextTicket = 1;
+        UploadTicket m_CompletedTicket = 0;
+        uint64_t m_OverflowCount = 0;
+    };
+}
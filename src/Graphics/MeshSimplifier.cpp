@@ -0,0 +1,305 @@
+#include "MeshSimplifier.h"
+
+#include "Core/Logging/LogMacros.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "glm/ext/vector_double3.hpp"
+#include "glm/ext/vector_float3.hpp"
+#include "glm/geometric.hpp"
+
+namespace Liara::Graphics
+{
+    namespace
+    {
+        /// A level must have at most this ratio of the triangles of the previous one to be worth keeping
+        constexpr float MIN_LEVEL_REDUCTION = 0.85f;
+
+        /**
+         * @brief Sum of squared distances to a set of planes, weighted by the area of the triangles they come from.
+         * Stored as the symmetric 4x4 matrix of Garland-Heckbert, with the total weight to average the error.
+         */
+        struct Quadric
+        {
+            double a2 = 0, ab = 0, ac = 0, ad = 0;
+            double b2 = 0, bc = 0, bd = 0;
+            double c2 = 0, cd = 0;
+            double d2 = 0;
+            double weight = 0;
+
+            static Quadric FromPlane(const glm::dvec3& normal, const double distance, const double planeWeight) {
+                const double a = normal.x;
+                const double b = normal.y;
+                const double c = normal.z;
+                const double d = distance;
+                return {.a2 = a * a * planeWeight,
+                        .ab = a * b * planeWeight,
+                        .ac = a * c * planeWeight,
+                        .ad = a * d * planeWeight,
+                        .b2 = b * b * planeWeight,
+                        .bc = b * c * planeWeight,
+                        .bd = b * d * planeWeight,
+                        .c2 = c * c * planeWeight,
+                        .cd = c * d * planeWeight,
+                        .d2 = d * d * planeWeight,
+                        .weight = planeWeight};
+            }
+
+            Quadric& operator+=(const Quadric& other) {
+                a2 += other.a2;
+                ab += other.ab;
+                ac += other.ac;
+                ad += other.ad;
+                b2 += other.b2;
+                bc += other.bc;
+                bd += other.bd;
+                c2 += other.c2;
+                cd += other.cd;
+                d2 += other.d2;
+                weight += other.weight;
+                return *this;
+            }
+
+            /**
+             * @brief Mean squared distance of the point to the planes.
+             */
+            [[nodiscard]] double Evaluate(const glm::dvec3& p) const {
+                const double sum = (a2 * p.x * p.x) + (2 * ab * p.x * p.y) + (2 * ac * p.x * p.z) + (2 * ad * p.x)
+                                   + (b2 * p.y * p.y) + (2 * bc * p.y * p.z) + (2 * bd * p.y) + (c2 * p.z * p.z)
+                                   + (2 * cd * p.z) + d2;
+                return weight > 0 ? std::abs(sum) / weight : 0.0;
+            }
+        };
+
+        struct Collapse
+        {
+            uint32_t from;
+            uint32_t to;
+            double cost;
+        };
+
+        /**
+         * @brief Vertices that must not move: on an open border, or sharing their position with another vertex.
+         */
+        std::vector<uint8_t> FindLockedVertices(const std::span<const Liara_Model::Vertex> vertices,
+                                                const std::span<const uint32_t> indices) {
+            std::vector<uint8_t> locked(vertices.size(), 0);
+
+            // Seams: the loaders split a vertex when its normal or UV differ between faces
+            std::vector<uint32_t> order(vertices.size());
+            std::iota(order.begin(), order.end(), 0u);
+            const auto lessPosition = [&](const uint32_t a, const uint32_t b) {
+                const glm::vec3& pa = vertices[a].position;
+                const glm::vec3& pb = vertices[b].position;
+                if (pa.x != pb.x) { return pa.x < pb.x; }
+                if (pa.y != pb.y) { return pa.y < pb.y; }
+                return pa.z < pb.z;
+            };
+            std::ranges::sort(order, lessPosition);
+            for (size_t i = 1; i < order.size(); ++i) {
+                if (vertices[order[i]].position == vertices[order[i - 1]].position) {
+                    locked[order[i]] = 1;
+                    locked[order[i - 1]] = 1;
+                }
+            }
+
+            // Borders: an edge used in one direction only belongs to a single triangle
+            std::vector<uint64_t> edges;
+            edges.reserve(indices.size());
+            for (size_t i = 0; i < indices.size(); i += 3) {
+                for (size_t corner = 0; corner < 3; ++corner) {
+                    const uint32_t a = indices[i + corner];
+                    const uint32_t b = indices[i + ((corner + 1) % 3)];
+                    edges.push_back((static_cast<uint64_t>(a) << 32) | b);
+                }
+            }
+            std::ranges::sort(edges);
+            for (const uint64_t edge : edges) {
+                const auto a = static_cast<uint32_t>(edge >> 32);
+                const auto b = static_cast<uint32_t>(edge & 0xFFFFFFFFu);
+                if (!std::ranges::binary_search(edges, (static_cast<uint64_t>(b) << 32) | a)) {
+                    locked[a] = 1;
+                    locked[b] = 1;
+                }
+            }
+            return locked;
+        }
+
+        /**
+         * @brief Whether moving `from` onto `to` turns over a triangle around `from` that survives the collapse.
+         */
+        bool FlipsTriangles(const std::span<const glm::dvec3> positions,
+                            const std::span<const uint32_t> indices,
+                            const std::span<const uint32_t> triangleOffsets,
+                            const std::span<const uint32_t> vertexTriangles,
+                            const uint32_t from,
+                            const uint32_t to) {
+            for (uint32_t t = triangleOffsets[from]; t < triangleOffsets[from + 1]; ++t) {
+                const uint32_t triangle = vertexTriangles[t];
+                const uint32_t* corners = &indices[static_cast<size_t>(triangle) * 3];
+                if (corners[0] == to || corners[1] == to || corners[2] == to) { continue; }
+
+                // The two other corners, in winding order starting after `from`
+                const size_t fromCorner = corners[0] == from ? 0 : (corners[1] == from ? 1 : 2);
+                const glm::dvec3& p1 = positions[corners[(fromCorner + 1) % 3]];
+                const glm::dvec3& p2 = positions[corners[(fromCorner + 2) % 3]];
+                const glm::dvec3 before = glm::cross(p1 - positions[from], p2 - positions[from]);
+                const glm::dvec3 after = glm::cross(p1 - positions[to], p2 - positions[to]);
+                if (glm::dot(before, after) <= 0.0) { return true; }
+            }
+            return false;
+        }
+    }
+
+    SimplifiedMesh SimplifyMesh(const std::span<const Liara_Model::Vertex> vertices,
+                                const std::span<const uint32_t> indices,
+                                const size_t targetIndexCount,
+                                const float maxError) {
+        LIARA_CHECK_ARGUMENT(indices.size() % 3 == 0, LogCore, "Index count {} is not a triangle list", indices.size());
+
+        SimplifiedMesh result;
+        result.indices.assign(indices.begin(), indices.end());
+        if (vertices.empty() || indices.size() <= targetIndexCount) { return result; }
+
+        // Positions relative to the bounding sphere, so that the error does not depend on the size of the mesh
+        const Core::Math::Bounds bounds = ComputeMeshBounds(vertices);
+        const double scale = bounds.sphere.radius > 0.0f ? 1.0 / bounds.sphere.radius : 1.0;
+        std::vector<glm::dvec3> positions(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            positions[i] = glm::dvec3(vertices[i].position - bounds.sphere.center) * scale;
+        }
+
+        const std::vector<uint8_t> locked = FindLockedVertices(vertices, indices);
+
+        std::vector<Quadric> quadrics(vertices.size());
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            const glm::dvec3& p0 = positions[indices[i]];
+            const glm::dvec3 normal = glm::cross(positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0);
+            const double doubleArea = glm::length(normal);
+            if (doubleArea <= 0.0) { continue; }
+
+            const glm::dvec3 unitNormal = normal / doubleArea;
+            const Quadric quadric = Quadric::FromPlane(unitNormal, -glm::dot(unitNormal, p0), doubleArea * 0.5);
+            for (size_t corner = 0; corner < 3; ++corner) { quadrics[indices[i + corner]] += quadric; }
+        }
+
+        const double maxCost = static_cast<double>(maxError) * maxError;
+        std::vector<uint32_t>& current = result.indices;
+        std::vector<uint32_t> remap(vertices.size());
+        std::vector<uint8_t> touched(vertices.size());
+        std::vector<uint32_t> triangleOffsets(vertices.size() + 1);
+        std::vector<uint32_t> vertexTriangles;
+        std::vector<Collapse> collapses;
+
+        // Each pass applies the cheapest collapses whose neighbourhoods do not overlap, then rebuilds the adjacency
+        while (current.size() > targetIndexCount) {
+            const size_t triangleCount = current.size() / 3;
+
+            std::ranges::fill(triangleOffsets, 0u);
+            for (const uint32_t index : current) { ++triangleOffsets[index + 1]; }
+            std::partial_sum(triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin());
+            vertexTriangles.resize(current.size());
+            std::vector<uint32_t> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+            for (size_t i = 0; i < current.size(); ++i) {
+                vertexTriangles[cursor[current[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+
+            collapses.clear();
+            for (size_t i = 0; i < current.size(); i += 3) {
+                for (size_t corner = 0; corner < 3; ++corner) {
+                    const uint32_t a = current[i + corner];
+                    const uint32_t b = current[i + ((corner + 1) % 3)];
+                    if (locked[a] == 0) { collapses.push_back({a, b, quadrics[a].Evaluate(positions[b])}); }
+                    if (locked[b] == 0) { collapses.push_back({b, a, quadrics[b].Evaluate(positions[a])}); }
+                }
+            }
+            if (collapses.empty()) { break; }
+            std::ranges::sort(collapses, {}, &Collapse::cost);
+
+            std::iota(remap.begin(), remap.end(), 0u);
+            std::ranges::fill(touched, uint8_t{0});
+            size_t remainingTriangles = triangleCount;
+            size_t appliedCount = 0;
+            for (const Collapse& collapse : collapses) {
+                if (remainingTriangles * 3 <= targetIndexCount || collapse.cost > maxCost) { break; }
+                if (touched[collapse.from] != 0 || touched[collapse.to] != 0) { continue; }
+                if (FlipsTriangles(positions, current, triangleOffsets, vertexTriangles, collapse.from, collapse.to)) {
+                    continue;
+                }
+
+                // Triangles holding the collapsed edge disappear
+                for (uint32_t t = triangleOffsets[collapse.from]; t < triangleOffsets[collapse.from + 1]; ++t) {
+                    const uint32_t* corners = &current[static_cast<size_t>(vertexTriangles[t]) * 3];
+                    if (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to) {
+                        --remainingTriangles;
+                    }
+                }
+
+                // The triangles around the collapsed vertex change, so does what the flip test of its neighbours sees
+                for (uint32_t t = triangleOffsets[collapse.from]; t < triangleOffsets[collapse.from + 1]; ++t) {
+                    const uint32_t* corners = &current[static_cast<size_t>(vertexTriangles[t]) * 3];
+                    for (size_t corner = 0; corner < 3; ++corner) { touched[corners[corner]] = 1; }
+                }
+                remap[collapse.from] = collapse.to;
+                quadrics[collapse.to] += quadrics[collapse.from];
+                result.error = std::max(result.error, static_cast<float>(std::sqrt(collapse.cost)));
+                ++appliedCount;
+            }
+            if (appliedCount == 0) { break; }
+
+            size_t writeIndex = 0;
+            for (size_t i = 0; i < current.size(); i += 3) {
+                const uint32_t a = remap[current[i]];
+                const uint32_t b = remap[current[i + 1]];
+                const uint32_t c = remap[current[i + 2]];
+                if (a == b || b == c || c == a) { continue; }
+                current[writeIndex++] = a;
+                current[writeIndex++] = b;
+                current[writeIndex++] = c;
+            }
+            current.resize(writeIndex);
+        }
+
+        return result;
+    }
+
+    void GenerateMeshLods(MeshData& meshData,
+                          const LodGenerationSettings& settings,
+                          Core::Jobs::Liara_JobSystem* jobSystem) {
+        meshData.lods.clear();
+        if (settings.levelCount == 0 || meshData.indices.empty()) { return; }
+
+        std::vector<SimplifiedMesh> levels(settings.levelCount);
+        const auto simplify = [&](const size_t begin, const size_t end) {
+            for (size_t level = begin; level < end; ++level) {
+                const double ratio = std::pow(static_cast<double>(settings.reduction), static_cast<double>(level + 1));
+                const auto triangles = static_cast<size_t>(static_cast<double>(meshData.indices.size() / 3) * ratio);
+                levels[level] = SimplifyMesh(meshData.vertices, meshData.indices, triangles * 3, settings.maxError);
+            }
+        };
+        if (jobSystem != nullptr) { jobSystem->ParallelFor(levels.size(), 1, simplify); }
+        else { simplify(0, levels.size()); }
+
+        size_t previousCount = meshData.indices.size();
+        for (auto& level : levels) {
+            if (level.indices.empty()
+                || static_cast<float>(level.indices.size()) > static_cast<float>(previousCount) * MIN_LEVEL_REDUCTION) {
+                break;
+            }
+            previousCount = level.indices.size();
+            meshData.lods.push_back({.indices = std::move(level.indices), .error = level.error});
+        }
+
+        LIARA_LOG_VERBOSE(LogCore,
+                          "Generated {} LOD levels from {} triangles, coarsest has {} triangles",
+                          meshData.lods.size(),
+                          meshData.indices.size() / 3,
+                          previousCount / 3);
+    }
+}
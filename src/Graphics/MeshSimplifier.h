@@ -0,0 +1,53 @@
+/**
+ * @file MeshSimplifier.h
+ * @brief Quadric error mesh simplification, used to build the LOD chain of a mesh at import time.
+ *
+ * The simplifier collapses edges onto one of their vertices (Garland-Heckbert quadrics, cheapest collapses first),
+ * so every level only needs a new index list: all the levels share the vertices of the original mesh.
+ * Vertices on an open border or on an attribute seam (same position, different normal or UV) never move,
+ * which keeps the silhouette and the texture mapping intact, at the cost of simplifying seam-heavy meshes less.
+ */
+
+#pragma once
+
+#include "Core/Jobs/Liara_JobSystem.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Liara_Model.h"
+
+namespace Liara::Graphics
+{
+    /**
+     * @brief Result of a simplification.
+     */
+    struct SimplifiedMesh
+    {
+        std::vector<uint32_t> indices;
+        float error = 0.0f;  ///< Largest geometric error introduced, relative to the radius of the mesh
+    };
+
+    /**
+     * @brief Simplifies a mesh down to a target index count, or until the next collapse would exceed maxError.
+     * @param vertices Vertices of the mesh, unchanged: the result indexes into them.
+     * @param indices Triangle list to simplify.
+     * @param targetIndexCount Number of indices to reach, the result may have more if the error limit is reached first.
+     * @param maxError Largest error allowed, relative to the radius of the mesh.
+     */
+    [[nodiscard]] SimplifiedMesh SimplifyMesh(std::span<const Liara_Model::Vertex> vertices,
+                                              std::span<const uint32_t> indices,
+                                              size_t targetIndexCount,
+                                              float maxError);
+
+    /**
+     * @brief Fills meshData.lods with simplified levels of meshData.indices.
+     * Levels are simplified from the original mesh independently, one job per level when a job system is given.
+     * A level that does not remove enough triangles compared to the previous one ends the chain.
+     */
+    void GenerateMeshLods(MeshData& meshData,
+                          const LodGenerationSettings& settings,
+                          Core::Jobs::Liara_JobSystem* jobSystem = nullptr);
+}
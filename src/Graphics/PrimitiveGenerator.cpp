@@ -6,7 +6,7 @@
 namespace Liara::Graphics::PrimitiveGenerator
 {
     MeshData GenerateQuad() {
-        return MeshData{
+        MeshData meshData{
             .vertices = {{.position = {-0.5f, -0.5f, 0.0f},
                           .color = {1.0f, 0.0f, 0.0f},
                           .normal = {0.0f, 0.0f, 1.0f},
@@ -29,6 +29,8 @@ namespace Liara::Graphics::PrimitiveGenerator
                           .specularExponent = 1}},
             .indices = {0, 1, 2, 2, 3, 0}
         };
+        meshData.UpdateBounds();
+        return meshData;
     }
 
     MeshData GenerateCube() {
@@ -99,6 +101,7 @@ namespace Liara::Graphics::PrimitiveGenerator
             }
         }
 
+        meshData.UpdateBounds();
         return meshData;
     }
 
@@ -157,13 +160,14 @@ namespace Liara::Graphics::PrimitiveGenerator
             }
         }
 
+        meshData.UpdateBounds();
         return meshData;
     }
 
     MeshData GeneratePlane(const float size) {
         const float halfSize = size * 0.5f;
 
-        return MeshData{
+        MeshData meshData{
             .vertices = {{.position = {-halfSize, 0.0f, -halfSize},
                           .color = {0.8f, 0.8f, 0.8f},
                           .normal = {0.0f, 1.0f, 0.0f},
@@ -186,6 +190,8 @@ namespace Liara::Graphics::PrimitiveGenerator
                           .specularExponent = 1}},
             .indices = {0, 1, 2, 2, 3, 0}
         };
+        meshData.UpdateBounds();
+        return meshData;
     }
 
     MeshData GenerateCylinder(const float height, uint32_t segments) {
@@ -287,6 +293,7 @@ namespace Liara::Graphics::PrimitiveGenerator
             meshData.indices.insert(meshData.indices.end(), {topCenterIdx, topIdx1, topIdx2});
         }
 
+        meshData.UpdateBounds();
         return meshData;
     }
 }
\ No newline at end of file
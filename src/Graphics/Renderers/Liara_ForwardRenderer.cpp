@@ -99,12 +99,23 @@ namespace Liara::Graphics::Renderers
         m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % Constants::MAX_FRAMES_IN_FLIGHT;
     }
 
-    void Liara_ForwardRenderer::BeginRenderPass(VkCommandBuffer commandBuffer) const {
+    void Liara_ForwardRenderer::BeginRenderPass(VkCommandBuffer commandBuffer, const VkSubpassContents contents) const {
+        BeginRenderPass(commandBuffer, m_SwapChain->GetRenderPass(), contents);
+    }
+
+    void Liara_ForwardRenderer::ResumeRenderPass(VkCommandBuffer commandBuffer,
+                                                 const VkSubpassContents contents) const {
+        BeginRenderPass(commandBuffer, m_SwapChain->GetResumeRenderPass(), contents);
+    }
+
+    void Liara_ForwardRenderer::BeginRenderPass(VkCommandBuffer commandBuffer,
+                                                VkRenderPass renderPass,
+                                                const VkSubpassContents contents) const {
         assert(m_IsFrameStarted && "Can't call BeginSwapChainRenderPass if frame is not in progress");
 
         VkRenderPassBeginInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = m_SwapChain->GetRenderPass();
+        renderPassInfo.renderPass = renderPass;
         renderPassInfo.framebuffer = m_SwapChain->GetFrameBuffer(static_cast<int>(m_CurrentImageIndex));
         renderPassInfo.renderArea.offset = {.x = 0, .y = 0};
         renderPassInfo.renderArea.extent = m_SwapChain->GetSwapChainExtent();
@@ -116,7 +127,9 @@ namespace Liara::Graphics::Renderers
         renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
         renderPassInfo.pClearValues = clearValues.data();
 
-        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, contents);
+        // The secondary command buffers set their own dynamic state, nothing else may be recorded in the pass
+        if (contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS) { return; }
 
         VkViewport viewport{};
         viewport.x = 0.0f;
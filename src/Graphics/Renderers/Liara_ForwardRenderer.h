@@ -28,12 +28,27 @@ namespace Liara::Graphics::Renderers
             return m_CommandBuffers[m_CurrentFrameIndex];
         }
 
+        [[nodiscard]] DepthAttachment GetDepthAttachment() const override {
+            assert(m_IsFrameStarted && "Cannot get depth attachment when frame not in progress");
+            return {.image = m_SwapChain->GetDepthImage(static_cast<int>(m_CurrentImageIndex)),
+                    .view = m_SwapChain->GetDepthImageView(static_cast<int>(m_CurrentImageIndex)),
+                    .format = m_SwapChain->GetDepthFormat(),
+                    .extent = m_SwapChain->GetSwapChainExtent()};
+        }
+        [[nodiscard]] VkFramebuffer GetCurrentFramebuffer() const override {
+            assert(m_IsFrameStarted && "Cannot get framebuffer when frame not in progress");
+            return m_SwapChain->GetFrameBuffer(static_cast<int>(m_CurrentImageIndex));
+        }
+        [[nodiscard]] VkExtent2D GetExtent() const override { return m_SwapChain->GetSwapChainExtent(); }
+
         VkCommandBuffer BeginFrame() override;
         void EndFrame() override;
-        void BeginRenderPass(VkCommandBuffer commandBuffer) const override;
+        void BeginRenderPass(VkCommandBuffer commandBuffer, VkSubpassContents contents) const override;
+        void ResumeRenderPass(VkCommandBuffer commandBuffer, VkSubpassContents contents) const override;
         void EndRenderPass(VkCommandBuffer commandBuffer) const override;
 
     private:
+        void BeginRenderPass(VkCommandBuffer commandBuffer, VkRenderPass renderPass, VkSubpassContents contents) const;
         void CreateCommandBuffers();
         void FreeCommandBuffers();
         void CreateSwapChain();
@@ -0,0 +1,410 @@
+#include "Liara_HeadlessRenderer.h"
+
+#include "Core/Liara_SettingsManager.h"
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/Liara_Device.h"
+#include "Graphics/Liara_UploadContext.h"
+#include "Graphics/Renderers/Liara_Renderer.h"
+#include "Plateform/Liara_Window.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace Liara::Graphics::Renderers
+{
+    Liara_HeadlessRenderer::Liara_HeadlessRenderer(Core::Liara_SettingsManager& settingsManager,
+                                                   Plateform::Liara_Window& window,
+                                                   Liara_Device& device)
+        : Liara_Renderer(settingsManager, window, device) {
+        m_Extent = m_Window.GetExtent();
+        if (m_Extent.width == 0) { m_Extent.width = 1; }
+        if (m_Extent.height == 0) { m_Extent.height = 1; }
+
+        // Same formats as the swap chain on most desktops, so the pipelines behave like with the forward renderer
+        m_ColorFormat = m_Device.FindSupportedFormat({VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_R8G8B8A8_UNORM},
+                                                     VK_IMAGE_TILING_OPTIMAL,
+                                                     VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT);
+        m_DepthFormat = m_Device.FindSupportedFormat(
+            {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT);
+
+        CreateRenderPass(false, m_RenderPass);
+        CreateRenderPass(true, m_ResumeRenderPass);
+        CreateFrameResources();
+        CreateTimestampQueries();
+
+        LIARA_LOG_INFO(LogRendering,
+                       "Headless renderer: {}x{} offscreen, GPU timing {}",
+                       m_Extent.width,
+                       m_Extent.height,
+                       m_TimestampPool != VK_NULL_HANDLE ? "enabled" : "unsupported");
+    }
+
+    Liara_HeadlessRenderer::~Liara_HeadlessRenderer() {
+        vkDeviceWaitIdle(m_Device.GetDevice());
+
+        DestroyFrameResources();
+        if (m_TimestampPool != VK_NULL_HANDLE) { vkDestroyQueryPool(m_Device.GetDevice(), m_TimestampPool, nullptr); }
+        vkDestroyRenderPass(m_Device.GetDevice(), m_RenderPass, nullptr);
+        vkDestroyRenderPass(m_Device.GetDevice(), m_ResumeRenderPass, nullptr);
+    }
+
+    VkCommandBuffer Liara_HeadlessRenderer::BeginFrame() {
+        assert(!m_IsFrameStarted && "Can't call BeginFrame while already in progress");
+        auto& frame = m_Frames[m_CurrentFrameIndex];
+
+        vkWaitForFences(m_Device.GetDevice(), 1, &frame.inFlightFence, VK_TRUE, UINT64_MAX);
+        ReadGpuFrameTime();
+        vkResetFences(m_Device.GetDevice(), 1, &frame.inFlightFence);
+
+        m_IsFrameStarted = true;
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        if (vkBeginCommandBuffer(frame.commandBuffer, &beginInfo) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to begin recording command buffer!");
+        }
+
+        if (m_TimestampPool != VK_NULL_HANDLE) {
+            const uint32_t firstQuery = m_CurrentFrameIndex * 2;
+            vkCmdResetQueryPool(frame.commandBuffer, m_TimestampPool, firstQuery, 2);
+            vkCmdWriteTimestamp(frame.commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_TimestampPool, firstQuery);
+        }
+        return frame.commandBuffer;
+    }
+
+    void Liara_HeadlessRenderer::EndFrame() {
+        assert(m_IsFrameStarted && "Can't call EndFrame while frame is not in progress");
+        auto& frame = m_Frames[m_CurrentFrameIndex];
+
+        if (m_TimestampPool != VK_NULL_HANDLE) {
+            const uint32_t lastQuery = m_CurrentFrameIndex * 2 + 1;
+            vkCmdWriteTimestamp(frame.commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_TimestampPool, lastQuery);
+        }
+
+        if (vkEndCommandBuffer(frame.commandBuffer) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to record command buffer!");
+        }
+
+        // The uploads submitted so far are waited for on their timeline, and handed over first
+        const UploadHandoff handoff = m_Device.GetUploadContext().PrepareHandoff(m_CurrentFrameIndex);
+        const VkCommandBuffer commandBuffers[] = {handoff.commandBuffer, frame.commandBuffer};
+        const bool hasHandoff = handoff.commandBuffer != VK_NULL_HANDLE;
+        constexpr VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount = 1;
+        timelineInfo.pWaitSemaphoreValues = &handoff.ticket;
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &handoff.timeline;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        submitInfo.commandBufferCount = hasHandoff ? 2 : 1;
+        submitInfo.pCommandBuffers = hasHandoff ? commandBuffers : &frame.commandBuffer;
+
+        if (vkQueueSubmit(m_Device.GetGraphicsQueue(), 1, &submitInfo, frame.inFlightFence) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to submit draw command buffer!");
+        }
+        frame.timestampsWritten = m_TimestampPool != VK_NULL_HANDLE;
+
+        m_IsFrameStarted = false;
+        m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % Constants::MAX_FRAMES_IN_FLIGHT;
+    }
+
+    void Liara_HeadlessRenderer::BeginRenderPass(VkCommandBuffer commandBuffer,
+                                                 const VkSubpassContents contents) const {
+        BeginRenderPass(commandBuffer, m_RenderPass, contents);
+    }
+
+    void Liara_HeadlessRenderer::ResumeRenderPass(VkCommandBuffer commandBuffer,
+                                                  const VkSubpassContents contents) const {
+        BeginRenderPass(commandBuffer, m_ResumeRenderPass, contents);
+    }
+
+    void Liara_HeadlessRenderer::BeginRenderPass(VkCommandBuffer commandBuffer,
+                                                 VkRenderPass renderPass,
+                                                 const VkSubpassContents contents) const {
+        assert(m_IsFrameStarted && "Can't call BeginRenderPass if frame is not in progress");
+
+        VkRenderPassBeginInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = renderPass;
+        renderPassInfo.framebuffer = m_Frames[m_CurrentFrameIndex].framebuffer;
+        renderPassInfo.renderArea.offset = {.x = 0, .y = 0};
+        renderPassInfo.renderArea.extent = m_Extent;
+
+        std::array<VkClearValue, 2> clearValues{};
+        clearValues[0].color = Constants::CLEAR_COLOR_VALUE;
+        clearValues[1].depthStencil = {.depth = 1.0f, .stencil = 0};
+
+        renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+        renderPassInfo.pClearValues = clearValues.data();
+
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, contents);
+        // The secondary command buffers set their own dynamic state, nothing else may be recorded in the pass
+        if (contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS) { return; }
+
+        VkViewport viewport{};
+        viewport.x = 0.0f;
+        viewport.y = 0.0f;
+        viewport.width = static_cast<float>(m_Extent.width);
+        viewport.height = static_cast<float>(m_Extent.height);
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+        const VkRect2D scissor{
+            {0, 0},
+            m_Extent
+        };
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    }
+
+    void Liara_HeadlessRenderer::EndRenderPass(VkCommandBuffer commandBuffer) const {
+        assert(m_IsFrameStarted && "Can't call EndRenderPass if frame is not in progress");
+
+        vkCmdEndRenderPass(commandBuffer);
+    }
+
+    void Liara_HeadlessRenderer::CreateRenderPass(const bool resume, VkRenderPass& renderPass) const {
+        VkAttachmentDescription colorAttachment{};
+        colorAttachment.format = m_ColorFormat;
+        colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        colorAttachment.loadOp = resume ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+        // Stored like a presented image would be, so the measured GPU work matches the windowed one
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        colorAttachment.initialLayout = resume ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+        VkAttachmentDescription depthAttachment{};
+        depthAttachment.format = m_DepthFormat;
+        depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        depthAttachment.loadOp = resume ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+        // Stored so that compute passes can read it between the main pass and the resumed one
+        depthAttachment.storeOp = resume ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.initialLayout =
+            resume ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference colorAttachmentRef{};
+        colorAttachmentRef.attachment = 0;
+        colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference depthAttachmentRef{};
+        depthAttachmentRef.attachment = 1;
+        depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorAttachmentRef;
+        subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+        VkSubpassDependency dependency{};
+        dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependency.dstSubpass = 0;
+        dependency.srcStageMask =
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+        dependency.srcAccessMask = 0;
+        dependency.dstStageMask =
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+        dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        if (resume) {
+            // The loads read the color written by the main pass
+            dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            dependency.dstAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+        }
+
+        const std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
+        VkRenderPassCreateInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+        renderPassInfo.pAttachments = attachments.data();
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+        renderPassInfo.dependencyCount = 1;
+        renderPassInfo.pDependencies = &dependency;
+
+        if (vkCreateRenderPass(m_Device.GetDevice(), &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to create render pass!");
+        }
+    }
+
+    void Liara_HeadlessRenderer::CreateFrameResources() {
+        std::array<VkCommandBuffer, Constants::MAX_FRAMES_IN_FLIGHT> commandBuffers{};
+
+        VkCommandBufferAllocateInfo commandBufferAllocInfo{};
+        commandBufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        commandBufferAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        commandBufferAllocInfo.commandPool = m_Device.GetCommandPool();
+        commandBufferAllocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
+
+        if (vkAllocateCommandBuffers(m_Device.GetDevice(), &commandBufferAllocInfo, commandBuffers.data())
+            != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to allocate command buffers!");
+        }
+
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+        for (size_t i = 0; i < m_Frames.size(); ++i) {
+            auto& frame = m_Frames[i];
+            frame.commandBuffer = commandBuffers[i];
+
+            CreateAttachment(m_ColorFormat,
+                             VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                             VK_IMAGE_ASPECT_COLOR_BIT,
+                             frame.colorImage,
+                             frame.colorMemory,
+                             frame.colorView);
+            CreateAttachment(m_DepthFormat,
+                             VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                             VK_IMAGE_ASPECT_DEPTH_BIT,
+                             frame.depthImage,
+                             frame.depthMemory,
+                             frame.depthView);
+
+            const std::array<VkImageView, 2> attachments = {frame.colorView, frame.depthView};
+            VkFramebufferCreateInfo framebufferInfo{};
+            framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+            framebufferInfo.renderPass = m_RenderPass;
+            framebufferInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+            framebufferInfo.pAttachments = attachments.data();
+            framebufferInfo.width = m_Extent.width;
+            framebufferInfo.height = m_Extent.height;
+            framebufferInfo.layers = 1;
+
+            if (vkCreateFramebuffer(m_Device.GetDevice(), &framebufferInfo, nullptr, &frame.framebuffer)
+                != VK_SUCCESS) {
+                LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to create framebuffer!");
+            }
+
+            if (vkCreateFence(m_Device.GetDevice(), &fenceInfo, nullptr, &frame.inFlightFence) != VK_SUCCESS) {
+                LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to create fences!");
+            }
+        }
+    }
+
+    void Liara_HeadlessRenderer::CreateTimestampQueries() {
+        const auto& limits = m_Device.deviceProperties.limits;
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_Device.GetPhysicalDevice(), &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_Device.GetPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+        const uint32_t validBits = queueFamilies[m_Device.GetGraphicsQueueFamily()].timestampValidBits;
+        if (validBits == 0 || limits.timestampPeriod <= 0.0f) {
+            LIARA_LOG_WARNING(LogRendering, "The graphics queue does not support timestamps, GPU time not measured");
+            return;
+        }
+
+        m_TimestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+        m_TimestampPeriod = limits.timestampPeriod;
+
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = Constants::MAX_FRAMES_IN_FLIGHT * 2;
+
+        if (vkCreateQueryPool(m_Device.GetDevice(), &queryPoolInfo, nullptr, &m_TimestampPool) != VK_SUCCESS) {
+            LIARA_LOG_WARNING(LogRendering, "Failed to create the timestamp query pool, GPU time not measured");
+            m_TimestampPool = VK_NULL_HANDLE;
+        }
+    }
+
+    void Liara_HeadlessRenderer::ReadGpuFrameTime() {
+        auto& frame = m_Frames[m_CurrentFrameIndex];
+        if (!frame.timestampsWritten) { return; }
+        frame.timestampsWritten = false;
+
+        std::array<uint64_t, 2> timestamps{};
+        if (vkGetQueryPoolResults(m_Device.GetDevice(),
+                                  m_TimestampPool,
+                                  m_CurrentFrameIndex * 2,
+                                  2,
+                                  sizeof(timestamps),
+                                  timestamps.data(),
+                                  sizeof(uint64_t),
+                                  VK_QUERY_RESULT_64_BIT)
+            != VK_SUCCESS) {
+            return;
+        }
+
+        // Masked difference, correct across a wrap of the valid bits
+        const uint64_t ticks = (timestamps[1] - timestamps[0]) & m_TimestampMask;
+        m_GpuFrameTime = static_cast<float>(static_cast<double>(ticks) * m_TimestampPeriod * 1e-6);
+    }
+
+    void Liara_HeadlessRenderer::CreateAttachment(const VkFormat format,
+                                                  const VkImageUsageFlags usage,
+                                                  const VkImageAspectFlags aspect,
+                                                  VkImage& image,
+                                                  MemoryAllocation& memory,
+                                                  VkImageView& view) const {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = m_Extent.width;
+        imageInfo.extent.height = m_Extent.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = usage;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        m_Device.CreateImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, memory);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange.aspectMask = aspect;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        if (vkCreateImageView(m_Device.GetDevice(), &viewInfo, nullptr, &view) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogVulkan, "Failed to create image views!");
+        }
+    }
+
+    void Liara_HeadlessRenderer::DestroyFrameResources() {
+        for (auto& frame : m_Frames) {
+            vkDestroyFence(m_Device.GetDevice(), frame.inFlightFence, nullptr);
+            vkDestroyFramebuffer(m_Device.GetDevice(), frame.framebuffer, nullptr);
+            vkDestroyImageView(m_Device.GetDevice(), frame.colorView, nullptr);
+            vkDestroyImage(m_Device.GetDevice(), frame.colorImage, nullptr);
+            m_Device.FreeMemory(frame.colorMemory);
+            vkDestroyImageView(m_Device.GetDevice(), frame.depthView, nullptr);
+            vkDestroyImage(m_Device.GetDevice(), frame.depthImage, nullptr);
+            m_Device.FreeMemory(frame.depthMemory);
+            if (frame.commandBuffer != VK_NULL_HANDLE) {
+                vkFreeCommandBuffers(m_Device.GetDevice(), m_Device.GetCommandPool(), 1, &frame.commandBuffer);
+            }
+            frame = {};
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * @file Liara_HeadlessRenderer.h
+ * @brief Defines the `Liara_HeadlessRenderer` class, a renderer drawing into offscreen images.
+ *
+ * It needs no surface, present queue or swap chain, so it runs without a window and on software devices (lavapipe).
+ * Each frame in flight owns its color and depth images, and the GPU time of each frame is measured with timestamps.
+ */
+
+#pragma once
+
+#include "Liara_Renderer.h"
+#include "Graphics/GraphicsConstants.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+namespace Liara::Graphics::Renderers
+{
+    class Liara_HeadlessRenderer final : public Liara_Renderer
+    {
+    public:
+        Liara_HeadlessRenderer(Core::Liara_SettingsManager& settingsManager,
+                               Plateform::Liara_Window& window,
+                               Liara_Device& device);
+        ~Liara_HeadlessRenderer() override;
+
+        [[nodiscard]] VkRenderPass GetRenderPass() const override { return m_RenderPass; }
+        [[nodiscard]] uint32_t GetImageCount() const override { return Constants::MAX_FRAMES_IN_FLIGHT; }
+        [[nodiscard]] float GetAspectRatio() const override {
+            return static_cast<float>(m_Extent.width) / static_cast<float>(m_Extent.height);
+        }
+        [[nodiscard]] uint32_t GetFrameIndex() const override {
+            assert(m_IsFrameStarted && "Cannot get frame index when frame not in progress");
+            return m_CurrentFrameIndex;
+        }
+        [[nodiscard]] bool IsFrameInProgress() const override { return m_IsFrameStarted; }
+        [[nodiscard]] VkCommandBuffer GetCurrentCommandBuffer() const override {
+            assert(m_IsFrameStarted && "Cannot get command buffer when frame not in progress");
+            return m_Frames[m_CurrentFrameIndex].commandBuffer;
+        }
+        [[nodiscard]] float GetGpuFrameTime() const override { return m_GpuFrameTime; }
+        [[nodiscard]] DepthAttachment GetDepthAttachment() const override {
+            assert(m_IsFrameStarted && "Cannot get depth attachment when frame not in progress");
+            const auto& frame = m_Frames[m_CurrentFrameIndex];
+            return {.image = frame.depthImage, .view = frame.depthView, .format = m_DepthFormat, .extent = m_Extent};
+        }
+        [[nodiscard]] VkFramebuffer GetCurrentFramebuffer() const override {
+            assert(m_IsFrameStarted && "Cannot get framebuffer when frame not in progress");
+            return m_Frames[m_CurrentFrameIndex].framebuffer;
+        }
+        [[nodiscard]] VkExtent2D GetExtent() const override { return m_Extent; }
+
+        VkCommandBuffer BeginFrame() override;
+        void EndFrame() override;
+        void BeginRenderPass(VkCommandBuffer commandBuffer, VkSubpassContents contents) const override;
+        void ResumeRenderPass(VkCommandBuffer commandBuffer, VkSubpassContents contents) const override;
+        void EndRenderPass(VkCommandBuffer commandBuffer) const override;
+
+    private:
+        struct FrameResources
+        {
+            VkImage colorImage{};
+            MemoryAllocation colorMemory;
+            VkImageView colorView{};
+            VkImage depthImage{};
+            MemoryAllocation depthMemory;
+            VkImageView depthView{};
+            VkFramebuffer framebuffer{};
+
+            VkCommandBuffer commandBuffer{};
+            VkFence inFlightFence{};
+            bool timestampsWritten = false;  ///< Whether the last submission of this frame wrote its timestamps
+        };
+
+        void BeginRenderPass(VkCommandBuffer commandBuffer, VkRenderPass renderPass, VkSubpassContents contents) const;
+        void CreateRenderPass(bool resume, VkRenderPass& renderPass) const;
+        void CreateFrameResources();
+        void CreateTimestampQueries();
+        void DestroyFrameResources();
+
+        /**
+         * @brief Reads the timestamps of the last submission of the current frame, which must have finished.
+         */
+        void ReadGpuFrameTime();
+
+        void CreateAttachment(VkFormat format,
+                              VkImageUsageFlags usage,
+                              VkImageAspectFlags aspect,
+                              VkImage& image,
+                              MemoryAllocation& memory,
+                              VkImageView& view) const;
+
+        std::array<FrameResources, Constants::MAX_FRAMES_IN_FLIGHT> m_Frames{};
+        VkRenderPass m_RenderPass{};
+        VkRenderPass m_ResumeRenderPass{};  ///< Compatible with m_RenderPass, loads the attachments
+        VkExtent2D m_Extent{};
+        VkFormat m_ColorFormat{};
+        VkFormat m_DepthFormat{};
+
+        VkQueryPool m_TimestampPool{};  ///< Two timestamps per frame in flight, null if timestamps are unsupported
+        uint64_t m_TimestampMask{};     ///< Valid bits of the timestamps written by the graphics queue
+        float m_TimestampPeriod{};      ///< Nanoseconds per timestamp tick
+        float m_GpuFrameTime{};         ///< GPU time of the last finished frame, in milliseconds
+
+        uint32_t m_CurrentFrameIndex{};
+        bool m_IsFrameStarted{false};
+    };
+}
@@ -6,6 +6,17 @@
 
 namespace Liara::Graphics::Renderers
 {
+    /**
+     * @brief Depth attachment of the current frame, stored by the render pass and sampleable once the pass ended.
+     */
+    struct DepthAttachment
+    {
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;  ///< Depth aspect only
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkExtent2D extent{};
+    };
+
     class Liara_Renderer
     {
     public:
@@ -21,10 +32,30 @@ namespace Liara::Graphics::Renderers
         [[nodiscard]] virtual uint32_t GetFrameIndex() const = 0;
         [[nodiscard]] virtual bool IsFrameInProgress() const = 0;
         [[nodiscard]] virtual VkCommandBuffer GetCurrentCommandBuffer() const = 0;
+        /**
+         * @brief GPU time of the last finished frame in milliseconds, 0 if the renderer does not measure it.
+         */
+        [[nodiscard]] virtual float GetGpuFrameTime() const { return 0.0f; }
+        [[nodiscard]] virtual DepthAttachment GetDepthAttachment() const = 0;
+        /**
+         * @brief Framebuffer and size of the render pass of the current frame, inherited by secondary command buffers.
+         */
+        [[nodiscard]] virtual VkFramebuffer GetCurrentFramebuffer() const = 0;
+        [[nodiscard]] virtual VkExtent2D GetExtent() const = 0;
 
         virtual VkCommandBuffer BeginFrame() = 0;
         virtual void EndFrame() = 0;
-        virtual void BeginRenderPass(VkCommandBuffer commandBuffer) const = 0;
+        /**
+         * @brief Begins the render pass of the current frame.
+         * @param contents With VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, the pass may only execute secondary
+         * command buffers, which set their own viewport and scissor.
+         */
+        virtual void BeginRenderPass(VkCommandBuffer commandBuffer, VkSubpassContents contents) const = 0;
+        /**
+         * @brief Begins the render pass again on the attachments of the current frame, keeping their content.
+         * The depth attachment must be back in the depth attachment layout.
+         */
+        virtual void ResumeRenderPass(VkCommandBuffer commandBuffer, VkSubpassContents contents) const = 0;
         virtual void EndRenderPass(VkCommandBuffer commandBuffer) const = 0;
 
     protected:
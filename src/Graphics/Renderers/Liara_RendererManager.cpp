@@ -11,6 +11,7 @@
 #include <stdexcept>
 
 #include "Liara_ForwardRenderer.h"
+#include "Liara_HeadlessRenderer.h"
 
 namespace Liara::Graphics::Renderers
 {
@@ -28,12 +29,19 @@ namespace Liara::Graphics::Renderers
     Liara_RendererManager::~Liara_RendererManager() { CleanUp(); }
 
     void Liara_RendererManager::SetRenderer(const RendererType type) {
+        LIARA_CHECK_ARGUMENT(type == RendererType::HEADLESS || !m_Window.IsHeadless(),
+                             LogGraphics,
+                             "A headless window can only be used with the headless renderer");
+
         CleanUp();
 
         switch (type) {
             case RendererType::FORWARD:
                 m_Renderer = std::make_unique<Liara_ForwardRenderer>(m_SettingsManager, m_Window, m_Device);
                 break;
+            case RendererType::HEADLESS:
+                m_Renderer = std::make_unique<Liara_HeadlessRenderer>(m_SettingsManager, m_Window, m_Device);
+                break;
             default: LIARA_THROW_RUNTIME_ERROR(LogGraphics, "Invalid renderer type");
         }
         m_RendererType = type;
@@ -49,9 +57,15 @@ namespace Liara::Graphics::Renderers
         m_Renderer->EndFrame();
     }
 
-    void Liara_RendererManager::BeginRenderPass(VkCommandBuffer commandBuffer) const {
+    void Liara_RendererManager::BeginRenderPass(VkCommandBuffer commandBuffer, const VkSubpassContents contents) const {
+        assert(m_Renderer && "Renderer not set!");
+        m_Renderer->BeginRenderPass(commandBuffer, contents);
+    }
+
+    void Liara_RendererManager::ResumeRenderPass(VkCommandBuffer commandBuffer,
+                                                 const VkSubpassContents contents) const {
         assert(m_Renderer && "Renderer not set!");
-        m_Renderer->BeginRenderPass(commandBuffer);
+        m_Renderer->ResumeRenderPass(commandBuffer, contents);
     }
 
     void Liara_RendererManager::EndRenderPass(VkCommandBuffer commandBuffer) const {
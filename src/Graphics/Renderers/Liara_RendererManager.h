@@ -16,6 +16,7 @@ namespace Liara::Graphics::Renderers
     enum class RendererType : uint8_t
     {
         FORWARD,
+        HEADLESS,  ///< Offscreen rendering, without surface nor swap chain
     };
 
     class Liara_RendererManager
@@ -34,7 +35,10 @@ namespace Liara::Graphics::Renderers
 
         [[nodiscard]] VkCommandBuffer BeginFrame() const;
         void EndFrame() const;
-        void BeginRenderPass(VkCommandBuffer commandBuffer) const;
+        void BeginRenderPass(VkCommandBuffer commandBuffer,
+                             VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE) const;
+        void ResumeRenderPass(VkCommandBuffer commandBuffer,
+                              VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE) const;
         void EndRenderPass(VkCommandBuffer commandBuffer) const;
 
         void CleanUp();
@@ -8,9 +8,16 @@
 namespace Liara::Listener
 {
     void KeybordMovementController::moveInSpaceXYZ(SDL_Window* /*window*/,
+                                                   const float deltaTime,
+                                                   Core::Liara_GameObject& gameObject) const {
+        int keyCount = 0;
+        const Uint8* state = SDL_GetKeyboardState(&keyCount);
+        moveInSpaceXYZ(std::span(state, static_cast<size_t>(keyCount)), deltaTime, gameObject);
+    }
+
+    void KeybordMovementController::moveInSpaceXYZ(const std::span<const uint8_t> state,
                                                    float deltaTime,
                                                    Core::Liara_GameObject& gameObject) const {
-        const Uint8* state = SDL_GetKeyboardState(nullptr);
 
         glm::vec3 rotation{0};
         if (state[m_KeyMappings.lookRight]) { rotation.y += 1.0f; }
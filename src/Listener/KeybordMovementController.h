@@ -2,7 +2,9 @@
 #include "Core/Liara_GameObject.h"
 #include "Core/Liara_SettingsManager.h"
 
+#include <cstdint>
 #include <SDL2/SDL.h>
+#include <span>
 
 namespace Liara::Listener
 {
@@ -43,6 +45,16 @@ namespace Liara::Listener
          */
         void moveInSpaceXYZ(SDL_Window* window, float deltaTime, Core::Liara_GameObject& gameObject) const;
 
+        /**
+         * @brief Moves the game object from a given keyboard state, live or replayed.
+         * @param keyboardState One byte per scancode, non-zero when the key is held.
+         * @param deltaTime The time since the last frame.
+         * @param gameObject The game object to move.
+         */
+        void moveInSpaceXYZ(std::span<const uint8_t> keyboardState,
+                            float deltaTime,
+                            Core::Liara_GameObject& gameObject) const;
+
         KeyMappings m_KeyMappings{};  ///< The key mappings for movement and looking
         float m_MoveSpeed = 3.0f;     ///< The movement speed
         float m_LookSpeed = 1.5f;     ///< The look speed
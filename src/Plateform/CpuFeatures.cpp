@@ -0,0 +1,89 @@
+#include "CpuFeatures.h"
+
+#include "Core/Logging/LogMacros.h"
+
+#include <cstdint>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LIARA_CPU_X86 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+namespace Liara::Plateform
+{
+    namespace
+    {
+#if defined(LIARA_CPU_X86)
+        void CpuId(const uint32_t leaf, const uint32_t subLeaf, uint32_t (&registers)[4]) {
+    #if defined(_MSC_VER)
+            int values[4];
+            __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subLeaf));
+            for (int i = 0; i < 4; ++i) { registers[i] = static_cast<uint32_t>(values[i]); }
+    #else
+            __cpuid_count(leaf, subLeaf, registers[0], registers[1], registers[2], registers[3]);
+    #endif
+        }
+
+        uint64_t ReadXcr0() {
+    #if defined(_MSC_VER)
+            return _xgetbv(0);
+    #else
+            uint32_t eax = 0;
+            uint32_t edx = 0;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<uint64_t>(edx) << 32) | eax;
+    #endif
+        }
+
+        SimdLevel DetectSimdLevel() {
+            uint32_t registers[4]{};  // eax, ebx, ecx, edx
+            CpuId(0, 0, registers);
+            const uint32_t maxLeaf = registers[0];
+
+            CpuId(1, 0, registers);
+            const bool sse2 = (registers[3] & (1u << 26)) != 0;
+            const bool fma = (registers[2] & (1u << 12)) != 0;
+            const bool osxsave = (registers[2] & (1u << 27)) != 0;
+            const bool avx = (registers[2] & (1u << 28)) != 0;
+
+            // The OS must save the YMM registers on context switches (XCR0 bits 1 and 2)
+            const bool osSupportsAvx = osxsave && avx && (ReadXcr0() & 0x6) == 0x6;
+
+            bool avx2 = false;
+            if (maxLeaf >= 7) {
+                CpuId(7, 0, registers);
+                avx2 = (registers[1] & (1u << 5)) != 0;
+            }
+
+            if (osSupportsAvx && avx2 && fma) { return SimdLevel::AVX2; }
+            if (sse2) { return SimdLevel::SSE2; }
+            return SimdLevel::SCALAR;
+        }
+#else
+        SimdLevel DetectSimdLevel() { return SimdLevel::SCALAR; }
+#endif
+    }
+
+    SimdLevel GetSimdLevel() {
+        static const SimdLevel level = [] {
+            const SimdLevel detected = DetectSimdLevel();
+            LIARA_LOG_INFO(LogPlatform, "Detected SIMD level: {}", SimdLevelToString(detected));
+            return detected;
+        }();
+        return level;
+    }
+
+    std::string_view SimdLevelToString(const SimdLevel level) {
+        switch (level) {
+            case SimdLevel::SCALAR: return "Scalar";
+            case SimdLevel::SSE2: return "SSE2";
+            case SimdLevel::AVX2: return "AVX2";
+        }
+        return "Unknown";
+    }
+}
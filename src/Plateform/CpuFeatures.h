@@ -0,0 +1,30 @@
+/**
+ * @file CpuFeatures.h
+ * @brief Runtime detection of the SIMD instruction sets supported by the CPU.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Liara::Plateform
+{
+    /**
+     * @brief SIMD instruction sets used by the engine kernels, ordered from the least to the most capable.
+     */
+    enum class SimdLevel : uint8_t
+    {
+        SCALAR,  ///< No SIMD, plain C++
+        SSE2,    ///< 4-wide float vectors, baseline of x86-64
+        AVX2,    ///< 8-wide float and integer vectors, with FMA
+    };
+
+    /**
+     * @brief Returns the best SIMD level supported by both the CPU and the operating system.
+     * The detection runs once, the result is cached.
+     */
+    [[nodiscard]] SimdLevel GetSimdLevel();
+
+    [[nodiscard]] std::string_view SimdLevelToString(SimdLevel level);
+}
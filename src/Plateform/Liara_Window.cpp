@@ -85,7 +85,7 @@ namespace Liara::Plateform
 
     Liara_Window::~Liara_Window() {
         windows.erase(m_ID);
-        SDL_DestroyWindow(m_Window);
+        if (m_Window != nullptr) { SDL_DestroyWindow(m_Window); }
         SDL_Quit();
     }
 
@@ -95,11 +95,13 @@ namespace Liara::Plateform
     }
 
     void Liara_Window::ResizeWindow() const {
+        if (m_Headless) { return; }
         auto [width, height] = GetExtent();
         SDL_SetWindowSize(m_Window, static_cast<int>(width), static_cast<int>(height));
     }
 
     void Liara_Window::UpdateFullscreenMode() const {
+        if (m_Headless) { return; }
         if (const auto settings = m_SettingsManager.Get<WindowSettings>("window." + std::to_string(m_ID));
             settings.fullscreen) {
             SDL_SetWindowFullscreen(m_Window, SDL_WINDOW_FULLSCREEN_DESKTOP);
@@ -111,6 +113,7 @@ namespace Liara::Plateform
     }
 
     void Liara_Window::CreateWindowSurface(VkInstance instance, VkSurfaceKHR* surface) const {
+        LIARA_CHECK_RUNTIME(!m_Headless, LogPlatform, "Cannot create a surface for a headless window");
         if (SDL_Vulkan_CreateSurface(m_Window, instance, surface) != SDL_TRUE) {
             LIARA_THROW_RUNTIME_ERROR(LogPlatform, "Failed to create window surface! SDL_Error: {}", SDL_GetError());
         }
@@ -124,6 +127,17 @@ namespace Liara::Plateform
     }
 
     void Liara_Window::InitWindow() {
+        m_Headless = m_SettingsManager.GetBool("app.headless");
+        if (m_Headless) {
+            // Events only, to keep the input and quit handling working without a video driver
+            if (SDL_Init(SDL_INIT_EVENTS) != 0) {
+                LIARA_THROW_RUNTIME_ERROR(LogPlatform, "Failed to initialize SDL! SDL_Error: {}", SDL_GetError());
+            }
+            LIARA_LOG_INFO(LogPlatform, "Window {} is headless, rendering offscreen", m_ID);
+            AddEventWatch();
+            return;
+        }
+
         if (SDL_Init(SDL_INIT_VIDEO) != 0) {
             LIARA_THROW_RUNTIME_ERROR(LogPlatform, "Failed to initialize SDL! SDL_Error: {}", SDL_GetError());
         }
@@ -146,6 +160,10 @@ namespace Liara::Plateform
         UpdateFullscreenMode();
 
         SDL_SetWindowData(m_Window, "Liara_Window", this);
+        AddEventWatch();
+    }
+
+    void Liara_Window::AddEventWatch() {
         SDL_AddEventWatch(
             [](void* userdata, SDL_Event* event) {
                 return static_cast<Liara_Window*>(userdata)->EventCallback(userdata, event);
@@ -171,6 +189,8 @@ namespace Liara::Plateform
             if (event->window.event == SDL_WINDOWEVENT_RESTORED) { m_minimized = false; }
             if (event->window.event == SDL_WINDOWEVENT_CLOSE) { m_quit_requested = true; }
         }
+        // Sent on its own by signals, and the only way a headless run is asked to close
+        if (event->type == SDL_QUIT) { m_quit_requested = true; }
         return 0;
     }
 }
\ No newline at end of file
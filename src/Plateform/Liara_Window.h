@@ -3,6 +3,7 @@
  * @brief Defines the `Liara_Window` class, which encapsulates a SDL2 window.
  *
  * For now, window must be unique, but I plan to add support for multiple windows.
+ * In headless mode (setting "app.headless"), no SDL window is created: the window only provides the render extent.
  */
 
 #pragma once
@@ -92,6 +93,7 @@ namespace Liara::Plateform
         [[nodiscard]] bool WasMinimized() const { return m_minimized; }      ///< Whether the window was minimized
         [[nodiscard]] SDL_Window* GetWindow() const { return m_Window; }     ///< Returns the SDL window
         [[nodiscard]] uint8_t GetID() const { return m_ID; }                 ///< Returns the window ID
+        [[nodiscard]] bool IsHeadless() const { return m_Headless; }         ///< Whether there is no real window
 
         void CreateWindowSurface(VkInstance instance,
                                  VkSurfaceKHR* surface) const;  ///< Creates a Vulkan surface for the window
@@ -118,8 +120,10 @@ namespace Liara::Plateform
 
         bool m_minimized = false;       ///< Whether the window is minimized
         bool m_quit_requested = false;  ///< Whether the window should close
+        bool m_Headless = false;        ///< Whether the window only exists offscreen
 
-        void InitWindow();  ///< Initializes the window
+        void InitWindow();     ///< Initializes the window
+        void AddEventWatch();  ///< Routes the SDL events to EventCallback
 
         /**
          * @brief Event callback function.
@@ -0,0 +1,681 @@
+#include "GpuDrivenRenderSystem.h"
+
+#include "Core/Components/ModelComponent.h"
+#include "Core/Components/WorldTransformComponent.h"
+#include "Core/FrameInfo.h"
+#include "Core/Liara_SettingsManager.h"
+#include "Core/Math/FrustumCulling.h"
+#include "Graphics/Descriptors/Liara_Descriptor.h"
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/Liara_Buffer.h"
+#include "Graphics/Liara_GeometryPool.h"
+#include "Graphics/Liara_Model.h"
+#include "Graphics/Liara_Pipeline.h"
+#include "Graphics/Liara_UploadContext.h"
+#include "Graphics/Renderers/Liara_RendererManager.h"
+#include "Graphics/VkResultToString.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float2.hpp"
+#include "glm/ext/vector_float4.hpp"
+
+namespace Liara::Systems
+{
+    namespace
+    {
+        /// Threads per workgroup of the culling shaders, see CullObjects.comp and BuildDraws.comp
+        constexpr uint32_t WORKGROUP_SIZE = 64;
+        /// Texels per workgroup side of BuildDepthPyramid.comp
+        constexpr uint32_t PYRAMID_GROUP_SIZE = 8;
+        /// Enough for a 65536 pixels wide depth buffer
+        constexpr uint32_t MAX_PYRAMID_LEVELS = 16;
+        /// Visibility index of the objects without history, their entity slot being past the flags
+        constexpr uint32_t NO_VISIBILITY = std::numeric_limits<uint32_t>::max();
+
+        /// Storage buffers of the object set, the pyramid comes after them
+        constexpr uint32_t STORAGE_BINDING_COUNT = 8;
+        constexpr uint32_t PYRAMID_BINDING = STORAGE_BINDING_COUNT;
+
+        /**
+         * @brief One object, as read by CullObjects.comp and GpuDriven.vert (std430).
+         */
+        struct GpuObject
+        {
+            glm::mat4 modelMatrix{1.0f};
+            glm::mat4 normalMatrix{1.0f};
+            glm::vec4 boundingSphere{0.0f};  ///< Model space center, and radius in w
+            uint32_t drawSlot = 0;
+            uint32_t visibilityIndex = NO_VISIBILITY;  ///< Entity slot, indexing the visibility flags
+            uint32_t padding[2]{};
+        };
+        static_assert(sizeof(GpuObject) == 160, "GpuObject must match its std430 layout");
+
+        /**
+         * @brief Draw slots of one mesh, its levels of detail from the finest.
+         */
+        struct GpuBatch
+        {
+            uint32_t firstSlot = 0;
+            uint32_t slotCount = 0;
+        };
+
+        /**
+         * @brief Frame constants of the culling shaders (std430).
+         */
+        struct CullingData
+        {
+            std::array<glm::vec4, 6> planes{};
+            glm::mat4 viewProjection{1.0f};
+            glm::vec2 depthSize{0.0f};       ///< In pixels
+            uint32_t pyramidLevelCount = 0;  ///< 0 when the objects are not tested against the pyramid
+            uint32_t objectCount = 0;
+            uint32_t batchCount = 0;
+            uint32_t maxObjects = 0;    ///< Offset of the second phase in the visible objects
+            uint32_t maxDrawSlots = 0;  ///< Offset of the second phase in the draw slots, commands and counts
+            uint32_t padding = 0;
+        };
+        static_assert(sizeof(CullingData) == 192, "CullingData must match its std430 layout");
+
+        uint32_t GroupCount(const uint32_t threadCount, const uint32_t groupSize = WORKGROUP_SIZE) {
+            return (threadCount + groupSize - 1) / groupSize;
+        }
+
+        /// Size of a level of the pyramid, level 0 being half the depth size, rounded down
+        VkExtent2D PyramidLevelExtent(const VkExtent2D depthExtent, const uint32_t level) {
+            return {std::max((depthExtent.width / 2) >> level, 1u), std::max((depthExtent.height / 2) >> level, 1u)};
+        }
+
+        uint32_t PyramidLevelCount(const VkExtent2D depthExtent) {
+            const VkExtent2D base = PyramidLevelExtent(depthExtent, 0);
+            return std::min(static_cast<uint32_t>(std::bit_width(std::max(base.width, base.height))),
+                            MAX_PYRAMID_LEVELS);
+        }
+
+        void ComputeBarrier(VkCommandBuffer commandBuffer,
+                            const VkPipelineStageFlags dstStage,
+                            const VkAccessFlags dstAccess) {
+            VkMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            barrier.dstAccessMask = dstAccess;
+            vkCmdPipelineBarrier(
+                commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        }
+
+        bool HasStencil(const VkFormat format) {
+            return format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT
+                   || format == VK_FORMAT_D16_UNORM_S8_UINT;
+        }
+    }
+
+    GpuDrivenRenderSystem::GpuDrivenRenderSystem(Graphics::Liara_Device& device,
+                                                 const Graphics::Renderers::Liara_RendererManager& rendererManager,
+                                                 VkRenderPass renderPass,
+                                                 VkDescriptorSetLayout globalSetLayout,
+                                                 const Core::Liara_SettingsManager& settingsManager)
+        : Liara_System("GPU-Driven Render System", {.major = 0, .minor = 2, .patch = 0, .prerelease = "dev"})
+        , m_Device(device)
+        , m_RendererManager(rendererManager)
+        , m_SettingsManager(settingsManager)
+        , m_MaxObjects(std::max(settingsManager.GetUInt("render.gpu_max_objects"), 1u))
+        , m_MaxDrawSlots(std::max(settingsManager.GetUInt("render.gpu_max_draws"), 1u)) {
+        m_Access.Read<Core::Component::WorldTransformComponent>()
+            .Read<Core::Component::ModelComponent>()
+            .ReadResource(SystemResource::CAMERA);
+
+        CreateFrameResources();
+        CreatePipelineLayouts(globalSetLayout);
+        CreatePipelines(renderPass);
+    }
+
+    GpuDrivenRenderSystem::~GpuDrivenRenderSystem() {
+        for (FrameResources& frame : m_Frames) { DestroyPyramid(frame); }
+        vkDestroySampler(m_Device.GetDevice(), m_DepthSampler, nullptr);
+        vkDestroyPipelineLayout(m_Device.GetDevice(), m_PipelineLayout, nullptr);
+        vkDestroyPipelineLayout(m_Device.GetDevice(), m_ComputePipelineLayout, nullptr);
+        vkDestroyPipelineLayout(m_Device.GetDevice(), m_PyramidPipelineLayout, nullptr);
+    }
+
+    void GpuDrivenRenderSystem::Update(const Core::FrameInfo& frameInfo, Graphics::Ubo::GlobalUbo&) {
+        m_ObjectCount = 0;
+        m_OcclusionCulling = false;
+        m_Batches.clear();
+        m_BatchIds.clear();
+        m_SlotCounts.clear();
+        if (!m_SettingsManager.GetBool("render.gpu_driven") || !m_Device.IsDrawIndirectCountSupported()) { return; }
+
+        m_FrameIndex = static_cast<uint32_t>(frameInfo.frameIndex);
+        FrameResources& frame = m_Frames[m_FrameIndex];
+
+        // The frame waited for its previous submission, so its pyramid and descriptor sets are free to change
+        m_OcclusionCulling = m_SettingsManager.GetBool("render.gpu_occlusion_culling");
+        if (m_OcclusionCulling) {
+            const Graphics::Renderers::DepthAttachment depth = m_RendererManager.GetRenderer().GetDepthAttachment();
+            if (depth.extent.width != frame.depthExtent.width || depth.extent.height != frame.depthExtent.height) {
+                CreatePyramid(frame, depth.extent);
+            }
+            const VkDescriptorImageInfo depthInfo{
+                m_DepthSampler, depth.view, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};
+            Graphics::Descriptors::Liara_DescriptorBuilder(*m_DescriptorLayoutCache, *m_DescriptorAllocator)
+                .BindImage(0, &depthInfo, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .Overwrite(frame.pyramidSets[0]);
+            m_DepthImage = depth.image;
+            m_DepthAspect = VK_IMAGE_ASPECT_DEPTH_BIT | (HasStencil(depth.format) ? VK_IMAGE_ASPECT_STENCIL_BIT : 0);
+        }
+
+        auto* const objects = static_cast<GpuObject*>(frame.objects->GetMappedMemory());
+        const bool lodSelection = m_SettingsManager.GetBool("render.lod_selection");
+
+        bool overflow = false;
+        frameInfo.registry.View<const Core::Component::WorldTransformComponent, const Core::Component::ModelComponent>()
+            .Each([&](const Core::ECS::Entity entity,
+                      const Core::Component::WorldTransformComponent& transform,
+                      const Core::Component::ModelComponent& model) {
+                if (!model.model || !model.model->HasIndices()) { return; }
+                if (m_ObjectCount == m_MaxObjects) {
+                    overflow = true;
+                    return;
+                }
+
+                // Every level of detail of a mesh gets a draw slot, next to each other
+                const Graphics::Liara_Model* mesh = model.model.get();
+                auto [it, inserted] = m_BatchIds.try_emplace(mesh, static_cast<uint32_t>(m_Batches.size()));
+                if (inserted) {
+                    const uint32_t firstSlot = static_cast<uint32_t>(m_SlotCounts.size());
+                    if (firstSlot + mesh->GetLodCount() > m_MaxDrawSlots) {
+                        m_BatchIds.erase(it);
+                        overflow = true;
+                        return;
+                    }
+                    m_Batches.push_back({.model = mesh, .firstSlot = firstSlot, .slotCount = mesh->GetLodCount()});
+                    m_SlotCounts.resize(firstSlot + mesh->GetLodCount(), 0);
+                }
+                const Batch& batch = m_Batches[it->second];
+                const uint32_t lodLevel = lodSelection ? std::min(model.lodLevel, batch.slotCount - 1) : 0;
+                const uint32_t slot = batch.firstSlot + lodLevel;
+                ++m_SlotCounts[slot];
+
+                const Core::Math::BoundingSphere& sphere = mesh->GetBounds().sphere;
+                objects[m_ObjectCount++] = {.modelMatrix = transform.interpolatedWorld,
+                                            .normalMatrix = glm::mat4{transform.interpolatedNormal},
+                                            .boundingSphere = glm::vec4{sphere.center, sphere.radius},
+                                            .drawSlot = slot,
+                                            .visibilityIndex = entity.index < m_MaxObjects ? entity.index
+                                                                                           : NO_VISIBILITY};
+            });
+
+        if (overflow && !m_CapacityWarned) {
+            LIARA_LOG_WARNING(LogSystems,
+                              "GPU-driven rendering is limited to {} objects and {} draw slots, the rest is not drawn",
+                              m_MaxObjects,
+                              m_MaxDrawSlots);
+            m_CapacityWarned = true;
+        }
+
+        // Each slot reserves room for all of its objects in the visible list, the culling fills it from the start.
+        // The second phase has its own copy of the slots, past the first one.
+        auto* const slots = static_cast<VkDrawIndexedIndirectCommand*>(frame.drawSlots->GetMappedMemory());
+        auto* const batches = static_cast<GpuBatch*>(frame.batches->GetMappedMemory());
+        const uint32_t phaseCount = m_OcclusionCulling ? 2 : 1;
+        uint32_t firstInstance = 0;
+        for (uint32_t b = 0; b < m_Batches.size(); ++b) {
+            const Batch& batch = m_Batches[b];
+            batches[b] = {.firstSlot = batch.firstSlot, .slotCount = batch.slotCount};
+            for (uint32_t level = 0; level < batch.slotCount; ++level) {
+                const uint32_t slot = batch.firstSlot + level;
+                const Graphics::Liara_Model::LodRange& lod = batch.model->GetLod(level);
+                const Graphics::GeometryAllocation& geometry = batch.model->GetGeometry();
+                for (uint32_t phase = 0; phase < phaseCount; ++phase) {
+                    slots[phase * m_MaxDrawSlots + slot] = {
+                        .indexCount = lod.indexCount,
+                        .instanceCount = 0,
+                        .firstIndex = geometry.firstIndex + lod.firstIndex,
+                        .vertexOffset = static_cast<int32_t>(geometry.vertexOffset),
+                        .firstInstance = phase * m_MaxObjects + firstInstance};
+                }
+                firstInstance += m_SlotCounts[slot];
+            }
+        }
+
+        const glm::mat4 viewProjection = frameInfo.camera.GetProjectionMatrix() * frameInfo.camera.GetViewMatrix();
+        CullingData culling{.viewProjection = viewProjection,
+                            .depthSize = {static_cast<float>(frame.depthExtent.width),
+                                          static_cast<float>(frame.depthExtent.height)},
+                            .pyramidLevelCount =
+                                m_OcclusionCulling ? static_cast<uint32_t>(frame.pyramidLevelViews.size()) : 0,
+                            .objectCount = m_ObjectCount,
+                            .batchCount = static_cast<uint32_t>(m_Batches.size()),
+                            .maxObjects = m_MaxObjects,
+                            .maxDrawSlots = m_MaxDrawSlots};
+        if (m_SettingsManager.GetBool("render.frustum_culling")) {
+            culling.planes = Core::Math::Frustum::FromMatrix(viewProjection).planes;
+        }
+        else {
+            // Planes every sphere is in front of
+            culling.planes.fill(glm::vec4{0.0f, 0.0f, 0.0f, 1.0f});
+        }
+        frame.culling->WriteObject(culling);
+    }
+
+    void GpuDrivenRenderSystem::PrepareRender(const Core::FrameInfo& frameInfo) const {
+        if (m_ObjectCount == 0) { return; }
+
+        // The visibility flags are shared with the culling of the previous frames
+        VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+        ComputeBarrier(commandBuffer,
+                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                       VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+        DispatchCulling(commandBuffer, 0);
+    }
+
+    void GpuDrivenRenderSystem::RenderEarly(const Core::FrameInfo& frameInfo) const { DrawPhase(frameInfo, 0); }
+
+    void GpuDrivenRenderSystem::PrepareMainPass(const Core::FrameInfo& frameInfo) const {
+        if (!HasEarlyPass()) { return; }
+        const FrameResources& frame = m_Frames[m_FrameIndex];
+        VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+        const auto levelCount = static_cast<uint32_t>(frame.pyramidLevelViews.size());
+
+        // The early depth becomes readable, the pyramid stays in the layout its descriptors use and is rewritten
+        std::array<VkImageMemoryBarrier, 2> barriers{};
+        barriers[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barriers[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        barriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barriers[0].oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        barriers[0].newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        barriers[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barriers[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barriers[0].image = m_DepthImage;
+        barriers[0].subresourceRange = {m_DepthAspect, 0, 1, 0, 1};
+        barriers[1].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barriers[1].srcAccessMask = 0;
+        barriers[1].dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barriers[1].oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barriers[1].newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barriers[1].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barriers[1].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barriers[1].image = frame.pyramid;
+        barriers[1].subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1};
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             static_cast<uint32_t>(barriers.size()),
+                             barriers.data());
+
+        // Each level keeps the farthest depth of the texels it covers in the level above
+        m_PyramidPipeline->Bind(commandBuffer);
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            vkCmdBindDescriptorSets(commandBuffer,
+                                    VK_PIPELINE_BIND_POINT_COMPUTE,
+                                    m_PyramidPipelineLayout,
+                                    0,
+                                    1,
+                                    &frame.pyramidSets[level],
+                                    0,
+                                    nullptr);
+            const VkExtent2D extent = PyramidLevelExtent(frame.depthExtent, level);
+            vkCmdDispatch(commandBuffer,
+                          GroupCount(extent.width, PYRAMID_GROUP_SIZE),
+                          GroupCount(extent.height, PYRAMID_GROUP_SIZE),
+                          1);
+            ComputeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+        }
+
+        // The main pass resumes on the depth
+        VkImageMemoryBarrier depthBarrier = barriers[0];
+        depthBarrier.srcAccessMask = 0;
+        depthBarrier.dstAccessMask =
+            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        depthBarrier.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        depthBarrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &depthBarrier);
+
+        DispatchCulling(commandBuffer, 1);
+    }
+
+    void GpuDrivenRenderSystem::Render(const Core::FrameInfo& frameInfo) const {
+        if (m_ObjectCount == 0) { return; }
+        DrawPhase(frameInfo, m_OcclusionCulling ? 1 : 0);
+    }
+
+    void GpuDrivenRenderSystem::DispatchCulling(VkCommandBuffer commandBuffer, const uint32_t phase) const {
+        const FrameResources& frame = m_Frames[m_FrameIndex];
+        vkCmdBindDescriptorSets(commandBuffer,
+                                VK_PIPELINE_BIND_POINT_COMPUTE,
+                                m_ComputePipelineLayout,
+                                0,
+                                1,
+                                &frame.descriptorSet,
+                                0,
+                                nullptr);
+        vkCmdPushConstants(
+            commandBuffer, m_ComputePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(phase), &phase);
+
+        m_CullPipeline->Bind(commandBuffer);
+        vkCmdDispatch(commandBuffer, GroupCount(m_ObjectCount), 1, 1);
+        ComputeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+        m_BuildDrawsPipeline->Bind(commandBuffer);
+        vkCmdDispatch(commandBuffer, GroupCount(static_cast<uint32_t>(m_Batches.size())), 1, 1);
+        ComputeBarrier(commandBuffer,
+                       VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                       VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT);
+    }
+
+    void GpuDrivenRenderSystem::DrawPhase(const Core::FrameInfo& frameInfo, const uint32_t phase) const {
+        const FrameResources& frame = m_Frames[m_FrameIndex];
+
+        VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+        m_Pipeline->Bind(commandBuffer);
+        const std::array<VkDescriptorSet, 2> descriptorSets = {frameInfo.globalDescriptorSet, frame.descriptorSet};
+        vkCmdBindDescriptorSets(commandBuffer,
+                                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                m_PipelineLayout,
+                                0,
+                                static_cast<uint32_t>(descriptorSets.size()),
+                                descriptorSets.data(),
+                                0,
+                                nullptr);
+
+        // One call per mesh, drawing the levels of detail the culling found visible.
+        // The commands carry the offsets of each mesh, the shared geometry is only bound when its block changes.
+        constexpr VkDeviceSize commandStride = sizeof(VkDrawIndexedIndirectCommand);
+        const VkDeviceSize phaseOffset = static_cast<VkDeviceSize>(phase) * m_MaxDrawSlots;
+        uint32_t boundGeometryBlock = Graphics::GeometryAllocation::NO_BLOCK;
+        for (uint32_t b = 0; b < m_Batches.size(); ++b) {
+            const Batch& batch = m_Batches[b];
+            if (batch.model->GetGeometry().block != boundGeometryBlock) {
+                batch.model->Bind(commandBuffer);
+                boundGeometryBlock = batch.model->GetGeometry().block;
+                ++frameStats.bindCount;
+            }
+            vkCmdDrawIndexedIndirectCount(commandBuffer,
+                                          frame.drawCommands->GetBuffer(),
+                                          (phaseOffset + batch.firstSlot) * commandStride,
+                                          frame.drawCounts->GetBuffer(),
+                                          (phaseOffset + b) * sizeof(uint32_t),
+                                          batch.slotCount,
+                                          static_cast<uint32_t>(commandStride));
+            ++frameStats.drawCallCount;
+        }
+    }
+
+    void GpuDrivenRenderSystem::CreateFrameResources() {
+        constexpr uint32_t frameCount = Graphics::Constants::MAX_FRAMES_IN_FLIGHT;
+        m_DescriptorAllocator =
+            Graphics::Descriptors::Liara_DescriptorAllocator::Builder(m_Device)
+                .SetMaxSets(frameCount * (1 + MAX_PYRAMID_LEVELS))
+                .AddPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, frameCount * STORAGE_BINDING_COUNT)
+                .AddPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, frameCount * (1 + MAX_PYRAMID_LEVELS))
+                .AddPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, frameCount * MAX_PYRAMID_LEVELS)
+                .Build();
+        m_DescriptorLayoutCache = Graphics::Descriptors::Liara_DescriptorLayoutCache::Builder(m_Device).Build();
+
+        // The pyramid shaders only fetch texels, the sampler never filters
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+        if (vkCreateSampler(m_Device.GetDevice(), &samplerInfo, nullptr, &m_DepthSampler) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogSystems, "Failed to create the depth pyramid sampler!");
+        }
+
+        // No entity starts visible
+        m_Visibility = std::make_unique<Graphics::Liara_Buffer>(
+            m_Device, sizeof(uint32_t) * m_MaxObjects, Graphics::BufferConfig::DeviceStorage());
+        {
+            Graphics::Liara_UploadBatch batch = m_Device.GetUploadContext().Begin();
+            vkCmdFillBuffer(batch.GetCommandBuffer(), m_Visibility->GetBuffer(), 0, VK_WHOLE_SIZE, 0);
+            batch.ReleaseBuffer(m_Visibility->GetBuffer(), 0, VK_WHOLE_SIZE);
+            batch.Submit();
+        }
+
+        // Both phases get their own draw slots, visible objects, commands and counts, one after the other
+        const VkDeviceSize commandBytes = sizeof(VkDrawIndexedIndirectCommand) * m_MaxDrawSlots * 2;
+        m_Frames.resize(frameCount);
+        for (FrameResources& frame : m_Frames) {
+            frame.objects = std::make_unique<Graphics::Liara_Buffer>(
+                m_Device, sizeof(GpuObject) * m_MaxObjects, Graphics::BufferConfig::Storage());
+            frame.drawSlots =
+                std::make_unique<Graphics::Liara_Buffer>(m_Device, commandBytes, Graphics::BufferConfig::Storage());
+            frame.batches = std::make_unique<Graphics::Liara_Buffer>(
+                m_Device, sizeof(GpuBatch) * m_MaxDrawSlots, Graphics::BufferConfig::Storage());
+            frame.culling = std::make_unique<Graphics::Liara_Buffer>(
+                m_Device, sizeof(CullingData), Graphics::BufferConfig::Storage());
+            frame.visibleObjects = std::make_unique<Graphics::Liara_Buffer>(
+                m_Device, sizeof(uint32_t) * m_MaxObjects * 2, Graphics::BufferConfig::DeviceStorage());
+            frame.drawCommands = std::make_unique<Graphics::Liara_Buffer>(
+                m_Device, commandBytes, Graphics::BufferConfig::DeviceStorage());
+            frame.drawCounts = std::make_unique<Graphics::Liara_Buffer>(
+                m_Device, sizeof(uint32_t) * m_MaxDrawSlots * 2, Graphics::BufferConfig::DeviceStorage());
+
+            // The CPU side buffers stay mapped, they are rewritten every frame
+            for (Graphics::Liara_Buffer* buffer :
+                 {frame.objects.get(), frame.drawSlots.get(), frame.batches.get(), frame.culling.get()}) {
+                if (const VkResult result = buffer->Map(); result != VK_SUCCESS) {
+                    LIARA_THROW_RUNTIME_ERROR(
+                        LogSystems, "Failed to map a GPU-driven buffer: {}", Graphics::VkResultToString(result));
+                }
+            }
+
+            // Bindings shared by the compute passes and the vertex shader, each stage declares the ones it reads
+            const std::array infos = {frame.objects->DescriptorInfo(),
+                                      frame.drawSlots->DescriptorInfo(),
+                                      frame.visibleObjects->DescriptorInfo(),
+                                      frame.batches->DescriptorInfo(),
+                                      frame.drawCommands->DescriptorInfo(),
+                                      frame.drawCounts->DescriptorInfo(),
+                                      frame.culling->DescriptorInfo(),
+                                      m_Visibility->DescriptorInfo()};
+            static_assert(infos.size() == STORAGE_BINDING_COUNT);
+
+            // A placeholder pyramid until the depth size is known
+            CreatePyramid(frame, {1, 1});
+            const VkDescriptorImageInfo pyramidInfo{m_DepthSampler, frame.pyramidView, VK_IMAGE_LAYOUT_GENERAL};
+
+            Graphics::Descriptors::Liara_DescriptorBuilder builder(*m_DescriptorLayoutCache, *m_DescriptorAllocator);
+            for (uint32_t binding = 0; binding < STORAGE_BINDING_COUNT; ++binding) {
+                builder.BindBuffer(binding,
+                                   &infos[binding],
+                                   VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                   VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT);
+            }
+            builder.BindImage(
+                PYRAMID_BINDING, &pyramidInfo, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT);
+            LIARA_CHECK_RUNTIME(builder.Build(frame.descriptorSet, m_ObjectSetLayout),
+                                LogSystems,
+                                "Failed to build the GPU-driven descriptor set");
+        }
+    }
+
+    void GpuDrivenRenderSystem::CreatePyramid(FrameResources& frame, const VkExtent2D depthExtent) {
+        DestroyPyramid(frame);
+
+        const uint32_t levelCount = PyramidLevelCount(depthExtent);
+        const VkExtent2D baseExtent = PyramidLevelExtent(depthExtent, 0);
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = VK_FORMAT_R32_SFLOAT;
+        imageInfo.extent = {baseExtent.width, baseExtent.height, 1};
+        imageInfo.mipLevels = levelCount;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        m_Device.CreateImageWithInfo(
+            imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, frame.pyramid, frame.pyramidMemory);
+
+        // Bound with the culling descriptors from the first dispatch on, before any frame builds it
+        VkImageMemoryBarrier layoutBarrier{};
+        layoutBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        layoutBarrier.srcAccessMask = 0;
+        layoutBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        layoutBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        layoutBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        layoutBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        layoutBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        layoutBarrier.image = frame.pyramid;
+        layoutBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1};
+        VkCommandBuffer commandBuffer = m_Device.BeginSingleTimeCommands();
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &layoutBarrier);
+        m_Device.EndSingleTimeCommands(commandBuffer);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = frame.pyramid;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = VK_FORMAT_R32_SFLOAT;
+        viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1};
+        if (vkCreateImageView(m_Device.GetDevice(), &viewInfo, nullptr, &frame.pyramidView) != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogSystems, "Failed to create the depth pyramid view!");
+        }
+        frame.pyramidLevelViews.resize(levelCount);
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1};
+            if (vkCreateImageView(m_Device.GetDevice(), &viewInfo, nullptr, &frame.pyramidLevelViews[level])
+                != VK_SUCCESS) {
+                LIARA_THROW_RUNTIME_ERROR(LogSystems, "Failed to create a depth pyramid level view!");
+            }
+        }
+        frame.depthExtent = depthExtent;
+
+        const VkDescriptorImageInfo pyramidInfo{m_DepthSampler, frame.pyramidView, VK_IMAGE_LAYOUT_GENERAL};
+        if (frame.descriptorSet != VK_NULL_HANDLE) {
+            Graphics::Descriptors::Liara_DescriptorBuilder(*m_DescriptorLayoutCache, *m_DescriptorAllocator)
+                .BindImage(PYRAMID_BINDING,
+                           &pyramidInfo,
+                           VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                           VK_SHADER_STAGE_COMPUTE_BIT)
+                .Overwrite(frame.descriptorSet);
+        }
+
+        // Each level reads the one above, level 0 reads the depth and is pointed at it every frame
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            const VkDescriptorImageInfo sourceInfo{
+                m_DepthSampler, frame.pyramidLevelViews[level == 0 ? 0 : level - 1], VK_IMAGE_LAYOUT_GENERAL};
+            const VkDescriptorImageInfo destinationInfo{
+                VK_NULL_HANDLE, frame.pyramidLevelViews[level], VK_IMAGE_LAYOUT_GENERAL};
+            Graphics::Descriptors::Liara_DescriptorBuilder builder(*m_DescriptorLayoutCache, *m_DescriptorAllocator);
+            builder
+                .BindImage(0, &sourceInfo, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .BindImage(1, &destinationInfo, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT);
+            if (level < frame.pyramidSets.size()) { builder.Overwrite(frame.pyramidSets[level]); }
+            else {
+                VkDescriptorSet set = VK_NULL_HANDLE;
+                LIARA_CHECK_RUNTIME(builder.Build(set, m_PyramidSetLayout),
+                                    LogSystems,
+                                    "Failed to build a depth pyramid descriptor set");
+                frame.pyramidSets.push_back(set);
+            }
+        }
+    }
+
+    void GpuDrivenRenderSystem::DestroyPyramid(FrameResources& frame) const {
+        for (VkImageView view : frame.pyramidLevelViews) { vkDestroyImageView(m_Device.GetDevice(), view, nullptr); }
+        frame.pyramidLevelViews.clear();
+        vkDestroyImageView(m_Device.GetDevice(), frame.pyramidView, nullptr);
+        vkDestroyImage(m_Device.GetDevice(), frame.pyramid, nullptr);
+        m_Device.FreeMemory(frame.pyramidMemory);
+        frame.pyramidView = VK_NULL_HANDLE;
+        frame.pyramid = VK_NULL_HANDLE;
+        frame.depthExtent = {};
+    }
+
+    void GpuDrivenRenderSystem::CreatePipelineLayouts(VkDescriptorSetLayout globalSetLayout) {
+        const std::array graphicsLayouts = {globalSetLayout, m_ObjectSetLayout};
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(graphicsLayouts.size());
+        pipelineLayoutInfo.pSetLayouts = graphicsLayouts.data();
+        if (vkCreatePipelineLayout(m_Device.GetDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayout)
+            != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogSystems, "Failed to create pipeline layout!");
+        }
+
+        // The culling shaders only get the phase they run for
+        constexpr VkPushConstantRange pushConstantRange{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(uint32_t)};
+        VkPipelineLayoutCreateInfo computeLayoutInfo{};
+        computeLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        computeLayoutInfo.setLayoutCount = 1;
+        computeLayoutInfo.pSetLayouts = &m_ObjectSetLayout;
+        computeLayoutInfo.pushConstantRangeCount = 1;
+        computeLayoutInfo.pPushConstantRanges = &pushConstantRange;
+        if (vkCreatePipelineLayout(m_Device.GetDevice(), &computeLayoutInfo, nullptr, &m_ComputePipelineLayout)
+            != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogSystems, "Failed to create compute pipeline layout!");
+        }
+
+        VkPipelineLayoutCreateInfo pyramidLayoutInfo{};
+        pyramidLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pyramidLayoutInfo.setLayoutCount = 1;
+        pyramidLayoutInfo.pSetLayouts = &m_PyramidSetLayout;
+        if (vkCreatePipelineLayout(m_Device.GetDevice(), &pyramidLayoutInfo, nullptr, &m_PyramidPipelineLayout)
+            != VK_SUCCESS) {
+            LIARA_THROW_RUNTIME_ERROR(LogSystems, "Failed to create depth pyramid pipeline layout!");
+        }
+    }
+
+    void GpuDrivenRenderSystem::CreatePipelines(VkRenderPass renderPass) {
+        assert(m_PipelineLayout != nullptr && "Cannot create pipeline before pipeline layout");
+
+        Graphics::PipelineConfigInfo pipelineConfig{};
+        Graphics::Liara_Pipeline::DefaultPipelineConfigInfo(pipelineConfig);
+        pipelineConfig.renderPass = renderPass;
+        pipelineConfig.pipelineLayout = m_PipelineLayout;
+        m_Pipeline = std::make_unique<Graphics::Liara_Pipeline>(m_Device,
+                                                                "shaders/GpuDriven.vert.spv",
+                                                                "shaders/SimpleShader.frag.spv",
+                                                                pipelineConfig,
+                                                                m_SettingsManager);
+
+        m_CullPipeline = std::make_unique<Graphics::Liara_ComputePipeline>(
+            m_Device, "shaders/CullObjects.comp.spv", m_ComputePipelineLayout);
+        m_BuildDrawsPipeline = std::make_unique<Graphics::Liara_ComputePipeline>(
+            m_Device, "shaders/BuildDraws.comp.spv", m_ComputePipelineLayout);
+        m_PyramidPipeline = std::make_unique<Graphics::Liara_ComputePipeline>(
+            m_Device, "shaders/BuildDepthPyramid.comp.spv", m_PyramidPipelineLayout);
+    }
+}
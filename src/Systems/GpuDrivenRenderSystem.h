@@ -0,0 +1,176 @@
+/**
+ * @file GpuDrivenRenderSystem.h
+ * @brief Defines the `GpuDrivenRenderSystem` class, which culls and draws the indexed models on the GPU.
+ *
+ * Each frame the CPU only copies the object data (matrices, bounds, draw slot) into a storage buffer.
+ * A first compute pass tests each object against the frustum and appends the visible ones to the draw slot of their
+ * mesh and level of detail. A second one compacts the non-empty slots of each mesh into indirect draw commands and
+ * writes their count, so a mesh is drawn with a single vkCmdDrawIndexedIndirectCount whatever its number of copies.
+ *
+ * With "render.gpu_occlusion_culling", the culling runs in two phases over a visibility history kept per entity:
+ *      - the objects visible last frame are drawn in the early pass, only tested against the frustum
+ *      - a compute pass reduces the depth of the early pass into a Hi-Z pyramid (farthest depth of each texel)
+ *      - every object is tested against the pyramid, which updates the history, and the newly visible ones are drawn
+ *        in the main pass
+ * Objects hidden behind what was visible last frame are so never drawn, and those appearing are never missed.
+ *
+ * Enabled by the "render.gpu_driven" setting, on devices supporting multiDrawIndirect and drawIndirectCount.
+ * Models without index buffer are left to SimpleRenderSystem.
+ */
+
+#pragma once
+#include "Core/Liara_SettingsManager.h"
+#include "Graphics/Liara_MemoryAllocator.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Liara_System.h"
+
+namespace Liara::Graphics
+{
+    class Liara_Buffer;
+    class Liara_ComputePipeline;
+    class Liara_Device;
+    class Liara_Model;
+    class Liara_Pipeline;
+}
+namespace Liara::Graphics::Renderers
+{
+    class Liara_RendererManager;
+}
+namespace Liara::Graphics::Descriptors
+{
+    class Liara_DescriptorAllocator;
+    class Liara_DescriptorLayoutCache;
+}
+namespace Liara::Graphics::Ubo
+{
+    struct GlobalUbo;
+}
+
+namespace Liara::Systems
+{
+    class GpuDrivenRenderSystem final : public Liara_System
+    {
+    public:
+        GpuDrivenRenderSystem(Graphics::Liara_Device& device,
+                              const Graphics::Renderers::Liara_RendererManager& rendererManager,
+                              VkRenderPass renderPass,
+                              VkDescriptorSetLayout globalSetLayout,
+                              const Core::Liara_SettingsManager& settingsManager);
+        ~GpuDrivenRenderSystem() override;
+
+        /**
+         * @brief Writes the objects, draw slots and meshes of the frame into its storage buffers.
+         */
+        void Update(const Core::FrameInfo& frameInfo, Graphics::Ubo::GlobalUbo& ubo) override;
+
+        /**
+         * @brief Dispatches the culling and draw compaction passes of the first phase.
+         */
+        void PrepareRender(const Core::FrameInfo& frameInfo) const override;
+
+        [[nodiscard]] bool HasEarlyPass() const override { return m_OcclusionCulling && m_ObjectCount > 0; }
+
+        /**
+         * @brief Draws the objects visible last frame.
+         */
+        void RenderEarly(const Core::FrameInfo& frameInfo) const override;
+
+        /**
+         * @brief Builds the Hi-Z pyramid from the early depth, and dispatches the culling of the second phase.
+         */
+        void PrepareMainPass(const Core::FrameInfo& frameInfo) const override;
+
+        void Render(const Core::FrameInfo& frameInfo) const override;
+
+    private:
+        /**
+         * @brief Storage buffers of one frame in flight, and the descriptor set binding them.
+         */
+        struct FrameResources
+        {
+            std::unique_ptr<Graphics::Liara_Buffer> objects;         ///< Written by the CPU
+            std::unique_ptr<Graphics::Liara_Buffer> drawSlots;       ///< Written by the CPU, counted by the culling
+            std::unique_ptr<Graphics::Liara_Buffer> batches;         ///< Written by the CPU
+            std::unique_ptr<Graphics::Liara_Buffer> visibleObjects;  ///< Object indices, by draw slot
+            std::unique_ptr<Graphics::Liara_Buffer> drawCommands;    ///< Non-empty slots, compacted per mesh
+            std::unique_ptr<Graphics::Liara_Buffer> drawCounts;      ///< Number of commands of each mesh
+            std::unique_ptr<Graphics::Liara_Buffer> culling;         ///< Frustum, camera and counts of the frame
+            VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+            // Hi-Z pyramid, level 0 is half the depth size, and its reduction sets (one per level)
+            VkImage pyramid = VK_NULL_HANDLE;
+            Graphics::MemoryAllocation pyramidMemory;
+            VkImageView pyramidView = VK_NULL_HANDLE;
+            std::vector<VkImageView> pyramidLevelViews;
+            std::vector<VkDescriptorSet> pyramidSets;
+            VkExtent2D depthExtent{};  ///< Depth size the pyramid was created for
+        };
+
+        /**
+         * @brief A mesh drawn this frame, with one draw slot per level of detail.
+         */
+        struct Batch
+        {
+            const Graphics::Liara_Model* model = nullptr;
+            uint32_t firstSlot = 0;
+            uint32_t slotCount = 0;
+        };
+
+        void CreateFrameResources();
+        void CreatePipelineLayouts(VkDescriptorSetLayout globalSetLayout);
+        void CreatePipelines(VkRenderPass renderPass);
+
+        /**
+         * @brief (Re)creates the pyramid of a frame for a depth size, and points its descriptors at it.
+         * The frame must not be in use by the GPU.
+         */
+        void CreatePyramid(FrameResources& frame, VkExtent2D depthExtent);
+        void DestroyPyramid(FrameResources& frame) const;
+
+        /**
+         * @brief Culls the objects and compacts the draws of one phase, 0 for the early pass and 1 for the main one.
+         */
+        void DispatchCulling(VkCommandBuffer commandBuffer, uint32_t phase) const;
+        void DrawPhase(const Core::FrameInfo& frameInfo, uint32_t phase) const;
+
+        Graphics::Liara_Device& m_Device;
+        const Graphics::Renderers::Liara_RendererManager& m_RendererManager;
+        const Core::Liara_SettingsManager& m_SettingsManager;
+        uint32_t m_MaxObjects;
+        uint32_t m_MaxDrawSlots;
+
+        std::unique_ptr<Graphics::Descriptors::Liara_DescriptorAllocator> m_DescriptorAllocator;
+        std::unique_ptr<Graphics::Descriptors::Liara_DescriptorLayoutCache> m_DescriptorLayoutCache;
+        VkDescriptorSetLayout m_ObjectSetLayout = VK_NULL_HANDLE;
+        VkDescriptorSetLayout m_PyramidSetLayout = VK_NULL_HANDLE;
+        std::vector<FrameResources> m_Frames;
+        std::unique_ptr<Graphics::Liara_Buffer> m_Visibility;  ///< Shared by the frames, one flag per entity slot
+        VkSampler m_DepthSampler = VK_NULL_HANDLE;
+
+        VkPipelineLayout m_PipelineLayout{};
+        VkPipelineLayout m_ComputePipelineLayout{};
+        VkPipelineLayout m_PyramidPipelineLayout{};
+        std::unique_ptr<Graphics::Liara_Pipeline> m_Pipeline;
+        std::unique_ptr<Graphics::Liara_ComputePipeline> m_CullPipeline;
+        std::unique_ptr<Graphics::Liara_ComputePipeline> m_BuildDrawsPipeline;
+        std::unique_ptr<Graphics::Liara_ComputePipeline> m_PyramidPipeline;
+
+        // State of the current frame, filled by Update
+        uint32_t m_FrameIndex = 0;
+        uint32_t m_ObjectCount = 0;
+        bool m_OcclusionCulling = false;
+        VkImage m_DepthImage = VK_NULL_HANDLE;  ///< Depth of the renderer, sampled by the pyramid
+        VkImageAspectFlags m_DepthAspect = 0;
+        std::vector<Batch> m_Batches;
+        std::unordered_map<const Graphics::Liara_Model*, uint32_t> m_BatchIds;
+        std::vector<uint32_t> m_SlotCounts;  ///< Objects of each draw slot
+        bool m_CapacityWarned = false;
+    };
+}
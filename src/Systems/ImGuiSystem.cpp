@@ -24,6 +24,12 @@ namespace Liara::Systems
                              const uint32_t imageCount)
         : Liara_System("ImGui System", {.major = 0, .minor = 2, .patch = 3, .prerelease = "dev"})
         , m_lveDevice{device} {
+        // Elements display the engine state, they receive the UBO but are not expected to modify it
+        m_Access.WriteResource(SystemResource::IMGUI)
+            .ReadResource(SystemResource::GLOBAL_UBO)
+            .ReadResource(SystemResource::CAMERA)
+            .ReadResource(SystemResource::FRAME_STATS);
+
         // set up a descriptor pool stored on this instance
         const VkDescriptorPoolSize poolSizes[] = {
             {VK_DESCRIPTOR_TYPE_SAMPLER,                1000},
@@ -90,7 +96,7 @@ namespace Liara::Systems
 
         imguiInitialized = true;
 
-        AddElement(std::make_unique<Core::ImGuiElements::MainMenu>(appInfo));
+        AddElement(std::make_unique<Core::ImGuiElements::MainMenu>(appInfo, device));
     }
 
     ImGuiSystem::~ImGuiSystem() {
@@ -1,6 +1,8 @@
 #pragma once
 #include "Core/ApplicationInfo.h"
 
+#include "SystemAccess.h"
+
 namespace Liara::Core
 {
     struct FrameInfo;
@@ -27,9 +29,55 @@ namespace Liara::Systems
         [[nodiscard]] const std::string& Name() const { return m_Name; }
         [[nodiscard]] const Core::Version& Version() const { return m_Version; }
 
+        /**
+         * @brief Components and resources accessed by FixedUpdate and Update, the scheduler may run them on a worker.
+         */
+        [[nodiscard]] const SystemAccess& Access() const { return m_Access; }
+
+        /**
+         * @brief Advances the simulation by one fixed step, frameInfo.deltaTime is the step duration.
+         * Called zero or more times per frame, before Update. Transforms should only be changed here.
+         */
+        virtual void FixedUpdate(const Core::FrameInfo& /*frameInfo*/) {}
+
         virtual void Update(const Core::FrameInfo& frameInfo, Graphics::Ubo::GlobalUbo& ubo) = 0;
+
+        /**
+         * @brief Records the work that must happen before the render pass begins, such as compute dispatches.
+         * Called serially, in registration order, after every Update.
+         */
+        virtual void PrepareRender(const Core::FrameInfo& /*frameInfo*/) const {}
+
+        /**
+         * @brief Whether the system draws in the early pass this frame. Called after PrepareRender.
+         *
+         * When a system does, the frame starts with an early render pass whose depth can be read before the main pass
+         * resumes on the same attachments.
+         */
+        [[nodiscard]] virtual bool HasEarlyPass() const { return false; }
+
+        /**
+         * @brief Records the draws of the early pass, only called when some system has one.
+         */
+        virtual void RenderEarly(const Core::FrameInfo& /*frameInfo*/) const {}
+
+        /**
+         * @brief Records the work between the early pass and the main pass, such as reading the early depth.
+         */
+        virtual void PrepareMainPass(const Core::FrameInfo& /*frameInfo*/) const {}
+
+        /**
+         * @brief Records the draws of the main pass.
+         *
+         * With "render.parallel_recording", it runs on a job thread (the main thread for main thread systems) and
+         * records into its own secondary command buffer, concurrently with the Render of the other systems.
+         * Systems submitting to the render queue must declare WriteResource(SystemResource::RENDER_QUEUE).
+         */
         virtual void Render(const Core::FrameInfo& frameInfo) const = 0;
 
+    protected:
+        SystemAccess m_Access;  ///< Declared by the constructor of the derived system, exclusive if left empty
+
     private:
         std::string m_Name{"UnnamedSystem"};
         Core::Version m_Version{.major = 0, .minor = 0, .patch = 0, .prerelease = "no version"};
@@ -0,0 +1,144 @@
+#include "Liara_SystemScheduler.h"
+
+#include "Core/FrameInfo.h"
+#include "Core/Jobs/Liara_JobSystem.h"
+#include "Core/Logging/LogMacros.h"
+#include "Graphics/Liara_RenderQueue.h"
+#include "Graphics/Liara_SecondaryCommandRecorder.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Liara::Systems
+{
+    void Liara_SystemScheduler::AddSystem(std::unique_ptr<Liara_System> system) {
+        LIARA_CHECK_ARGUMENT(system != nullptr, LogSystems, "Cannot add a null system");
+
+        const SystemAccess& access = system->Access();
+        std::vector<size_t> dependencies;
+        for (size_t i = 0; i < m_Systems.size(); ++i) {
+            const SystemAccess& previous = m_Systems[i]->Access();
+            if (!access.ConflictsWith(previous)) { continue; }
+
+            if (!access.IsExclusive() && !previous.IsExclusive() && access.HasWriteHazardWith(previous)) {
+                LIARA_LOG_WARNING(LogSystems,
+                                  "Write/write hazard: \"{}\" and \"{}\" write the same data, \"{}\" runs first",
+                                  system->Name(),
+                                  m_Systems[i]->Name(),
+                                  m_Systems[i]->Name());
+            }
+
+            // An edge to a system that already depends on another dependency is redundant but harmless
+            dependencies.push_back(i);
+        }
+
+        if (access.IsExclusive()) {
+            LIARA_LOG_VERBOSE(LogSystems, "System \"{}\" declares no access, it runs exclusively", system->Name());
+        }
+
+        m_Systems.push_back(std::move(system));
+        m_Dependencies.push_back(std::move(dependencies));
+    }
+
+    void Liara_SystemScheduler::FixedUpdate(const Core::FrameInfo& frameInfo) {
+        Dispatch(frameInfo, [&frameInfo](Liara_System& system) { system.FixedUpdate(frameInfo); });
+    }
+
+    void Liara_SystemScheduler::Update(const Core::FrameInfo& frameInfo, Graphics::Ubo::GlobalUbo& ubo) {
+        Dispatch(frameInfo, [&frameInfo, &ubo](Liara_System& system) { system.Update(frameInfo, ubo); });
+    }
+
+    template <typename Func> void Liara_SystemScheduler::Dispatch(const Core::FrameInfo& frameInfo, const Func& call) {
+        // Pools are created lazily by the registry, create them here before systems access them concurrently
+        for (const auto& system : m_Systems) { system->Access().PrepareStorage(frameInfo.registry); }
+
+        Core::Jobs::Liara_JobSystem& jobSystem = frameInfo.jobSystem;
+        m_Handles.assign(m_Systems.size(), {});
+
+        for (size_t i = 0; i < m_Systems.size(); ++i) {
+            m_DependencyHandles.clear();
+            for (const size_t dependency : m_Dependencies[i]) { m_DependencyHandles.push_back(m_Handles[dependency]); }
+
+            Liara_System& system = *m_Systems[i];
+            if (system.Access().IsMainThreadOnly()) {
+                // Main thread systems run in order, the systems scheduled after them see their results
+                for (const auto& handle : m_DependencyHandles) { jobSystem.Wait(handle); }
+                call(system);
+            }
+            else { m_Handles[i] = jobSystem.Schedule([&system, &call] { call(system); }, m_DependencyHandles); }
+        }
+
+        for (const auto& handle : m_Handles) { jobSystem.Wait(handle); }
+    }
+
+    void Liara_SystemScheduler::PrepareRender(const Core::FrameInfo& frameInfo) const {
+        for (const auto& system : m_Systems) { system->PrepareRender(frameInfo); }
+    }
+
+    bool Liara_SystemScheduler::HasEarlyPass() const {
+        return std::ranges::any_of(m_Systems, [](const auto& system) { return system->HasEarlyPass(); });
+    }
+
+    void Liara_SystemScheduler::RenderEarly(const Core::FrameInfo& frameInfo) const {
+        for (const auto& system : m_Systems) { system->RenderEarly(frameInfo); }
+    }
+
+    void Liara_SystemScheduler::PrepareMainPass(const Core::FrameInfo& frameInfo) const {
+        for (const auto& system : m_Systems) { system->PrepareMainPass(frameInfo); }
+    }
+
+    void Liara_SystemScheduler::Render(const Core::FrameInfo& frameInfo) const {
+        // Flushing after each system keeps the order between systems that queue their draws and those that record them
+        for (const auto& system : m_Systems) {
+            system->Render(frameInfo);
+            frameInfo.renderQueue.Flush(frameInfo.commandBuffer);
+        }
+    }
+
+    void Liara_SystemScheduler::RecordRender(const Core::FrameInfo& frameInfo,
+                                             Graphics::Liara_SecondaryCommandRecorder& recorder,
+                                             std::vector<VkCommandBuffer>& commandBuffers) {
+        Core::Jobs::Liara_JobSystem& jobSystem = frameInfo.jobSystem;
+        m_Handles.assign(m_Systems.size(), {});
+        m_RenderCommandBuffers.resize(m_Systems.size());
+
+        // The render queue keeps one set of packets, its users record in registration order
+        Core::Jobs::JobHandle lastQueueUser;
+        for (size_t i = 0; i < m_Systems.size(); ++i) {
+            const Liara_System& system = *m_Systems[i];
+            const bool usesQueue = system.Access().WritesResource(SystemResource::RENDER_QUEUE);
+            std::vector<VkCommandBuffer>& buffers = m_RenderCommandBuffers[i];
+            buffers.clear();
+
+            const auto record = [&frameInfo, &recorder, &system, &buffers, usesQueue] {
+                Core::FrameInfo info = frameInfo;
+                info.commandBuffer = recorder.Begin(info.jobSystem.GetCurrentThreadIndex());
+                system.Render(info);
+                recorder.End(info.commandBuffer);
+                buffers.push_back(info.commandBuffer);
+                if (usesQueue) { info.renderQueue.Flush(recorder, info.jobSystem, buffers); }
+            };
+
+            if (system.Access().IsMainThreadOnly()) {
+                if (usesQueue) { jobSystem.Wait(lastQueueUser); }
+                record();
+                continue;
+            }
+            if (usesQueue) {
+                m_Handles[i] = jobSystem.Schedule(record, {lastQueueUser});
+                lastQueueUser = m_Handles[i];
+            }
+            else { m_Handles[i] = jobSystem.Schedule(record); }
+        }
+
+        for (const auto& handle : m_Handles) { jobSystem.Wait(handle); }
+        for (const auto& buffers : m_RenderCommandBuffers) {
+            commandBuffers.insert(commandBuffers.end(), buffers.begin(), buffers.end());
+        }
+    }
+}
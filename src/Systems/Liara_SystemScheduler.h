@@ -0,0 +1,108 @@
+/**
+ * @file Liara_SystemScheduler.h
+ * @brief Defines the `Liara_SystemScheduler` class, which runs the systems according to their declared accesses.
+ */
+
+#pragma once
+
+#include "Core/Jobs/Liara_JobSystem.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Liara_System.h"
+
+namespace Liara::Core
+{
+    struct FrameInfo;
+}
+namespace Liara::Graphics
+{
+    class Liara_SecondaryCommandRecorder;
+}
+namespace Liara::Graphics::Ubo
+{
+    struct GlobalUbo;
+}
+
+namespace Liara::Systems
+{
+    /**
+     * @class Liara_SystemScheduler
+     * @brief Owns the systems and runs their Update as a dependency graph on the job system.
+     *
+     * A system depends on every system registered before it with a conflicting access (see SystemAccess),
+     * so the result is the same as running them in registration order, while independent systems run in parallel.
+     * The render hooks (PrepareRender, RenderEarly, PrepareMainPass and Render) are always called serially, in
+     * registration order, as they record the frame command buffer.
+     */
+    class Liara_SystemScheduler
+    {
+    public:
+        Liara_SystemScheduler() = default;
+        Liara_SystemScheduler(const Liara_SystemScheduler&) = delete;
+        Liara_SystemScheduler& operator=(const Liara_SystemScheduler&) = delete;
+
+        /**
+         * @brief Registers a system after the existing ones.
+         * Logs a warning for each registered system writing the same component or resource (write/write hazard).
+         */
+        void AddSystem(std::unique_ptr<Liara_System> system);
+
+        /**
+         * @brief Runs the FixedUpdate of every system, and returns once all of them are done.
+         */
+        void FixedUpdate(const Core::FrameInfo& frameInfo);
+
+        /**
+         * @brief Runs the Update of every system, and returns once all of them are done.
+         */
+        void Update(const Core::FrameInfo& frameInfo, Graphics::Ubo::GlobalUbo& ubo);
+
+        void PrepareRender(const Core::FrameInfo& frameInfo) const;
+        [[nodiscard]] bool HasEarlyPass() const;
+        void RenderEarly(const Core::FrameInfo& frameInfo) const;
+        void PrepareMainPass(const Core::FrameInfo& frameInfo) const;
+        void Render(const Core::FrameInfo& frameInfo) const;
+
+        /**
+         * @brief Records the Render of every system into secondary command buffers, in parallel on the job system.
+         *
+         * Main thread systems record on the calling thread. The systems writing the render queue record one after the
+         * other, each flushing the queue into its own buffers in chunks, see Liara_RenderQueue::Flush.
+         * The other systems must record their draws directly.
+         * @param commandBuffers Receives the recorded buffers in registration order, to execute in the render pass.
+         */
+        void RecordRender(const Core::FrameInfo& frameInfo,
+                          Graphics::Liara_SecondaryCommandRecorder& recorder,
+                          std::vector<VkCommandBuffer>& commandBuffers);
+
+        [[nodiscard]] size_t Size() const { return m_Systems.size(); }
+        [[nodiscard]] bool Empty() const { return m_Systems.empty(); }
+        [[nodiscard]] Liara_System& operator[](const size_t index) const { return *m_Systems[index]; }
+
+        /**
+         * @brief Returns the indices of the systems that must finish before the system at index starts.
+         */
+        [[nodiscard]] const std::vector<size_t>& GetDependencies(const size_t index) const {
+            return m_Dependencies[index];
+        }
+
+    private:
+        /**
+         * @brief Runs call(system) for every system, following the dependency graph.
+         */
+        template <typename Func> void Dispatch(const Core::FrameInfo& frameInfo, const Func& call);
+
+        std::vector<std::unique_ptr<Liara_System>> m_Systems;
+        std::vector<std::vector<size_t>> m_Dependencies;  ///< Edges of the graph, per system
+
+        // Per frame state, kept to avoid reallocations
+        std::vector<Core::Jobs::JobHandle> m_Handles;
+        std::vector<Core::Jobs::JobHandle> m_DependencyHandles;
+        std::vector<std::vector<VkCommandBuffer>> m_RenderCommandBuffers;  ///< Recorded by each system
+    };
+}
@@ -1,8 +1,10 @@
 #include "PointLightSystem.h"
 
+#include "Core/Components/ColorComponent.h"
+#include "Core/Components/PointLightComponent.h"
 #include "Core/Components/TransformComponent3d.h"
+#include "Core/Components/WorldTransformComponent.h"
 #include "Core/FrameInfo.h"
-#include "Core/Liara_GameObject.h"
 #include "Core/Liara_SettingsManager.h"
 #include "Core/Logging/LogMacros.h"
 #include "Graphics/GraphicsConstants.h"
@@ -11,12 +13,11 @@
 
 #include <vulkan/vulkan_core.h>
 
-#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
-#include <vector>
 
 #include "glm/ext/matrix_float4x4.hpp"
 #include "glm/ext/matrix_transform.hpp"
@@ -26,7 +27,6 @@
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #define GLM_ENABLE_EXPERIMENTAL
 
-#include <ranges>
 #include <stdexcept>
 
 #include "glm/gtx/rotate_vector.hpp"
@@ -47,35 +47,66 @@ namespace Liara::Systems
         : Liara_System("Point Light System", {.major = 0, .minor = 2, .patch = 5, .prerelease = "dev"})
         , m_Device(device)
         , m_SettingsManager(settingsManager) {
+        m_Access
+            .Read<Core::Component::PointLightComponent,
+                  Core::Component::WorldTransformComponent,
+                  Core::Component::ColorComponent>()
+            .Write<Core::Component::TransformComponent3d>()
+            .WriteResource(SystemResource::GLOBAL_UBO)
+            .WriteResource(SystemResource::TRANSFORM_HIERARCHY);
+
         CreatePipelineLayout(descriptorSetLayout);
         CreatePipeline(renderPass);
     }
 
     PointLightSystem::~PointLightSystem() { vkDestroyPipelineLayout(m_Device.GetDevice(), m_PipelineLayout, nullptr); }
 
-    void PointLightSystem::Update(const Core::FrameInfo& frameInfo, Graphics::Ubo::GlobalUbo& ubo) {
-        UpdateLightCache(frameInfo);
-
+    void PointLightSystem::FixedUpdate(const Core::FrameInfo& frameInfo) {
         const auto rotateLight = glm::rotate(glm::mat4(1.f), frameInfo.deltaTime, {0.f, -1.f, 0.f});
 
-        const size_t lightCount =
-            std::min(m_CachedPointLights.size(), static_cast<size_t>(Graphics::Constants::MAX_LIGHTS));
+        frameInfo.registry.View<const Core::Component::PointLightComponent, Core::Component::TransformComponent3d>()
+            .Each([&](const Core::ECS::Entity entity,
+                      const Core::Component::PointLightComponent&,
+                      Core::Component::TransformComponent3d& transform) {
+                transform.position = glm::vec3(rotateLight * glm::vec4(transform.position, 1.f));
+                frameInfo.transformHierarchy.MarkDirty(entity);
+            });
+    }
 
-        for (size_t i = 0; i < lightCount; ++i) {
-            auto* gameObject = m_CachedPointLights[i];
+    void PointLightSystem::Update(const Core::FrameInfo& frameInfo, Graphics::Ubo::GlobalUbo& ubo) {
+        const auto lights = frameInfo.registry.View<const Core::Component::PointLightComponent,
+                                                    const Core::Component::WorldTransformComponent,
+                                                    const Core::Component::ColorComponent>();
+
+        if (!m_LightCapWarningIssued && lights.SizeHint() > Graphics::Constants::MAX_LIGHTS) {
+            LIARA_LOG_WARNING(LogSystems,
+                              "Too many point lights ({}), capping at {}",
+                              lights.SizeHint(),
+                              Graphics::Constants::MAX_LIGHTS);
+            m_LightCapWarningIssued = true;
+        }
 
-            gameObject->transform.position = glm::vec3(rotateLight * glm::vec4(gameObject->transform.position, 1.f));
+        uint32_t lightCount = 0;
+        lights.Each([&](Core::ECS::Entity,
+                        const Core::Component::PointLightComponent& pointLight,
+                        const Core::Component::WorldTransformComponent& transform,
+                        const Core::Component::ColorComponent& color) {
+            if (lightCount >= Graphics::Constants::MAX_LIGHTS) { return; }
 
-            ubo.pointLights[i].position = glm::vec4(gameObject->transform.position, 1.0f);
-            ubo.pointLights[i].color = glm::vec4(gameObject->color, gameObject->pointLight->intensity);
-        }
+            ubo.pointLights[lightCount].position = transform.interpolatedWorld[3];
+            ubo.pointLights[lightCount].color = glm::vec4(color.color, pointLight.intensity);
+            ++lightCount;
+        });
 
         ubo.numLights = static_cast<int>(lightCount);
     }
 
-
     void PointLightSystem::Render(const Core::FrameInfo& frameInfo) const {
-        if (m_CachedPointLights.empty()) { return; }
+        const auto lights = frameInfo.registry.View<const Core::Component::PointLightComponent,
+                                                    const Core::Component::TransformComponent3d,
+                                                    const Core::Component::WorldTransformComponent,
+                                                    const Core::Component::ColorComponent>();
+        if (lights.SizeHint() == 0) { return; }
 
         m_Pipeline->Bind(frameInfo.commandBuffer);
 
@@ -88,11 +119,18 @@ namespace Liara::Systems
                                 0,
                                 nullptr);
 
-        for (const auto* gameObject : m_CachedPointLights) {
+        uint32_t lightCount = 0;
+        lights.Each([&](Core::ECS::Entity,
+                        const Core::Component::PointLightComponent& pointLight,
+                        const Core::Component::TransformComponent3d& transform,
+                        const Core::Component::WorldTransformComponent& world,
+                        const Core::Component::ColorComponent& color) {
+            if (lightCount++ >= Graphics::Constants::MAX_LIGHTS) { return; }
+
             PointLightPushConstants push{};
-            push.position = glm::vec4(gameObject->transform.position, 1.0f);
-            push.color = glm::vec4(gameObject->color, gameObject->pointLight->intensity);
-            push.radius = gameObject->transform.scale.x;
+            push.position = world.interpolatedWorld[3];
+            push.color = glm::vec4(color.color, pointLight.intensity);
+            push.radius = transform.scale.x;
 
             vkCmdPushConstants(frameInfo.commandBuffer,
                                m_PipelineLayout,
@@ -102,14 +140,14 @@ namespace Liara::Systems
                                &push);
 
             vkCmdDraw(frameInfo.commandBuffer, 6, 1, 0, 0);
-        }
+        });
     }
 
     void PointLightSystem::CreatePipelineLayout(VkDescriptorSetLayout descriptorSetLayout) {
         constexpr VkPushConstantRange pushConstantRange{
             VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PointLightPushConstants)};
 
-        const std::vector<VkDescriptorSetLayout> layouts = {descriptorSetLayout};
+        const std::array<VkDescriptorSetLayout, 1> layouts = {descriptorSetLayout};
 
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -135,32 +173,4 @@ namespace Liara::Systems
         m_Pipeline = std::make_unique<Graphics::Liara_Pipeline>(
             m_Device, "shaders/PointLight.vert.spv", "shaders/PointLight.frag.spv", pipelineConfig, m_SettingsManager);
     }
-
-    void PointLightSystem::RebuildLightCache(const Core::FrameInfo& frameInfo) {
-        m_CachedPointLights.clear();
-        m_CachedPointLights.reserve(Graphics::Constants::MAX_LIGHTS);
-
-        for (auto& gameObject : frameInfo.gameObjects | std::views::values) {
-            if (gameObject.pointLight) {
-                m_CachedPointLights.push_back(&gameObject);
-
-                if (m_CachedPointLights.size() >= Graphics::Constants::MAX_LIGHTS) {
-                    LIARA_LOG_WARNING(LogSystems,
-                                      "Too many point lights ({}), capping at {}",
-                                      m_CachedPointLights.size(),
-                                      Graphics::Constants::MAX_LIGHTS);
-                    break;
-                }
-            }
-        }
-
-        m_LastGameObjectCount = frameInfo.gameObjects.size();
-        m_CacheNeedsRebuild = false;
-    }
-
-    void PointLightSystem::UpdateLightCache(const Core::FrameInfo& frameInfo) {
-        if (m_CacheNeedsRebuild || m_LastGameObjectCount != frameInfo.gameObjects.size()) {
-            RebuildLightCache(frameInfo);
-        }
-    }
 }
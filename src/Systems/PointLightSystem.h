@@ -3,16 +3,10 @@
 
 #include <vulkan/vulkan_core.h>
 
-#include <cstddef>
 #include <memory>
-#include <vector>
 
 #include "Liara_System.h"
 
-namespace Liara::Core
-{
-    class Liara_GameObject;
-}
 namespace Liara::Graphics
 {
     class Liara_Pipeline;
@@ -34,27 +28,20 @@ namespace Liara::Systems
                          const Core::Liara_SettingsManager& settingsManager);
         ~PointLightSystem() override;
 
+        void FixedUpdate(const Core::FrameInfo& frameInfo) override;
         void Update(const Core::FrameInfo& frameInfo, Graphics::Ubo::GlobalUbo& ubo) override;
         void Render(const Core::FrameInfo& frameInfo) const override;
 
-        void CacheNeedsRebuild() { m_CacheNeedsRebuild = true; }
-
     private:
         void CreatePipelineLayout(VkDescriptorSetLayout descriptorSetLayout);
         void CreatePipeline(VkRenderPass renderPass);
 
-        void RebuildLightCache(const Core::FrameInfo& frameInfo);
-        void UpdateLightCache(const Core::FrameInfo& frameInfo);
-
         Graphics::Liara_Device& m_Device;
         std::unique_ptr<Graphics::Liara_Pipeline> m_Pipeline;
         VkPipelineLayout m_PipelineLayout{};
 
         const Core::Liara_SettingsManager& m_SettingsManager;
 
-        // Use a vector to cache point lights for efficient rendering
-        std::vector<Core::Liara_GameObject*> m_CachedPointLights;
-        bool m_CacheNeedsRebuild = true;
-        size_t m_LastGameObjectCount = 0;
+        bool m_LightCapWarningIssued = false;
     };
 }
\ No newline at end of file
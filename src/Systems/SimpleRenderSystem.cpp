@@ -1,33 +1,48 @@
 #include "SimpleRenderSystem.h"
 
-#include "Core/Components/TransformComponent3d.h"
+#include "Core/Components/ModelComponent.h"
+#include "Core/Components/WorldTransformComponent.h"
+#include "Core/Culling/Liara_OcclusionBuffer.h"
 #include "Core/FrameInfo.h"
-#include "Core/Liara_GameObject.h"
 #include "Core/Liara_SettingsManager.h"
+#include "Core/Math/Bounds.h"
+#include "Core/Math/FrustumCulling.h"
+#include "Core/Memory/Liara_FrameAllocator.h"
+#include "Core/Spatial/Liara_SceneIndex.h"
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/Liara_Model.h"
+#include "Graphics/Liara_ObjectBuffer.h"
 #include "Graphics/Liara_Pipeline.h"
+#include "Graphics/Liara_RenderQueue.h"
 
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
-#include <vector>
 
+#include "glm/ext/matrix_float3x3.hpp"
 #include "glm/ext/matrix_float4x4.hpp"
+#include "glm/ext/vector_float3.hpp"
+#include "glm/ext/vector_float4.hpp"
+#include "glm/geometric.hpp"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 
-#include <ranges>
 #include <stdexcept>
 
 namespace Liara::Systems
 {
-    struct SimplePushConstantData
+    namespace
     {
-        glm::mat4 modelMatrix{1.0f};
-        glm::mat4 normalMatrix{1.0f};
-    };
+        /// Objects tested against the occlusion buffer per job
+        constexpr size_t OCCLUSION_BATCH_SIZE = 64;
+    }
 
     SimpleRenderSystem::SimpleRenderSystem(Graphics::Liara_Device& device,
                                            VkRenderPass renderPass,
@@ -36,6 +51,16 @@ namespace Liara::Systems
         : Liara_System("Simple Render System", {.major = 0, .minor = 4, .patch = 2, .prerelease = "dev"})
         , m_Device(device)
         , m_SettingsManager(settingsManager) {
+        // Update picks the level of detail of the models and writes their object data, Render only reads them.
+        // Update also counts the uploaded objects in the frame statistics
+        m_Access.Read<Core::Component::WorldTransformComponent>()
+            .Write<Core::Component::ModelComponent>()
+            .ReadResource(SystemResource::CAMERA)
+            .WriteResource(SystemResource::RENDER_QUEUE)
+            .WriteResource(SystemResource::FRAME_STATS);
+
+        m_ObjectBuffer = std::make_unique<Graphics::Liara_ObjectBuffer>(
+            m_Device, Graphics::Constants::MAX_FRAMES_IN_FLIGHT, VK_SHADER_STAGE_VERTEX_BIT);
         CreatePipelineLayout(descriptorSetLayout);
         CreatePipeline(renderPass);
     }
@@ -44,47 +69,200 @@ namespace Liara::Systems
         vkDestroyPipelineLayout(m_Device.GetDevice(), m_PipelineLayout, nullptr);
     }
 
+    void SimpleRenderSystem::Update(const Core::FrameInfo& frameInfo, Graphics::Ubo::GlobalUbo&) {
+        const bool lodSelection = m_SettingsManager.GetBool("render.lod_selection");
+        // Indexed models are drawn by the GPU-driven system when it is enabled, from its own object data
+        const bool gpuDriven =
+            m_SettingsManager.GetBool("render.gpu_driven") && m_Device.IsDrawIndirectCountSupported();
+
+        // A level is good enough while its error covers less than this fraction of the screen height
+        const float threshold = m_SettingsManager.GetFloat("render.lod_screen_error");
+        const float hysteresis = m_SettingsManager.GetFloat("render.lod_hysteresis");
+        const float coarserThreshold = threshold * (1.0f - hysteresis);
+        const float finerThreshold = threshold * (1.0f + hysteresis);
+
+        // A length l at distance d covers l * projection[1][1] / d of the [-1, 1] clip space height
+        const float projectionScale = 0.5f * frameInfo.camera.GetProjectionMatrix()[1][1];
+        const glm::vec3 cameraPosition{frameInfo.camera.GetInverseViewMatrix()[3]};
+
+        const auto selectLevel = [&](const Core::Component::WorldTransformComponent& transform,
+                                     const Core::Component::ModelComponent& model) -> uint32_t {
+            if (!model.model || model.model->GetLodCount() <= 1) { return 0; }
+
+            const Core::Math::BoundingSphere sphere =
+                Core::Math::TransformSphere(model.model->GetBounds().sphere, transform.interpolatedWorld);
+            const float distance = glm::length(sphere.center - cameraPosition) - sphere.radius;
+            if (distance <= 0.0f) { return 0; }
+
+            const float screenScale = sphere.radius * projectionScale / distance;
+            const auto screenError = [&](const uint32_t level) {
+                return model.model->GetLod(level).error * screenScale;
+            };
+
+            // Switching needs a margin on both sides, so that an object at the limit does not flicker
+            const uint32_t lodCount = model.model->GetLodCount();
+            uint32_t level = std::min(model.lodLevel, lodCount - 1);
+            while (level + 1 < lodCount && screenError(level + 1) <= coarserThreshold) { ++level; }
+            while (level > 0 && screenError(level) > finerThreshold) { --level; }
+            return level;
+        };
+
+        frameInfo.registry.View<const Core::Component::WorldTransformComponent, Core::Component::ModelComponent>()
+            .Each([&](const Core::ECS::Entity entity,
+                      const Core::Component::WorldTransformComponent& transform,
+                      Core::Component::ModelComponent& model) {
+                if (lodSelection) { model.lodLevel = selectLevel(transform, model); }
+                if (!model.model || (gpuDriven && model.model->HasIndices())) { return; }
+
+                // Unchanged objects, most of the static ones, are skipped by the object buffer
+                const glm::mat3& normal = transform.interpolatedNormal;
+                m_ObjectBuffer->Write(entity.index,
+                                      {.modelMatrix = transform.interpolatedWorld,
+                                       .normalMatrix = {glm::vec4{normal[0], 0.0f},
+                                                        glm::vec4{normal[1], 0.0f},
+                                                        glm::vec4{normal[2], 0.0f}}});
+            });
+
+        frameStats.uploadedObjectCount += m_ObjectBuffer->Upload(static_cast<uint32_t>(frameInfo.frameIndex));
+    }
+
     void SimpleRenderSystem::Render(const Core::FrameInfo& frameInfo) const {
-        m_Pipeline->Bind(frameInfo.commandBuffer);
-
-        vkCmdBindDescriptorSets(frameInfo.commandBuffer,
-                                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                m_PipelineLayout,
-                                0,
-                                1,
-                                &frameInfo.globalDescriptorSet,
-                                0,
-                                nullptr);
-
-        for (auto& snd : frameInfo.gameObjects | std::views::values) {
-            auto& obj = snd;
-            if (!obj.model) { continue; }
-            SimplePushConstantData push{};
-            push.modelMatrix = obj.transform.GetMat4();
-            push.normalMatrix = obj.transform.GetNormalMatrix();
-            vkCmdPushConstants(frameInfo.commandBuffer,
-                               m_PipelineLayout,
-                               VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                               0,
-                               sizeof(SimplePushConstantData),
-                               &push);
-            obj.model->Bind(frameInfo.commandBuffer);
-            obj.model->Draw(frameInfo.commandBuffer);
+        const auto objects = frameInfo.registry.View<const Core::Component::WorldTransformComponent,
+                                                     const Core::Component::ModelComponent>();
+        const size_t capacity = objects.SizeHint();
+        if (capacity == 0) { return; }
+
+        // Scratch arrays of the frame: a pointer bump each, released all at once when the frame index comes back
+        Core::Memory::Liara_LinearArena& arena = frameInfo.frameArena;
+        auto* const transforms = arena.AllocateArray<const Core::Component::WorldTransformComponent*>(capacity);
+        auto* const objectIndices = arena.AllocateArray<uint32_t>(capacity);
+        auto* const models = arena.AllocateArray<const Graphics::Liara_Model*>(capacity);
+        auto* const lodLevels = arena.AllocateArray<uint32_t>(capacity);
+        auto* const centerX = arena.AllocateArray<float>(capacity);
+        auto* const centerY = arena.AllocateArray<float>(capacity);
+        auto* const centerZ = arena.AllocateArray<float>(capacity);
+        auto* const radius = arena.AllocateArray<float>(capacity);
+        auto* const visible = arena.AllocateArray<uint8_t>(capacity);
+
+        const bool lodSelection = m_SettingsManager.GetBool("render.lod_selection");
+        // Indexed models are culled and drawn by the GPU-driven system when it is enabled
+        const bool gpuDriven =
+            m_SettingsManager.GetBool("render.gpu_driven") && m_Device.IsDrawIndirectCountSupported();
+        size_t count = 0;
+        size_t gpuDrivenCount = 0;
+        const auto gather = [&](const Core::ECS::Entity entity,
+                                const Core::Component::WorldTransformComponent& transform,
+                                const Core::Component::ModelComponent& model) {
+            if (!model.model) { return; }
+            if (gpuDriven && model.model->HasIndices()) {
+                ++gpuDrivenCount;
+                return;
+            }
+            const Core::Math::BoundingSphere sphere =
+                Core::Math::TransformSphere(model.model->GetBounds().sphere, transform.interpolatedWorld);
+            transforms[count] = &transform;
+            objectIndices[count] = entity.index;
+            models[count] = model.model.get();
+            lodLevels[count] = lodSelection ? model.lodLevel : 0;
+            centerX[count] = sphere.center.x;
+            centerY[count] = sphere.center.y;
+            centerZ[count] = sphere.center.z;
+            radius[count] = sphere.radius;
+            ++count;
+        };
+
+        const bool frustumCulling = m_SettingsManager.GetBool("render.frustum_culling");
+        const auto frustum =
+            Core::Math::Frustum::FromMatrix(frameInfo.camera.GetProjectionMatrix() * frameInfo.camera.GetViewMatrix());
+
+        // The scene index skips whole groups of objects out of view, only its candidates are tested one by one
+        size_t skippedCount = 0;
+        if (frustumCulling && m_SettingsManager.GetBool("render.spatial_index")) {
+            size_t candidateCount = 0;
+            frameInfo.sceneIndex.QueryFrustum(frustum, [&](const Core::ECS::Entity entity) {
+                ++candidateCount;
+                const auto* transform = frameInfo.registry.TryGet<Core::Component::WorldTransformComponent>(entity);
+                const auto* model = frameInfo.registry.TryGet<Core::Component::ModelComponent>(entity);
+                if (transform != nullptr && model != nullptr && count < capacity) {
+                    gather(entity, *transform, *model);
+                }
+            });
+            // Only what the index rejected, the candidates skipped by gather were not culled
+            skippedCount = frameInfo.sceneIndex.GetEntityCount() - candidateCount;
+        }
+        else {
+            objects.Each([&](const Core::ECS::Entity entity,
+                             const Core::Component::WorldTransformComponent& transform,
+                             const Core::Component::ModelComponent& model) { gather(entity, transform, model); });
+        }
+
+        size_t visibleCount = count;
+        if (frustumCulling) {
+            const Core::Math::SphereBatch spheres{.centerX = {centerX, count},
+                                                  .centerY = {centerY, count},
+                                                  .centerZ = {centerZ, count},
+                                                  .radius = {radius, count}};
+            visibleCount = Core::Math::CullSpheres(frustum, spheres, {visible, count});
+        }
+        else { std::fill_n(visible, count, uint8_t{1}); }
+
+        frameStats.culledObjectCount += skippedCount + count - visibleCount;
+
+        // The objects left are tested against the occluders rasterized for this frame, in parallel
+        if (frameInfo.occlusionBuffer != nullptr && visibleCount > 0) {
+            const Core::Culling::Liara_OcclusionBuffer& occlusionBuffer = *frameInfo.occlusionBuffer;
+            std::atomic<size_t> occludedCount{0};
+            frameInfo.jobSystem.ParallelFor(count, OCCLUSION_BATCH_SIZE, [&](const size_t begin, const size_t end) {
+                size_t occluded = 0;
+                for (size_t i = begin; i < end; ++i) {
+                    if (visible[i] == 0) { continue; }
+                    if (!occlusionBuffer.IsBoxVisible(models[i]->GetBounds().box, transforms[i]->interpolatedWorld)) {
+                        visible[i] = 0;
+                        ++occluded;
+                    }
+                }
+                occludedCount.fetch_add(occluded, std::memory_order_relaxed);
+            });
+            visibleCount -= occludedCount.load(std::memory_order_relaxed);
+            frameStats.occludedObjectCount += occludedCount.load(std::memory_order_relaxed);
+        }
+
+        frameStats.visibleObjectCount += visibleCount;
+
+        // The queue binds the pipeline, the global set and each mesh once, and draws the copies of a mesh as instances.
+        // Instances only carry the slot of their object, the shader reads its matrices from the object buffer.
+        Graphics::Liara_RenderQueue& queue = frameInfo.renderQueue;
+        const VkDescriptorSet objectSet = m_ObjectBuffer->GetDescriptorSet(static_cast<uint32_t>(frameInfo.frameIndex));
+        const glm::vec3 cameraPosition{frameInfo.camera.GetInverseViewMatrix()[3]};
+        for (size_t i = 0; i < count; ++i) {
+            if (visible[i] == 0) { continue; }
+
+            const float viewDepth = glm::length(glm::vec3{centerX[i], centerY[i], centerZ[i]} - cameraPosition);
+            const Graphics::DrawPacket packet{.sortKey = queue.MakeSortKey(Graphics::DrawLayer::SOLID,
+                                                                           m_Pipeline.get(),
+                                                                           frameInfo.globalDescriptorSet,
+                                                                           models[i],
+                                                                           lodLevels[i],
+                                                                           viewDepth),
+                                              .pipeline = m_Pipeline.get(),
+                                              .pipelineLayout = m_PipelineLayout,
+                                              .descriptorSet = frameInfo.globalDescriptorSet,
+                                              .objectDescriptorSet = objectSet,
+                                              .model = models[i],
+                                              .lodLevel = lodLevels[i]};
+            queue.SubmitInstance(packet, {.objectIndex = objectIndices[i]});
         }
     }
 
     void SimpleRenderSystem::CreatePipelineLayout(VkDescriptorSetLayout descriptorSetLayout) {
-        constexpr VkPushConstantRange pushConstantRange{
-            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(SimplePushConstantData)};
-
-        const std::vector<VkDescriptorSetLayout> layouts = {descriptorSetLayout};
+        const std::array<VkDescriptorSetLayout, 2> layouts = {descriptorSetLayout, m_ObjectBuffer->GetSetLayout()};
 
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(layouts.size());
         pipelineLayoutInfo.pSetLayouts = layouts.data();
-        pipelineLayoutInfo.pushConstantRangeCount = 1;
-        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+        pipelineLayoutInfo.pushConstantRangeCount = 0;
+        pipelineLayoutInfo.pPushConstantRanges = nullptr;
         if (vkCreatePipelineLayout(m_Device.GetDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayout)
             != VK_SUCCESS) {
             LIARA_THROW_RUNTIME_ERROR(LogSystems, "Failed to create pipeline layout!");
@@ -96,6 +274,11 @@ namespace Liara::Systems
 
         Graphics::PipelineConfigInfo pipelineConfig{};
         Graphics::Liara_Pipeline::DefaultPipelineConfigInfo(pipelineConfig);
+        // The object slot comes per instance, from the instance buffer of the render queue
+        pipelineConfig.bindingDescriptions.push_back(Graphics::InstanceData::GetBindingDescription());
+        const auto instanceAttributes = Graphics::InstanceData::GetAttributeDescriptions();
+        pipelineConfig.attributeDescriptions.insert(
+            pipelineConfig.attributeDescriptions.end(), instanceAttributes.begin(), instanceAttributes.end());
         pipelineConfig.renderPass = renderPass;
         pipelineConfig.pipelineLayout = m_PipelineLayout;
         m_Pipeline = std::make_unique<Graphics::Liara_Pipeline>(m_Device,
@@ -9,6 +9,7 @@
 
 namespace Liara::Graphics
 {
+    class Liara_ObjectBuffer;
     class Liara_Pipeline;
     class Liara_Device;
 }
@@ -28,7 +29,11 @@ namespace Liara::Systems
                            const Core::Liara_SettingsManager& settingsManager);
         ~SimpleRenderSystem() override;
 
-        void Update(const Core::FrameInfo&, Graphics::Ubo::GlobalUbo&) override {}
+        /**
+         * @brief Chooses the level of detail of each model from its projected size, with some hysteresis, and
+         * uploads the object data that changed.
+         */
+        void Update(const Core::FrameInfo& frameInfo, Graphics::Ubo::GlobalUbo& ubo) override;
         void Render(const Core::FrameInfo& frameInfo) const override;
 
     private:
@@ -38,6 +43,7 @@ namespace Liara::Systems
         Graphics::Liara_Device& m_Device;
         std::unique_ptr<Graphics::Liara_Pipeline> m_Pipeline;
         VkPipelineLayout m_PipelineLayout{};
+        std::unique_ptr<Graphics::Liara_ObjectBuffer> m_ObjectBuffer;  ///< Matrices of the objects, by entity index
 
         const Core::Liara_SettingsManager& m_SettingsManager;
     };
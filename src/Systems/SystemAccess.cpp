@@ -0,0 +1,83 @@
+#include "SystemAccess.h"
+
+#include "Core/ECS/Liara_Registry.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Liara::Systems
+{
+    namespace
+    {
+        constexpr uint32_t ResourceBit(const SystemResource resource) {
+            return 1u << static_cast<uint32_t>(resource);
+        }
+    }
+
+    std::string_view SystemResourceToString(const SystemResource resource) {
+        switch (resource) {
+            case SystemResource::GLOBAL_UBO: return "GlobalUbo";
+            case SystemResource::CAMERA: return "Camera";
+            case SystemResource::TRANSFORM_HIERARCHY: return "TransformHierarchy";
+            case SystemResource::FRAME_STATS: return "FrameStats";
+            case SystemResource::IMGUI: return "ImGui";
+            case SystemResource::RENDER_QUEUE: return "RenderQueue";
+            case SystemResource::COUNT: break;
+        }
+        return "Unknown";
+    }
+
+    SystemAccess& SystemAccess::ReadResource(const SystemResource resource) {
+        m_ReadResources |= ResourceBit(resource);
+        if (resource == SystemResource::IMGUI) { m_MainThreadOnly = true; }
+        m_Declared = true;
+        return *this;
+    }
+
+    SystemAccess& SystemAccess::WriteResource(const SystemResource resource) {
+        m_WriteResources |= ResourceBit(resource);
+        if (resource == SystemResource::IMGUI) { m_MainThreadOnly = true; }
+        m_Declared = true;
+        return *this;
+    }
+
+    SystemAccess& SystemAccess::MainThreadOnly() {
+        m_MainThreadOnly = true;
+        return *this;
+    }
+
+    SystemAccess& SystemAccess::Exclusive() {
+        m_Exclusive = true;
+        return *this;
+    }
+
+    bool SystemAccess::ConflictsWith(const SystemAccess& other) const {
+        if (IsExclusive() || other.IsExclusive()) { return true; }
+
+        const uint32_t resources = m_ReadResources | m_WriteResources;
+        const uint32_t otherResources = other.m_ReadResources | other.m_WriteResources;
+        if ((m_WriteResources & otherResources) != 0 || (other.m_WriteResources & resources) != 0) { return true; }
+
+        return Intersects(m_WriteComponents, other.m_WriteComponents)
+            || Intersects(m_WriteComponents, other.m_ReadComponents)
+            || Intersects(m_ReadComponents, other.m_WriteComponents);
+    }
+
+    bool SystemAccess::HasWriteHazardWith(const SystemAccess& other) const {
+        return (m_WriteResources & other.m_WriteResources) != 0
+            || Intersects(m_WriteComponents, other.m_WriteComponents);
+    }
+
+    void SystemAccess::PrepareStorage(Core::ECS::Liara_Registry& registry) const {
+        for (const auto& component : m_ReadComponents) { component.createStorage(registry); }
+        for (const auto& component : m_WriteComponents) { component.createStorage(registry); }
+    }
+
+    bool SystemAccess::Intersects(const std::vector<ComponentAccess>& a, const std::vector<ComponentAccess>& b) {
+        return std::ranges::any_of(a, [&b](const ComponentAccess& access) {
+            return std::ranges::find(b, access) != b.end();
+        });
+    }
+}
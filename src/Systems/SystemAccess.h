@@ -0,0 +1,122 @@
+/**
+ * @file SystemAccess.h
+ * @brief Defines the `SystemAccess` class, the components and resources a system reads and writes during Update.
+ *
+ * The scheduler uses these declarations to run systems without conflicting accesses in parallel,
+ * and to keep the registration order between the others.
+ */
+
+#pragma once
+
+#include "Core/ECS/Liara_Registry.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Liara::Systems
+{
+    /**
+     * @brief Shared engine state a system can access besides the components.
+     */
+    enum class SystemResource : uint8_t
+    {
+        GLOBAL_UBO,           ///< The global uniform buffer passed to Update
+        CAMERA,               ///< The camera of the frame
+        TRANSFORM_HIERARCHY,  ///< Parent links and dirty list, MarkDirty is a write
+        FRAME_STATS,          ///< The global frame statistics
+        IMGUI,                ///< The ImGui context, also implies running on the main thread
+        RENDER_QUEUE,         ///< The render queue, written by the Render of the systems submitting draw packets
+
+        COUNT
+    };
+
+    [[nodiscard]] std::string_view SystemResourceToString(SystemResource resource);
+
+    /**
+     * @class SystemAccess
+     * @brief Declaration of the accesses of a system, built in its constructor.
+     *
+     * A system that declares nothing is exclusive and runs on the main thread, as before the scheduler existed.
+     * Systems running in parallel must not create or destroy entities, nor add or remove components.
+     */
+    class SystemAccess
+    {
+    public:
+        template <typename... Ts> SystemAccess& Read() {
+            (AddComponent<Ts>(m_ReadComponents), ...);
+            m_Declared = true;
+            return *this;
+        }
+
+        template <typename... Ts> SystemAccess& Write() {
+            (AddComponent<Ts>(m_WriteComponents), ...);
+            m_Declared = true;
+            return *this;
+        }
+
+        SystemAccess& ReadResource(SystemResource resource);
+        SystemAccess& WriteResource(SystemResource resource);
+
+        /**
+         * @brief Forces the system to run on the main thread, e.g. for SDL or ImGui calls.
+         */
+        SystemAccess& MainThreadOnly();
+
+        /**
+         * @brief Forbids any parallelism with the system, e.g. when it changes the structure of the registry.
+         */
+        SystemAccess& Exclusive();
+
+        [[nodiscard]] bool IsExclusive() const { return !m_Declared || m_Exclusive; }
+        [[nodiscard]] bool IsMainThreadOnly() const { return !m_Declared || m_MainThreadOnly; }
+        [[nodiscard]] bool WritesResource(const SystemResource resource) const {
+            return (m_WriteResources & (1u << static_cast<uint32_t>(resource))) != 0;
+        }
+
+        /**
+         * @brief Whether the two systems cannot run in parallel: one writes what the other reads or writes.
+         */
+        [[nodiscard]] bool ConflictsWith(const SystemAccess& other) const;
+
+        /**
+         * @brief Whether both systems write a same component or resource, their result then depends on their order.
+         */
+        [[nodiscard]] bool HasWriteHazardWith(const SystemAccess& other) const;
+
+        /**
+         * @brief Creates the pools of the declared components, so that parallel systems never create them concurrently.
+         */
+        void PrepareStorage(Core::ECS::Liara_Registry& registry) const;
+
+    private:
+        struct ComponentAccess
+        {
+            uint32_t id;
+            void (*createStorage)(Core::ECS::Liara_Registry& registry);
+
+            bool operator==(const ComponentAccess& other) const { return id == other.id; }
+        };
+
+        template <typename T> static void AddComponent(std::vector<ComponentAccess>& components) {
+            using Component = std::remove_const_t<T>;
+            const ComponentAccess access{
+                Core::ECS::ComponentTypeId<Component>(),
+                [](Core::ECS::Liara_Registry& registry) { static_cast<void>(registry.Storage<Component>()); }};
+            if (std::ranges::find(components, access) == components.end()) { components.push_back(access); }
+        }
+
+        [[nodiscard]] static bool Intersects(const std::vector<ComponentAccess>& a,
+                                             const std::vector<ComponentAccess>& b);
+
+        std::vector<ComponentAccess> m_ReadComponents;
+        std::vector<ComponentAccess> m_WriteComponents;
+        uint32_t m_ReadResources = 0;   ///< Bit mask of SystemResource
+        uint32_t m_WriteResources = 0;  ///< Bit mask of SystemResource
+        bool m_Declared = false;
+        bool m_Exclusive = false;
+        bool m_MainThreadOnly = false;
+    };
+}
@@ -1,6 +1,10 @@
 #include "ImGuiEngineStats.h"
 
 #include "Core/FrameInfo.h"
+#include "Graphics/Liara_Device.h"
+#include "Graphics/Liara_GeometryPool.h"
+#include "Graphics/Liara_MemoryAllocator.h"
+#include "Graphics/Liara_UploadContext.h"
 
 #include "imgui.h"
 
@@ -27,12 +31,53 @@ namespace Liara::UI
             ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
                         frameInfo.deltaTime * 1000.0f,
                         1.0f / frameInfo.deltaTime);
-            ImGui::Text("Number of Game Objects: %ld", frameInfo.gameObjects.size());
+            ImGui::Text("Number of Entities: %ld", frameInfo.registry.Size());
             ImGui::Text("Triangle Count: %ld Vertex Count: %ld",
                         frameStats.previousTriangleCount,
                         frameStats.previousVertexCount);
-            ImGui::Text("Draw Call Count: %ld", frameStats.previousDrawCallCount);
+            ImGui::Text("Draw Call Count: %ld Binds: %ld",
+                        frameStats.previousDrawCallCount,
+                        frameStats.previousBindCount);
+            ImGui::Text("Objects Drawn: %ld Culled: %ld Occluded: %ld",
+                        frameStats.previousVisibleObjectCount,
+                        frameStats.previousCulledObjectCount,
+                        frameStats.previousOccludedObjectCount);
+            ImGui::Text("Object Data Uploads: %ld", frameStats.previousUploadedObjectCount);
             ImGui::Text("Mesh Draw Time: %.3f ms", frameStats.previousMeshDrawTime);
+
+            const Core::Memory::ArenaStats arena = frameInfo.frameArena.GetStats();
+            ImGui::Text("Frame Arena: %.1f / %.1f KiB (peak %.1f KiB, %zu overflows)",
+                        static_cast<double>(arena.used) / 1024.0,
+                        static_cast<double>(arena.capacity) / 1024.0,
+                        static_cast<double>(arena.highWaterMark) / 1024.0,
+                        arena.overflowCount);
+        }
+
+        if (ImGui::CollapsingHeader("GPU Memory")) {
+            constexpr double mib = 1024.0 * 1024.0;
+            const Graphics::MemoryStats memory = m_device.GetMemoryAllocator().GetStats();
+            ImGui::Text("Blocks: %u, %.1f / %.1f MiB used by %lu allocations",
+                        memory.blockCount,
+                        static_cast<double>(memory.blockUsedBytes) / mib,
+                        static_cast<double>(memory.blockBytes) / mib,
+                        memory.allocationCount);
+            ImGui::Text("Free Ranges: %lu, %.1f%% fragmented", memory.freeRangeCount, memory.fragmentation * 100.0);
+            ImGui::Text("Dedicated: %u, %.1f MiB",
+                        memory.dedicatedCount,
+                        static_cast<double>(memory.dedicatedBytes) / mib);
+
+            const Graphics::GeometryPoolStats geometry = m_device.GetGeometryPool().GetStats();
+            ImGui::Text("Geometry: %u blocks, %.1f%% fragmented", geometry.blockCount, geometry.fragmentation * 100.0);
+            ImGui::Text("Defragmented: %.1f KiB last frame",
+                        static_cast<double>(frameStats.previousDefragmentedBytes) / 1024.0);
+
+            const Graphics::UploadStats upload = m_device.GetUploadContext().GetStats();
+            ImGui::Text("Staging Ring: %.1f / %.1f KiB, %u batches pending, %lu overflows",
+                        static_cast<double>(upload.ringUsed) / 1024.0,
+                        static_cast<double>(upload.ringCapacity) / 1024.0,
+                        upload.pendingBatches,
+                        upload.overflowCount);
+            ImGui::Text("Upload Queue: %s", upload.dedicatedQueue ? "separate" : "graphics");
         }
 
         // TODO:
@@ -8,13 +8,19 @@ namespace Liara
         struct FrameInfo;
     }
 
+    namespace Graphics
+    {
+        class Liara_Device;
+    }
+
     namespace UI
     {
         class ImGuiEngineStats
         {
         public:
-            explicit ImGuiEngineStats(const Core::ApplicationInfo& appInfo)
-                : m_app_info(appInfo) {}
+            ImGuiEngineStats(const Core::ApplicationInfo& appInfo, const Graphics::Liara_Device& device)
+                : m_app_info(appInfo)
+                , m_device(device) {}
             ~ImGuiEngineStats() = default;
 
             ImGuiEngineStats(const ImGuiEngineStats&) = delete;
@@ -26,6 +32,7 @@ namespace Liara
 
         private:
             const Core::ApplicationInfo& m_app_info;
+            const Graphics::Liara_Device& m_device;
         };
 
     }
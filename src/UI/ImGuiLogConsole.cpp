@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <string_view>
 #include <imgui.h>
 
 namespace Liara::UI
@@ -23,7 +24,7 @@ namespace Liara::UI
         m_filter_dirty = true;
     }
 
-    void ImGuiLogConsole::Draw(bool* p_open) {
+    void ImGuiLogConsole::Draw(Core::Memory::Liara_LinearArena& frameArena, bool* p_open) {
         if (p_open && !*p_open) return;
 
         ImGui::SetNextWindowSize(ImVec2(800, 600), ImGuiCond_FirstUseEver);
@@ -37,7 +38,7 @@ namespace Liara::UI
         ImGui::Separator();
         DrawStats();
         ImGui::Separator();
-        DrawLogList();
+        DrawLogList(frameArena);
         ImGui::End();
     }
 
@@ -78,7 +79,7 @@ namespace Liara::UI
         }
 
         if (m_text_filter[0] != '\0') {
-            if (const std::string filter_text(m_text_filter.data());
+            if (const std::string_view filter_text(m_text_filter.data());
                 entry.message.find(filter_text) == std::string::npos
                 && entry.full_formatted.find(filter_text) == std::string::npos) {
                 return false;
@@ -86,7 +87,7 @@ namespace Liara::UI
         }
 
         if (m_category_filter[0] != '\0') {
-            if (const std::string filter_category(m_category_filter.data());
+            if (const std::string_view filter_category(m_category_filter.data());
                 entry.category_name.find(filter_category) == std::string::npos) {
                 return false;
             }
@@ -198,7 +199,7 @@ namespace Liara::UI
         }
     }
 
-    void ImGuiLogConsole::DrawLogList() {
+    void ImGuiLogConsole::DrawLogList(Core::Memory::Liara_LinearArena& frameArena) {
         UpdateFilteredEntries();
 
         if (ImGui::BeginChild("LogScrollRegion", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar)) {
@@ -211,17 +212,18 @@ namespace Liara::UI
 
                     const ImVec4 color = GetLogLevelColor(entry->level);
 
-                    std::string display_text;
+                    // Rebuilt every frame for every visible line, so appended in place in the frame arena
+                    Core::Memory::FrameString display_text{Core::Memory::ArenaAllocator<char>(frameArena)};
 
-                    if (m_show_timestamps) { display_text += "[" + entry->formatted_timestamp + "]"; }
+                    if (m_show_timestamps) { display_text.append("[").append(entry->formatted_timestamp).append("]"); }
 
-                    display_text += "[" + std::string(Logging::LogLevelToString(entry->level)) + "]";
+                    display_text.append("[").append(Logging::LogLevelToString(entry->level)).append("]");
 
-                    if (m_show_categories) { display_text += "[" + entry->category_name + "]"; }
-                    if (m_show_thread_ids) { display_text += "[T:" + entry->thread_id + "]"; }
-                    if (m_show_location) { display_text += "[" + entry->location + "]"; }
+                    if (m_show_categories) { display_text.append("[").append(entry->category_name).append("]"); }
+                    if (m_show_thread_ids) { display_text.append("[T:").append(entry->thread_id).append("]"); }
+                    if (m_show_location) { display_text.append("[").append(entry->location).append("]"); }
 
-                    display_text += " " + entry->message;
+                    display_text.append(" ").append(entry->message);
 
                     ImGui::PushStyleColor(ImGuiCol_Text, color);
                     ImGui::TextUnformatted(display_text.c_str());
@@ -3,6 +3,7 @@
 #include "Core/Logging/LogCategory.h"
 #include "Core/Logging/LogLevel.h"
 #include "Core/Logging/LogMessage.h"
+#include "Core/Memory/Liara_FrameAllocator.h"
 
 #include <algorithm>
 #include <array>
@@ -90,7 +91,10 @@ namespace Liara::UI
         ImGuiLogConsole& operator=(ImGuiLogConsole&&) = delete;
 
         void AddLogEntry(const Logging::LogMessage& message, const std::string& formatted_timestamp);
-        void Draw(bool* p_open = nullptr);
+        /**
+         * @brief Draws the console, the text of the visible lines is built in the frame arena.
+         */
+        void Draw(Core::Memory::Liara_LinearArena& frameArena, bool* p_open = nullptr);
         void Clear();
 
         size_t GetTotalLogCount() const { return m_total_logs.load(); }
@@ -104,6 +108,6 @@ namespace Liara::UI
 
         void DrawFilterBar();
         void DrawStats() const;
-        void DrawLogList();
+        void DrawLogList(Core::Memory::Liara_LinearArena& frameArena);
     };
 }
\ No newline at end of file